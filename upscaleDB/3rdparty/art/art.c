@@ -0,0 +1,1092 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Writers never modify the keys or the layout of a node which is visible
+ * to readers. The only in-place modifications are single (atomic) pointer
+ * stores: replacing a child, setting the value leaf of a node and
+ * adding/removing a child of a Node256 (its slots are addressed directly
+ * by the key byte). Everything else creates a new node which is then
+ * published with an atomic store, and the old node is retired.
+ *
+ * Invariant: each inner node has at least two entries (children plus the
+ * value leaf, which is the leaf of the key that ends in this node).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+#include "art.h"
+
+#define NODE4           1
+#define NODE16          2
+#define NODE48          3
+#define NODE256         4
+
+/* a Node256 is converted to a Node48 if it has less children */
+#define NODE256_MIN     40
+
+/* retired objects are reclaimed when there are this many */
+#define RECLAIM_THRESHOLD 64
+
+#define IS_LEAF(p)      (((uintptr_t)(p)) & 1)
+#define LEAF(p)         ((art_leaf_t *)((uintptr_t)(p) & ~(uintptr_t)1))
+#define TAG(l)          ((void *)((uintptr_t)(l) | 1))
+
+#define LOAD(p)         __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define STORE(p, v)     __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+
+typedef struct node_t {
+  uint8_t type;
+  uint8_t _reserved[3];
+
+  /* the number of children (without the value leaf) */
+  uint32_t num_children;
+
+  /* the length of the compressed path */
+  uint32_t prefix_len;
+
+  /* the compressed path; stored behind the node */
+  uint8_t *prefix;
+
+  /* the leaf of the key which ends in this node, or NULL */
+  art_leaf_t *value_leaf;
+} node_t;
+
+typedef struct {
+  node_t n;
+  uint8_t keys[4];
+  void *children[4];
+} node4_t;
+
+typedef struct {
+  node_t n;
+  uint8_t keys[16];
+  void *children[16];
+} node16_t;
+
+typedef struct {
+  node_t n;
+  /* 1-based index into |children|; 0 if there's no child */
+  uint8_t index[256];
+  void *children[48];
+} node48_t;
+
+typedef struct {
+  node_t n;
+  void *children[256];
+} node256_t;
+
+struct art_retired_t {
+  art_retired_t *next;
+  void *ptr;
+  void (*fn)(void *);
+  uint64_t epoch;
+};
+
+static size_t
+node_struct_size(int type)
+{
+  switch (type) {
+    case NODE4:   return sizeof(node4_t);
+    case NODE16:  return sizeof(node16_t);
+    case NODE48:  return sizeof(node48_t);
+    default:      return sizeof(node256_t);
+  }
+}
+
+static size_t
+node_size(const node_t *n)
+{
+  return node_struct_size(n->type) + n->prefix_len;
+}
+
+static size_t
+leaf_size(const art_leaf_t *l)
+{
+  size_t s = offsetof(art_leaf_t, key) + l->key_size;
+  return s < sizeof(art_leaf_t) ? sizeof(art_leaf_t) : s;
+}
+
+static int
+leaf_equals(const art_leaf_t *l, const uint8_t *key, uint32_t key_size)
+{
+  return l->key_size == key_size && !memcmp(l->key, key, key_size);
+}
+
+static int
+leaf_compare(const art_leaf_t *l, const uint8_t *key, uint32_t key_size)
+{
+  uint32_t n = l->key_size < key_size ? l->key_size : key_size;
+  int cmp = memcmp(l->key, key, n);
+  if (cmp)
+    return cmp;
+  return l->key_size < key_size ? -1 : (l->key_size > key_size ? 1 : 0);
+}
+
+static art_leaf_t *
+leaf_alloc(art_tree_t *tree, const uint8_t *key, uint32_t key_size,
+                void *value)
+{
+  size_t s = offsetof(art_leaf_t, key) + key_size;
+  art_leaf_t *l;
+
+  if (s < sizeof(art_leaf_t))
+    s = sizeof(art_leaf_t);
+  l = (art_leaf_t *)malloc(s);
+  if (!l)
+    return 0;
+  l->value = value;
+  l->key_size = key_size;
+  memcpy(l->key, key, key_size);
+  tree->memory_usage += s;
+  return l;
+}
+
+static node_t *
+node_alloc(art_tree_t *tree, int type, const uint8_t *prefix,
+                uint32_t prefix_len)
+{
+  size_t s = node_struct_size(type);
+  node_t *n = (node_t *)calloc(1, s + prefix_len);
+  if (!n)
+    return 0;
+  n->type = (uint8_t)type;
+  n->prefix_len = prefix_len;
+  n->prefix = (uint8_t *)n + s;
+  if (prefix_len)
+    memcpy(n->prefix, prefix, prefix_len);
+  tree->memory_usage += s + prefix_len;
+  return n;
+}
+
+/* blocks until no reader can see the objects of the current epoch */
+static void
+synchronize(art_tree_t *tree)
+{
+  uint64_t e = __atomic_add_fetch(&tree->epoch, 1, __ATOMIC_SEQ_CST);
+  int i;
+
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  for (i = 0; i < ART_MAX_READERS; i++) {
+    uint64_t r;
+    do {
+      r = __atomic_load_n(&tree->readers[i].epoch, __ATOMIC_ACQUIRE);
+    } while (r != 0 && r < e);
+  }
+}
+
+static void
+retire(art_tree_t *tree, void *ptr, void (*fn)(void *))
+{
+  art_retired_t *r = (art_retired_t *)malloc(sizeof(*r));
+  if (!r) {
+    synchronize(tree);
+    fn(ptr);
+    return;
+  }
+  r->ptr = ptr;
+  r->fn = fn;
+  r->epoch = __atomic_load_n(&tree->epoch, __ATOMIC_RELAXED);
+  r->next = tree->retired;
+  tree->retired = r;
+  tree->num_retired++;
+}
+
+static void
+retire_node(art_tree_t *tree, node_t *n)
+{
+  tree->memory_usage -= node_size(n);
+  retire(tree, n, free);
+}
+
+static void
+retire_leaf(art_tree_t *tree, art_leaf_t *l)
+{
+  tree->memory_usage -= leaf_size(l);
+  retire(tree, l, free);
+}
+
+/* returns the address of the child slot for |byte|, or NULL; the slot
+ * can be empty */
+static void **
+find_child(node_t *n, uint8_t byte)
+{
+  uint32_t i;
+
+  switch (n->type) {
+    case NODE4: {
+      node4_t *p = (node4_t *)n;
+      for (i = 0; i < n->num_children; i++)
+        if (p->keys[i] == byte)
+          return &p->children[i];
+      return 0;
+    }
+    case NODE16: {
+      node16_t *p = (node16_t *)n;
+#ifdef __SSE2__
+      __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte),
+                      _mm_loadu_si128((const __m128i *)p->keys));
+      unsigned mask = (unsigned)_mm_movemask_epi8(cmp)
+                      & ((1u << n->num_children) - 1);
+      return mask ? &p->children[__builtin_ctz(mask)] : 0;
+#else
+      for (i = 0; i < n->num_children; i++)
+        if (p->keys[i] == byte)
+          return &p->children[i];
+      return 0;
+#endif
+    }
+    case NODE48: {
+      node48_t *p = (node48_t *)n;
+      return p->index[byte] ? &p->children[p->index[byte] - 1] : 0;
+    }
+    default:
+      return &((node256_t *)n)->children[byte];
+  }
+}
+
+/* returns the first child with a key byte >= |from|, or NULL */
+static void *
+child_ge(node_t *n, int from, int *byte)
+{
+  int i;
+
+  switch (n->type) {
+    case NODE4:
+    case NODE16: {
+      const uint8_t *keys = n->type == NODE4
+                ? ((node4_t *)n)->keys : ((node16_t *)n)->keys;
+      void **children = n->type == NODE4
+                ? ((node4_t *)n)->children : ((node16_t *)n)->children;
+      for (i = 0; i < (int)n->num_children; i++) {
+        void *c;
+        if (keys[i] >= from && (c = LOAD(children[i])) != 0) {
+          *byte = keys[i];
+          return c;
+        }
+      }
+      return 0;
+    }
+    case NODE48: {
+      node48_t *p = (node48_t *)n;
+      for (i = from; i < 256; i++) {
+        void *c;
+        if (p->index[i] && (c = LOAD(p->children[p->index[i] - 1])) != 0) {
+          *byte = i;
+          return c;
+        }
+      }
+      return 0;
+    }
+    default: {
+      node256_t *p = (node256_t *)n;
+      for (i = from; i < 256; i++) {
+        void *c = LOAD(p->children[i]);
+        if (c) {
+          *byte = i;
+          return c;
+        }
+      }
+      return 0;
+    }
+  }
+}
+
+/* returns the last child with a key byte <= |from|, or NULL */
+static void *
+child_le(node_t *n, int from, int *byte)
+{
+  int i;
+
+  switch (n->type) {
+    case NODE4:
+    case NODE16: {
+      const uint8_t *keys = n->type == NODE4
+                ? ((node4_t *)n)->keys : ((node16_t *)n)->keys;
+      void **children = n->type == NODE4
+                ? ((node4_t *)n)->children : ((node16_t *)n)->children;
+      for (i = (int)n->num_children - 1; i >= 0; i--) {
+        void *c;
+        if (keys[i] <= from && (c = LOAD(children[i])) != 0) {
+          *byte = keys[i];
+          return c;
+        }
+      }
+      return 0;
+    }
+    case NODE48: {
+      node48_t *p = (node48_t *)n;
+      for (i = from; i >= 0; i--) {
+        void *c;
+        if (p->index[i] && (c = LOAD(p->children[p->index[i] - 1])) != 0) {
+          *byte = i;
+          return c;
+        }
+      }
+      return 0;
+    }
+    default: {
+      node256_t *p = (node256_t *)n;
+      for (i = from; i >= 0; i--) {
+        void *c = LOAD(p->children[i]);
+        if (c) {
+          *byte = i;
+          return c;
+        }
+      }
+      return 0;
+    }
+  }
+}
+
+/* copies the children of |n| (sorted by key byte); returns their number */
+static int
+collect(node_t *n, uint8_t *bytes, void **children)
+{
+  int count = 0;
+  int b = 0;
+  void *c;
+
+  while (b < 256 && (c = child_ge(n, b, &b)) != 0) {
+    bytes[count] = (uint8_t)b;
+    children[count++] = c;
+    b++;
+  }
+  return count;
+}
+
+/* creates the smallest node which can hold |count| children */
+static node_t *
+build(art_tree_t *tree, const uint8_t *prefix, uint32_t prefix_len,
+                art_leaf_t *value_leaf, const uint8_t *bytes, void **children,
+                int count)
+{
+  node_t *n;
+  int i;
+
+  if (count <= 4) {
+    node4_t *p = (node4_t *)(n = node_alloc(tree, NODE4, prefix, prefix_len));
+    if (!n)
+      return 0;
+    memcpy(p->keys, bytes, count);
+    memcpy(p->children, children, count * sizeof(void *));
+  }
+  else if (count <= 16) {
+    node16_t *p = (node16_t *)(n = node_alloc(tree, NODE16, prefix,
+                            prefix_len));
+    if (!n)
+      return 0;
+    memcpy(p->keys, bytes, count);
+    memcpy(p->children, children, count * sizeof(void *));
+  }
+  else if (count <= 48) {
+    node48_t *p = (node48_t *)(n = node_alloc(tree, NODE48, prefix,
+                            prefix_len));
+    if (!n)
+      return 0;
+    for (i = 0; i < count; i++) {
+      p->index[bytes[i]] = (uint8_t)(i + 1);
+      p->children[i] = children[i];
+    }
+  }
+  else {
+    node256_t *p = (node256_t *)(n = node_alloc(tree, NODE256, prefix,
+                            prefix_len));
+    if (!n)
+      return 0;
+    for (i = 0; i < count; i++)
+      p->children[bytes[i]] = children[i];
+  }
+  n->num_children = (uint32_t)count;
+  n->value_leaf = value_leaf;
+  return n;
+}
+
+/* copies |n| with a different prefix */
+static node_t *
+copy_with_prefix(art_tree_t *tree, node_t *n, const uint8_t *prefix,
+                uint32_t prefix_len)
+{
+  uint8_t bytes[256];
+  void *children[256];
+  int count = collect(n, bytes, children);
+  return build(tree, prefix, prefix_len, n->value_leaf, bytes, children,
+                  count);
+}
+
+static uint32_t
+prefix_mismatch(const node_t *n, const uint8_t *key, uint32_t key_size,
+                uint32_t depth)
+{
+  uint32_t i;
+  for (i = 0; i < n->prefix_len; i++)
+    if (depth + i >= key_size || n->prefix[i] != key[depth + i])
+      return i;
+  return n->prefix_len;
+}
+
+static void
+maybe_reclaim(art_tree_t *tree)
+{
+  if (tree->num_retired >= RECLAIM_THRESHOLD)
+    art_reclaim(tree);
+}
+
+void
+art_init(art_tree_t *tree)
+{
+  memset(tree, 0, sizeof(*tree));
+  tree->epoch = 1;
+}
+
+static void
+free_recursive(void *p, void (*free_value)(void *))
+{
+  uint8_t bytes[256];
+  void *children[256];
+  node_t *n;
+  int i, count;
+
+  if (!p)
+    return;
+  if (IS_LEAF(p)) {
+    if (free_value)
+      free_value(LEAF(p)->value);
+    free(LEAF(p));
+    return;
+  }
+  n = (node_t *)p;
+  count = collect(n, bytes, children);
+  for (i = 0; i < count; i++)
+    free_recursive(children[i], free_value);
+  if (n->value_leaf)
+    free_recursive(TAG(n->value_leaf), free_value);
+  free(n);
+}
+
+void
+art_free(art_tree_t *tree, void (*free_value)(void *))
+{
+  art_retired_t *r = tree->retired;
+  while (r) {
+    art_retired_t *next = r->next;
+    r->fn(r->ptr);
+    free(r);
+    r = next;
+  }
+  free_recursive(tree->root, free_value);
+  art_init(tree);
+}
+
+int
+art_insert(art_tree_t *tree, const uint8_t *key, uint32_t key_size,
+                void *value, void **old_value)
+{
+  void **ref = &tree->root;
+  uint32_t depth = 0;
+  art_leaf_t *leaf = leaf_alloc(tree, key, key_size, value);
+
+  if (old_value)
+    *old_value = 0;
+  if (!leaf)
+    return -1;
+
+  for (;;) {
+    void *p = *ref;
+    node_t *n;
+    uint32_t m;
+
+    if (!p) {
+      STORE(*ref, TAG(leaf));
+      break;
+    }
+
+    if (IS_LEAF(p)) {
+      art_leaf_t *l = LEAF(p);
+      art_leaf_t *value_leaf = 0;
+      uint8_t bytes[2];
+      void *children[2];
+      int count = 0;
+      uint32_t max, i;
+
+      if (leaf_equals(l, key, key_size)) {
+        if (old_value)
+          *old_value = l->value;
+        STORE(*ref, TAG(leaf));
+        retire_leaf(tree, l);
+        maybe_reclaim(tree);
+        return 0;
+      }
+
+      /* replace the leaf with a node; the shorter key becomes the value
+       * leaf if it is a prefix of the other one */
+      max = l->key_size < key_size ? l->key_size : key_size;
+      for (i = depth; i < max && l->key[i] == key[i]; i++)
+        ;
+      if (i == l->key_size)
+        value_leaf = l;
+      else if (i == key_size)
+        value_leaf = leaf;
+      if (value_leaf == l) {
+        bytes[0] = key[i];
+        children[0] = TAG(leaf);
+        count = 1;
+      }
+      else if (value_leaf == leaf) {
+        bytes[0] = l->key[i];
+        children[0] = TAG(l);
+        count = 1;
+      }
+      else {
+        int less = l->key[i] < key[i];
+        bytes[less ? 0 : 1] = l->key[i];
+        children[less ? 0 : 1] = TAG(l);
+        bytes[less ? 1 : 0] = key[i];
+        children[less ? 1 : 0] = TAG(leaf);
+        count = 2;
+      }
+      n = build(tree, key + depth, i - depth, value_leaf, bytes, children,
+                      count);
+      if (!n)
+        goto oom;
+      STORE(*ref, (void *)n);
+      break;
+    }
+
+    n = (node_t *)p;
+    m = prefix_mismatch(n, key, key_size, depth);
+    if (m < n->prefix_len) {
+      /* split the compressed path */
+      uint8_t bytes[2];
+      void *children[2];
+      int count = 1;
+      node_t *child = copy_with_prefix(tree, n, n->prefix + m + 1,
+                              n->prefix_len - m - 1);
+      node_t *split;
+
+      if (!child)
+        goto oom;
+      if (depth + m == key_size) {
+        bytes[0] = n->prefix[m];
+        children[0] = child;
+      }
+      else {
+        int less = n->prefix[m] < key[depth + m];
+        bytes[less ? 0 : 1] = n->prefix[m];
+        children[less ? 0 : 1] = child;
+        bytes[less ? 1 : 0] = key[depth + m];
+        children[less ? 1 : 0] = TAG(leaf);
+        count = 2;
+      }
+      split = build(tree, n->prefix, m,
+                      depth + m == key_size ? leaf : 0, bytes, children, count);
+      if (!split) {
+        tree->memory_usage -= node_size(child);
+        free(child);
+        goto oom;
+      }
+      STORE(*ref, (void *)split);
+      retire_node(tree, n);
+      break;
+    }
+
+    depth += n->prefix_len;
+    if (depth == key_size) {
+      art_leaf_t *old = n->value_leaf;
+      STORE(n->value_leaf, leaf);
+      if (old) {
+        if (old_value)
+          *old_value = old->value;
+        retire_leaf(tree, old);
+        maybe_reclaim(tree);
+        return 0;
+      }
+      break;
+    }
+
+    {
+      void **child = find_child(n, key[depth]);
+      if (child && *child) {
+        ref = child;
+        depth++;
+        continue;
+      }
+    }
+
+    /* add a new child */
+    if (n->type == NODE256) {
+      STORE(((node256_t *)n)->children[key[depth]], TAG(leaf));
+      n->num_children++;
+    }
+    else {
+      uint8_t bytes[256];
+      void *children[256];
+      node_t *grown;
+      int count = collect(n, bytes, children);
+      int pos = count;
+
+      while (pos > 0 && bytes[pos - 1] > key[depth]) {
+        bytes[pos] = bytes[pos - 1];
+        children[pos] = children[pos - 1];
+        pos--;
+      }
+      bytes[pos] = key[depth];
+      children[pos] = TAG(leaf);
+      grown = build(tree, n->prefix, n->prefix_len, n->value_leaf,
+                      bytes, children, count + 1);
+      if (!grown)
+        goto oom;
+      STORE(*ref, (void *)grown);
+      retire_node(tree, n);
+    }
+    break;
+  }
+
+  tree->size++;
+  maybe_reclaim(tree);
+  return 0;
+
+oom:
+  tree->memory_usage -= leaf_size(leaf);
+  free(leaf);
+  return -1;
+}
+
+/* removes the child |byte| (or the value leaf if |byte| is -1) from |n| */
+static void
+remove_entry(art_tree_t *tree, void **ref, node_t *n, int byte)
+{
+  uint8_t bytes[256];
+  void *children[256];
+  art_leaf_t *value_leaf = byte < 0 ? 0 : n->value_leaf;
+  int count = collect(n, bytes, children);
+  node_t *rebuilt;
+  int i;
+
+  if (byte >= 0) {
+    for (i = 0; bytes[i] != byte; i++)
+      ;
+    memmove(bytes + i, bytes + i + 1, count - i - 1);
+    memmove(children + i, children + i + 1,
+                    (count - i - 1) * sizeof(void *));
+    count--;
+  }
+
+  /* collapse the node if only one entry is left */
+  if (count + (value_leaf ? 1 : 0) == 1) {
+    if (value_leaf)
+      STORE(*ref, TAG(value_leaf));
+    else if (IS_LEAF(children[0]))
+      STORE(*ref, children[0]);
+    else {
+      node_t *child = (node_t *)children[0];
+      uint32_t len = n->prefix_len + 1 + child->prefix_len;
+      uint8_t stack[256];
+      uint8_t *prefix = len <= sizeof(stack) ? stack : (uint8_t *)malloc(len);
+      node_t *merged = 0;
+
+      if (prefix) {
+        memcpy(prefix, n->prefix, n->prefix_len);
+        prefix[n->prefix_len] = bytes[0];
+        memcpy(prefix + n->prefix_len + 1, child->prefix, child->prefix_len);
+        merged = copy_with_prefix(tree, child, prefix, len);
+        if (prefix != stack)
+          free(prefix);
+      }
+      if (!merged) {
+        /* out of memory; keep the node with a single child */
+        goto rebuild;
+      }
+      STORE(*ref, (void *)merged);
+      retire_node(tree, child);
+    }
+    retire_node(tree, n);
+    return;
+  }
+
+  /* modify in place if possible */
+  if (byte < 0) {
+    STORE(n->value_leaf, (art_leaf_t *)0);
+    return;
+  }
+  if (n->type == NODE256 && count >= NODE256_MIN) {
+    STORE(((node256_t *)n)->children[byte], (void *)0);
+    n->num_children--;
+    return;
+  }
+
+rebuild:
+  rebuilt = build(tree, n->prefix, n->prefix_len, value_leaf, bytes,
+                  children, count);
+  if (!rebuilt) {
+    /* out of memory; leave an empty slot (or value leaf) in the node. The
+     * readers skip empty slots, and the slot is removed when the node is
+     * rebuilt the next time */
+    if (byte < 0)
+      STORE(n->value_leaf, (art_leaf_t *)0);
+    else {
+      STORE(*find_child(n, (uint8_t)byte), (void *)0);
+      if (n->type == NODE256)
+        n->num_children--;
+    }
+    return;
+  }
+  STORE(*ref, (void *)rebuilt);
+  retire_node(tree, n);
+}
+
+int
+art_erase(art_tree_t *tree, const uint8_t *key, uint32_t key_size,
+                void **old_value)
+{
+  void **ref = &tree->root;
+  uint32_t depth = 0;
+  art_leaf_t *leaf;
+
+  for (;;) {
+    void *p = *ref;
+    void **child;
+    node_t *n;
+
+    if (!p)
+      return -1;
+
+    if (IS_LEAF(p)) {
+      /* only possible for the root */
+      leaf = LEAF(p);
+      if (!leaf_equals(leaf, key, key_size))
+        return -1;
+      STORE(*ref, (void *)0);
+      break;
+    }
+
+    n = (node_t *)p;
+    if (prefix_mismatch(n, key, key_size, depth) < n->prefix_len)
+      return -1;
+    depth += n->prefix_len;
+
+    if (depth == key_size) {
+      leaf = n->value_leaf;
+      if (!leaf)
+        return -1;
+      remove_entry(tree, ref, n, -1);
+      break;
+    }
+
+    child = find_child(n, key[depth]);
+    if (!child || !*child)
+      return -1;
+    if (IS_LEAF(*child)) {
+      leaf = LEAF(*child);
+      if (!leaf_equals(leaf, key, key_size))
+        return -1;
+      remove_entry(tree, ref, n, key[depth]);
+      break;
+    }
+    ref = child;
+    depth++;
+  }
+
+  if (old_value)
+    *old_value = leaf->value;
+  retire_leaf(tree, leaf);
+  tree->size--;
+  maybe_reclaim(tree);
+  return 0;
+}
+
+const art_leaf_t *
+art_find(art_tree_t *tree, const uint8_t *key, uint32_t key_size)
+{
+  void *p = LOAD(tree->root);
+  uint32_t depth = 0;
+
+  while (p) {
+    node_t *n;
+    void **child;
+
+    if (IS_LEAF(p))
+      return leaf_equals(LEAF(p), key, key_size) ? LEAF(p) : 0;
+
+    n = (node_t *)p;
+    if (n->prefix_len) {
+      if (key_size - depth < n->prefix_len
+            || memcmp(n->prefix, key + depth, n->prefix_len))
+        return 0;
+      depth += n->prefix_len;
+    }
+    if (depth == key_size) {
+      art_leaf_t *l = LOAD(n->value_leaf);
+      return l && leaf_equals(l, key, key_size) ? l : 0;
+    }
+    child = find_child(n, key[depth]);
+    if (!child)
+      return 0;
+    p = LOAD(*child);
+    depth++;
+  }
+  return 0;
+}
+
+static const art_leaf_t *
+min_leaf(void *p)
+{
+  while (p) {
+    node_t *n;
+    art_leaf_t *l;
+    int b = 0;
+
+    if (IS_LEAF(p))
+      return LEAF(p);
+    n = (node_t *)p;
+    l = LOAD(n->value_leaf);
+    if (l)
+      return l;
+    p = child_ge(n, 0, &b);
+  }
+  return 0;
+}
+
+static const art_leaf_t *
+max_leaf(void *p)
+{
+  while (p) {
+    node_t *n;
+    void *c;
+    int b = 0;
+
+    if (IS_LEAF(p))
+      return LEAF(p);
+    n = (node_t *)p;
+    c = child_le(n, 255, &b);
+    if (!c)
+      return LOAD(n->value_leaf);
+    p = c;
+  }
+  return 0;
+}
+
+/* returns the smallest leaf in the children >= |from| */
+static const art_leaf_t *
+min_of_children(node_t *n, int from)
+{
+  void *c;
+  int b;
+
+  while (from < 256 && (c = child_ge(n, from, &b)) != 0) {
+    const art_leaf_t *l = min_leaf(c);
+    if (l)
+      return l;
+    from = b + 1;
+  }
+  return 0;
+}
+
+/* returns the largest leaf in the children <= |from| */
+static const art_leaf_t *
+max_of_children(node_t *n, int from)
+{
+  void *c;
+  int b;
+
+  while (from >= 0 && (c = child_le(n, from, &b)) != 0) {
+    const art_leaf_t *l = max_leaf(c);
+    if (l)
+      return l;
+    from = b - 1;
+  }
+  return 0;
+}
+
+static const art_leaf_t *
+seek_ge(void *p, const uint8_t *key, uint32_t key_size, uint32_t depth,
+                int strict)
+{
+  const art_leaf_t *l;
+  void **child;
+  node_t *n;
+  uint32_t i;
+
+  if (!p)
+    return 0;
+  if (IS_LEAF(p)) {
+    int cmp = leaf_compare(LEAF(p), key, key_size);
+    return cmp > 0 || (cmp == 0 && !strict) ? LEAF(p) : 0;
+  }
+
+  n = (node_t *)p;
+  for (i = 0; i < n->prefix_len; i++) {
+    /* all keys in this subtree are longer than the key */
+    if (depth + i >= key_size)
+      return min_leaf(p);
+    if (n->prefix[i] != key[depth + i])
+      return n->prefix[i] > key[depth + i] ? min_leaf(p) : 0;
+  }
+  depth += n->prefix_len;
+
+  if (depth == key_size) {
+    l = LOAD(n->value_leaf);
+    if (l && !strict)
+      return l;
+    return min_of_children(n, 0);
+  }
+
+  /* the value leaf is a prefix of the key and therefore smaller */
+  child = find_child(n, key[depth]);
+  if (child) {
+    l = seek_ge(LOAD(*child), key, key_size, depth + 1, strict);
+    if (l)
+      return l;
+  }
+  return key[depth] < 255 ? min_of_children(n, key[depth] + 1) : 0;
+}
+
+static const art_leaf_t *
+seek_le(void *p, const uint8_t *key, uint32_t key_size, uint32_t depth,
+                int strict)
+{
+  const art_leaf_t *l;
+  void **child;
+  node_t *n;
+  uint32_t i;
+
+  if (!p)
+    return 0;
+  if (IS_LEAF(p)) {
+    int cmp = leaf_compare(LEAF(p), key, key_size);
+    return cmp < 0 || (cmp == 0 && !strict) ? LEAF(p) : 0;
+  }
+
+  n = (node_t *)p;
+  for (i = 0; i < n->prefix_len; i++) {
+    if (depth + i >= key_size)
+      return 0;
+    if (n->prefix[i] != key[depth + i])
+      return n->prefix[i] < key[depth + i] ? max_leaf(p) : 0;
+  }
+  depth += n->prefix_len;
+
+  if (depth == key_size) {
+    l = LOAD(n->value_leaf);
+    return l && !strict ? l : 0;
+  }
+
+  child = find_child(n, key[depth]);
+  if (child) {
+    l = seek_le(LOAD(*child), key, key_size, depth + 1, strict);
+    if (l)
+      return l;
+  }
+  if (key[depth] > 0) {
+    l = max_of_children(n, key[depth] - 1);
+    if (l)
+      return l;
+  }
+  return LOAD(n->value_leaf);
+}
+
+const art_leaf_t *
+art_seek(art_tree_t *tree, const uint8_t *key, uint32_t key_size, int mode)
+{
+  void *root = LOAD(tree->root);
+
+  switch (mode) {
+    case ART_SEEK_GE:
+    case ART_SEEK_GT:
+      return seek_ge(root, key, key_size, 0, mode == ART_SEEK_GT);
+    case ART_SEEK_LE:
+    case ART_SEEK_LT:
+      return seek_le(root, key, key_size, 0, mode == ART_SEEK_LT);
+    default:
+      return 0;
+  }
+}
+
+const art_leaf_t *
+art_first(art_tree_t *tree)
+{
+  return min_leaf(LOAD(tree->root));
+}
+
+const art_leaf_t *
+art_last(art_tree_t *tree)
+{
+  return max_leaf(LOAD(tree->root));
+}
+
+int
+art_reader_enter(art_tree_t *tree)
+{
+  int i;
+
+  for (i = 0; i < ART_MAX_READERS; i++) {
+    uint64_t expected = 0;
+    uint64_t e = __atomic_load_n(&tree->epoch, __ATOMIC_SEQ_CST);
+    if (__atomic_compare_exchange_n(&tree->readers[i].epoch, &expected, e,
+                0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void
+art_reader_leave(art_tree_t *tree, int slot)
+{
+  if (slot >= 0 && slot < ART_MAX_READERS)
+    __atomic_store_n(&tree->readers[slot].epoch, 0, __ATOMIC_RELEASE);
+}
+
+void
+art_defer_free(art_tree_t *tree, void *ptr, void (*fn)(void *))
+{
+  retire(tree, ptr, fn);
+  maybe_reclaim(tree);
+}
+
+void
+art_reclaim(art_tree_t *tree)
+{
+  art_retired_t **pr = &tree->retired;
+  uint64_t min;
+  int i;
+
+  /* objects retired from now on belong to the next epoch */
+  min = __atomic_add_fetch(&tree->epoch, 1, __ATOMIC_SEQ_CST);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  for (i = 0; i < ART_MAX_READERS; i++) {
+    uint64_t e = __atomic_load_n(&tree->readers[i].epoch, __ATOMIC_ACQUIRE);
+    if (e != 0 && e < min)
+      min = e;
+  }
+
+  while (*pr) {
+    art_retired_t *r = *pr;
+    if (r->epoch < min) {
+      *pr = r->next;
+      r->fn(r->ptr);
+      free(r);
+      tree->num_retired--;
+    }
+    else
+      pr = &r->next;
+  }
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * An adaptive radix tree (ART) for in-memory indices.
+ *
+ * Keys are binary strings and are sorted with memcmp(); a key may be a
+ * prefix of another key. Inner nodes have 4, 16, 48 or 256 slots and
+ * store the compressed path. Leaves store the full key and a value
+ * pointer, which is owned by the caller.
+ *
+ * Concurrency: one writer and any number of readers. Writers (art_insert,
+ * art_erase, art_reclaim) must be serialized by the caller. Readers do not
+ * block and are never blocked: nodes are replaced (copy-on-write) instead
+ * of being modified, and replaced nodes are freed only after all readers
+ * which might still see them have left (epoch-based reclamation). A reader
+ * brackets its lookups with art_reader_enter() and art_reader_leave(); the
+ * returned leaves are valid until the reader leaves.
+ *
+ * See the README.md file for more information.
+ */
+
+#ifndef ART_H_3d5c9a61_7e24_4b1f_9c08_b2f6e4a1d573
+#define ART_H_3d5c9a61_7e24_4b1f_9c08_b2f6e4a1d573
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The maximum number of concurrent readers */
+#define ART_MAX_READERS     64
+
+/** Modes for art_seek() */
+#define ART_SEEK_GE         0
+#define ART_SEEK_GT         1
+#define ART_SEEK_LE         2
+#define ART_SEEK_LT         3
+
+typedef struct art_leaf_t {
+  /* the value, owned by the caller */
+  void *value;
+
+  /* the size of the key */
+  uint32_t key_size;
+
+  /* the key data (|key_size| bytes) */
+  uint8_t key[1];
+} art_leaf_t;
+
+typedef struct art_retired_t art_retired_t;
+
+typedef struct art_reader_slot_t {
+  /* the epoch when the reader entered; 0 if the slot is unused */
+  uint64_t epoch;
+
+  /* pads the slot to a cache line */
+  uint8_t _padding[56];
+} art_reader_slot_t;
+
+typedef struct art_tree_t {
+  /* the root node, or a (tagged) leaf */
+  void *root;
+
+  /* the number of keys; only valid for the writer */
+  uint64_t size;
+
+  /* the memory used by nodes and leaves; only valid for the writer */
+  uint64_t memory_usage;
+
+  /* the current epoch; starts with 1 */
+  uint64_t epoch;
+
+  /* nodes and leaves which are waiting to be freed */
+  art_retired_t *retired;
+
+  /* the number of elements in |retired| */
+  uint32_t num_retired;
+
+  /* the active readers */
+  art_reader_slot_t readers[ART_MAX_READERS];
+} art_tree_t;
+
+/**
+ * Initializes an empty tree.
+ */
+extern void
+art_init(art_tree_t *tree);
+
+/**
+ * Releases all memory of |tree|. If |free_value| is not NULL then it is
+ * called for each value. There must be no active readers.
+ */
+extern void
+art_free(art_tree_t *tree, void (*free_value)(void *));
+
+/**
+ * Inserts a key, or replaces the value of an existing key. If the key
+ * already exists then its previous value is returned in |old_value|,
+ * otherwise |old_value| is set to NULL. Returns 0 on success or -1 if
+ * memory could not be allocated.
+ *
+ * A replaced value can still be seen by readers; use art_defer_free()
+ * to release it.
+ */
+extern int
+art_insert(art_tree_t *tree, const uint8_t *key, uint32_t key_size,
+                void *value, void **old_value);
+
+/**
+ * Erases a key and returns its value in |old_value| (if not NULL).
+ * Returns 0 on success or -1 if the key was not found.
+ */
+extern int
+art_erase(art_tree_t *tree, const uint8_t *key, uint32_t key_size,
+                void **old_value);
+
+/**
+ * Returns the leaf of a key, or NULL if the key does not exist.
+ */
+extern const art_leaf_t *
+art_find(art_tree_t *tree, const uint8_t *key, uint32_t key_size);
+
+/**
+ * Returns the smallest leaf which is greater than or equal to
+ * (@ref ART_SEEK_GE) or greater than (@ref ART_SEEK_GT) the key, or the
+ * largest leaf which is less than or equal to (@ref ART_SEEK_LE) or less
+ * than (@ref ART_SEEK_LT) the key. Returns NULL if there is no such leaf.
+ */
+extern const art_leaf_t *
+art_seek(art_tree_t *tree, const uint8_t *key, uint32_t key_size,
+                int mode);
+
+/**
+ * Returns the leaf with the smallest key, or NULL if the tree is empty.
+ */
+extern const art_leaf_t *
+art_first(art_tree_t *tree);
+
+/**
+ * Returns the leaf with the largest key, or NULL if the tree is empty.
+ */
+extern const art_leaf_t *
+art_last(art_tree_t *tree);
+
+/**
+ * Registers a reader. Returns the reader's slot, or -1 if all
+ * @ref ART_MAX_READERS slots are in use (then the caller has to
+ * synchronize with the writer).
+ */
+extern int
+art_reader_enter(art_tree_t *tree);
+
+/**
+ * Unregisters a reader. Leaves returned to this reader must no longer
+ * be used.
+ */
+extern void
+art_reader_leave(art_tree_t *tree, int slot);
+
+/**
+ * Calls |fn(ptr)| as soon as no reader can access |ptr| anymore. Only
+ * for the writer.
+ */
+extern void
+art_defer_free(art_tree_t *tree, void *ptr, void (*fn)(void *));
+
+/**
+ * Frees the retired nodes, leaves and values which are no longer
+ * visible to any reader. Called automatically by the writer functions;
+ * only for the writer.
+ */
+extern void
+art_reclaim(art_tree_t *tree);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* ART_H_3d5c9a61_7e24_4b1f_9c08_b2f6e4a1d573 */
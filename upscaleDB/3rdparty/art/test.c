@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Tests and benchmarks for the adaptive radix tree.
+ *
+ *  cc -O2 test.c art.c -lpthread -o test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include "art.h"
+
+#define CHECK(x)                                                            \
+  do {                                                                      \
+    if (!(x)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #x);          \
+      exit(1);                                                              \
+    }                                                                       \
+  } while (0)
+
+typedef struct {
+  uint8_t data[12];
+  uint32_t size;
+} key_t_;
+
+static uint64_t rng = 0x9e3779b97f4a7c15ull;
+
+static uint32_t
+next_random(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return (uint32_t)(rng >> 16);
+}
+
+/* short keys from a small alphabet: many shared prefixes, and many keys
+ * which are prefixes of other keys */
+static void
+random_key(key_t_ *k)
+{
+  uint32_t i;
+  k->size = next_random() % 9;
+  for (i = 0; i < k->size; i++)
+    k->data[i] = (uint8_t)("\x00\x01\x7f\x80\xfe\xff"[next_random() % 6]);
+}
+
+static int
+compare_keys(const void *a, const void *b)
+{
+  const key_t_ *lhs = (const key_t_ *)a;
+  const key_t_ *rhs = (const key_t_ *)b;
+  uint32_t n = lhs->size < rhs->size ? lhs->size : rhs->size;
+  int cmp = memcmp(lhs->data, rhs->data, n);
+  if (cmp)
+    return cmp;
+  return (int)lhs->size - (int)rhs->size;
+}
+
+static double
+now(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* the reference: a sorted array of unique keys */
+static key_t_ *ref;
+static int ref_size;
+
+static int
+ref_find(const key_t_ *k)
+{
+  return bsearch(k, ref, ref_size, sizeof(key_t_), compare_keys) != 0;
+}
+
+static void
+ref_insert(const key_t_ *k)
+{
+  int i;
+  if (ref_find(k))
+    return;
+  for (i = ref_size; i > 0 && compare_keys(&ref[i - 1], k) > 0; i--)
+    ref[i] = ref[i - 1];
+  ref[i] = *k;
+  ref_size++;
+}
+
+static void
+ref_erase(const key_t_ *k)
+{
+  key_t_ *p = (key_t_ *)bsearch(k, ref, ref_size, sizeof(key_t_),
+                  compare_keys);
+  if (p) {
+    memmove(p, p + 1, (ref + ref_size - p - 1) * sizeof(key_t_));
+    ref_size--;
+  }
+}
+
+/* returns the index of the reference key for art_seek() mode |mode| */
+static int
+ref_seek(const key_t_ *k, int mode)
+{
+  int i;
+  switch (mode) {
+    case ART_SEEK_GE:
+      for (i = 0; i < ref_size; i++)
+        if (compare_keys(&ref[i], k) >= 0)
+          return i;
+      return -1;
+    case ART_SEEK_GT:
+      for (i = 0; i < ref_size; i++)
+        if (compare_keys(&ref[i], k) > 0)
+          return i;
+      return -1;
+    case ART_SEEK_LE:
+      for (i = ref_size - 1; i >= 0; i--)
+        if (compare_keys(&ref[i], k) <= 0)
+          return i;
+      return -1;
+    default:
+      for (i = ref_size - 1; i >= 0; i--)
+        if (compare_keys(&ref[i], k) < 0)
+          return i;
+      return -1;
+  }
+}
+
+static int
+leaf_is(const art_leaf_t *l, const key_t_ *k)
+{
+  return l && l->key_size == k->size && !memcmp(l->key, k->data, k->size);
+}
+
+static void
+verify(art_tree_t *tree)
+{
+  const art_leaf_t *l;
+  key_t_ k;
+  int i, mode;
+
+  CHECK(tree->size == (uint64_t)ref_size);
+
+  /* forward and backward iteration */
+  l = art_first(tree);
+  for (i = 0; i < ref_size; i++) {
+    CHECK(leaf_is(l, &ref[i]));
+    CHECK(l->value == (void *)(uintptr_t)(ref[i].size + 1));
+    l = art_seek(tree, l->key, l->key_size, ART_SEEK_GT);
+  }
+  CHECK(l == 0);
+  l = art_last(tree);
+  for (i = ref_size - 1; i >= 0; i--) {
+    CHECK(leaf_is(l, &ref[i]));
+    l = art_seek(tree, l->key, l->key_size, ART_SEEK_LT);
+  }
+  CHECK(l == 0);
+
+  /* lookups and seeks of random keys */
+  for (i = 0; i < 2000; i++) {
+    random_key(&k);
+    l = art_find(tree, k.data, k.size);
+    CHECK(ref_find(&k) ? leaf_is(l, &k) : l == 0);
+    for (mode = ART_SEEK_GE; mode <= ART_SEEK_LT; mode++) {
+      int r = ref_seek(&k, mode);
+      l = art_seek(tree, k.data, k.size, mode);
+      CHECK(r < 0 ? l == 0 : leaf_is(l, &ref[r]));
+    }
+  }
+}
+
+static void
+test_random(void)
+{
+  art_tree_t tree;
+  key_t_ k;
+  int i;
+
+  art_init(&tree);
+  ref = (key_t_ *)malloc(100000 * sizeof(key_t_));
+  ref_size = 0;
+
+  verify(&tree);
+  for (i = 0; i < 30000; i++) {
+    void *old;
+    random_key(&k);
+    old = (void *)1;
+    CHECK(0 == art_insert(&tree, k.data, k.size,
+                    (void *)(uintptr_t)(k.size + 1), &old));
+    CHECK(ref_find(&k) ? old == (void *)(uintptr_t)(k.size + 1) : old == 0);
+    ref_insert(&k);
+    if (i % 5000 == 0)
+      verify(&tree);
+  }
+  verify(&tree);
+
+  for (i = 0; i < 60000; i++) {
+    int found;
+    random_key(&k);
+    found = ref_find(&k);
+    CHECK(art_erase(&tree, k.data, k.size, 0) == (found ? 0 : -1));
+    ref_erase(&k);
+    if (i % 10000 == 0)
+      verify(&tree);
+  }
+  verify(&tree);
+
+  /* erase the rest */
+  while (ref_size) {
+    k = ref[next_random() % ref_size];
+    CHECK(0 == art_erase(&tree, k.data, k.size, 0));
+    ref_erase(&k);
+  }
+  verify(&tree);
+  CHECK(tree.root == 0);
+  CHECK(tree.memory_usage == 0);
+
+  art_free(&tree, 0);
+  free(ref);
+  printf("random: ok\n");
+}
+
+static void
+put_be64(uint8_t *p, uint64_t v)
+{
+  int i;
+  for (i = 7; i >= 0; i--, v >>= 8)
+    p[i] = (uint8_t)v;
+}
+
+static void
+test_node_types(void)
+{
+  art_tree_t tree;
+  uint8_t key[2];
+  const art_leaf_t *l;
+  int i, j;
+
+  /* grow a node from 4 to 256 children and shrink it again */
+  art_init(&tree);
+  for (i = 0; i < 256; i++) {
+    key[0] = 0x42;
+    key[1] = (uint8_t)(i * 7);
+    CHECK(0 == art_insert(&tree, key, 2, (void *)(uintptr_t)(i + 1), 0));
+    for (j = 0; j <= i; j++) {
+      key[1] = (uint8_t)(j * 7);
+      l = art_find(&tree, key, 2);
+      CHECK(l && l->value == (void *)(uintptr_t)(j + 1));
+    }
+  }
+  for (i = 0; i < 255; i++) {
+    key[1] = (uint8_t)(i * 7);
+    CHECK(0 == art_erase(&tree, key, 2, 0));
+    CHECK(0 == art_find(&tree, key, 2));
+    l = art_first(&tree);
+    CHECK(l != 0);
+  }
+  CHECK(tree.size == 1 && (((uintptr_t)tree.root) & 1));
+  art_free(&tree, 0);
+
+  /* long common prefixes */
+  art_init(&tree);
+  {
+    uint8_t big[300];
+    memset(big, 'x', sizeof(big));
+    for (i = 0; i < 300; i++)
+      CHECK(0 == art_insert(&tree, big, i, (void *)(uintptr_t)(i + 1), 0));
+    for (i = 0; i < 300; i++) {
+      l = art_find(&tree, big, i);
+      CHECK(l && l->value == (void *)(uintptr_t)(i + 1));
+    }
+    for (i = 0; i < 300; i += 2)
+      CHECK(0 == art_erase(&tree, big, i, 0));
+    l = art_first(&tree);
+    for (i = 1; i < 300; i += 2) {
+      CHECK(l && l->key_size == (uint32_t)i);
+      l = art_seek(&tree, l->key, l->key_size, ART_SEEK_GT);
+    }
+    CHECK(l == 0);
+  }
+  art_free(&tree, 0);
+  printf("node types: ok\n");
+}
+
+/* concurrency: readers look up stable keys and check the order of
+ * iteration while a writer inserts and erases other keys */
+#define STABLE_KEYS 20000
+
+static art_tree_t shared;
+static volatile int stop;
+static uint64_t reads;
+
+static void *
+reader(void *arg)
+{
+  uint64_t n = 0;
+  uint32_t seed = (uint32_t)(uintptr_t)arg * 2654435761u + 1;
+  (void)arg;
+
+  while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE)) {
+    int slot = art_reader_enter(&shared);
+    const art_leaf_t *l;
+    uint8_t key[8];
+    uint64_t v, last;
+    int i;
+
+    CHECK(slot >= 0);
+    for (i = 0; i < 100; i++) {
+      seed = seed * 1103515245 + 12345;
+      v = (seed >> 8) % STABLE_KEYS;
+      put_be64(key, v * 2);
+      l = art_find(&shared, key, 8);
+      CHECK(l && l->value == (void *)(uintptr_t)(v * 2 + 1));
+      n++;
+    }
+    /* a short range scan */
+    l = art_seek(&shared, key, 8, ART_SEEK_GE);
+    last = 0;
+    for (i = 0; l && i < 50; i++) {
+      uint64_t k = 0;
+      int j;
+      for (j = 0; j < 8; j++)
+        k = (k << 8) | l->key[j];
+      CHECK(i == 0 || k > last);
+      last = k;
+      l = art_seek(&shared, l->key, l->key_size, ART_SEEK_GT);
+    }
+    art_reader_leave(&shared, slot);
+  }
+  __atomic_add_fetch(&reads, n, __ATOMIC_RELAXED);
+  return 0;
+}
+
+static void
+test_concurrency(int num_readers, double seconds)
+{
+  pthread_t threads[16];
+  uint8_t key[8];
+  uint64_t writes = 0;
+  double start;
+  int i;
+
+  art_init(&shared);
+  for (i = 0; i < STABLE_KEYS; i++) {
+    put_be64(key, (uint64_t)i * 2);
+    CHECK(0 == art_insert(&shared, key, 8, (void *)(uintptr_t)(i * 2 + 1),
+                    0));
+  }
+
+  stop = 0;
+  for (i = 0; i < num_readers; i++)
+    pthread_create(&threads[i], 0, reader, (void *)(uintptr_t)(i + 1));
+
+  start = now();
+  while (now() - start < seconds) {
+    /* odd keys come and go */
+    for (i = 0; i < 1000; i++) {
+      uint64_t v = (next_random() % STABLE_KEYS) * 2 + 1;
+      put_be64(key, v);
+      if (art_find(&shared, key, 8))
+        CHECK(0 == art_erase(&shared, key, 8, 0));
+      else
+        CHECK(0 == art_insert(&shared, key, 8, (void *)(uintptr_t)v, 0));
+      writes++;
+    }
+  }
+  __atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+  for (i = 0; i < num_readers; i++)
+    pthread_join(threads[i], 0);
+
+  art_free(&shared, 0);
+  printf("concurrency: ok (%d readers, %.1fM reads/sec, %.1fM writes/sec)\n",
+                  num_readers, reads / seconds / 1e6, writes / seconds / 1e6);
+}
+
+static void
+benchmark(void)
+{
+  const int n = 1000000;
+  art_tree_t tree;
+  uint8_t key[8];
+  uint64_t sum = 0;
+  double t;
+  int i;
+
+  art_init(&tree);
+  t = now();
+  for (i = 0; i < n; i++) {
+    put_be64(key, (uint64_t)next_random() << 16 | (uint64_t)i);
+    art_insert(&tree, key, 8, (void *)(uintptr_t)1, 0);
+  }
+  t = now() - t;
+  printf("benchmark: %.1fM inserts/sec, %.1f bytes/key\n", n / t / 1e6,
+                  (double)tree.memory_usage / tree.size);
+
+  rng = 0x9e3779b97f4a7c15ull;
+  t = now();
+  for (i = 0; i < n; i++) {
+    put_be64(key, (uint64_t)next_random() << 16 | (uint64_t)i);
+    sum += (uintptr_t)art_find(&tree, key, 8)->value;
+  }
+  t = now() - t;
+  CHECK(sum == (uint64_t)n);
+  printf("benchmark: %.1fM lookups/sec\n", n / t / 1e6);
+  art_free(&tree, 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  (void)argv;
+  test_random();
+  test_node_types();
+  test_concurrency(4, argc > 1 ? 5.0 : 1.0);
+  rng = 0x9e3779b97f4a7c15ull;
+  benchmark();
+  return 0;
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "bloom.h"
+
+#define BLOCK_BITS      (BLOOM_BLOCK_WORDS * 64)
+#define CACHE_LINE      64
+#define MAX_PROBES      16
+#define HEADER_SIZE     24
+#define MAGIC           0x324d4c42u /* "BLM2" */
+
+static void
+put32(unsigned char *p, uint32_t v)
+{
+  p[0] = (unsigned char)v;
+  p[1] = (unsigned char)(v >> 8);
+  p[2] = (unsigned char)(v >> 16);
+  p[3] = (unsigned char)(v >> 24);
+}
+
+static void
+put64(unsigned char *p, uint64_t v)
+{
+  put32(p, (uint32_t)v);
+  put32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint32_t
+get32(const unsigned char *p)
+{
+  return (uint32_t)p[0]
+        | ((uint32_t)p[1] << 8)
+        | ((uint32_t)p[2] << 16)
+        | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t
+get64(const unsigned char *p)
+{
+  return (uint64_t)get32(p) | ((uint64_t)get32(p + 4) << 32);
+}
+
+/* allocates the (zeroed) bits for |num_blocks| blocks */
+static int
+allocate(bloom_filter_t *filter, uint32_t num_blocks, uint32_t num_probes)
+{
+  size_t size = (size_t)num_blocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+  unsigned char *memory = (unsigned char *)calloc(1, size + CACHE_LINE);
+
+  if (!memory)
+    return -1;
+  filter->memory = memory;
+  filter->bits = (uint64_t *)(memory
+                  + (CACHE_LINE - ((uintptr_t)memory & (CACHE_LINE - 1))));
+  filter->num_blocks = num_blocks;
+  filter->num_probes = num_probes;
+  filter->num_keys = 0;
+  return 0;
+}
+
+/* returns the first word of the block of |hash| */
+static uint64_t *
+block(const bloom_filter_t *filter, uint64_t hash)
+{
+  /* maps the upper 32 bits to [0, num_blocks) without a division */
+  uint64_t index = ((hash >> 32) * filter->num_blocks) >> 32;
+  return filter->bits + index * BLOOM_BLOCK_WORDS;
+}
+
+/* the initial increment of the probes. The increment grows with each
+ * probe ("enhanced double hashing"); with a constant increment, the
+ * probes of a key are an arithmetic progression which shares many bits
+ * with the progressions of other keys in the same block, and the false
+ * positive rate is much higher than estimated by bloom_estimated_fpr() */
+static uint32_t
+delta(uint32_t h)
+{
+  return ((h >> 17) | (h << 15)) | 1;
+}
+
+int
+bloom_init(bloom_filter_t *filter, uint64_t expected_keys,
+                uint32_t bits_per_key)
+{
+  uint64_t num_blocks;
+  uint32_t num_probes;
+
+  memset(filter, 0, sizeof(*filter));
+  if (bits_per_key == 0)
+    return -1;
+
+  /* k = ln(2) * bits per key minimizes the false positive rate */
+  num_probes = (uint32_t)(bits_per_key * 0.69 + 0.5);
+  if (num_probes < 1)
+    num_probes = 1;
+  if (num_probes > MAX_PROBES)
+    num_probes = MAX_PROBES;
+
+  num_blocks = (expected_keys * bits_per_key + BLOCK_BITS - 1) / BLOCK_BITS;
+  if (num_blocks == 0)
+    num_blocks = 1;
+  if (num_blocks > UINT32_MAX)
+    return -1;
+
+  return allocate(filter, (uint32_t)num_blocks, num_probes);
+}
+
+void
+bloom_free(bloom_filter_t *filter)
+{
+  free(filter->memory);
+  memset(filter, 0, sizeof(*filter));
+}
+
+void
+bloom_clear(bloom_filter_t *filter)
+{
+  memset(filter->bits, 0,
+          (size_t)filter->num_blocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+  filter->num_keys = 0;
+}
+
+void
+bloom_add(bloom_filter_t *filter, uint64_t hash)
+{
+  uint64_t *words = block(filter, hash);
+  uint32_t h = (uint32_t)hash;
+  uint32_t d = delta(h);
+  uint32_t i;
+
+  for (i = 0; i < filter->num_probes; i++) {
+    uint32_t bit = h % BLOCK_BITS;
+    words[bit / 64] |= (uint64_t)1 << (bit % 64);
+    h += d;
+    d += i;
+  }
+  filter->num_keys++;
+}
+
+int
+bloom_may_contain(const bloom_filter_t *filter, uint64_t hash)
+{
+  const uint64_t *words = block(filter, hash);
+  uint32_t h = (uint32_t)hash;
+  uint32_t d = delta(h);
+  uint32_t i;
+
+  for (i = 0; i < filter->num_probes; i++) {
+    uint32_t bit = h % BLOCK_BITS;
+    if ((words[bit / 64] & ((uint64_t)1 << (bit % 64))) == 0)
+      return 0;
+    h += d;
+    d += i;
+  }
+  return 1;
+}
+
+/* a key is a false positive if all its probes hit set bits of its block;
+ * the rate is therefore averaged over the blocks */
+double
+bloom_estimated_fpr(const bloom_filter_t *filter)
+{
+  double sum = 0;
+  uint32_t b, i;
+
+  for (b = 0; b < filter->num_blocks; b++) {
+    const uint64_t *words = filter->bits + (uint64_t)b * BLOOM_BLOCK_WORDS;
+    uint32_t set = 0;
+    for (i = 0; i < BLOOM_BLOCK_WORDS; i++) {
+      uint64_t w = words[i];
+      while (w) {
+        w &= w - 1;
+        set++;
+      }
+    }
+    sum += pow((double)set / BLOCK_BITS, filter->num_probes);
+  }
+  return sum / filter->num_blocks;
+}
+
+size_t
+bloom_serialized_size(const bloom_filter_t *filter)
+{
+  return HEADER_SIZE
+        + (size_t)filter->num_blocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+}
+
+void
+bloom_serialize(const bloom_filter_t *filter, void *buffer)
+{
+  unsigned char *p = (unsigned char *)buffer;
+  uint64_t words = (uint64_t)filter->num_blocks * BLOOM_BLOCK_WORDS;
+  uint64_t i;
+
+  put32(p, MAGIC);
+  put32(p + 4, filter->num_probes);
+  put32(p + 8, filter->num_blocks);
+  put32(p + 12, 0);
+  put64(p + 16, filter->num_keys);
+  p += HEADER_SIZE;
+
+  for (i = 0; i < words; i++, p += 8)
+    put64(p, filter->bits[i]);
+}
+
+int
+bloom_deserialize(bloom_filter_t *filter, const void *buffer, size_t length)
+{
+  const unsigned char *p = (const unsigned char *)buffer;
+  uint32_t num_probes, num_blocks;
+  uint64_t num_keys, words, i;
+
+  memset(filter, 0, sizeof(*filter));
+  if (length < HEADER_SIZE || get32(p) != MAGIC)
+    return -1;
+
+  num_probes = get32(p + 4);
+  num_blocks = get32(p + 8);
+  num_keys = get64(p + 16);
+  words = (uint64_t)num_blocks * BLOOM_BLOCK_WORDS;
+  if (num_probes < 1 || num_probes > MAX_PROBES || num_blocks == 0
+        || (length - HEADER_SIZE) / sizeof(uint64_t) != words
+        || (length - HEADER_SIZE) % sizeof(uint64_t) != 0)
+    return -1;
+
+  if (allocate(filter, num_blocks, num_probes))
+    return -1;
+  filter->num_keys = num_keys;
+
+  p += HEADER_SIZE;
+  for (i = 0; i < words; i++, p += 8)
+    filter->bits[i] = get64(p);
+  return 0;
+}
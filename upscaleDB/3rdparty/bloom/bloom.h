@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * A blocked Bloom filter.
+ *
+ * The filter is split into blocks of 512 bits (one cache line). The upper
+ * 32 bits of a key's 64bit hash select the block, the lower 32 bits the
+ * bits within the block; therefore each lookup touches a single cache
+ * line. The false positive rate is slightly higher than that of a
+ * standard Bloom filter with the same size (about 1.0% instead of 0.8%
+ * with 10 bits per key).
+ *
+ * The caller provides the hash (i.e. MurmurHash3_x64_128). The filter is
+ * not thread-safe; concurrent calls to bloom_add() must be synchronized
+ * by the caller.
+ *
+ * See the README.md file for more information.
+ */
+
+#ifndef BLOOM_H_8e1f4c27_03b9_4d6a_a5f2_71c9d0e36b48
+#define BLOOM_H_8e1f4c27_03b9_4d6a_a5f2_71c9d0e36b48
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The number of 64bit words per block */
+#define BLOOM_BLOCK_WORDS   8
+
+typedef struct bloom_filter_t {
+  /* num_blocks * BLOOM_BLOCK_WORDS words */
+  uint64_t *bits;
+
+  /* the number of blocks */
+  uint32_t num_blocks;
+
+  /* the number of bits which are set per key */
+  uint32_t num_probes;
+
+  /* the number of keys which were added */
+  uint64_t num_keys;
+
+  /* the allocated memory; |bits| is aligned to a cache line */
+  void *memory;
+} bloom_filter_t;
+
+/**
+ * Initializes |filter| for |expected_keys| keys with |bits_per_key|
+ * bits per key. Returns 0 on success, -1 if memory could not be allocated
+ * or if |bits_per_key| is 0.
+ */
+extern int
+bloom_init(bloom_filter_t *filter, uint64_t expected_keys,
+                uint32_t bits_per_key);
+
+/**
+ * Releases the memory of |filter|.
+ */
+extern void
+bloom_free(bloom_filter_t *filter);
+
+/**
+ * Removes all keys from |filter|.
+ */
+extern void
+bloom_clear(bloom_filter_t *filter);
+
+/**
+ * Adds the key with the 64bit |hash| to |filter|.
+ */
+extern void
+bloom_add(bloom_filter_t *filter, uint64_t hash);
+
+/**
+ * Returns 0 if the key with the 64bit |hash| was definitely not added
+ * to |filter|, otherwise non-zero.
+ */
+extern int
+bloom_may_contain(const bloom_filter_t *filter, uint64_t hash);
+
+/**
+ * Returns the estimated false positive rate (between 0 and 1), based on
+ * the number of bits which are set in each block. The estimate assumes
+ * that the probes of a key are independent; since they are derived from
+ * 32 bits of the hash, the actual rate is up to 1.5 times higher with
+ * many bits per key.
+ */
+extern double
+bloom_estimated_fpr(const bloom_filter_t *filter);
+
+/**
+ * Returns the number of bytes which bloom_serialize() writes.
+ */
+extern size_t
+bloom_serialized_size(const bloom_filter_t *filter);
+
+/**
+ * Writes |filter| to |buffer| in a portable (little-endian) format;
+ * |buffer| must have bloom_serialized_size() bytes.
+ */
+extern void
+bloom_serialize(const bloom_filter_t *filter, void *buffer);
+
+/**
+ * Initializes |filter| from the |length| bytes at |buffer|, which were
+ * written by bloom_serialize(). Returns 0 on success, -1 if the buffer
+ * is invalid or memory could not be allocated.
+ */
+extern int
+bloom_deserialize(bloom_filter_t *filter, const void *buffer, size_t length);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BLOOM_H_8e1f4c27_03b9_4d6a_a5f2_71c9d0e36b48 */
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "bloom.h"
+
+/* a 64bit mixer (splitmix64); MurmurHash3 is used in upscaledb */
+static uint64_t
+hash(uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/* returns the measured false positive rate of |filter|, which contains
+ * the keys [0, n) */
+static double
+false_positives(const bloom_filter_t *filter, uint64_t n)
+{
+  uint64_t i, positives = 0;
+
+  for (i = n; i < 2 * n; i++)
+    positives += bloom_may_contain(filter, hash(i)) != 0;
+  return (double)positives / n;
+}
+
+static void
+check(uint64_t n, uint32_t bits_per_key, double max_fpr)
+{
+  bloom_filter_t filter, copy;
+  unsigned char *buffer;
+  size_t size;
+  double fpr, estimated;
+  uint64_t i;
+
+  assert(bloom_init(&filter, n, bits_per_key) == 0);
+  for (i = 0; i < n; i++)
+    bloom_add(&filter, hash(i));
+  assert(filter.num_keys == n);
+
+  /* no false negatives */
+  for (i = 0; i < n; i++)
+    assert(bloom_may_contain(&filter, hash(i)));
+
+  fpr = false_positives(&filter, n);
+  estimated = bloom_estimated_fpr(&filter);
+  printf("keys %8llu, bits/key %2u: fpr %.4f (estimated %.4f)\n",
+                  (unsigned long long)n, bits_per_key, fpr, estimated);
+  assert(fpr <= max_fpr);
+  /* the estimate ignores the correlation of the probes (see bloom.h);
+   * the constant covers the sampling error of small filters */
+  assert(fpr <= estimated * 1.5 + 0.002);
+
+  /* serialization */
+  size = bloom_serialized_size(&filter);
+  buffer = malloc(size);
+  bloom_serialize(&filter, buffer);
+  assert(bloom_deserialize(&copy, buffer, size) == 0);
+  assert(copy.num_blocks == filter.num_blocks);
+  assert(copy.num_probes == filter.num_probes);
+  assert(copy.num_keys == filter.num_keys);
+  assert(memcmp(copy.bits, filter.bits,
+                  filter.num_blocks * BLOOM_BLOCK_WORDS * 8) == 0);
+  for (i = 0; i < n; i++)
+    assert(bloom_may_contain(&copy, hash(i)));
+  bloom_free(&copy);
+
+  /* truncated or corrupt buffers are rejected */
+  assert(bloom_deserialize(&copy, buffer, size - 1) != 0);
+  assert(bloom_deserialize(&copy, buffer, 10) != 0);
+  buffer[0] ^= 1;
+  assert(bloom_deserialize(&copy, buffer, size) != 0);
+  free(buffer);
+
+  bloom_clear(&filter);
+  assert(filter.num_keys == 0);
+  assert(false_positives(&filter, n) == 0);
+  bloom_free(&filter);
+}
+
+static void
+benchmark(uint64_t n)
+{
+  bloom_filter_t filter;
+  uint64_t i, found = 0;
+  clock_t start;
+  double sec;
+
+  assert(bloom_init(&filter, n, 10) == 0);
+  for (i = 0; i < n; i++)
+    bloom_add(&filter, hash(i));
+
+  start = clock();
+  for (i = 0; i < 2 * n; i++)
+    found += bloom_may_contain(&filter, hash(i)) != 0;
+  sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("lookups: %.1f M/sec (%llu found)\n",
+                  sec > 0 ? 2 * n / sec / 1e6 : 0.0,
+                  (unsigned long long)found);
+  bloom_free(&filter);
+}
+
+int
+main()
+{
+  bloom_filter_t filter;
+
+  assert(bloom_init(&filter, 100, 0) != 0);
+
+  /* an empty filter has a single block */
+  assert(bloom_init(&filter, 0, 10) == 0);
+  assert(filter.num_blocks == 1);
+  assert(!bloom_may_contain(&filter, hash(1)));
+  bloom_add(&filter, hash(1));
+  assert(bloom_may_contain(&filter, hash(1)));
+  bloom_free(&filter);
+
+  check(1, 10, 1.0);
+  check(1000, 10, 0.03);
+  check(100000, 10, 0.02);
+  check(1000000, 10, 0.02);
+  check(1000000, 16, 0.005);
+  check(1000000, 4, 0.2);
+
+  benchmark(1000000);
+
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crc32c.h"
+#include "crc32c_tables.h"
+
+/*
+ * The hardware implementations are compiled with function-specific target
+ * attributes; no special compiler flags are required.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define CRC32C_SSE42 1
+#  include <nmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#  define CRC32C_ARMV8 1
+#  include <sys/auxv.h>
+#  ifndef HWCAP_CRC32
+#    define HWCAP_CRC32 (1 << 7)
+#  endif
+#endif
+
+/* reads a little-endian 64bit word */
+static inline uint64_t
+load64(const unsigned char *p)
+{
+  return (uint64_t)p[0]
+        | ((uint64_t)p[1] << 8)
+        | ((uint64_t)p[2] << 16)
+        | ((uint64_t)p[3] << 24)
+        | ((uint64_t)p[4] << 32)
+        | ((uint64_t)p[5] << 40)
+        | ((uint64_t)p[6] << 48)
+        | ((uint64_t)p[7] << 56);
+}
+
+/* the crc of a block followed by |table|'s number of zero bytes */
+static inline uint32_t
+shift(const uint32_t table[][256], uint32_t crc)
+{
+  return table[0][crc & 0xff]
+        ^ table[1][(crc >> 8) & 0xff]
+        ^ table[2][(crc >> 16) & 0xff]
+        ^ table[3][crc >> 24];
+}
+
+/* slicing-by-8; |crc| is the (inverted) crc register */
+static uint32_t
+update_sw(uint32_t crc, const unsigned char *next, size_t length)
+{
+  while (length && ((uintptr_t)next & 7) != 0) {
+    crc = crc32c_table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+    length--;
+  }
+
+  while (length >= 8) {
+    uint64_t word = crc ^ load64(next);
+    crc = crc32c_table[7][word & 0xff]
+        ^ crc32c_table[6][(word >> 8) & 0xff]
+        ^ crc32c_table[5][(word >> 16) & 0xff]
+        ^ crc32c_table[4][(word >> 24) & 0xff]
+        ^ crc32c_table[3][(word >> 32) & 0xff]
+        ^ crc32c_table[2][(word >> 40) & 0xff]
+        ^ crc32c_table[1][(word >> 48) & 0xff]
+        ^ crc32c_table[0][word >> 56];
+    next += 8;
+    length -= 8;
+  }
+
+  while (length) {
+    crc = crc32c_table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+    length--;
+  }
+  return crc;
+}
+
+/*
+ * The hardware implementation. The crc instructions have a latency of
+ * three cycles, but a throughput of one per cycle. Therefore large buffers
+ * are split into three blocks of |block| bytes, which are processed in
+ * parallel. The crc of the first block is then shifted over the length
+ * of the second block and combined with the second crc (and the same for
+ * the third block).
+ *
+ * |crc_u64| and |crc_u8| update the crc register with a 64bit word or
+ * with a single byte.
+ */
+#define UPDATE_HW_BLOCKS(crc0, next, length, block, table, crc_u64)       \
+  while (length >= 3 * block) {                                           \
+    const unsigned char *end = next + block;                              \
+    uint32_t crc1 = 0, crc2 = 0;                                          \
+    do {                                                                  \
+      crc0 = crc_u64(crc0, load64(next));                                 \
+      crc1 = crc_u64(crc1, load64(next + block));                         \
+      crc2 = crc_u64(crc2, load64(next + 2 * block));                     \
+      next += 8;                                                          \
+    } while (next < end);                                                 \
+    crc0 = shift(table, crc0) ^ crc1;                                     \
+    crc0 = shift(table, crc0) ^ crc2;                                     \
+    next += 2 * block;                                                    \
+    length -= 3 * block;                                                  \
+  }
+
+#define UPDATE_HW(crc0, next, length, crc_u64, crc_u8)                    \
+  while (length && ((uintptr_t)next & 7) != 0) {                          \
+    crc0 = crc_u8(crc0, *next++);                                         \
+    length--;                                                             \
+  }                                                                       \
+  UPDATE_HW_BLOCKS(crc0, next, length, CRC32C_LONG, crc32c_long, crc_u64) \
+  UPDATE_HW_BLOCKS(crc0, next, length, CRC32C_SHORT, crc32c_short,        \
+                  crc_u64)                                                \
+  while (length >= 8) {                                                   \
+    crc0 = crc_u64(crc0, load64(next));                                   \
+    next += 8;                                                            \
+    length -= 8;                                                          \
+  }                                                                       \
+  while (length) {                                                        \
+    crc0 = crc_u8(crc0, *next++);                                         \
+    length--;                                                             \
+  }
+
+#ifdef CRC32C_SSE42
+
+#define SSE42_U64(crc, v)   ((uint32_t)_mm_crc32_u64(crc, v))
+#define SSE42_U8(crc, v)    _mm_crc32_u8(crc, v)
+
+__attribute__((target("sse4.2")))
+static uint32_t
+update_hw(uint32_t crc, const unsigned char *next, size_t length)
+{
+  UPDATE_HW(crc, next, length, SSE42_U64, SSE42_U8)
+  return crc;
+}
+
+static int
+detect_hw(void)
+{
+  return __builtin_cpu_supports("sse4.2");
+}
+
+#endif /* CRC32C_SSE42 */
+
+#ifdef CRC32C_ARMV8
+
+__attribute__((target("+crc"), always_inline))
+static inline uint32_t
+armv8_u64(uint32_t crc, uint64_t v)
+{
+  __asm__("crc32cx %w0, %w0, %x1" : "+r" (crc) : "r" (v));
+  return crc;
+}
+
+__attribute__((target("+crc"), always_inline))
+static inline uint32_t
+armv8_u8(uint32_t crc, uint8_t v)
+{
+  __asm__("crc32cb %w0, %w0, %w1" : "+r" (crc) : "r" ((uint32_t)v));
+  return crc;
+}
+
+__attribute__((target("+crc")))
+static uint32_t
+update_hw(uint32_t crc, const unsigned char *next, size_t length)
+{
+  UPDATE_HW(crc, next, length, armv8_u64, armv8_u8)
+  return crc;
+}
+
+static int
+detect_hw(void)
+{
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+#endif /* CRC32C_ARMV8 */
+
+#if defined(CRC32C_SSE42) || defined(CRC32C_ARMV8)
+/* -1: not yet detected */
+static int hw_available = -1;
+#endif
+
+int
+crc32c_hw_available(void)
+{
+#if defined(CRC32C_SSE42) || defined(CRC32C_ARMV8)
+  /* a race is harmless; all threads store the same value */
+  if (hw_available < 0)
+    hw_available = detect_hw();
+  return hw_available;
+#else
+  return 0;
+#endif
+}
+
+uint32_t
+crc32c_sw(uint32_t crc, const void *buffer, size_t length)
+{
+  return ~update_sw(~crc, (const unsigned char *)buffer, length);
+}
+
+uint32_t
+crc32c(uint32_t crc, const void *buffer, size_t length)
+{
+#if defined(CRC32C_SSE42) || defined(CRC32C_ARMV8)
+  if (crc32c_hw_available())
+    return ~update_hw(~crc, (const unsigned char *)buffer, length);
+#endif
+  return crc32c_sw(crc, buffer, length);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * CRC-32C (Castagnoli) checksums.
+ *
+ * On x86-64 CPUs with SSE4.2 the checksum is calculated with the crc32
+ * instruction, on aarch64 CPUs with the ARMv8 CRC extension with the
+ * crc32c instructions. Large buffers are split into three streams which
+ * are processed in parallel, hiding the latency of the instruction; the
+ * partial checksums are then combined with lookup tables. The
+ * implementation is selected at run-time. Other CPUs use a table-driven
+ * (slicing-by-8) implementation.
+ *
+ * See the README.md file for more information.
+ */
+
+#ifndef CRC32C_H_4b8d0e62_57a1_4f3b_9e0c_2d6f1a7c3b95
+#define CRC32C_H_4b8d0e62_57a1_4f3b_9e0c_2d6f1a7c3b95
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Updates the checksum |crc| with the |length| bytes at |buffer|, and
+ * returns the new checksum. Start with a |crc| of 0.
+ *
+ * crc32c(crc32c(0, a, n), a + n, m) equals crc32c(0, a, n + m).
+ */
+extern uint32_t
+crc32c(uint32_t crc, const void *buffer, size_t length);
+
+/**
+ * Same as crc32c(), but always uses the software implementation.
+ */
+extern uint32_t
+crc32c_sw(uint32_t crc, const void *buffer, size_t length);
+
+/**
+ * Returns non-zero if crc32c() uses the hardware instructions.
+ */
+extern int
+crc32c_hw_available(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CRC32C_H_4b8d0e62_57a1_4f3b_9e0c_2d6f1a7c3b95 */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "crc32c.h"
+
+/* the bit-wise reference implementation */
+static uint32_t
+reference(uint32_t crc, const unsigned char *p, size_t length)
+{
+  int k;
+
+  crc = ~crc;
+  while (length--) {
+    crc ^= *p++;
+    for (k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static void
+check(const unsigned char *p, size_t length)
+{
+  uint32_t expected = reference(0, p, length);
+  size_t split = length ? (size_t)rand() % length : 0;
+
+  assert(crc32c_sw(0, p, length) == expected);
+  assert(crc32c(0, p, length) == expected);
+  /* incremental updates */
+  assert(crc32c(crc32c(0, p, split), p + split, length - split) == expected);
+  assert(crc32c_sw(crc32c(0, p, split), p + split, length - split)
+                  == expected);
+}
+
+static void
+benchmark(const unsigned char *p, size_t length, int loops,
+                uint32_t (*f)(uint32_t, const void *, size_t),
+                const char *name)
+{
+  clock_t start = clock();
+  uint32_t crc = 0;
+  double sec;
+  int i;
+
+  for (i = 0; i < loops; i++)
+    crc = f(crc, p, length);
+  sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("%s: %8.1f MB/sec (%08x)\n", name,
+                  sec > 0 ? (double)length * loops / sec / 1e6 : 0.0, crc);
+}
+
+int
+main()
+{
+  static const size_t lengths[] = {0, 1, 2, 7, 8, 9, 255, 256, 767, 768,
+          769, 1000, 4096, 16384, 24575, 24576, 24577, 65536, 100000};
+  size_t max = 100000 + 8;
+  unsigned char *buffer = malloc(max);
+  unsigned seed = (unsigned)time(0);
+  size_t i, l, offset;
+
+  printf("seed: %u\n", seed);
+  srand(seed);
+  printf("hardware: %s\n", crc32c_hw_available() ? "yes" : "no");
+
+  /* the standard check value */
+  assert(crc32c(0, "123456789", 9) == 0xe3069283);
+  assert(crc32c_sw(0, "123456789", 9) == 0xe3069283);
+
+  for (i = 0; i < max; i++)
+    buffer[i] = (unsigned char)rand();
+
+  /* all lengths at all alignments */
+  for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    for (offset = 0; offset < 8; offset++)
+      check(buffer + offset, lengths[l]);
+
+  for (i = 0; i < 1000; i++)
+    check(buffer + rand() % 8, (size_t)rand() % (max - 8));
+
+  benchmark(buffer, 16384, 20000, crc32c_sw, "software");
+  benchmark(buffer, 16384, 20000, crc32c, "crc32c  ");
+
+  free(buffer);
+  printf("ok\n");
+  return 0;
+}
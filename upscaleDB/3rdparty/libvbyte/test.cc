@@ -4,6 +4,8 @@
 #include <assert.h>
 #include <ctime>
 #include <set>
+#include <iterator>
+#include <stdlib.h>
 
 #include <boost/random.hpp>
 #include <boost/random/uniform_01.hpp>
@@ -97,6 +99,64 @@ run_append_test(std::vector<typename Traits::type> &plain,
   }
 }
 
+template<typename Traits>
+static void
+run_insert_delete_test(size_t length)
+{
+  typedef typename Traits::type type;
+  std::set<type> plain;
+  std::vector<uint8_t> z(length * 10 + 10);
+  std::vector<type> out(length + 1);
+  size_t zsize = 0;
+
+  // insert random values; values 0 and 1 are never inserted
+  Timer<boost::chrono::high_resolution_clock> t;
+  for (size_t i = 0; i < length; i++) {
+    type value = 2 + (type)(::rand() % (length * 7 + 1));
+    size_t expected = std::distance(plain.begin(), plain.lower_bound(value));
+    size_t index = Traits::insert(&z[0], &zsize, 1, value);
+    if (plain.find(value) != plain.end())
+      assert(index == (size_t)-1);
+    else
+      assert(index == expected);
+    plain.insert(value);
+  }
+  printf("    %s insert -> %f\n", Traits::name, t.seconds());
+
+  // verify
+  size_t len = Traits::uncompress(&z[0], &out[0], 1, plain.size());
+  assert(len == zsize);
+  size_t j = 0;
+  for (typename std::set<type>::iterator it = plain.begin();
+                  it != plain.end(); ++it, ++j)
+    assert(out[j] == *it);
+
+  // now delete every other value
+  t = Timer<boost::chrono::high_resolution_clock>();
+  j = 0;
+  for (typename std::set<type>::iterator it = plain.begin();
+                  it != plain.end(); j++) {
+    if (j % 2 == 0) {
+      size_t expected = std::distance(plain.begin(), it);
+      size_t index = Traits::erase(&z[0], &zsize, 1, *it);
+      assert(index == expected);
+      plain.erase(it++);
+    }
+    else
+      ++it;
+  }
+  assert(Traits::erase(&z[0], &zsize, 1, 0) == (size_t)-1);
+  printf("    %s delete -> %f\n", Traits::name, t.seconds());
+
+  // verify
+  len = Traits::uncompress(&z[0], &out[0], 1, plain.size());
+  assert(len == zsize);
+  j = 0;
+  for (typename std::set<type>::iterator it = plain.begin();
+                  it != plain.end(); ++it, ++j)
+    assert(out[j] == *it);
+}
+
 template<typename Traits>
 static void
 run_tests(size_t length)
@@ -129,7 +189,7 @@ struct Sorted32Traits {
   static constexpr const char *name = "Sorted32";
 
   static size_t compress(const type *in, uint8_t *out, size_t length) {
-    return vbyte_compress_sorted32(in, out, length);
+    return vbyte_compress_sorted32(in, out, 0, length);
   }
   
   static size_t compressed_size(const type *in, size_t length) {
@@ -137,21 +197,36 @@ struct Sorted32Traits {
   }
 
   static size_t uncompress(const uint8_t *in, type *out, size_t length) {
-    return vbyte_uncompress_sorted32(in, out, length);
+    return vbyte_uncompress_sorted32(in, out, 0, length);
   } 
 
   static type select(const uint8_t *in, size_t length, size_t index) {
-    return vbyte_select_sorted32(in, length, index);
+    return vbyte_select_sorted32(in, length, 0, index);
   } 
 
   static size_t search(const uint8_t *in, size_t length, type value,
                   type *result) {
-    return vbyte_search_lower_bound_sorted32(in, length, value, result);
+    return vbyte_search_lower_bound_sorted32(in, length, value, 0, result);
   }
 
   static size_t append(uint8_t *end, type highest, type value) {
     return vbyte_append_sorted64(end, highest, value);
   }
+
+  static size_t uncompress(const uint8_t *in, type *out, type previous,
+                  size_t length) {
+    return vbyte_uncompress_sorted32(in, out, previous, length);
+  }
+
+  static size_t insert(uint8_t *in, size_t *size, type previous,
+                  type value) {
+    return vbyte_insert_sorted32(in, size, previous, value);
+  }
+
+  static size_t erase(uint8_t *in, size_t *size, type previous,
+                  type value) {
+    return vbyte_delete_sorted32(in, size, previous, value);
+  }
 };
 
 struct Sorted64Traits {
@@ -159,7 +234,7 @@ struct Sorted64Traits {
   static constexpr const char *name = "Sorted64";
 
   static size_t compress(const type *in, uint8_t *out, size_t length) {
-    return vbyte_compress_sorted64(in, out, length);
+    return vbyte_compress_sorted64(in, out, 0, length);
   }
 
   static size_t compressed_size(const type *in, size_t length) {
@@ -167,21 +242,36 @@ struct Sorted64Traits {
   }
 
   static size_t uncompress(const uint8_t *in, type *out, size_t length) {
-    return vbyte_uncompress_sorted64(in, out, length);
+    return vbyte_uncompress_sorted64(in, out, 0, length);
   } 
 
   static type select(const uint8_t *in, size_t length, size_t index) {
-    return vbyte_select_sorted64(in, length, index);
+    return vbyte_select_sorted64(in, length, 0, index);
   } 
 
   static size_t search(const uint8_t *in, size_t length, type value,
                   type *result) {
-    return vbyte_search_lower_bound_sorted64(in, length, value, result);
+    return vbyte_search_lower_bound_sorted64(in, length, value, 0, result);
   }
 
   static size_t append(uint8_t *end, type highest, type value) {
     return vbyte_append_sorted64(end, highest, value);
   }
+
+  static size_t uncompress(const uint8_t *in, type *out, type previous,
+                  size_t length) {
+    return vbyte_uncompress_sorted64(in, out, previous, length);
+  }
+
+  static size_t insert(uint8_t *in, size_t *size, type previous,
+                  type value) {
+    return vbyte_insert_sorted64(in, size, previous, value);
+  }
+
+  static size_t erase(uint8_t *in, size_t *size, type previous,
+                  type value) {
+    return vbyte_delete_sorted64(in, size, previous, value);
+  }
 };
 
 struct Unsorted32Traits {
@@ -246,20 +336,75 @@ struct Unsorted64Traits {
   }
 };
 
+// the encoded integers have 1 to 5 bytes, so that every code path of the
+// (MaskedVbyte) decoder is used
+static void
+run_mixed_width_tests(size_t length)
+{
+  std::vector<uint32_t> plain(length);
+  std::vector<uint32_t> out(length);
+  std::vector<uint8_t> z(length * 5 + 16);
+
+  // unsorted; values with the top bits set use 5 bytes
+  for (size_t i = 0; i < length; i++)
+    plain[i] = (uint32_t)::rand() >> (::rand() % 32);
+  if (length > 0)
+    plain[length / 2] = 0xffffffffu;
+  size_t len = vbyte_compress_unsorted32(&plain[0], &z[0], length);
+  assert(len == vbyte_compressed_size_unsorted32(&plain[0], length));
+  assert(vbyte_uncompress_unsorted32(&z[0], &out[0], length) == len);
+  for (size_t i = 0; i < length; i++)
+    assert(plain[i] == out[i]);
+
+  // sorted; the deltas have 1 to 4 bytes, and the sum stays below 2^32
+  uint32_t value = 0;
+  for (size_t i = 0; i < length; i++) {
+    uint32_t delta = (uint32_t)::rand() % (1u << (7 * (1 + ::rand() % 3)));
+    if (i % 997 == 0)
+      delta = 1u << 21;
+    value += delta;
+    plain[i] = value;
+  }
+  len = vbyte_compress_sorted32(&plain[0], &z[0], 0, length);
+  assert(len == vbyte_compressed_size_sorted32(&plain[0], length));
+  assert(vbyte_uncompress_sorted32(&z[0], &out[0], 0, length) == len);
+  for (size_t i = 0; i < length; i++)
+    assert(plain[i] == out[i]);
+  for (size_t i = 0; i < length; i += 1 + length / 100) {
+    assert(plain[i] == vbyte_select_sorted32(&z[0], len, 0, i));
+    uint32_t found;
+    size_t pos = vbyte_search_lower_bound_sorted32(&z[0], length, plain[i],
+                    0, &found);
+    assert(found == plain[i]);
+    assert(plain[pos] == plain[i]);
+  }
+  printf("    mixed widths -> ok\n");
+}
+
 inline static void
 test(size_t length)
 {
   printf("%u, sorted, 32bit\n", (uint32_t)length);
   run_tests<Sorted32Traits>(length);
+  // insert and delete are linear in the length of the sequence
+  if (length <= 20000)
+    run_insert_delete_test<Sorted32Traits>(length);
 
   printf("%u, sorted, 64bit\n", (uint32_t)length);
   run_tests<Sorted64Traits>(length);
+  // insert and delete are linear in the length of the sequence
+  if (length <= 20000)
+    run_insert_delete_test<Sorted64Traits>(length);
 
   printf("%u, unsorted, 32bit\n", (uint32_t)length);
   run_tests<Unsorted32Traits>(length);
 
   printf("%u, unsorted, 64bit\n", (uint32_t)length);
   run_tests<Unsorted64Traits>(length);
+
+  // the sorted deltas are at most 2^21, and their sum is below 2^32
+  if (length <= 1000)
+    run_mixed_width_tests(length);
 }
 
 int
@@ -9,21 +9,26 @@
 #  include <intrin.h>
 #  include "ups/msstdint.h"
 #endif
-#else
+#elif defined(__SSE2__)
 #  include <x86intrin.h>
+#else
+/* ARM/aarch64: the SSE intrinsics are implemented with NEON, see
+ * simdcomp/include/simdintrin.h */
+#  include "simdintrin.h"
 #endif
 
 #if defined(_MSC_VER)
 #  define ALIGNED(x) __declspec(align(x))
 #else
-#  include <x86intrin.h>
 #  if defined(__GNUC__)
 #    define ALIGNED(x) __attribute__ ((aligned(x)))
 #  endif
 #endif
 
 
-#if defined(_MSC_VER)
+#if defined(SIMDCOMP_CTZ)
+/* already defined by simdcomp/include/portability.h */
+#elif defined(_MSC_VER)
 # include <intrin.h>
 /* 64-bit needs extending */
 # define SIMDCOMP_CTZ(result, mask) do { \
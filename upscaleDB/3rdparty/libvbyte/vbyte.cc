@@ -28,6 +28,10 @@ typedef signed char int8_t;
 #  define USE_MASKEDVBYTE 1
 #endif
 
+// On ARM, Makefile.am defines USE_MASKEDVBYTE if configure detected NEON;
+// varintdecode.c is then built with the NEON versions of the SSE
+// intrinsics (see simdcomp/include/simdintrin.h)
+
 #include "vbyte.h"
 #include "varintdecode.h"
 
@@ -81,6 +85,13 @@ is_avx_available()
 
   return available;
 }
+#elif defined(__aarch64__)
+// NEON is part of every ARMv8-A CPU
+static inline bool
+is_avx_available()
+{
+  return true;
+}
 #else
 static inline bool
 is_avx_available()
@@ -500,6 +511,87 @@ sorted_search(const uint8_t *in, size_t length, T value, T previous, T *actual)
   return length;
 }
 
+template<typename T>
+static inline size_t
+insert_sorted(uint8_t *in, size_t *size, T previous, T value)
+{
+  uint8_t *p = in;
+  uint8_t *end = in + *size;
+  size_t index = 0;
+  T delta = 0;
+  int len = 0;
+
+  // find the first element which is not less than |value|
+  while (p < end) {
+    len = read_int(p, &delta);
+    if (previous + delta == value)
+      return (size_t)-1;
+    if (previous + delta > value)
+      break;
+    previous += delta;
+    p += len;
+    index++;
+  }
+
+  // append at the end?
+  if (p == end) {
+    *size += write_int(p, (T)(value - previous));
+    return index;
+  }
+
+  // the delta at |p| is replaced by two deltas: |previous| -> |value| and
+  // |value| -> next
+  T next = previous + delta;
+  int len1 = compressed_size((T)(value - previous));
+  int len2 = compressed_size((T)(next - value));
+  ::memmove(p + len1 + len2, p + len, end - (p + len));
+  write_int(p, (T)(value - previous));
+  write_int(p + len1, (T)(next - value));
+  *size += len1 + len2 - len;
+  return index;
+}
+
+template<typename T>
+static inline size_t
+delete_sorted(uint8_t *in, size_t *size, T previous, T value)
+{
+  uint8_t *p = in;
+  uint8_t *end = in + *size;
+  size_t index = 0;
+  T delta;
+  int len = 0;
+
+  while (p < end) {
+    len = read_int(p, &delta);
+    if (previous + delta > value)
+      return (size_t)-1;
+    if (previous + delta == value)
+      break;
+    previous += delta;
+    p += len;
+    index++;
+  }
+
+  if (p == end)
+    return (size_t)-1;
+
+  // the last element is simply truncated
+  if (p + len == end) {
+    *size -= len;
+    return index;
+  }
+
+  // otherwise merge the delta of |value| with the one of its successor
+  T next_delta;
+  int next_len = read_int(p + len, &next_delta);
+  T next = value + next_delta;
+  int new_len = write_int(p, (T)(next - previous));
+  uint8_t *tail = p + len + next_len;
+  ::memmove(p + new_len, tail, end - tail);
+  *size -= len + next_len - new_len;
+  return index;
+}
+
 } // namespace vbyte
 
 #ifdef __cplusplus
@@ -681,6 +773,36 @@ vbyte_append_unsorted64(uint8_t *end, uint64_t value)
   return vbyte::write_int(end, value);
 }
 
+size_t
+vbyte_insert_sorted32(uint8_t *in, size_t *size, uint32_t previous,
+                uint32_t value)
+{
+  assert(value > previous);
+  return vbyte::insert_sorted(in, size, previous, value);
+}
+
+size_t
+vbyte_insert_sorted64(uint8_t *in, size_t *size, uint64_t previous,
+                uint64_t value)
+{
+  assert(value > previous);
+  return vbyte::insert_sorted(in, size, previous, value);
+}
+
+size_t
+vbyte_delete_sorted32(uint8_t *in, size_t *size, uint32_t previous,
+                uint32_t value)
+{
+  return vbyte::delete_sorted(in, size, previous, value);
+}
+
+size_t
+vbyte_delete_sorted64(uint8_t *in, size_t *size, uint64_t previous,
+                uint64_t value)
+{
+  return vbyte::delete_sorted(in, size, previous, value);
+}
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -334,6 +334,90 @@ extern size_t
 vbyte_append_unsorted64(uint8_t *end, uint64_t value);
 
 
+/**
+ * Inserts |value| into a sorted sequence of compressed 32bit unsigned
+ * integers.
+ *
+ * |in| points to the compressed sequence, |*size| is its size in bytes.
+ * The buffer pointed to by |in| must have room for at least |*size| + 5
+ * bytes. |previous| is the value preceding the first encoded integer
+ * (see vbyte_compress_sorted32()); |value| must be greater than |previous|.
+ *
+ * Only the delta at the insert position is re-encoded; the remaining
+ * bytes are shifted with memmove().
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the index of |value| in the sequence, and stores the new size
+ * of the compressed sequence in |*size|. If |value| is already stored then
+ * the sequence is not modified and (size_t)-1 is returned.
+ */
+extern size_t
+vbyte_insert_sorted32(uint8_t *in, size_t *size, uint32_t previous,
+                uint32_t value);
+
+/**
+ * Inserts |value| into a sorted sequence of compressed 64bit unsigned
+ * integers.
+ *
+ * |in| points to the compressed sequence, |*size| is its size in bytes.
+ * The buffer pointed to by |in| must have room for at least |*size| + 10
+ * bytes. |previous| is the value preceding the first encoded integer
+ * (see vbyte_compress_sorted64()); |value| must be greater than |previous|.
+ *
+ * Only the delta at the insert position is re-encoded; the remaining
+ * bytes are shifted with memmove().
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the index of |value| in the sequence, and stores the new size
+ * of the compressed sequence in |*size|. If |value| is already stored then
+ * the sequence is not modified and (size_t)-1 is returned.
+ */
+extern size_t
+vbyte_insert_sorted64(uint8_t *in, size_t *size, uint64_t previous,
+                uint64_t value);
+
+/**
+ * Deletes |value| from a sorted sequence of compressed 32bit unsigned
+ * integers.
+ *
+ * |in| points to the compressed sequence, |*size| is its size in bytes.
+ * |previous| is the value preceding the first encoded integer.
+ *
+ * The deltas of |value| and its successor are merged; the remaining
+ * bytes are shifted with memmove().
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the index which |value| had in the sequence, and stores the new
+ * size of the compressed sequence in |*size|. If |value| is not stored
+ * then the sequence is not modified and (size_t)-1 is returned.
+ */
+extern size_t
+vbyte_delete_sorted32(uint8_t *in, size_t *size, uint32_t previous,
+                uint32_t value);
+
+/**
+ * Deletes |value| from a sorted sequence of compressed 64bit unsigned
+ * integers.
+ *
+ * |in| points to the compressed sequence, |*size| is its size in bytes.
+ * |previous| is the value preceding the first encoded integer.
+ *
+ * The deltas of |value| and its successor are merged; the remaining
+ * bytes are shifted with memmove().
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the index which |value| had in the sequence, and stores the new
+ * size of the compressed sequence in |*size|. If |value| is not stored
+ * then the sequence is not modified and (size_t)-1 is returned.
+ */
+extern size_t
+vbyte_delete_sorted64(uint8_t *in, size_t *size, uint64_t previous,
+                uint64_t value);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
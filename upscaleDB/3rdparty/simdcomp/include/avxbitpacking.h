@@ -0,0 +1,104 @@
+/**
+ * This code is released under a BSD License.
+ */
+#ifndef AVXBITPACKING_H_
+#define AVXBITPACKING_H_
+
+#include "portability.h"
+
+/*
+ * The AVX2 and AVX-512 kernels are compiled with function-specific target
+ * attributes; the remaining code does not need -mavx2 or -mavx512f. Always
+ * check avx2_available() or avx512_available() before calling them.
+ */
+#if defined(__GNUC__) && defined(__SSE2__) \
+    && (defined(__x86_64__) || defined(__i386__))
+# define SIMDCOMP_AVX 1
+# include <immintrin.h>
+#endif
+
+enum { AVXBlockSize = 256 };
+
+enum { AVX512BlockSize = 512 };
+
+/* returns non-zero if the CPU supports AVX2 (checked at run-time) */
+int avx2_available(void);
+
+/* returns non-zero if the CPU supports AVX-512F (checked at run-time) */
+int avx512_available(void);
+
+#ifdef SIMDCOMP_AVX
+
+/* max integer logarithm over a range of AVXBlockSize integers (256 integer) */
+uint32_t avxmaxbits(const uint32_t * begin);
+
+/* reads 256 values from "in", writes  "bit" 256-bit vectors to "out" */
+void avxpack(const uint32_t *  in, __m256i *  out, const uint32_t bit);
+
+/* reads 256 values from "in", writes  "bit" 256-bit vectors to "out";
+   the values must not exceed "bit" bits */
+void avxpackwithoutmask(const uint32_t *  in, __m256i *  out, const uint32_t bit);
+
+/* reads  "bit" 256-bit vectors from "in", writes  256 values to "out" */
+void avxunpack(const __m256i *  in, uint32_t *  out, const uint32_t bit);
+
+/* returns the value stored at the specified "slot" of a block which was
+   packed with avxpack */
+uint32_t avxselect(const __m256i *  in, int slot, const uint32_t bit);
+
+/* like avxmaxbits, but over the differences of successive integers;
+   the first difference is against "initvalue" */
+uint32_t avxmaxbitsd1(uint32_t initvalue, const uint32_t * begin);
+
+/* like avxpack, but stores the differences of successive integers
+   (differential coding, like simdpackd1) */
+void avxpackd1(uint32_t initvalue, const uint32_t *  in, __m256i *  out, const uint32_t bit);
+
+/* reads  "bit" 256-bit vectors which were packed with avxpackd1 from
+   "in", writes  256 values to "out" */
+void avxunpackd1(uint32_t initvalue, const __m256i *  in, uint32_t *  out, const uint32_t bit);
+
+/* searches a block which was packed with avxpackd1 for the first value
+   which is >= "key", and returns its position; the value is stored in
+   "*presult". If no such value exists, 256 is returned and "*presult"
+   is set to key + 1 (like simdsearchd1) */
+int avxsearchd1(uint32_t initvalue, const __m256i *  in, uint32_t bit,
+                uint32_t key, uint32_t *presult);
+
+/* max integer logarithm over a range of AVX512BlockSize integers (512 integer) */
+uint32_t avx512maxbits(const uint32_t * begin);
+
+/* reads 512 values from "in", writes  "bit" 512-bit vectors to "out" */
+void avx512pack(const uint32_t *  in, __m512i *  out, const uint32_t bit);
+
+/* reads 512 values from "in", writes  "bit" 512-bit vectors to "out";
+   the values must not exceed "bit" bits */
+void avx512packwithoutmask(const uint32_t *  in, __m512i *  out, const uint32_t bit);
+
+/* reads  "bit" 512-bit vectors from "in", writes  512 values to "out" */
+void avx512unpack(const __m512i *  in, uint32_t *  out, const uint32_t bit);
+
+/* returns the value stored at the specified "slot" of a block which was
+   packed with avx512pack */
+uint32_t avx512select(const __m512i *  in, int slot, const uint32_t bit);
+
+/* like avx512maxbits, but over the differences of successive integers;
+   the first difference is against "initvalue" */
+uint32_t avx512maxbitsd1(uint32_t initvalue, const uint32_t * begin);
+
+/* like avx512pack, but stores the differences of successive integers
+   (differential coding, like simdpackd1) */
+void avx512packd1(uint32_t initvalue, const uint32_t *  in, __m512i *  out, const uint32_t bit);
+
+/* reads  "bit" 512-bit vectors which were packed with avx512packd1 from
+   "in", writes  512 values to "out" */
+void avx512unpackd1(uint32_t initvalue, const __m512i *  in, uint32_t *  out, const uint32_t bit);
+
+/* like avxsearchd1, for a block which was packed with avx512packd1; returns
+   512 if no value is >= "key" */
+int avx512searchd1(uint32_t initvalue, const __m512i *  in, uint32_t bit,
+                uint32_t key, uint32_t *presult);
+
+#endif /* SIMDCOMP_AVX */
+
+#endif /* AVXBITPACKING_H_ */
@@ -6,8 +6,8 @@
 
 #include "portability.h"
 
-/* SSE2 is required */
-#include <emmintrin.h>
+/* SSE2 (or NEON) is required */
+#include "simdintrin.h"
 
 #include "simdcomputil.h"
 #include "simdbitpacking.h"
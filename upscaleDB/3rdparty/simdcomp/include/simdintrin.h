@@ -0,0 +1,259 @@
+/**
+ * This code is released under a BSD License.
+ */
+#ifndef SIMDINTRIN_H_
+#define SIMDINTRIN_H_
+
+/*
+ * simdcomp is written against the SSE2/SSE4.1 intrinsics. On x86 these are
+ * taken from the compiler. On other platforms (ARM/aarch64) the small
+ * subset of intrinsics which is used by simdcomp (and by the MaskedVbyte
+ * decoder in libvbyte) is implemented with GCC vector extensions; the
+ * compiler translates them to NEON instructions. The packed format is
+ * identical on all platforms.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+
+#elif defined(__GNUC__)
+
+#define SIMDCOMP_GENERIC_SIMD 1
+
+#include <string.h>
+#include "portability.h"
+
+#ifdef __ARM_NEON
+# include <arm_neon.h>
+#endif
+
+typedef int32_t __m128i __attribute__((vector_size(16), may_alias));
+typedef float __m128 __attribute__((vector_size(16), may_alias));
+
+/* unaligned variants of the vector types, for loads and stores */
+typedef int32_t simdcomp_m128i_u __attribute__((vector_size(16), may_alias,
+                        aligned(1)));
+typedef uint32_t simdcomp_u32x4 __attribute__((vector_size(16)));
+typedef uint64_t simdcomp_u64x2 __attribute__((vector_size(16)));
+typedef uint16_t simdcomp_u16x8 __attribute__((vector_size(16)));
+typedef int16_t simdcomp_s16x8 __attribute__((vector_size(16)));
+typedef uint8_t simdcomp_u8x16 __attribute__((vector_size(16)));
+typedef int8_t simdcomp_s8x16 __attribute__((vector_size(16)));
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_setzero_si128(void) {
+    __m128i r = {0, 0, 0, 0};
+    return r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_set1_epi32(int a) {
+    __m128i r = {a, a, a, a};
+    return r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_setr_epi32(int a, int b, int c,
+                int d) {
+    __m128i r = {a, b, c, d};
+    return r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_set1_epi16(short a) {
+    simdcomp_s16x8 r = {a, a, a, a, a, a, a, a};
+    return (__m128i)r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_setr_epi16(short a0, short a1,
+                short a2, short a3, short a4, short a5, short a6, short a7) {
+    simdcomp_s16x8 r = {a0, a1, a2, a3, a4, a5, a6, a7};
+    return (__m128i)r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_set1_epi8(char a) {
+    simdcomp_s8x16 r = {a, a, a, a, a, a, a, a, a, a, a, a, a, a, a, a};
+    return (__m128i)r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_setr_epi8(char a0, char a1,
+                char a2, char a3, char a4, char a5, char a6, char a7,
+                char a8, char a9, char a10, char a11, char a12, char a13,
+                char a14, char a15) {
+    simdcomp_s8x16 r = {a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11,
+                a12, a13, a14, a15};
+    return (__m128i)r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_load_si128(const __m128i *p) {
+    return *p;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_loadu_si128(const __m128i *p) {
+    return *(const simdcomp_m128i_u *)p;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_lddqu_si128(const __m128i *p) {
+    return _mm_loadu_si128(p);
+}
+
+static SIMDCOMP_ALWAYS_INLINE void _mm_store_si128(__m128i *p, __m128i a) {
+    *p = a;
+}
+
+static SIMDCOMP_ALWAYS_INLINE void _mm_storeu_si128(__m128i *p, __m128i a) {
+    *(simdcomp_m128i_u *)p = a;
+}
+
+/* stores the lower 64 bits */
+static SIMDCOMP_ALWAYS_INLINE void _mm_storel_epi64(__m128i *p, __m128i a) {
+    memcpy(p, &a, 8);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_and_si128(__m128i a, __m128i b) {
+    return a & b;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_or_si128(__m128i a, __m128i b) {
+    return a | b;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_add_epi32(__m128i a, __m128i b) {
+    return (__m128i)((simdcomp_u32x4)a + (simdcomp_u32x4)b);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_sub_epi32(__m128i a, __m128i b) {
+    return (__m128i)((simdcomp_u32x4)a - (simdcomp_u32x4)b);
+}
+
+/* keeps the lower 16 bits of each product */
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_mullo_epi16(__m128i a, __m128i b) {
+    return (__m128i)((simdcomp_u16x8)a * (simdcomp_u16x8)b);
+}
+
+/* like SSE, shifting by 32 or more bits returns 0 */
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_slli_epi32(__m128i a, int n) {
+    if (n > 31)
+        return _mm_setzero_si128();
+    return (__m128i)((simdcomp_u32x4)a << n);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_srli_epi32(__m128i a, int n) {
+    if (n > 31)
+        return _mm_setzero_si128();
+    return (__m128i)((simdcomp_u32x4)a >> n);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_srli_epi16(__m128i a, int n) {
+    if (n > 15)
+        return _mm_setzero_si128();
+    return (__m128i)((simdcomp_u16x8)a >> n);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_slli_epi64(__m128i a, int n) {
+    if (n > 63)
+        return _mm_setzero_si128();
+    return (__m128i)((simdcomp_u64x2)a << n);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_srli_epi64(__m128i a, int n) {
+    if (n > 63)
+        return _mm_setzero_si128();
+    return (__m128i)((simdcomp_u64x2)a >> n);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_cmplt_epi32(__m128i a, __m128i b) {
+    return (__m128i)(a < b);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_min_epu32(__m128i a, __m128i b) {
+    __m128i m = (__m128i)((simdcomp_u32x4)a < (simdcomp_u32x4)b);
+    return (a & m) | (b & ~m);
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_max_epu32(__m128i a, __m128i b) {
+    __m128i m = (__m128i)((simdcomp_u32x4)a > (simdcomp_u32x4)b);
+    return (a & m) | (b & ~m);
+}
+
+static SIMDCOMP_ALWAYS_INLINE int _mm_cvtsi128_si32(__m128i a) {
+    return a[0];
+}
+
+/* sign-extends the lower 4 bytes to 32 bits */
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_cvtepi8_epi32(__m128i a) {
+    simdcomp_s8x16 s = (simdcomp_s8x16)a;
+    __m128i r = {s[0], s[1], s[2], s[3]};
+    return r;
+}
+
+#define _mm_extract_epi32(a, imm) ((int)(a)[(imm) & 3])
+
+#define _mm_shuffle_epi32(a, imm) \
+    ((__m128i){(a)[(imm) & 3], (a)[((imm) >> 2) & 3], \
+               (a)[((imm) >> 4) & 3], (a)[((imm) >> 6) & 3]})
+
+/* byte shifts of the whole register; |imm| is a constant from 0 to 16 */
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_srli_si128(__m128i a, int imm) {
+    __m128i r = _mm_setzero_si128();
+    if (imm < 16)
+        memcpy(&r, (const uint8_t *)&a + imm, 16 - imm);
+    return r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_slli_si128(__m128i a, int imm) {
+    __m128i r = _mm_setzero_si128();
+    if (imm < 16)
+        memcpy((uint8_t *)&r + imm, &a, 16 - imm);
+    return r;
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128i _mm_shuffle_epi8(__m128i a, __m128i b) {
+#ifdef __aarch64__
+    /* vqtbl1q returns 0 for indices >= 16; SSE only looks at bit 7 and
+     * the lower 4 bits */
+    uint8x16_t idx = vandq_u8(vreinterpretq_u8_s32((int32x4_t)b),
+                    vdupq_n_u8(0x8F));
+    return (__m128i)vreinterpretq_s32_u8(
+                    vqtbl1q_u8(vreinterpretq_u8_s32((int32x4_t)a), idx));
+#else
+    simdcomp_u8x16 ua = (simdcomp_u8x16)a, ub = (simdcomp_u8x16)b, r;
+    int i;
+    for (i = 0; i < 16; i++)
+        r[i] = (ub[i] & 0x80) ? 0 : ua[ub[i] & 0x0F];
+    return (__m128i)r;
+#endif
+}
+
+static SIMDCOMP_ALWAYS_INLINE __m128 _mm_castsi128_ps(__m128i a) {
+    return (__m128)a;
+}
+
+static SIMDCOMP_ALWAYS_INLINE int _mm_movemask_ps(__m128 a) {
+    simdcomp_u32x4 s = (simdcomp_u32x4)a >> 31;
+    return (int)(s[0] | (s[1] << 1) | (s[2] << 2) | (s[3] << 3));
+}
+
+/* collects the top bit of each byte */
+static SIMDCOMP_ALWAYS_INLINE int _mm_movemask_epi8(__m128i a) {
+#ifdef __aarch64__
+    /* each byte becomes 0xFF or 0; keep one bit per byte position, then
+     * add up the bits of each half */
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                     1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t m = vandq_u8(vreinterpretq_u8_s8(
+                    vshrq_n_s8(vreinterpretq_s8_s32((int32x4_t)a), 7)),
+                    vld1q_u8(bits));
+    return (int)vaddv_u8(vget_low_u8(m))
+            | ((int)vaddv_u8(vget_high_u8(m)) << 8);
+#else
+    simdcomp_u8x16 s = (simdcomp_u8x16)a >> 7;
+    int i, r = 0;
+    for (i = 0; i < 16; i++)
+        r |= s[i] << i;
+    return r;
+#endif
+}
+
+#else
+# error "simdcomp requires SSE2 or a compiler with GCC vector extensions"
+#endif
+
+#endif /* SIMDINTRIN_H_ */
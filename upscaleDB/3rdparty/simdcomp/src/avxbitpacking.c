@@ -0,0 +1,565 @@
+/**
+ * This code is released under a BSD License.
+ */
+#include "avxbitpacking.h"
+#include "simdcomputil.h"
+
+/*
+ * The packed format is the same as the one of simdpack, but with 8 (AVX2)
+ * or 16 (AVX-512) interleaved lanes instead of 4: the integer at position
+ * i is stored in lane (i % lanes). Each lane holds 32 integers of "bit"
+ * bits, therefore a block occupies "bit" vectors.
+ *
+ * The kernels are written once and are specialized by the switch statements
+ * of the public functions; since they are always inlined, the compiler
+ * sees "bit" as a constant.
+ *
+ * The "d1" variants store the differences of successive integers (in the
+ * original order, not per lane), like simdpackd1. The differences are
+ * computed while packing, and the prefix sum is computed in the registers
+ * while unpacking. Each unpacked vector holds consecutive integers, so the
+ * search kernels compare it with the key and stop at the first match.
+ */
+
+#ifdef SIMDCOMP_AVX
+
+#define AVX2_TARGET   __attribute__((target("avx2")))
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+#define BIT_CASES(f) \
+    case 1: f(1); case 2: f(2); case 3: f(3); case 4: f(4); \
+    case 5: f(5); case 6: f(6); case 7: f(7); case 8: f(8); \
+    case 9: f(9); case 10: f(10); case 11: f(11); case 12: f(12); \
+    case 13: f(13); case 14: f(14); case 15: f(15); case 16: f(16); \
+    case 17: f(17); case 18: f(18); case 19: f(19); case 20: f(20); \
+    case 21: f(21); case 22: f(22); case 23: f(23); case 24: f(24); \
+    case 25: f(25); case 26: f(26); case 27: f(27); case 28: f(28); \
+    case 29: f(29); case 30: f(30); case 31: f(31); case 32: f(32)
+
+static uint32_t lowmask(const uint32_t bit) {
+    return bit >= 32 ? 0xFFFFFFFFU : (1U << bit) - 1;
+}
+
+/* scalar select; works for every lane count */
+static uint32_t select_lanes(const uint32_t * in, int slot,
+                const uint32_t bit, const int lanes) {
+    const uint32_t lane = (uint32_t)slot % lanes;
+    const uint32_t offset = ((uint32_t)slot / lanes) * bit;
+    const uint32_t word = offset / 32;
+    const uint32_t shift = offset % 32;
+    uint32_t value;
+
+    if (bit == 0)
+        return 0;
+    value = in[word * lanes + lane] >> shift;
+    if (shift + bit > 32)
+        value |= in[(word + 1) * lanes + lane] << (32 - shift);
+    return value & lowmask(bit);
+}
+
+/* AVX2 */
+
+/* returns the differences of the integers in "v"; "prev" holds the
+ * preceding integer in all lanes, and is updated */
+static SIMDCOMP_ALWAYS_INLINE AVX2_TARGET
+__m256i avxdelta(__m256i v, __m256i * prev) {
+    const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    __m256i shifted = _mm256_blend_epi32(
+                    _mm256_permutevar8x32_epi32(v, rotate), *prev, 0x01);
+    *prev = _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7));
+    return _mm256_sub_epi32(v, shifted);
+}
+
+/* returns the prefix sum of the integers in "v" plus "prev"; "prev" holds
+ * the preceding integer in all lanes, and is updated */
+static SIMDCOMP_ALWAYS_INLINE AVX2_TARGET
+__m256i avxprefixsum(__m256i v, __m256i * prev) {
+    __m256i low;
+    /* within each 128-bit half */
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+    /* carry the last integer of the lower half into the upper half */
+    low = _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(3));
+    v = _mm256_add_epi32(v,
+                    _mm256_blend_epi32(_mm256_setzero_si256(), low, 0xF0));
+    v = _mm256_add_epi32(v, *prev);
+    *prev = _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7));
+    return v;
+}
+
+static SIMDCOMP_ALWAYS_INLINE AVX2_TARGET
+void avxpack_kernel(const uint32_t * in, __m256i * out, const uint32_t bit,
+                const int masked, const int delta, uint32_t initvalue) {
+    const __m256i mask = _mm256_set1_epi32((int)lowmask(bit));
+    const __m256i *pin = (const __m256i *)in;
+    __m256i acc = _mm256_setzero_si256();
+    __m256i prev = _mm256_set1_epi32((int)initvalue);
+    uint32_t shift = 0;
+    int r;
+
+    for (r = 0; r < 32; ++r) {
+        __m256i v = _mm256_loadu_si256(pin + r);
+        if (delta)
+            v = avxdelta(v, &prev);
+        if (masked)
+            v = _mm256_and_si256(v, mask);
+        acc = _mm256_or_si256(acc, _mm256_slli_epi32(v, shift));
+        shift += bit;
+        if (shift >= 32) {
+            _mm256_storeu_si256(out++, acc);
+            shift -= 32;
+            acc = shift
+                    ? _mm256_srli_epi32(v, bit - shift)
+                    : _mm256_setzero_si256();
+        }
+    }
+}
+
+static SIMDCOMP_ALWAYS_INLINE AVX2_TARGET
+void avxunpack_kernel(const __m256i * in, uint32_t * out, const uint32_t bit,
+                const int delta, uint32_t initvalue) {
+    const __m256i mask = _mm256_set1_epi32((int)lowmask(bit));
+    __m256i *pout = (__m256i *)out;
+    __m256i prev = _mm256_set1_epi32((int)initvalue);
+    __m256i w = _mm256_loadu_si256(in);
+    uint32_t shift = 0;
+    int r;
+
+    for (r = 0; r < 32; ++r) {
+        __m256i v = _mm256_srli_epi32(w, shift);
+        shift += bit;
+        if (shift > 32) {
+            w = _mm256_loadu_si256(++in);
+            shift -= 32;
+            v = _mm256_or_si256(v, _mm256_slli_epi32(w, bit - shift));
+        }
+        else if (shift == 32) {
+            shift = 0;
+            if (r < 31)
+                w = _mm256_loadu_si256(++in);
+        }
+        if (bit < 32)
+            v = _mm256_and_si256(v, mask);
+        if (delta)
+            v = avxprefixsum(v, &prev);
+        _mm256_storeu_si256(pout + r, v);
+    }
+}
+
+/* decodes the vectors of a block like avxunpack_kernel (with "delta"), and
+ * returns the position of the first integer which is >= key */
+static SIMDCOMP_ALWAYS_INLINE AVX2_TARGET
+int avxsearch_kernel(const __m256i * in, const uint32_t bit,
+                uint32_t initvalue, uint32_t key, uint32_t * presult) {
+    const __m256i mask = _mm256_set1_epi32((int)lowmask(bit));
+    const __m256i key8 = _mm256_set1_epi32((int)key);
+    __m256i prev = _mm256_set1_epi32((int)initvalue);
+    __m256i w = _mm256_loadu_si256(in);
+    uint32_t shift = 0;
+    int r;
+
+    for (r = 0; r < 32; ++r) {
+        __m256i v = _mm256_srli_epi32(w, shift);
+        __m256i ge;
+        int m;
+        shift += bit;
+        if (shift > 32) {
+            w = _mm256_loadu_si256(++in);
+            shift -= 32;
+            v = _mm256_or_si256(v, _mm256_slli_epi32(w, bit - shift));
+        }
+        else if (shift == 32) {
+            shift = 0;
+            if (r < 31)
+                w = _mm256_loadu_si256(++in);
+        }
+        if (bit < 32)
+            v = _mm256_and_si256(v, mask);
+        v = avxprefixsum(v, &prev);
+        /* unsigned v >= key */
+        ge = _mm256_cmpeq_epi32(_mm256_max_epu32(v, key8), v);
+        m = _mm256_movemask_ps(_mm256_castsi256_ps(ge));
+        if (m) {
+            int offset;
+            SIMDCOMP_CTZ(offset, m);
+            *presult = (uint32_t)_mm256_cvtsi256_si32(
+                    _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(offset)));
+            return r * 8 + offset;
+        }
+    }
+    *presult = key + 1;
+    return AVXBlockSize;
+}
+
+AVX2_TARGET
+uint32_t avxmaxbits(const uint32_t * begin) {
+    const __m256i *pin = (const __m256i *)begin;
+    __m256i acc = _mm256_loadu_si256(pin);
+    __m128i half;
+    uint32_t k;
+
+    for (k = 1; 8 * k < AVXBlockSize; ++k)
+        acc = _mm256_or_si256(acc, _mm256_loadu_si256(pin + k));
+    half = _mm_or_si128(_mm256_castsi256_si128(acc),
+                    _mm256_extracti128_si256(acc, 1));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 8));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 4));
+    return bits((uint32_t)_mm_cvtsi128_si32(half));
+}
+
+AVX2_TARGET
+void avxpack(const uint32_t * in, __m256i * out, const uint32_t bit) {
+#define F(b) avxpack_kernel(in, out, b, 1, 0, 0); return
+    switch (bit) {
+        case 0: return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX2_TARGET
+void avxpackwithoutmask(const uint32_t * in, __m256i * out,
+                const uint32_t bit) {
+#define F(b) avxpack_kernel(in, out, b, 0, 0, 0); return
+    switch (bit) {
+        case 0: return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX2_TARGET
+void avxunpack(const __m256i * in, uint32_t * out, const uint32_t bit) {
+#define F(b) avxunpack_kernel(in, out, b, 0, 0); return
+    switch (bit) {
+        case 0: memset(out, 0, AVXBlockSize * sizeof(uint32_t)); return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+uint32_t avxselect(const __m256i * in, int slot, const uint32_t bit) {
+    return select_lanes((const uint32_t *)in, slot, bit, 8);
+}
+
+AVX2_TARGET
+uint32_t avxmaxbitsd1(uint32_t initvalue, const uint32_t * begin) {
+    const __m256i *pin = (const __m256i *)begin;
+    __m256i prev = _mm256_set1_epi32((int)initvalue);
+    __m256i acc = _mm256_setzero_si256();
+    __m128i half;
+    uint32_t k;
+
+    for (k = 0; 8 * k < AVXBlockSize; ++k)
+        acc = _mm256_or_si256(acc,
+                        avxdelta(_mm256_loadu_si256(pin + k), &prev));
+    half = _mm_or_si128(_mm256_castsi256_si128(acc),
+                    _mm256_extracti128_si256(acc, 1));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 8));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 4));
+    return bits((uint32_t)_mm_cvtsi128_si32(half));
+}
+
+AVX2_TARGET
+void avxpackd1(uint32_t initvalue, const uint32_t * in, __m256i * out,
+                const uint32_t bit) {
+#define F(b) avxpack_kernel(in, out, b, 1, 1, initvalue); return
+    switch (bit) {
+        case 0: return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX2_TARGET
+void avxunpackd1(uint32_t initvalue, const __m256i * in, uint32_t * out,
+                const uint32_t bit) {
+    const __m256i v = _mm256_set1_epi32((int)initvalue);
+    int r;
+#define F(b) avxunpack_kernel(in, out, b, 1, initvalue); return
+    switch (bit) {
+        case 0:
+            /* all differences are 0 */
+            for (r = 0; r < 32; ++r)
+                _mm256_storeu_si256((__m256i *)out + r, v);
+            return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX2_TARGET
+int avxsearchd1(uint32_t initvalue, const __m256i * in, uint32_t bit,
+                uint32_t key, uint32_t * presult) {
+#define F(b) return avxsearch_kernel(in, b, initvalue, key, presult)
+    switch (bit) {
+        case 0:
+            /* all integers are equal to "initvalue" */
+            if (initvalue >= key) {
+                *presult = initvalue;
+                return 0;
+            }
+            *presult = key + 1;
+            return AVXBlockSize;
+        BIT_CASES(F);
+        default: return -1;
+    }
+#undef F
+}
+
+/* AVX-512 */
+
+/* see avxdelta */
+static SIMDCOMP_ALWAYS_INLINE AVX512_TARGET
+__m512i avx512delta(__m512i v, __m512i * prev) {
+    __m512i shifted = _mm512_alignr_epi32(v, *prev, 15);
+    *prev = _mm512_permutexvar_epi32(_mm512_set1_epi32(15), v);
+    return _mm512_sub_epi32(v, shifted);
+}
+
+/* see avxprefixsum */
+static SIMDCOMP_ALWAYS_INLINE AVX512_TARGET
+__m512i avx512prefixsum(__m512i v, __m512i * prev) {
+    const __m512i zero = _mm512_setzero_si512();
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 15));
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 14));
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 12));
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 8));
+    v = _mm512_add_epi32(v, *prev);
+    *prev = _mm512_permutexvar_epi32(_mm512_set1_epi32(15), v);
+    return v;
+}
+
+static SIMDCOMP_ALWAYS_INLINE AVX512_TARGET
+void avx512pack_kernel(const uint32_t * in, __m512i * out, const uint32_t bit,
+                const int masked, const int delta, uint32_t initvalue) {
+    const __m512i mask = _mm512_set1_epi32((int)lowmask(bit));
+    __m512i acc = _mm512_setzero_si512();
+    __m512i prev = _mm512_set1_epi32((int)initvalue);
+    uint32_t shift = 0;
+    int r;
+
+    for (r = 0; r < 32; ++r) {
+        __m512i v = _mm512_loadu_si512(in + 16 * r);
+        if (delta)
+            v = avx512delta(v, &prev);
+        if (masked)
+            v = _mm512_and_si512(v, mask);
+        acc = _mm512_or_si512(acc, _mm512_slli_epi32(v, shift));
+        shift += bit;
+        if (shift >= 32) {
+            _mm512_storeu_si512(out++, acc);
+            shift -= 32;
+            acc = shift
+                    ? _mm512_srli_epi32(v, bit - shift)
+                    : _mm512_setzero_si512();
+        }
+    }
+}
+
+static SIMDCOMP_ALWAYS_INLINE AVX512_TARGET
+void avx512unpack_kernel(const __m512i * in, uint32_t * out,
+                const uint32_t bit, const int delta, uint32_t initvalue) {
+    const __m512i mask = _mm512_set1_epi32((int)lowmask(bit));
+    __m512i prev = _mm512_set1_epi32((int)initvalue);
+    __m512i w = _mm512_loadu_si512(in);
+    uint32_t shift = 0;
+    int r;
+
+    for (r = 0; r < 32; ++r) {
+        __m512i v = _mm512_srli_epi32(w, shift);
+        shift += bit;
+        if (shift > 32) {
+            w = _mm512_loadu_si512(++in);
+            shift -= 32;
+            v = _mm512_or_si512(v, _mm512_slli_epi32(w, bit - shift));
+        }
+        else if (shift == 32) {
+            shift = 0;
+            if (r < 31)
+                w = _mm512_loadu_si512(++in);
+        }
+        if (bit < 32)
+            v = _mm512_and_si512(v, mask);
+        if (delta)
+            v = avx512prefixsum(v, &prev);
+        _mm512_storeu_si512(out + 16 * r, v);
+    }
+}
+
+/* see avxsearch_kernel */
+static SIMDCOMP_ALWAYS_INLINE AVX512_TARGET
+int avx512search_kernel(const __m512i * in, const uint32_t bit,
+                uint32_t initvalue, uint32_t key, uint32_t * presult) {
+    const __m512i mask = _mm512_set1_epi32((int)lowmask(bit));
+    const __m512i key16 = _mm512_set1_epi32((int)key);
+    __m512i prev = _mm512_set1_epi32((int)initvalue);
+    __m512i w = _mm512_loadu_si512(in);
+    uint32_t shift = 0;
+    int r;
+
+    for (r = 0; r < 32; ++r) {
+        __m512i v = _mm512_srli_epi32(w, shift);
+        __mmask16 m;
+        shift += bit;
+        if (shift > 32) {
+            w = _mm512_loadu_si512(++in);
+            shift -= 32;
+            v = _mm512_or_si512(v, _mm512_slli_epi32(w, bit - shift));
+        }
+        else if (shift == 32) {
+            shift = 0;
+            if (r < 31)
+                w = _mm512_loadu_si512(++in);
+        }
+        if (bit < 32)
+            v = _mm512_and_si512(v, mask);
+        v = avx512prefixsum(v, &prev);
+        m = _mm512_cmpge_epu32_mask(v, key16);
+        if (m) {
+            int offset;
+            SIMDCOMP_CTZ(offset, (uint32_t)m);
+            *presult = (uint32_t)_mm_cvtsi128_si32(_mm512_castsi512_si128(
+                    _mm512_permutexvar_epi32(_mm512_set1_epi32(offset), v)));
+            return r * 16 + offset;
+        }
+    }
+    *presult = key + 1;
+    return AVX512BlockSize;
+}
+
+AVX512_TARGET
+uint32_t avx512maxbits(const uint32_t * begin) {
+    __m512i acc = _mm512_loadu_si512(begin);
+    uint32_t k;
+
+    for (k = 1; 16 * k < AVX512BlockSize; ++k)
+        acc = _mm512_or_si512(acc, _mm512_loadu_si512(begin + 16 * k));
+    return bits((uint32_t)_mm512_reduce_or_epi32(acc));
+}
+
+AVX512_TARGET
+void avx512pack(const uint32_t * in, __m512i * out, const uint32_t bit) {
+#define F(b) avx512pack_kernel(in, out, b, 1, 0, 0); return
+    switch (bit) {
+        case 0: return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX512_TARGET
+void avx512packwithoutmask(const uint32_t * in, __m512i * out,
+                const uint32_t bit) {
+#define F(b) avx512pack_kernel(in, out, b, 0, 0, 0); return
+    switch (bit) {
+        case 0: return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX512_TARGET
+void avx512unpack(const __m512i * in, uint32_t * out, const uint32_t bit) {
+#define F(b) avx512unpack_kernel(in, out, b, 0, 0); return
+    switch (bit) {
+        case 0: memset(out, 0, AVX512BlockSize * sizeof(uint32_t)); return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+uint32_t avx512select(const __m512i * in, int slot, const uint32_t bit) {
+    return select_lanes((const uint32_t *)in, slot, bit, 16);
+}
+
+AVX512_TARGET
+uint32_t avx512maxbitsd1(uint32_t initvalue, const uint32_t * begin) {
+    __m512i prev = _mm512_set1_epi32((int)initvalue);
+    __m512i acc = _mm512_setzero_si512();
+    uint32_t k;
+
+    for (k = 0; 16 * k < AVX512BlockSize; ++k)
+        acc = _mm512_or_si512(acc,
+                        avx512delta(_mm512_loadu_si512(begin + 16 * k), &prev));
+    return bits((uint32_t)_mm512_reduce_or_epi32(acc));
+}
+
+AVX512_TARGET
+void avx512packd1(uint32_t initvalue, const uint32_t * in, __m512i * out,
+                const uint32_t bit) {
+#define F(b) avx512pack_kernel(in, out, b, 1, 1, initvalue); return
+    switch (bit) {
+        case 0: return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX512_TARGET
+void avx512unpackd1(uint32_t initvalue, const __m512i * in, uint32_t * out,
+                const uint32_t bit) {
+    const __m512i v = _mm512_set1_epi32((int)initvalue);
+    int r;
+#define F(b) avx512unpack_kernel(in, out, b, 1, initvalue); return
+    switch (bit) {
+        case 0:
+            /* all differences are 0 */
+            for (r = 0; r < 32; ++r)
+                _mm512_storeu_si512(out + 16 * r, v);
+            return;
+        BIT_CASES(F);
+        default: return;
+    }
+#undef F
+}
+
+AVX512_TARGET
+int avx512searchd1(uint32_t initvalue, const __m512i * in, uint32_t bit,
+                uint32_t key, uint32_t * presult) {
+#define F(b) return avx512search_kernel(in, b, initvalue, key, presult)
+    switch (bit) {
+        case 0:
+            /* all integers are equal to "initvalue" */
+            if (initvalue >= key) {
+                *presult = initvalue;
+                return 0;
+            }
+            *presult = key + 1;
+            return AVX512BlockSize;
+        BIT_CASES(F);
+        default: return -1;
+    }
+#undef F
+}
+
+int avx2_available(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+int avx512_available(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+}
+
+#else /* !SIMDCOMP_AVX */
+
+int avx2_available(void) {
+    return 0;
+}
+
+int avx512_available(void) {
+    return 0;
+}
+
+#endif /* SIMDCOMP_AVX */
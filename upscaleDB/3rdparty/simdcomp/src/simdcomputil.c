@@ -3,7 +3,7 @@
  */
 
 #include "simdcomputil.h"
-#include <smmintrin.h>
+#include "simdintrin.h"
 #include <assert.h>
 
 #define Delta(curr, prev) \
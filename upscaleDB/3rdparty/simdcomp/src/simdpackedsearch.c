@@ -1,7 +1,7 @@
 /**
  * This code is released under a BSD License.
  */
-#include <smmintrin.h>
+#include "simdintrin.h"
 #include "simdintegratedbitpacking.h"
 
 
@@ -2,7 +2,7 @@
  * This code is released under a BSD License.
  */
 #include "simdintegratedbitpacking.h"
-#include <smmintrin.h>
+#include "simdintrin.h"
 
 
 SIMDCOMP_ALIGNED(16) int8_t shuffle_mask_bytes[256] = {
@@ -532,6 +532,209 @@ int test_simdpackedselect_advanced() {
 }
 
 
+#ifdef SIMDCOMP_AVX
+int testavxpack() {
+    uint32_t bit;
+    int i;
+    int result = 0;
+    uint32_t * data = malloc(AVX512BlockSize * sizeof(uint32_t));
+    uint32_t * backdata = malloc(AVX512BlockSize * sizeof(uint32_t));
+    uint32_t * buffer = malloc(AVX512BlockSize * sizeof(uint32_t));
+    srand(0);
+    for (bit = 0; bit <= 32; ++bit) {
+        const uint32_t mask = bit == 32 ? 0xFFFFFFFFU : (1U << bit) - 1;
+        for (i = 0; i < AVX512BlockSize; ++i)
+            data[i] = ((uint32_t)rand() ^ ((uint32_t)rand() << 16)) & mask;
+        if (bit > 0)
+            data[0] = mask; /* make sure that maxbits() returns |bit| */
+
+        if (avx2_available()) {
+            if (avxmaxbits(data) != bit) {
+                printf("bug in avxmaxbits\n");
+                result = -1;
+                goto cleanup;
+            }
+            memset(backdata, 0, AVXBlockSize * sizeof(uint32_t));
+            avxpack(data, (__m256i *) buffer, bit);
+            avxunpack((__m256i *) buffer, backdata, bit);
+            for (i = 0; i < AVXBlockSize; ++i) {
+                if (data[i] != backdata[i]) {
+                    printf("bug in avxpack/avxunpack\n");
+                    result = -2;
+                    goto cleanup;
+                }
+                if (avxselect((__m256i *) buffer, i, bit) != data[i]) {
+                    printf("bug in avxselect\n");
+                    result = -3;
+                    goto cleanup;
+                }
+            }
+        }
+
+        if (avx512_available()) {
+            if (avx512maxbits(data) != bit) {
+                printf("bug in avx512maxbits\n");
+                result = -4;
+                goto cleanup;
+            }
+            memset(backdata, 0, AVX512BlockSize * sizeof(uint32_t));
+            avx512pack(data, (__m512i *) buffer, bit);
+            avx512unpack((__m512i *) buffer, backdata, bit);
+            for (i = 0; i < AVX512BlockSize; ++i) {
+                if (data[i] != backdata[i]) {
+                    printf("bug in avx512pack/avx512unpack\n");
+                    result = -5;
+                    goto cleanup;
+                }
+                if (avx512select((__m512i *) buffer, i, bit) != data[i]) {
+                    printf("bug in avx512select\n");
+                    result = -6;
+                    goto cleanup;
+                }
+            }
+        }
+    }
+    printf("Code looks good.\n");
+cleanup:
+    free(data);
+    free(backdata);
+    free(buffer);
+    return result;
+}
+
+int testavxpackd1() {
+    uint32_t bit;
+    int i;
+    int result = 0;
+    const uint32_t initvalue = 1000;
+    uint32_t * data = malloc(AVX512BlockSize * sizeof(uint32_t));
+    uint32_t * backdata = malloc(AVX512BlockSize * sizeof(uint32_t));
+    uint32_t * buffer = malloc(AVX512BlockSize * sizeof(uint32_t));
+    srand(0);
+    for (bit = 0; bit <= 32; ++bit) {
+        const uint32_t mask = bit == 32 ? 0xFFFFFFFFU : (1U << bit) - 1;
+        /* sorted input; the differences have at most |bit| bits */
+        data[0] = initvalue + mask;
+        for (i = 1; i < AVX512BlockSize; ++i)
+            data[i] = data[i - 1]
+                    + (((uint32_t)rand() ^ ((uint32_t)rand() << 16)) & mask);
+
+        if (avx2_available()) {
+            if (avxmaxbitsd1(initvalue, data) != bit) {
+                printf("bug in avxmaxbitsd1\n");
+                result = -1;
+                goto cleanup;
+            }
+            memset(backdata, 0, AVXBlockSize * sizeof(uint32_t));
+            avxpackd1(initvalue, data, (__m256i *) buffer, bit);
+            avxunpackd1(initvalue, (__m256i *) buffer, backdata, bit);
+            for (i = 0; i < AVXBlockSize; ++i) {
+                if (data[i] != backdata[i]) {
+                    printf("bug in avxpackd1/avxunpackd1\n");
+                    result = -2;
+                    goto cleanup;
+                }
+            }
+        }
+
+        if (avx512_available()) {
+            if (avx512maxbitsd1(initvalue, data) != bit) {
+                printf("bug in avx512maxbitsd1\n");
+                result = -3;
+                goto cleanup;
+            }
+            memset(backdata, 0, AVX512BlockSize * sizeof(uint32_t));
+            avx512packd1(initvalue, data, (__m512i *) buffer, bit);
+            avx512unpackd1(initvalue, (__m512i *) buffer, backdata, bit);
+            for (i = 0; i < AVX512BlockSize; ++i) {
+                if (data[i] != backdata[i]) {
+                    printf("bug in avx512packd1/avx512unpackd1\n");
+                    result = -4;
+                    goto cleanup;
+                }
+            }
+        }
+    }
+    printf("Code looks good.\n");
+cleanup:
+    free(data);
+    free(backdata);
+    free(buffer);
+    return result;
+}
+
+/* returns the position of the first value >= key, like simdsearchd1 */
+static int lowerbound(const uint32_t * data, int length, uint32_t key,
+                uint32_t * presult) {
+    int i;
+    for (i = 0; i < length; ++i) {
+        if (data[i] >= key) {
+            *presult = data[i];
+            return i;
+        }
+    }
+    *presult = key + 1;
+    return length;
+}
+
+int testavxsearchd1() {
+    uint32_t bit;
+    int i;
+    int result = 0;
+    const uint32_t initvalue = 1000;
+    uint32_t * data = malloc(AVX512BlockSize * sizeof(uint32_t));
+    uint32_t * buffer = malloc(AVX512BlockSize * sizeof(uint32_t));
+    srand(0);
+    for (bit = 0; bit <= 32; ++bit) {
+        const uint32_t mask = bit == 32 ? 0xFFFFFFFFU : (1U << bit) - 1;
+        data[0] = initvalue + mask;
+        for (i = 1; i < AVX512BlockSize; ++i)
+            data[i] = data[i - 1]
+                    + (((uint32_t)rand() ^ ((uint32_t)rand() << 16)) & mask);
+
+        if (avx2_available()) {
+            avxpackd1(initvalue, data, (__m256i *) buffer, bit);
+            for (i = 0; i <= AVXBlockSize; ++i) {
+                /* the last key is larger than all values (unless it wraps) */
+                uint32_t key = i < AVXBlockSize
+                        ? data[i] : data[AVXBlockSize - 1] + 1;
+                uint32_t expected, found;
+                int pos = avxsearchd1(initvalue, (__m256i *) buffer, bit,
+                                key, &found);
+                if (pos != lowerbound(data, AVXBlockSize, key, &expected)
+                        || found != expected) {
+                    printf("bug in avxsearchd1\n");
+                    result = -1;
+                    goto cleanup;
+                }
+            }
+        }
+
+        if (avx512_available()) {
+            avx512packd1(initvalue, data, (__m512i *) buffer, bit);
+            for (i = 0; i <= AVX512BlockSize; ++i) {
+                uint32_t key = i < AVX512BlockSize
+                        ? data[i] : data[AVX512BlockSize - 1] + 1;
+                uint32_t expected, found;
+                int pos = avx512searchd1(initvalue, (__m512i *) buffer, bit,
+                                key, &found);
+                if (pos != lowerbound(data, AVX512BlockSize, key, &expected)
+                        || found != expected) {
+                    printf("bug in avx512searchd1\n");
+                    result = -2;
+                    goto cleanup;
+                }
+            }
+        }
+    }
+    printf("Code looks good.\n");
+cleanup:
+    free(data);
+    free(buffer);
+    return result;
+}
+#endif
+
 int main() {
     int r;
 
@@ -578,6 +781,20 @@ int main() {
     if (r)
         return r;
 
+#ifdef SIMDCOMP_AVX
+    r = testavxpack();
+    if (r)
+        return r;
+
+    r = testavxpackd1();
+    if (r)
+        return r;
+
+    r = testavxsearchd1();
+    if (r)
+        return r;
+#endif
+
 
     return 0;
 }
@@ -0,0 +1,575 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "streamvbyte.h"
+#include "svb_tables.h"
+
+#if defined(__SSSE3__)
+#  include <tmmintrin.h>
+#  define USE_SSSE3 1
+#endif
+
+/* returns the byte length - 1 of |v| */
+static inline uint32_t
+code_of(uint32_t v)
+{
+  if (v < (1u << 8))
+    return 0;
+  if (v < (1u << 16))
+    return 1;
+  if (v < (1u << 24))
+    return 2;
+  return 3;
+}
+
+static inline uint8_t *
+write_value(uint8_t *p, uint32_t v, uint32_t code)
+{
+  memcpy(p, &v, code + 1); /* little endian! */
+  return p + code + 1;
+}
+
+static inline uint32_t
+read_value(const uint8_t *p, uint32_t code)
+{
+  uint32_t v = 0;
+  memcpy(&v, p, code + 1); /* little endian! */
+  return v;
+}
+
+static inline uint32_t
+code_at(uint8_t key, uint32_t i)
+{
+  return (key >> (2 * (i & 3))) & 3;
+}
+
+static inline uint32_t
+key_bytes(uint32_t length)
+{
+  return (length + 3) / 4;
+}
+
+#ifdef USE_SSSE3
+/* decodes the four integers of |key| at |data| */
+static inline __m128i
+decode_quad(uint8_t key, const uint8_t *data)
+{
+  __m128i v = _mm_loadu_si128((const __m128i *)data);
+  return _mm_shuffle_epi8(v,
+                  _mm_loadu_si128((const __m128i *)svb_shuffle_table[key]));
+}
+
+/* computes the prefix sum of the four deltas in |v|, starting at
+ * |previous| (which is broadcast to all lanes) */
+static inline __m128i
+prefix_sum(__m128i v, __m128i previous)
+{
+  v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+  v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+  return _mm_add_epi32(v, previous);
+}
+#endif
+
+/*
+ * StreamVByte
+ */
+
+size_t
+streamvbyte_max_compressed_size(uint32_t length)
+{
+  return key_bytes(length) + (size_t)length * 4;
+}
+
+static inline size_t
+svb_compressed_size(const uint32_t *in, uint32_t length, uint32_t previous,
+                int delta)
+{
+  size_t size = key_bytes(length);
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    size += code_of(delta ? in[i] - previous : in[i]) + 1;
+    previous = in[i];
+  }
+  return size;
+}
+
+static inline size_t
+svb_compress(const uint32_t *in, uint8_t *out, uint32_t previous,
+                uint32_t length, int delta)
+{
+  uint8_t *key = out;
+  uint8_t *data = out + key_bytes(length);
+  uint32_t i;
+
+  memset(key, 0, key_bytes(length));
+  for (i = 0; i < length; i++) {
+    uint32_t v = delta ? in[i] - previous : in[i];
+    uint32_t code = code_of(v);
+    key[i / 4] |= (uint8_t)(code << (2 * (i & 3)));
+    data = write_value(data, v, code);
+    previous = in[i];
+  }
+  return data - out;
+}
+
+static inline size_t
+svb_uncompress(const uint8_t *in, uint32_t *out, uint32_t previous,
+                uint32_t length, int delta)
+{
+  const uint8_t *key = in;
+  const uint8_t *data = in + key_bytes(length);
+  uint32_t i = 0;
+
+#ifdef USE_SSSE3
+  /* each quad has at least four data bytes; the 16 byte loads therefore
+   * stay within the stream as long as three more quads follow */
+  if (length >= 16) {
+    uint32_t quads = length / 4 - 3;
+    uint32_t q;
+    __m128i prev = _mm_set1_epi32((int)previous);
+
+    for (q = 0; q < quads; q++) {
+      __m128i v = decode_quad(key[q], data);
+      if (delta) {
+        v = prefix_sum(v, prev);
+        prev = _mm_shuffle_epi32(v, 0xff);
+      }
+      _mm_storeu_si128((__m128i *)(out + 4 * q), v);
+      data += svb_length_table[key[q]];
+    }
+    i = quads * 4;
+    previous = (uint32_t)_mm_cvtsi128_si32(prev);
+  }
+#endif
+
+  for (; i < length; i++) {
+    uint32_t code = code_at(key[i / 4], i);
+    uint32_t v = read_value(data, code);
+    data += code + 1;
+    if (delta)
+      v = previous += v;
+    out[i] = v;
+  }
+  return data - in;
+}
+
+/* returns a pointer to the data of the integer at |index| */
+static inline const uint8_t *
+svb_seek(const uint8_t *in, uint32_t length, uint32_t index)
+{
+  const uint8_t *key = in;
+  const uint8_t *data = in + key_bytes(length);
+  uint32_t q, i;
+
+  for (q = 0; q < index / 4; q++)
+    data += svb_length_table[key[q]];
+  for (i = q * 4; i < index; i++)
+    data += code_at(key[q], i) + 1;
+  return data;
+}
+
+size_t
+streamvbyte_compressed_size_unsorted(const uint32_t *in, uint32_t length)
+{
+  return svb_compressed_size(in, length, 0, 0);
+}
+
+size_t
+streamvbyte_compressed_size_sorted(const uint32_t *in, uint32_t length,
+                uint32_t previous)
+{
+  return svb_compressed_size(in, length, previous, 1);
+}
+
+size_t
+streamvbyte_compress_unsorted(const uint32_t *in, uint8_t *out,
+                uint32_t length)
+{
+  return svb_compress(in, out, 0, length, 0);
+}
+
+size_t
+streamvbyte_compress_sorted(const uint32_t *in, uint8_t *out,
+                uint32_t previous, uint32_t length)
+{
+  return svb_compress(in, out, previous, length, 1);
+}
+
+size_t
+streamvbyte_uncompress_unsorted(const uint8_t *in, uint32_t *out,
+                uint32_t length)
+{
+  return svb_uncompress(in, out, 0, length, 0);
+}
+
+size_t
+streamvbyte_uncompress_sorted(const uint8_t *in, uint32_t *out,
+                uint32_t previous, uint32_t length)
+{
+  return svb_uncompress(in, out, previous, length, 1);
+}
+
+uint32_t
+streamvbyte_select_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t index)
+{
+  assert(index < length);
+  return read_value(svb_seek(in, length, index),
+                  code_at(in[index / 4], index));
+}
+
+uint32_t
+streamvbyte_select_sorted(const uint8_t *in, uint32_t length,
+                uint32_t previous, uint32_t index)
+{
+  const uint8_t *key = in;
+  const uint8_t *data = in + key_bytes(length);
+  uint32_t i;
+
+  assert(index < length);
+  for (i = 0; i <= index; i++) {
+    uint32_t code = code_at(key[i / 4], i);
+    previous += read_value(data, code);
+    data += code + 1;
+  }
+  return previous;
+}
+
+uint32_t
+streamvbyte_search_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t value)
+{
+  const uint8_t *key = in;
+  const uint8_t *data = in + key_bytes(length);
+  uint32_t i = 0;
+
+#ifdef USE_SSSE3
+  if (length >= 16) {
+    uint32_t quads = length / 4 - 3;
+    uint32_t q;
+    __m128i needle = _mm_set1_epi32((int)value);
+
+    for (q = 0; q < quads; q++) {
+      __m128i v = decode_quad(key[q], data);
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v,
+                              needle)));
+      if (mask) {
+        for (i = 0; (mask & (1 << i)) == 0; i++)
+          ;
+        return q * 4 + i;
+      }
+      data += svb_length_table[key[q]];
+    }
+    i = quads * 4;
+  }
+#endif
+
+  for (; i < length; i++) {
+    uint32_t code = code_at(key[i / 4], i);
+    if (read_value(data, code) == value)
+      return i;
+    data += code + 1;
+  }
+  return length;
+}
+
+uint32_t
+streamvbyte_search_lower_bound_sorted(const uint8_t *in, uint32_t length,
+                uint32_t value, uint32_t previous, uint32_t *actual)
+{
+  const uint8_t *key = in;
+  const uint8_t *data = in + key_bytes(length);
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    uint32_t code = code_at(key[i / 4], i);
+    previous += read_value(data, code);
+    if (previous >= value) {
+      *actual = previous;
+      return i;
+    }
+    data += code + 1;
+  }
+  return length;
+}
+
+size_t
+streamvbyte_append_unsorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t value)
+{
+  uint32_t code = code_of(value);
+
+  /* a new key byte is required */
+  if ((length & 3) == 0) {
+    uint32_t keys = key_bytes(length);
+    memmove(in + keys + 1, in + keys, size - keys);
+    in[keys] = 0;
+    size++;
+  }
+
+  in[length / 4] |= (uint8_t)(code << (2 * (length & 3)));
+  write_value(in + size, value, code);
+  return size + code + 1;
+}
+
+size_t
+streamvbyte_append_sorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t previous, uint32_t value)
+{
+  assert(length == 0 || value > previous);
+  return streamvbyte_append_unsorted(in, length, size, value - previous);
+}
+
+/*
+ * GroupVarint
+ */
+
+static inline size_t
+gv_compressed_size(const uint32_t *in, uint32_t length, uint32_t previous,
+                int delta)
+{
+  return svb_compressed_size(in, length, previous, delta);
+}
+
+static inline size_t
+gv_compress(const uint32_t *in, uint8_t *out, uint32_t previous,
+                uint32_t length, int delta)
+{
+  uint8_t *p = out;
+  uint8_t *key = 0;
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    uint32_t v = delta ? in[i] - previous : in[i];
+    uint32_t code = code_of(v);
+    if ((i & 3) == 0) {
+      key = p++;
+      *key = 0;
+    }
+    *key |= (uint8_t)(code << (2 * (i & 3)));
+    p = write_value(p, v, code);
+    previous = in[i];
+  }
+  return p - out;
+}
+
+static inline size_t
+gv_uncompress(const uint8_t *in, uint32_t *out, uint32_t previous,
+                uint32_t length, int delta)
+{
+  const uint8_t *p = in;
+  uint32_t i = 0;
+
+#ifdef USE_SSSE3
+  /* each group has at least five bytes; the 16 byte loads therefore
+   * stay within the stream as long as three more groups follow */
+  if (length >= 16) {
+    uint32_t groups = length / 4 - 3;
+    uint32_t g;
+    __m128i prev = _mm_set1_epi32((int)previous);
+
+    for (g = 0; g < groups; g++) {
+      __m128i v = decode_quad(*p, p + 1);
+      if (delta) {
+        v = prefix_sum(v, prev);
+        prev = _mm_shuffle_epi32(v, 0xff);
+      }
+      _mm_storeu_si128((__m128i *)(out + 4 * g), v);
+      p += 1 + svb_length_table[*p];
+    }
+    i = groups * 4;
+    previous = (uint32_t)_mm_cvtsi128_si32(prev);
+  }
+#endif
+
+  for (; i < length; i += 4) {
+    uint8_t key = *p++;
+    uint32_t j;
+    for (j = i; j < i + 4 && j < length; j++) {
+      uint32_t code = code_at(key, j);
+      uint32_t v = read_value(p, code);
+      p += code + 1;
+      if (delta)
+        v = previous += v;
+      out[j] = v;
+    }
+  }
+  return p - in;
+}
+
+/* returns a pointer to the key byte of the group of |index| */
+static inline const uint8_t *
+gv_seek_group(const uint8_t *in, uint32_t index)
+{
+  const uint8_t *p = in;
+  uint32_t g;
+
+  for (g = 0; g < index / 4; g++)
+    p += 1 + svb_length_table[*p];
+  return p;
+}
+
+size_t
+groupvarint_compressed_size_unsorted(const uint32_t *in, uint32_t length)
+{
+  return gv_compressed_size(in, length, 0, 0);
+}
+
+size_t
+groupvarint_compressed_size_sorted(const uint32_t *in, uint32_t length,
+                uint32_t previous)
+{
+  return gv_compressed_size(in, length, previous, 1);
+}
+
+size_t
+groupvarint_compress_unsorted(const uint32_t *in, uint8_t *out,
+                uint32_t length)
+{
+  return gv_compress(in, out, 0, length, 0);
+}
+
+size_t
+groupvarint_compress_sorted(const uint32_t *in, uint8_t *out,
+                uint32_t previous, uint32_t length)
+{
+  return gv_compress(in, out, previous, length, 1);
+}
+
+size_t
+groupvarint_uncompress_unsorted(const uint8_t *in, uint32_t *out,
+                uint32_t length)
+{
+  return gv_uncompress(in, out, 0, length, 0);
+}
+
+size_t
+groupvarint_uncompress_sorted(const uint8_t *in, uint32_t *out,
+                uint32_t previous, uint32_t length)
+{
+  return gv_uncompress(in, out, previous, length, 1);
+}
+
+uint32_t
+groupvarint_select_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t index)
+{
+  const uint8_t *p = gv_seek_group(in, index);
+  uint8_t key = *p++;
+  uint32_t i;
+
+  assert(index < length);
+  (void)length;
+  for (i = index & ~3u; i < index; i++)
+    p += code_at(key, i) + 1;
+  return read_value(p, code_at(key, index));
+}
+
+uint32_t
+groupvarint_select_sorted(const uint8_t *in, uint32_t length,
+                uint32_t previous, uint32_t index)
+{
+  const uint8_t *p = in;
+  uint8_t key = 0;
+  uint32_t i;
+
+  assert(index < length);
+  (void)length;
+  for (i = 0; i <= index; i++) {
+    uint32_t code;
+    if ((i & 3) == 0)
+      key = *p++;
+    code = code_at(key, i);
+    previous += read_value(p, code);
+    p += code + 1;
+  }
+  return previous;
+}
+
+uint32_t
+groupvarint_search_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t value)
+{
+  const uint8_t *p = in;
+  uint8_t key = 0;
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    uint32_t code;
+    if ((i & 3) == 0)
+      key = *p++;
+    code = code_at(key, i);
+    if (read_value(p, code) == value)
+      return i;
+    p += code + 1;
+  }
+  return length;
+}
+
+uint32_t
+groupvarint_search_lower_bound_sorted(const uint8_t *in, uint32_t length,
+                uint32_t value, uint32_t previous, uint32_t *actual)
+{
+  const uint8_t *p = in;
+  uint8_t key = 0;
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    uint32_t code;
+    if ((i & 3) == 0)
+      key = *p++;
+    code = code_at(key, i);
+    previous += read_value(p, code);
+    if (previous >= value) {
+      *actual = previous;
+      return i;
+    }
+    p += code + 1;
+  }
+  return length;
+}
+
+size_t
+groupvarint_append_unsorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t value)
+{
+  uint32_t code = code_of(value);
+
+  /* start a new group? */
+  if ((length & 3) == 0) {
+    in[size] = (uint8_t)code;
+    write_value(in + size + 1, value, code);
+    return size + code + 2;
+  }
+
+  /* otherwise update the key byte of the last group */
+  *(uint8_t *)gv_seek_group(in, length) |=
+          (uint8_t)(code << (2 * (length & 3)));
+  write_value(in + size, value, code);
+  return size + code + 1;
+}
+
+size_t
+groupvarint_append_sorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t previous, uint32_t value)
+{
+  assert(length == 0 || value > previous);
+  return groupvarint_append_unsorted(in, length, size, value - previous);
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Implementations of the StreamVByte and GroupVarint encodings for 32bit
+ * integers, with SSSE3-accelerated decoding.
+ *
+ * Both encodings store the byte lengths of four integers in a "key" byte.
+ * StreamVByte stores all key bytes at the beginning of the stream, followed
+ * by the data bytes: a stream of |length| integers starts with
+ * (|length| + 3) / 4 key bytes. GroupVarint stores groups of one key byte
+ * followed by the data bytes of (up to) four integers.
+ *
+ * The interface follows vbyte.h. The "sorted" functions use delta encoding;
+ * |previous| is the value preceding the first encoded integer.
+ *
+ * Decoding never reads beyond the compressed data. All functions assume
+ * a little-endian CPU.
+ *
+ * See the README.md file for more information.
+ */
+
+#ifndef STREAMVBYTE_H_96c2e1a4_6f0b_4d5c_8f7e_1b3a9d2c4e60
+#define STREAMVBYTE_H_96c2e1a4_6f0b_4d5c_8f7e_1b3a9d2c4e60
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Returns the maximum size (in bytes) of a compressed stream of |length|
+ * integers. This is the same for StreamVByte and GroupVarint.
+ */
+extern size_t
+streamvbyte_max_compressed_size(uint32_t length);
+
+/**
+ * Calculates the size (in bytes) of a compressed stream of unsorted 32bit
+ * integers.
+ */
+extern size_t
+streamvbyte_compressed_size_unsorted(const uint32_t *in, uint32_t length);
+
+/**
+ * Calculates the size (in bytes) of a compressed stream of sorted 32bit
+ * integers.
+ *
+ * This function uses delta encoding.
+ */
+extern size_t
+streamvbyte_compressed_size_sorted(const uint32_t *in, uint32_t length,
+                uint32_t previous);
+
+/**
+ * Compresses an unsorted sequence of |length| 32bit unsigned integers
+ * at |in| and stores the result in |out|.
+ *
+ * Returns the number of compressed bytes.
+ */
+extern size_t
+streamvbyte_compress_unsorted(const uint32_t *in, uint8_t *out,
+                uint32_t length);
+
+/**
+ * Compresses a sorted sequence of |length| 32bit unsigned integers
+ * at |in| and stores the result in |out|.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the number of compressed bytes.
+ */
+extern size_t
+streamvbyte_compress_sorted(const uint32_t *in, uint8_t *out,
+                uint32_t previous, uint32_t length);
+
+/**
+ * Uncompresses a sequence of |length| 32bit unsigned integers at |in|
+ * and stores the result in |out|.
+ *
+ * Returns the number of compressed bytes processed.
+ */
+extern size_t
+streamvbyte_uncompress_unsorted(const uint8_t *in, uint32_t *out,
+                uint32_t length);
+
+/**
+ * Uncompresses a sequence of |length| 32bit unsigned integers at |in|
+ * and stores the result in |out|.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the number of compressed bytes processed.
+ */
+extern size_t
+streamvbyte_uncompress_sorted(const uint8_t *in, uint32_t *out,
+                uint32_t previous, uint32_t length);
+
+/**
+ * Returns the value at the given |index| from a compressed sequence of
+ * |length| integers.
+ *
+ * Skips whole key bytes with a lookup table, therefore the cost is
+ * |index| / 4 table lookups.
+ */
+extern uint32_t
+streamvbyte_select_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t index);
+
+/**
+ * Returns the value at the given |index| from a compressed sequence of
+ * |length| integers.
+ *
+ * This function uses delta encoding.
+ */
+extern uint32_t
+streamvbyte_select_sorted(const uint8_t *in, uint32_t length,
+                uint32_t previous, uint32_t index);
+
+/**
+ * Performs a linear search for |value| in a compressed sequence of |length|
+ * integers.
+ *
+ * Returns the index of the found element, or |length| if the key was not
+ * found.
+ */
+extern uint32_t
+streamvbyte_search_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t value);
+
+/**
+ * Performs a lower-bound search for |value| in a compressed sequence of
+ * |length| integers. The actual result is stored in |*actual|.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the index of the found element, or |length| if the key was not
+ * found.
+ */
+extern uint32_t
+streamvbyte_search_lower_bound_sorted(const uint8_t *in, uint32_t length,
+                uint32_t value, uint32_t previous, uint32_t *actual);
+
+/**
+ * Appends |value| to a compressed sequence of |length| integers with
+ * |size| bytes.
+ *
+ * If |length| is a multiple of 4 then a new key byte is required, and the
+ * data bytes are moved by one byte.
+ *
+ * Returns the new size of the compressed sequence.
+ */
+extern size_t
+streamvbyte_append_unsorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t value);
+
+/**
+ * Appends |value| to a compressed sequence of |length| integers with
+ * |size| bytes. |previous| is the greatest encoded value in the sequence.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the new size of the compressed sequence.
+ */
+extern size_t
+streamvbyte_append_sorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t previous, uint32_t value);
+
+
+/**
+ * GroupVarint: calculates the size (in bytes) of a compressed stream of
+ * unsorted 32bit integers.
+ */
+extern size_t
+groupvarint_compressed_size_unsorted(const uint32_t *in, uint32_t length);
+
+/**
+ * GroupVarint: calculates the size (in bytes) of a compressed stream of
+ * sorted 32bit integers.
+ *
+ * This function uses delta encoding.
+ */
+extern size_t
+groupvarint_compressed_size_sorted(const uint32_t *in, uint32_t length,
+                uint32_t previous);
+
+/**
+ * GroupVarint: compresses an unsorted sequence of |length| 32bit unsigned
+ * integers at |in| and stores the result in |out|.
+ *
+ * Returns the number of compressed bytes.
+ */
+extern size_t
+groupvarint_compress_unsorted(const uint32_t *in, uint8_t *out,
+                uint32_t length);
+
+/**
+ * GroupVarint: compresses a sorted sequence of |length| 32bit unsigned
+ * integers at |in| and stores the result in |out|.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the number of compressed bytes.
+ */
+extern size_t
+groupvarint_compress_sorted(const uint32_t *in, uint8_t *out,
+                uint32_t previous, uint32_t length);
+
+/**
+ * GroupVarint: uncompresses a sequence of |length| 32bit unsigned
+ * integers at |in| and stores the result in |out|.
+ *
+ * Returns the number of compressed bytes processed.
+ */
+extern size_t
+groupvarint_uncompress_unsorted(const uint8_t *in, uint32_t *out,
+                uint32_t length);
+
+/**
+ * GroupVarint: uncompresses a sequence of |length| 32bit unsigned
+ * integers at |in| and stores the result in |out|.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the number of compressed bytes processed.
+ */
+extern size_t
+groupvarint_uncompress_sorted(const uint8_t *in, uint32_t *out,
+                uint32_t previous, uint32_t length);
+
+/**
+ * GroupVarint: returns the value at the given |index| from a compressed
+ * sequence of |length| integers.
+ */
+extern uint32_t
+groupvarint_select_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t index);
+
+/**
+ * GroupVarint: returns the value at the given |index| from a compressed
+ * sequence of |length| integers.
+ *
+ * This function uses delta encoding.
+ */
+extern uint32_t
+groupvarint_select_sorted(const uint8_t *in, uint32_t length,
+                uint32_t previous, uint32_t index);
+
+/**
+ * GroupVarint: performs a linear search for |value| in a compressed
+ * sequence of |length| integers.
+ *
+ * Returns the index of the found element, or |length| if the key was not
+ * found.
+ */
+extern uint32_t
+groupvarint_search_unsorted(const uint8_t *in, uint32_t length,
+                uint32_t value);
+
+/**
+ * GroupVarint: performs a lower-bound search for |value| in a compressed
+ * sequence of |length| integers. The actual result is stored in |*actual|.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the index of the found element, or |length| if the key was not
+ * found.
+ */
+extern uint32_t
+groupvarint_search_lower_bound_sorted(const uint8_t *in, uint32_t length,
+                uint32_t value, uint32_t previous, uint32_t *actual);
+
+/**
+ * GroupVarint: appends |value| to a compressed sequence of |length|
+ * integers with |size| bytes.
+ *
+ * Returns the new size of the compressed sequence.
+ */
+extern size_t
+groupvarint_append_unsorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t value);
+
+/**
+ * GroupVarint: appends |value| to a compressed sequence of |length|
+ * integers with |size| bytes. |previous| is the greatest encoded value
+ * in the sequence.
+ *
+ * This function uses delta encoding.
+ *
+ * Returns the new size of the compressed sequence.
+ */
+extern size_t
+groupvarint_append_sorted(uint8_t *in, uint32_t length, size_t size,
+                uint32_t previous, uint32_t value);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* STREAMVBYTE_H_96c2e1a4_6f0b_4d5c_8f7e_1b3a9d2c4e60 */
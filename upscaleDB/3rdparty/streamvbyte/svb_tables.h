@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Lookup tables which are shared by StreamVByte and GroupVarint. Both
+ * codecs store the byte lengths of four integers in one "key" byte (two bits
+ * per integer, storing the length - 1).
+ *
+ * Generated code - do not modify.
+ */
+
+#ifndef SVB_TABLES_H_4eab1d6e_2c7b_4f0e_9d3a_63c1f6b0a5e2
+#define SVB_TABLES_H_4eab1d6e_2c7b_4f0e_9d3a_63c1f6b0a5e2
+
+#include <stdint.h>
+
+/* the total number of data bytes of the four integers of a key byte */
+static const uint8_t svb_length_table[256] = {
+   4,  5,  6,  7,  5,  6,  7,  8,  6,  7,  8,  9,  7,  8,  9, 10,
+   5,  6,  7,  8,  6,  7,  8,  9,  7,  8,  9, 10,  8,  9, 10, 11,
+   6,  7,  8,  9,  7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12,
+   7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13,
+   5,  6,  7,  8,  6,  7,  8,  9,  7,  8,  9, 10,  8,  9, 10, 11,
+   6,  7,  8,  9,  7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12,
+   7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13,
+   8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+   6,  7,  8,  9,  7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12,
+   7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13,
+   8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+   9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15,
+   7,  8,  9, 10,  8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13,
+   8,  9, 10, 11,  9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+   9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15,
+  10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16
+};
+
+/* pshufb masks which expand the data bytes of a key byte to four
+ * 32bit integers; 255 clears the target byte */
+static const uint8_t svb_shuffle_table[256][16] = {
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 255, 255, 255, 3, 255, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 255, 255, 255, 4, 255, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 255, 255, 255, 5, 255, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 255, 255, 255, 6, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 255, 255, 255, 4, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 255, 255, 255, 5, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 255, 255, 255, 6, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 255, 255, 255, 7, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 255, 255, 255, 5, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 255, 255, 255, 6, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 255, 255, 255, 7, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 255, 255, 255, 8, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 255, 255, 255, 6, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 255, 255, 255, 7, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 255, 255, 255, 8, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 255, 255, 255, 9, 255, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 255, 255, 4, 255, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 255, 255, 5, 255, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 255, 255, 6, 255, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 255, 255, 7, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 255, 255, 5, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 255, 255, 6, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 255, 255, 7, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 255, 255, 8, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 255, 255, 6, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 255, 255, 7, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 255, 255, 8, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 255, 255, 9, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 255, 255, 7, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 255, 255, 8, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 255, 255, 9, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 255, 255, 10, 255, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 255, 5, 255, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 255, 6, 255, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 255, 7, 255, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 255, 8, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 255, 6, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 255, 7, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 255, 8, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 255, 9, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 255, 7, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 255, 8, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 255, 10, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 255, 8, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 255, 9, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 255, 10, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 255, 11, 255, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 5, 6, 255, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 6, 7, 255, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 7, 8, 255, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 8, 9, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 6, 7, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 7, 8, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 8, 9, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 9, 10, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 7, 8, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 8, 9, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 9, 10, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 10, 11, 255, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 8, 9, 255, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 9, 10, 255, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 10, 11, 255, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 255, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 255, 255, 255, 3, 4, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 255, 255, 255, 4, 5, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 255, 255, 255, 5, 6, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 255, 255, 255, 6, 7, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 255, 255, 255, 4, 5, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 255, 255, 255, 5, 6, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 255, 255, 255, 6, 7, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 255, 255, 255, 7, 8, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 255, 255, 255, 5, 6, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 255, 255, 255, 6, 7, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 255, 255, 255, 7, 8, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 255, 255, 255, 8, 9, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 255, 255, 255, 6, 7, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 255, 255, 255, 7, 8, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 255, 255, 255, 8, 9, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 255, 255, 255, 9, 10, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 255, 255, 4, 5, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 255, 255, 5, 6, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 255, 255, 6, 7, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 255, 255, 7, 8, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 255, 255, 5, 6, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 255, 255, 6, 7, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 255, 255, 7, 8, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 255, 255, 8, 9, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 255, 255, 6, 7, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 255, 255, 7, 8, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 255, 255, 8, 9, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 255, 255, 9, 10, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 255, 255, 7, 8, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 255, 255, 8, 9, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 255, 255, 9, 10, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 255, 255, 10, 11, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 255, 5, 6, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 255, 6, 7, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 255, 7, 8, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 255, 8, 9, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 255, 6, 7, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 255, 7, 8, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 255, 8, 9, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 255, 9, 10, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 255, 7, 8, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 255, 8, 9, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 255, 10, 11, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 255, 8, 9, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 255, 9, 10, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 255, 10, 11, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 255, 11, 12, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 5, 6, 7, 255, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 6, 7, 8, 255, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 7, 8, 9, 255, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 8, 9, 10, 255, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 6, 7, 8, 255, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 7, 8, 9, 255, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 8, 9, 10, 255, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 9, 10, 11, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 7, 8, 9, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 8, 9, 10, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 9, 10, 11, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 10, 11, 12, 255, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 255, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 255, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 255, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 255, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 255, 255, 255, 3, 4, 5, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 255, 255, 255, 4, 5, 6, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 255, 255, 255, 5, 6, 7, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 255, 255, 255, 6, 7, 8, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 255, 255, 255, 4, 5, 6, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 255, 255, 255, 5, 6, 7, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 255, 255, 255, 6, 7, 8, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 255, 255, 255, 7, 8, 9, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 255, 255, 255, 5, 6, 7, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 255, 255, 255, 6, 7, 8, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 255, 255, 255, 7, 8, 9, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 255, 255, 255, 8, 9, 10, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 255, 255, 255, 6, 7, 8, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 255, 255, 255, 7, 8, 9, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 255, 255, 255, 8, 9, 10, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 255, 255, 255, 9, 10, 11, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 255, 255, 4, 5, 6, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 255, 255, 5, 6, 7, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 255, 255, 6, 7, 8, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 255, 255, 7, 8, 9, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 255, 255, 5, 6, 7, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 255, 255, 6, 7, 8, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 255, 255, 7, 8, 9, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 255, 255, 8, 9, 10, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 255, 255, 6, 7, 8, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 255, 255, 7, 8, 9, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 255, 255, 8, 9, 10, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 255, 255, 9, 10, 11, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 255, 255, 7, 8, 9, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 255, 255, 8, 9, 10, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 255, 255, 9, 10, 11, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 255, 255, 10, 11, 12, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 255, 5, 6, 7, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 255, 6, 7, 8, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 255, 7, 8, 9, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 255, 8, 9, 10, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 255, 6, 7, 8, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 255, 7, 8, 9, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 255, 8, 9, 10, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 255, 9, 10, 11, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 255, 7, 8, 9, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 255, 8, 9, 10, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 11, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 255, 10, 11, 12, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 255, 8, 9, 10, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 255, 9, 10, 11, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 255, 10, 11, 12, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 255, 11, 12, 13, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 5, 6, 7, 8, 255},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 6, 7, 8, 9, 255},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 7, 8, 9, 10, 255},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 8, 9, 10, 11, 255},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 6, 7, 8, 9, 255},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 7, 8, 9, 10, 255},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 8, 9, 10, 11, 255},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 9, 10, 11, 12, 255},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 7, 8, 9, 10, 255},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 8, 9, 10, 11, 255},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 9, 10, 11, 12, 255},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 10, 11, 12, 13, 255},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 255},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 255},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 255},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 255},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 255, 255, 255, 3, 4, 5, 6},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 255, 255, 255, 4, 5, 6, 7},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 255, 255, 255, 5, 6, 7, 8},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 255, 255, 255, 6, 7, 8, 9},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 255, 255, 255, 4, 5, 6, 7},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 255, 255, 255, 5, 6, 7, 8},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 255, 255, 255, 6, 7, 8, 9},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 255, 255, 255, 7, 8, 9, 10},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 255, 255, 255, 5, 6, 7, 8},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 255, 255, 255, 6, 7, 8, 9},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 255, 255, 255, 7, 8, 9, 10},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 255, 255, 255, 8, 9, 10, 11},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 255, 255, 255, 6, 7, 8, 9},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 255, 255, 255, 7, 8, 9, 10},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 255, 255, 255, 8, 9, 10, 11},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 255, 255, 255, 9, 10, 11, 12},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 255, 255, 4, 5, 6, 7},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 255, 255, 5, 6, 7, 8},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 255, 255, 6, 7, 8, 9},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 255, 255, 7, 8, 9, 10},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 255, 255, 5, 6, 7, 8},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 255, 255, 6, 7, 8, 9},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 255, 255, 7, 8, 9, 10},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 255, 255, 8, 9, 10, 11},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 255, 255, 6, 7, 8, 9},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 255, 255, 7, 8, 9, 10},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 255, 255, 8, 9, 10, 11},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 255, 255, 9, 10, 11, 12},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 255, 255, 7, 8, 9, 10},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 255, 255, 8, 9, 10, 11},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 255, 255, 9, 10, 11, 12},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 255, 255, 10, 11, 12, 13},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 255, 5, 6, 7, 8},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 255, 6, 7, 8, 9},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 255, 7, 8, 9, 10},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 255, 8, 9, 10, 11},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 255, 6, 7, 8, 9},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 255, 7, 8, 9, 10},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 255, 8, 9, 10, 11},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 255, 9, 10, 11, 12},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 255, 7, 8, 9, 10},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 255, 8, 9, 10, 11},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 11, 12},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 255, 10, 11, 12, 13},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 255, 8, 9, 10, 11},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 255, 9, 10, 11, 12},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 255, 10, 11, 12, 13},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 255, 11, 12, 13, 14},
+  {0, 255, 255, 255, 1, 255, 255, 255, 2, 3, 4, 5, 6, 7, 8, 9},
+  {0, 1, 255, 255, 2, 255, 255, 255, 3, 4, 5, 6, 7, 8, 9, 10},
+  {0, 1, 2, 255, 3, 255, 255, 255, 4, 5, 6, 7, 8, 9, 10, 11},
+  {0, 1, 2, 3, 4, 255, 255, 255, 5, 6, 7, 8, 9, 10, 11, 12},
+  {0, 255, 255, 255, 1, 2, 255, 255, 3, 4, 5, 6, 7, 8, 9, 10},
+  {0, 1, 255, 255, 2, 3, 255, 255, 4, 5, 6, 7, 8, 9, 10, 11},
+  {0, 1, 2, 255, 3, 4, 255, 255, 5, 6, 7, 8, 9, 10, 11, 12},
+  {0, 1, 2, 3, 4, 5, 255, 255, 6, 7, 8, 9, 10, 11, 12, 13},
+  {0, 255, 255, 255, 1, 2, 3, 255, 4, 5, 6, 7, 8, 9, 10, 11},
+  {0, 1, 255, 255, 2, 3, 4, 255, 5, 6, 7, 8, 9, 10, 11, 12},
+  {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 9, 10, 11, 12, 13},
+  {0, 1, 2, 3, 4, 5, 6, 255, 7, 8, 9, 10, 11, 12, 13, 14},
+  {0, 255, 255, 255, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
+  {0, 1, 255, 255, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13},
+  {0, 1, 2, 255, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14},
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}
+};
+
+#endif /* SVB_TABLES_H_4eab1d6e_2c7b_4f0e_9d3a_63c1f6b0a5e2 */
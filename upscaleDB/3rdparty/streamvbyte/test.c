@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "streamvbyte.h"
+
+typedef struct {
+  const char *name;
+  size_t (*compressed_size)(const uint32_t *, uint32_t, uint32_t);
+  size_t (*compress)(const uint32_t *, uint8_t *, uint32_t, uint32_t);
+  size_t (*uncompress)(const uint8_t *, uint32_t *, uint32_t, uint32_t);
+  uint32_t (*select)(const uint8_t *, uint32_t, uint32_t, uint32_t);
+  uint32_t (*search)(const uint8_t *, uint32_t, uint32_t, uint32_t,
+                  uint32_t *);
+  size_t (*append)(uint8_t *, uint32_t, size_t, uint32_t, uint32_t);
+} codec_t;
+
+/* adapters for the unsorted functions, which have no |previous| */
+#define UNSORTED(prefix) \
+static size_t prefix ## _size_u(const uint32_t *in, uint32_t len, \
+                uint32_t prev) { \
+  (void)prev; return prefix ## _compressed_size_unsorted(in, len); } \
+static size_t prefix ## _compress_u(const uint32_t *in, uint8_t *out, \
+                uint32_t prev, uint32_t len) { \
+  (void)prev; return prefix ## _compress_unsorted(in, out, len); } \
+static size_t prefix ## _uncompress_u(const uint8_t *in, uint32_t *out, \
+                uint32_t prev, uint32_t len) { \
+  (void)prev; return prefix ## _uncompress_unsorted(in, out, len); } \
+static uint32_t prefix ## _select_u(const uint8_t *in, uint32_t len, \
+                uint32_t prev, uint32_t index) { \
+  (void)prev; return prefix ## _select_unsorted(in, len, index); } \
+static uint32_t prefix ## _search_u(const uint8_t *in, uint32_t len, \
+                uint32_t value, uint32_t prev, uint32_t *actual) { \
+  (void)prev; *actual = value; \
+  return prefix ## _search_unsorted(in, len, value); } \
+static size_t prefix ## _append_u(uint8_t *in, uint32_t len, size_t size, \
+                uint32_t prev, uint32_t value) { \
+  (void)prev; return prefix ## _append_unsorted(in, len, size, value); }
+
+UNSORTED(streamvbyte)
+UNSORTED(groupvarint)
+
+static const codec_t codecs[] = {
+  {"streamvbyte sorted", streamvbyte_compressed_size_sorted,
+    streamvbyte_compress_sorted, streamvbyte_uncompress_sorted,
+    streamvbyte_select_sorted, streamvbyte_search_lower_bound_sorted,
+    streamvbyte_append_sorted},
+  {"streamvbyte unsorted", streamvbyte_size_u, streamvbyte_compress_u,
+    streamvbyte_uncompress_u, streamvbyte_select_u, streamvbyte_search_u,
+    streamvbyte_append_u},
+  {"groupvarint sorted", groupvarint_compressed_size_sorted,
+    groupvarint_compress_sorted, groupvarint_uncompress_sorted,
+    groupvarint_select_sorted, groupvarint_search_lower_bound_sorted,
+    groupvarint_append_sorted},
+  {"groupvarint unsorted", groupvarint_size_u, groupvarint_compress_u,
+    groupvarint_uncompress_u, groupvarint_select_u, groupvarint_search_u,
+    groupvarint_append_u},
+};
+
+static void
+test(const codec_t *codec, uint32_t length, uint32_t gap)
+{
+  const uint32_t previous = 7;
+  uint32_t *plain = malloc(sizeof(uint32_t) * (length + 100));
+  uint32_t *out = malloc(sizeof(uint32_t) * (length + 100));
+  size_t max = streamvbyte_max_compressed_size(length + 100);
+  uint8_t *z = malloc(max);
+  uint8_t *z2 = malloc(max);
+  uint8_t *exact;
+  uint32_t i, actual;
+  size_t size, size2;
+
+  /* strictly ascending values with random gaps */
+  plain[0] = previous + 1 + rand() % gap;
+  for (i = 1; i < length + 100; i++)
+    plain[i] = plain[i - 1] + 1 + rand() % gap;
+
+  size = codec->compress(plain, z, previous, length);
+  assert(size == codec->compressed_size(plain, length, previous));
+  assert(size <= streamvbyte_max_compressed_size(length));
+
+  /* decode from a copy with the exact size; ASan/valgrind will catch
+   * over-reads */
+  exact = malloc(size ? size : 1);
+  memcpy(exact, z, size);
+  memset(out, 0, sizeof(uint32_t) * length);
+  assert(codec->uncompress(exact, out, previous, length) == size);
+  for (i = 0; i < length; i++)
+    assert(out[i] == plain[i]);
+  free(exact);
+
+  for (i = 0; i < length; i++) {
+    assert(codec->select(z, length, previous, i) == plain[i]);
+    assert(codec->search(z, length, plain[i], previous, &actual) == i);
+    assert(actual == plain[i]);
+  }
+  assert(codec->search(z, length, plain[length + 99] + 1, previous, &actual)
+                  == length);
+
+  /* append 100 values and compare with a freshly compressed stream */
+  for (i = 0; i < 100; i++)
+    size = codec->append(z, length + i, size,
+                    length + i > 0 ? plain[length + i - 1] : previous,
+                    plain[length + i]);
+  size2 = codec->compress(plain, z2, previous, length + 100);
+  assert(size == size2);
+  assert(memcmp(z, z2, size) == 0);
+
+  free(plain);
+  free(out);
+  free(z);
+  free(z2);
+}
+
+int
+main()
+{
+  static const uint32_t lengths[] = {0, 1, 2, 3, 4, 5, 15, 16, 17, 31, 32,
+          33, 100, 127, 128, 129, 1000, 10000};
+  static const uint32_t gaps[] = {1, 200, 60000, 300000};
+  size_t c, l, g;
+  unsigned seed = (unsigned)time(0);
+
+  printf("seed: %u\n", seed);
+  srand(seed);
+
+  for (c = 0; c < sizeof(codecs) / sizeof(codecs[0]); c++) {
+    printf("%s\n", codecs[c].name);
+    for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+      for (g = 0; g < sizeof(gaps) / sizeof(gaps[0]); g++)
+        test(&codecs[c], lengths[l], gaps[g]);
+  }
+
+  printf("ok\n");
+  return 0;
+}
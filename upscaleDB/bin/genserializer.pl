@@ -27,6 +27,44 @@ sub print_epilogue
 sub print_stdlib
 {
   my $p = $options{'prefix'};
+
+  # A list of buffers which are sent with a single writev(2)/WSASend().
+  # The fixed-size fields are written to a small header buffer; the
+  # payload of Bytes fields (i.e. keys and records) is referenced in place
+  # and never copied. The wire format is identical to serialize().
+  # A message with more than kMaxSegments segments sets |overflow|; the
+  # caller then has to fall back to the copying serialize().
+  print "struct $p" . "SegmentList {\n";
+  print "  enum { kMaxSegments = 32 };\n\n";
+  print "  struct Segment {\n";
+  print "    const void *data;\n";
+  print "    size_t size;\n";
+  print "  };\n\n";
+  print "  Segment segments[kMaxSegments];\n";
+  print "  int count;\n";
+  print "  bool overflow;\n";
+  print "  const unsigned char *pending;\n\n";
+  print "  $p" . "SegmentList(const unsigned char *header)\n";
+  print "    : count(0), overflow(false), pending(header) {\n";
+  print "  }\n\n";
+  print "  // returns false (and sets |overflow|) if the list is full\n";
+  print "  bool append(const void *data, size_t size) {\n";
+  print "    if (count >= kMaxSegments) {\n";
+  print "      overflow = true;\n";
+  print "      return (false);\n";
+  print "    }\n";
+  print "    segments[count].data = data;\n";
+  print "    segments[count].size = size;\n";
+  print "    count++;\n";
+  print "    return (true);\n";
+  print "  }\n\n";
+  print "  // appends the header bytes which were written since the last call\n";
+  print "  void flush(const unsigned char *ptr) {\n";
+  print "    if (ptr > pending)\n";
+  print "      append(pending, ptr - pending);\n";
+  print "    pending = ptr;\n";
+  print "  }\n";
+  print "};\n\n";
   print "template<typename Ex, typename In>\n";
   print "struct $p" . "_Base {\n";
   print "  Ex value;\n\n";
@@ -56,6 +94,17 @@ sub print_stdlib
   print "    *pptr += sizeof(In);\n";
   print "    *psize -= sizeof(In);\n";
   print "    assert(*psize >= 0);\n";
+  print "  }\n\n";
+  # the header buffer is not aligned if a Bytes payload with an odd
+  # length was sent in place, therefore the value is copied with memcpy
+  print "  void serialize(unsigned char **pptr, int *psize,\n";
+  print "                  $p" . "SegmentList *segments) const {\n";
+  print "    In v = (In)value;\n";
+  print "    (void)segments;\n";
+  print "    memcpy(*pptr, &v, sizeof(In));\n";
+  print "    *pptr += sizeof(In);\n";
+  print "    *psize -= sizeof(In);\n";
+  print "    assert(*psize >= 0);\n";
   print "  }\n";
   print "};\n\n";
   print "struct $p" . "Bytes {\n";
@@ -97,6 +146,27 @@ sub print_stdlib
   print "    }\n";
   print "    else\n";
   print "      value = 0;\n";
+  print "  }\n\n";
+  print "  // |*pptr| points into the header buffer, which only receives the\n";
+  print "  // length and the alignment padding; it is not necessarily aligned\n";
+  print "  void serialize(unsigned char **pptr, int *psize,\n";
+  print "                  $p" . "SegmentList *segments) const {\n";
+  print "    memcpy(*pptr, &size, sizeof(uint32_t));\n";
+  print "    *pptr += sizeof(uint32_t);\n";
+  print "    *psize -= sizeof(uint32_t);\n";
+  print "    if (size) {\n";
+  print "      segments->flush(*pptr);\n";
+  print "      segments->append(value, size);\n";
+  print "      size_t padding = align(size) - size;\n";
+  print "      memset(*pptr, 0, padding);\n";
+  print "      *pptr += padding;\n";
+  print "      *psize -= padding;\n";
+  print "    }\n";
+  print "    assert(*psize >= 0);\n";
+  print "  }\n\n";
+  print "  // the number of bytes which are written to the header buffer\n";
+  print "  size_t get_header_size() const {\n";
+  print "    return (sizeof(uint32_t) + align(size) - size);\n";
   print "  }\n";
   print "};\n\n";
   print "typedef $p" . "_Base<bool, uint32_t> $p" . "Bool;\n";
@@ -246,6 +316,24 @@ sub print_message_code
   }
   print "  }\n\n";
 
+  # serialize to a segment list; the caller passes a header buffer of
+  # get_size() bytes (or less if the payload size is known), and calls
+  # segments->flush() when done. Messages with a custom implementation
+  # have to provide this method themselves if they are sent with writev.
+  print "  void serialize(unsigned char **pptr, int *psize,\n";
+  print "                  $prefix" . "SegmentList *segments) const {\n";
+  foreach (@$fields) {
+    my $name = $$_{'name'};
+    if ($$_{'optional'}) {
+      print "    has_$name.serialize(pptr, psize, segments);\n";
+      print "    if (has_$name.value) $name.serialize(pptr, psize, segments);\n";
+    }
+    else {
+      print "    $name.serialize(pptr, psize, segments);\n";
+    }
+  }
+  print "  }\n\n";
+
   # deserialize
   print "  void deserialize(unsigned char **pptr, int *psize) {\n";
   foreach (@$fields) {
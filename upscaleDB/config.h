@@ -22,6 +22,12 @@
 /* Define to 1 if you have the <dlfcn.h> header file. */
 #define HAVE_DLFCN_H 1
 
+/* Define to 1 if you have the `EVP_aes_128_xts' function. */
+/* #undef HAVE_EVP_AES_128_XTS */
+
+/* Define to 1 if you have the `fallocate' function. */
+#define HAVE_FALLOCATE 1
+
 /* Define to 1 if you have the <fcntl.h> header file. */
 #define HAVE_FCNTL_H 1
 
@@ -43,16 +49,31 @@
 /* Define to 1 if you have the <inttypes.h> header file. */
 #define HAVE_INTTYPES_H 1
 
+/* Define to 1 if the UQI kernels are built with ispc */
+/* #undef HAVE_ISPC */
+
 /* Define to 1 if you have the `crypto' library (-lcrypto). */
 /* #undef HAVE_LIBCRYPTO */
 
 /* Define to 1 if you have the `db' library (-ldb). */
 /* #undef HAVE_LIBDB */
 
+/* Define to 1 if you have the `numa' library (-lnuma). */
+/* #undef HAVE_LIBNUMA */
+
 /* Define to 1 if you have the `tcmalloc_minimal' library
    (-ltcmalloc_minimal). */
 /* #undef HAVE_LIBTCMALLOC_MINIMAL */
 
+/* Define to 1 if you have the `uring' library (-luring). */
+/* #undef HAVE_LIBURING */
+
+/* Define to 1 if you have the <liburing.h> header file. */
+/* #undef HAVE_LIBURING_H */
+
+/* Define to 1 if you have the <lz4.h> header file. */
+/* #undef HAVE_LZ4_H */
+
 /* Define to 1 if you have the `madvise' function. */
 #define HAVE_MADVISE 1
 
@@ -62,12 +83,18 @@
 /* Define to 1 if you have the `munmap' function. */
 #define HAVE_MUNMAP 1
 
+/* Define to 1 if you have the <numa.h> header file. */
+/* #undef HAVE_NUMA_H */
+
 /* Define to 1 if you have the <openssl/evp.h> header file. */
 /* #undef HAVE_OPENSSL_EVP_H */
 
 /* Define to 1 if you have the `posix_fadvise' function. */
 #define HAVE_POSIX_FADVISE 1
 
+/* Define to 1 if you have the `posix_fallocate' function. */
+#define HAVE_POSIX_FALLOCATE 1
+
 /* Define to 1 if you have the `pread' function. */
 #define HAVE_PREAD 1
 
@@ -107,15 +134,24 @@
 /* Define to 1 if you have the <unistd.h> header file. */
 #define HAVE_UNISTD_H 1
 
+/* Define to 1 if the USDT probes are enabled */
+/* #undef HAVE_USDT */
+
 /* Define to 1 if you have the `usleep' function. */
 #define HAVE_USLEEP 1
 
 /* Define to 1 if you have the `writev' function. */
 #define HAVE_WRITEV 1
 
+/* Define to 1 if you have the <zdict.h> header file. */
+/* #undef HAVE_ZDICT_H */
+
 /* Define to 1 if you have the <zlib.h> header file. */
 #define HAVE_ZLIB_H 1
 
+/* Define to 1 if you have the <zstd.h> header file. */
+/* #undef HAVE_ZSTD_H */
+
 /* Define to the sub-directory where libtool stores uninstalled libraries. */
 #define LT_OBJDIR ".libs/"
 
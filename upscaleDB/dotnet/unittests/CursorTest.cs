@@ -167,6 +167,38 @@ namespace Unittests
             Assert.Null(r2);
         }
 
+        [Fact]
+        public void TryMoveSpan()
+        {
+            Cursor c = new Cursor(db);
+            db.Insert(new byte[] { 1 }, new byte[] { 0x11, 0x12 });
+            db.Insert(new byte[] { 2 }, new byte[] { 0x22 });
+            Span<byte> key = stackalloc byte[8];
+            Span<byte> record = stackalloc byte[8];
+            Assert.True(c.TryMove(key, record, UpsConst.UPS_CURSOR_NEXT,
+                        out int keySize, out int recordSize));
+            Assert.Equal(1, keySize);
+            Assert.Equal(2, recordSize);
+            Assert.Equal(1, key[0]);
+            Assert.Equal(0x12, record[1]);
+            Assert.True(c.TryMove(key, Span<byte>.Empty,
+                        UpsConst.UPS_CURSOR_NEXT, out keySize, out recordSize));
+            Assert.Equal(2, key[0]);
+            Assert.Equal(0, recordSize);
+            Assert.False(c.TryMove(key, record, UpsConst.UPS_CURSOR_NEXT,
+                        out keySize, out recordSize));
+            try
+            {
+                c.TryMove(key, new byte[1], UpsConst.UPS_CURSOR_FIRST,
+                        out keySize, out recordSize);
+                Assert.False(true);
+            }
+            catch (DatabaseException e)
+            {
+                Assert.Equal(UpsConst.UPS_LIMITS_REACHED, e.ErrorCode);
+            }
+        }
+
         [Fact]
         public void GetKey() {
             Cursor c = new Cursor(db);
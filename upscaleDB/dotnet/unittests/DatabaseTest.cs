@@ -772,6 +772,74 @@ namespace Unittests
             env.Close();
         }
 
+        [Fact]
+        public void TryFind()
+        {
+            env.Create("ntest.db");
+            using (Database db = env.CreateDatabase(1))
+            {
+                db.Insert(new byte[] { 1 }, new byte[] { 0x11 });
+                CheckEqual(new byte[] { 0x11 }, db.TryFind(new byte[] { 1 }));
+                Assert.Null(db.TryFind(new byte[] { 2 }));
+            }
+        }
+
+        [Fact]
+        public void SpanFindInsertErase()
+        {
+            env.Create("ntest.db");
+            using (Database db = env.CreateDatabase(1))
+            {
+                Span<byte> key = stackalloc byte[] { 1, 2 };
+                Span<byte> record = stackalloc byte[16];
+                db.Insert(null, key, new byte[] { 9, 8, 7 }, 0);
+                Assert.Equal(3, db.Find(null, key, record, 0));
+                Assert.Equal(9, record[0]);
+                Assert.Equal(7, record[2]);
+                Assert.True(db.TryFind(null, key, record, out int size));
+                Assert.Equal(3, size);
+                try
+                {
+                    db.Find(null, key, new byte[2], 0);
+                    Assert.False(true);
+                }
+                catch (DatabaseException e)
+                {
+                    Assert.Equal(UpsConst.UPS_LIMITS_REACHED, e.ErrorCode);
+                }
+                db.Erase(null, key);
+                Assert.False(db.TryFind(null, key, record, out size));
+            }
+        }
+
+        [Fact]
+        public void InsertManyFindMany()
+        {
+            env.Create("ntest.db");
+            using (Database db = env.CreateDatabase(1))
+            {
+                db.InsertMany(new byte[][] { new byte[] { 1 }, new byte[] { 2 } },
+                        new byte[][] { new byte[] { 0x11 }, new byte[] { 0x22, 0x23 } });
+                byte[][] records = db.FindMany(new byte[][] {
+                        new byte[] { 2 }, new byte[] { 3 }, new byte[] { 1 } });
+                Assert.Equal(3, records.Length);
+                CheckEqual(new byte[] { 0x22, 0x23 }, records[0]);
+                Assert.Null(records[1]);
+                CheckEqual(new byte[] { 0x11 }, records[2]);
+                Assert.Empty(db.FindMany(new byte[0][]));
+                try
+                {
+                    db.InsertMany(new byte[][] { new byte[] { 1 } },
+                            new byte[][] { new byte[] { 0x11 } });
+                    Assert.False(true);
+                }
+                catch (DatabaseException e)
+                {
+                    Assert.Equal(UpsConst.UPS_DUPLICATE_KEY, e.ErrorCode);
+                }
+            }
+        }
+
         [Fact]
         public void ApproxMatching()
         {
@@ -296,6 +296,60 @@ namespace Unittests
             env.Flush();
         }
 
+        [Fact]
+        public void Compact()
+        {
+            env.Create("ntest.db");
+            env.Compact();
+            env.Compact(UpsConst.UPS_COMPACT_ASYNC);
+            env.Compact(UpsConst.UPS_COMPACT_STOP);
+        }
+
+        [Fact]
+        public void CompactNegative()
+        {
+            env.Create("ntest.db");
+            try
+            {
+                env.Compact(UpsConst.UPS_COMPACT_ASYNC
+                        | UpsConst.UPS_COMPACT_STOP);
+            }
+            catch (DatabaseException e)
+            {
+                Assert.Equal(UpsConst.UPS_INV_PARAMETER, e.ErrorCode);
+            }
+        }
+
+        [Fact]
+        public void Backup()
+        {
+            byte[] k = new byte[5];
+            byte[] r = new byte[5];
+            env.Create("ntest.db");
+            Database db = env.CreateDatabase(1);
+            db.Insert(k, r);
+            env.Backup("ntest-backup.db");
+            env.Close();
+
+            env.Open("ntest-backup.db");
+            db = env.OpenDatabase(1);
+            Assert.Equal(r, db.Find(k));
+        }
+
+        [Fact]
+        public void BackupNegative()
+        {
+            env.Create(null, UpsConst.UPS_IN_MEMORY);
+            try
+            {
+                env.Backup("ntest-backup.db");
+            }
+            catch (DatabaseException e)
+            {
+                Assert.Equal(UpsConst.UPS_INV_PARAMETER, e.ErrorCode);
+            }
+        }
+
         [Fact]
         public void GetDatabaseNames()
         {
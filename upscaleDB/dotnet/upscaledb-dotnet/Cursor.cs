@@ -247,6 +247,40 @@ namespace Upscaledb
         throw new DatabaseException(st);
     }
 
+    /// <summary>
+    /// Moves the Cursor and copies key and record to caller-supplied
+    /// buffers
+    /// </summary>
+    /// <remarks>
+    /// Like <see cref="Cursor.TryMove(ref byte[], ref byte[], int)" />,
+    /// but does not allocate managed memory. An empty span is not
+    /// retrieved, and its size is returned as 0.
+    /// <br />
+    /// If a span is too small then the Cursor is nevertheless moved,
+    /// and <see cref="UpsConst.UPS_LIMITS_REACHED" /> is thrown.
+    /// </remarks>
+    /// <param name="key">Receives the key of the item</param>
+    /// <param name="record">Receives the record of the item</param>
+    /// <param name="flags">The flags of ups_cursor_move</param>
+    /// <param name="keySize">Receives the size of the key</param>
+    /// <param name="recordSize">Receives the size of the record</param>
+    /// <returns>false if there is no further item, otherwise true</returns>
+    public bool TryMove(Span<byte> key, Span<byte> record, int flags,
+            out int keySize, out int recordSize)
+    {
+        int st;
+        lock (db)
+        {
+            st = NativeMethods.CursorGet(handle, flags, key, record,
+                            out keySize, out recordSize);
+        }
+        if (st == 0)
+            return true;
+        if (st == UpsConst.UPS_KEY_NOT_FOUND)
+            return false;
+        throw new DatabaseException(st);
+    }
+
     /// <summary>
     /// Retrieves the Key of the current item
     /// </summary>
@@ -282,6 +282,161 @@ namespace Upscaledb
       return record;
     }
 
+    /// <summary>
+    /// Searches an item in the Database, returns the record or null
+    /// </summary>
+    public byte[] TryFind(byte[] key) {
+      return TryFind(null, ref key, 0);
+    }
+
+    /// <summary>
+    /// Searches an item in the Database, returns the record or null
+    /// </summary>
+    public byte[] TryFind(Transaction txn, byte[] key) {
+      return TryFind(txn, ref key, 0);
+    }
+
+    /// <summary>
+    /// Searches an item in the Database, returns the record or null
+    /// </summary>
+    /// <remarks>
+    /// Like <see cref="Database.Find(Transaction, ref byte[], int)" />,
+    /// but returns null instead of throwing
+    /// <see cref="UpsConst.UPS_KEY_NOT_FOUND" /> if the key does not
+    /// exist. All other errors are thrown as a DatabaseException.
+    /// </remarks>
+    /// <param name="txn">The optional Transaction</param>
+    /// <param name="key">The key of the item</param>
+    /// <param name="flags">The flags of the operation</param>
+    /// <returns>The record of the item, or null</returns>
+    public byte[] TryFind(Transaction txn, ref byte[] key, int flags) {
+      byte[] record = null;
+      int st;
+      lock (this) {
+        st = NativeMethods.Find(handle,
+                        txn != null ? txn.Handle : IntPtr.Zero,
+                        ref key, ref record, flags);
+      }
+      if (st == UpsConst.UPS_KEY_NOT_FOUND)
+        return null;
+      if (st != 0)
+        throw new DatabaseException(st);
+      return record;
+    }
+
+    /// <summary>
+    /// Searches an item in the Database and copies the record to a
+    /// caller-supplied buffer
+    /// </summary>
+    /// <remarks>
+    /// This method wraps the native ups_db_find function.<br />
+    /// <br />
+    /// Unlike <see cref="Database.Find(Transaction, ref byte[], int)" />,
+    /// this method does not allocate managed memory. The key is pinned
+    /// and passed to upscaledb, and the record is copied to
+    /// <paramref name="record"/>, which can be a stackalloc'd or a
+    /// reused buffer.<br />
+    /// <br />
+    /// The key is not updated if approximate matching is requested; use
+    /// <see cref="Database.Find(Transaction, ref byte[], int)" /> to
+    /// retrieve the matched key.
+    /// </remarks>
+    /// <param name="txn">The optional Transaction</param>
+    /// <param name="key">The key of the item</param>
+    /// <param name="record">Receives the record of the item</param>
+    /// <param name="flags">The flags of the operation</param>
+    /// <returns>The size of the record</returns>
+    /// <exception cref="DatabaseException">
+    ///   <list type="bullet">
+    ///   <item><see cref="UpsConst.UPS_KEY_NOT_FOUND"/>
+    ///     if the item was not found</item>
+    ///   <item><see cref="UpsConst.UPS_LIMITS_REACHED"/>
+    ///     if <paramref name="record"/> is too small</item>
+    ///   </list>
+    /// </exception>
+    public int Find(Transaction txn, ReadOnlySpan<byte> key,
+              Span<byte> record, int flags) {
+      int st, size;
+      lock (this) {
+        st = NativeMethods.Find(handle,
+                        txn != null ? txn.Handle : IntPtr.Zero,
+                        key, record, flags, out size);
+      }
+      if (st != 0)
+        throw new DatabaseException(st);
+      return size;
+    }
+
+    /// <summary>
+    /// Searches an item in the Database and copies the record to a
+    /// caller-supplied buffer
+    /// </summary>
+    /// <remarks>
+    /// Like <see cref="Database.Find(Transaction, ReadOnlySpan{byte},
+    /// Span{byte}, int)" />, but returns false instead of throwing
+    /// <see cref="UpsConst.UPS_KEY_NOT_FOUND" /> if the key does not
+    /// exist.
+    /// </remarks>
+    /// <param name="txn">The optional Transaction</param>
+    /// <param name="key">The key of the item</param>
+    /// <param name="record">Receives the record of the item</param>
+    /// <param name="size">Receives the size of the record</param>
+    /// <returns>true if the item was found, otherwise false</returns>
+    public bool TryFind(Transaction txn, ReadOnlySpan<byte> key,
+              Span<byte> record, out int size) {
+      int st;
+      lock (this) {
+        st = NativeMethods.Find(handle,
+                        txn != null ? txn.Handle : IntPtr.Zero,
+                        key, record, 0, out size);
+      }
+      if (st == UpsConst.UPS_KEY_NOT_FOUND)
+        return false;
+      if (st != 0)
+        throw new DatabaseException(st);
+      return true;
+    }
+
+    /// <summary>
+    /// Searches several items in the Database
+    /// </summary>
+    /// <remarks>
+    /// This is an overloaded function for
+    ///   Database.FindMany(null, keys, 0).
+    /// </remarks>
+    public byte[][] FindMany(byte[][] keys) {
+      return FindMany(null, keys, 0);
+    }
+
+    /// <summary>
+    /// Searches several items in the Database
+    /// </summary>
+    /// <remarks>
+    /// This method wraps the native ups_db_find_many function.<br />
+    /// <br />
+    /// All keys are looked up with a single call. The keys are copied
+    /// to a single pooled buffer, which is pinned once for the whole
+    /// batch instead of one GCHandle per key. The returned array has one
+    /// record per key; keys which were not found have a null record.
+    /// </remarks>
+    /// <param name="txn">The optional Transaction</param>
+    /// <param name="keys">The keys of the items</param>
+    /// <param name="flags">The flags of the operation; they are applied
+    /// to all keys</param>
+    /// <returns>The records of the items</returns>
+    public byte[][] FindMany(Transaction txn, byte[][] keys, int flags) {
+      byte[][] records = new byte[keys.Length][];
+      int st;
+      lock (this) {
+        st = NativeMethods.FindMany(handle,
+                        txn != null ? txn.Handle : IntPtr.Zero,
+                        keys, records, flags);
+      }
+      if (st != 0)
+        throw new DatabaseException(st);
+      return records;
+    }
+
     /// <summary>
     /// Inserts a Database item
     /// </summary>
@@ -377,6 +532,74 @@ namespace Upscaledb
         throw new DatabaseException(st);
     }
 
+    /// <summary>
+    /// Inserts a Database Item from caller-supplied buffers
+    /// </summary>
+    /// <remarks>
+    /// Like <see cref="Database.Insert(Transaction, byte[], byte[], int)" />,
+    /// but accepts spans; key and record are pinned and passed to
+    /// upscaledb without being copied to managed arrays.
+    /// </remarks>
+    /// <param name="txn">An optional Transaction object</param>
+    /// <param name="key">The key of the new item</param>
+    /// <param name="record">The record of the new item</param>
+    /// <param name="flags">Optional flags for this operation</param>
+    public void Insert(Transaction txn, ReadOnlySpan<byte> key,
+              ReadOnlySpan<byte> record, int flags) {
+      int st;
+      lock (this) {
+        st = NativeMethods.Insert(handle,
+                  txn != null ? txn.Handle : IntPtr.Zero,
+                  key, record, flags);
+      }
+      if (st != 0)
+        throw new DatabaseException(st);
+    }
+
+    /// <summary>
+    /// Inserts several Database items
+    /// </summary>
+    /// <remarks>
+    /// This is an overloaded function for
+    ///   Database.InsertMany(null, keys, records, 0).
+    /// </remarks>
+    public void InsertMany(byte[][] keys, byte[][] records) {
+      InsertMany(null, keys, records, 0);
+    }
+
+    /// <summary>
+    /// Inserts several Database items
+    /// </summary>
+    /// <remarks>
+    /// This method wraps the native ups_db_bulk_operations function.
+    /// <br />
+    /// All items are inserted with a single call. Keys and records are
+    /// copied to a single pooled buffer, which is pinned once for the
+    /// whole batch instead of one GCHandle per array. The first failed
+    /// insert is thrown as a DatabaseException; the remaining items are
+    /// nevertheless inserted.
+    /// <br />
+    /// For Record Number Databases, <paramref name="keys"/> can be null.
+    /// </remarks>
+    /// <param name="txn">An optional Transaction object</param>
+    /// <param name="keys">The keys of the new items</param>
+    /// <param name="records">The records of the new items</param>
+    /// <param name="flags">Optional flags for this operation; they are
+    /// applied to all items</param>
+    public void InsertMany(Transaction txn, byte[][] keys, byte[][] records,
+              int flags) {
+      if (keys != null && keys.Length != records.Length)
+        throw new ArgumentException("keys and records differ in length");
+      int st;
+      lock (this) {
+        st = NativeMethods.InsertMany(handle,
+                  txn != null ? txn.Handle : IntPtr.Zero,
+                  keys, records, flags);
+      }
+      if (st != 0)
+        throw new DatabaseException(st);
+    }
+
     /// <summary>
     /// Inserts a Database Item into a Record Number Database
     /// </summary>
@@ -477,6 +700,25 @@ namespace Upscaledb
         throw new DatabaseException(st);
     }
 
+    /// <summary>
+    /// Erases a Database Item
+    /// </summary>
+    /// <remarks>
+    /// Like <see cref="Database.Erase(Transaction, byte[])" />, but
+    /// accepts a span.
+    /// </remarks>
+    /// <param name="txn">The optional Transaction</param>
+    /// <param name="key">The key of the item to delete</param>
+    public void Erase(Transaction txn, ReadOnlySpan<byte> key) {
+      int st;
+      lock (this) {
+        st = NativeMethods.Erase(handle,
+              txn != null ? txn.Handle : IntPtr.Zero, key, 0);
+      }
+      if (st != 0)
+        throw new DatabaseException(st);
+    }
+
     /// <summary>
     /// Perform bulk operations on a database.
     /// This function receives an array of Operation structures
@@ -485,9 +485,20 @@ namespace Upscaledb
     ///   </list>
     /// </exception>
     public void EraseDatabase(short name) {
+      EraseDatabase(name, 0);
+    }
+
+    /// <summary>
+    /// Deletes a Database from this Environment
+    /// </summary>
+    /// <param name="name">The name of the Database which is deleted</param>
+    /// <param name="flags">Optional flags; <see
+    /// cref="UpsConst.UPS_ERASE_DB_ASYNC" /> releases the pages of the
+    /// Database in the background</param>
+    public void EraseDatabase(short name, int flags) {
       int st;
       lock (this) {
-        st = NativeMethods.EnvEraseDatabase(handle, name, 0);
+        st = NativeMethods.EnvEraseDatabase(handle, name, flags);
       }
       if (st != 0)
         throw new DatabaseException(st);
@@ -514,6 +525,62 @@ namespace Upscaledb
         throw new DatabaseException(st);
     }
 
+    /// <summary>
+    /// Compacts the Environment
+    /// </summary>
+    /// <remarks>
+    /// This method wraps the native ups_env_compact function.
+    /// <br />
+    /// Merges underfull leaf nodes, moves blobs into dense pages and
+    /// truncates the free pages at the end of the file. Other threads can
+    /// continue to use the Environment.
+    /// </remarks>
+    /// <param name="flags">Optional flags for this operation, combined
+    /// with bitwise OR. Possible flags are:
+    /// <list type="bullet">
+    ///   <item><see cref="UpsConst.UPS_COMPACT_ASYNC" />
+    ///     Starts the compaction in the background and returns
+    ///     immediately</item>
+    ///   <item><see cref="UpsConst.UPS_COMPACT_STOP" />
+    ///     Stops a running compaction</item>
+    /// </list>
+    /// </param>
+    public void Compact(int flags) {
+      int st;
+      lock (this) {
+        st = NativeMethods.EnvCompact(handle, flags);
+      }
+      if (st != 0)
+        throw new DatabaseException(st);
+    }
+
+    /// <summary>
+    /// Compacts the Environment and waits till it is finished
+    /// </summary>
+    public void Compact() {
+      Compact(0);
+    }
+
+    /// <summary>
+    /// Creates a consistent backup of the Environment
+    /// </summary>
+    /// <remarks>
+    /// This method wraps the native ups_env_backup function.
+    /// <br />
+    /// Copies the Environment file (and the journal entries of the
+    /// checkpoint) to destPath. Other threads can continue to read and
+    /// write while the backup is created; the backup reflects the state
+    /// of the Environment when this method was called.
+    /// </remarks>
+    /// <param name="destPath">The path of the backup file</param>
+    public void Backup(String destPath) {
+      // not locked - other threads can use the Environment while the
+      // backup is running
+      int st = NativeMethods.EnvBackup(handle, destPath, 0);
+      if (st != 0)
+        throw new DatabaseException(st);
+    }
+
     /// <summary>
     /// Returns the names of all Databases in this Environment
     /// </summary>
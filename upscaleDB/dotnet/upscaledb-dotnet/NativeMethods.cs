@@ -16,6 +16,7 @@
  */
 
 using System;
+using System.Buffers;
 using System.Runtime.InteropServices;
 
 // See http://stackoverflow.com/questions/772531
@@ -216,6 +217,15 @@ namespace Upscaledb
        CallingConvention = CallingConvention.Cdecl)]
     static public extern int EnvFlush(IntPtr handle, int flags);
 
+    [DllImport(UpscaleNativeDll, EntryPoint = "ups_env_compact",
+       CallingConvention = CallingConvention.Cdecl)]
+    static public extern int EnvCompact(IntPtr handle, int flags);
+
+    [DllImport(UpscaleNativeDll, EntryPoint = "ups_env_backup",
+       CallingConvention = CallingConvention.Cdecl)]
+    static public extern int EnvBackup(IntPtr handle, String destPath,
+        int flags);
+
     [DllImport(UpscaleNativeDll, EntryPoint = "ups_env_get_database_names",
        CallingConvention = CallingConvention.Cdecl)]
     static public extern int EnvGetDatabaseNamesLow(IntPtr handle,
@@ -316,6 +326,79 @@ namespace Upscaledb
       }
     }
 
+    static public unsafe int Find(IntPtr handle, IntPtr txnhandle,
+                ReadOnlySpan<byte> keydata, Span<byte> recdata, int flags,
+                out int size) {
+      KeyStruct key = new KeyStruct();
+      RecordStruct record = new RecordStruct();
+      size = 0;
+      fixed (byte *bk = keydata) {
+        key.data = bk;
+        key.size = (short)keydata.Length;
+        int st = FindLow(handle, txnhandle, ref key, ref record, flags);
+        if (st != 0)
+          return st;
+        size = record.size;
+        if (record.size > recdata.Length)
+          return UpsConst.UPS_LIMITS_REACHED;
+        new ReadOnlySpan<byte>(record.data, record.size).CopyTo(recdata);
+        return 0;
+      }
+    }
+
+    [DllImport(UpscaleNativeDll, EntryPoint = "ups_db_find_many",
+       CallingConvention = CallingConvention.Cdecl)]
+    static private unsafe extern int FindManyLow(IntPtr handle,
+        IntPtr txnhandle, KeyStruct* keys, RecordStruct* records,
+        int* statuses, int count, int flags);
+
+    static public unsafe int FindMany(IntPtr handle, IntPtr txnhandle,
+                byte[][] keydata, byte[][] recdata, int flags) {
+      int count = keydata.Length;
+      if (count == 0)
+        return 0;
+
+      // copy the keys to a single pooled buffer which is pinned only once
+      int total = 0;
+      foreach (byte[] k in keydata)
+        total += k.Length;
+      byte[] buffer = ArrayPool<byte>.Shared.Rent(Math.Max(total, 1));
+      try {
+        KeyStruct[] keys = new KeyStruct[count];
+        RecordStruct[] records = new RecordStruct[count];
+        int[] statuses = new int[count];
+        fixed (byte *b = buffer)
+        fixed (KeyStruct *pk = keys)
+        fixed (RecordStruct *pr = records)
+        fixed (int *ps = statuses) {
+          int offset = 0;
+          for (int i = 0; i < count; i++) {
+            Buffer.BlockCopy(keydata[i], 0, buffer, offset, keydata[i].Length);
+            pk[i].data = b + offset;
+            pk[i].size = (short)keydata[i].Length;
+            offset += keydata[i].Length;
+          }
+          int st = FindManyLow(handle, txnhandle, pk, pr, ps, count, flags);
+          if (st != 0)
+            return st;
+          for (int i = 0; i < count; i++) {
+            if (ps[i] == UpsConst.UPS_KEY_NOT_FOUND) {
+              recdata[i] = null;
+              continue;
+            }
+            if (ps[i] != 0)
+              return ps[i];
+            recdata[i] = new byte[pr[i].size];
+            Marshal.Copy(new IntPtr(pr[i].data), recdata[i], 0, pr[i].size);
+          }
+          return 0;
+        }
+      }
+      finally {
+        ArrayPool<byte>.Shared.Return(buffer);
+      }
+    }
+
     [DllImport(UpscaleNativeDll, EntryPoint = "ups_db_insert",
        CallingConvention = CallingConvention.Cdecl)]
     static private extern int InsertLow(IntPtr handle, IntPtr txnhandle,
@@ -334,6 +417,67 @@ namespace Upscaledb
       }
     }
 
+    static public unsafe int Insert(IntPtr handle, IntPtr txnhandle,
+        ReadOnlySpan<byte> keyData, ReadOnlySpan<byte> recordData, int flags) {
+      KeyStruct key = new KeyStruct();
+      RecordStruct record = new RecordStruct();
+      fixed (byte* br = recordData, bk = keyData) {
+        record.data = br;
+        record.size = recordData.Length;
+        key.data = bk;
+        key.size = (short)keyData.Length;
+        return InsertLow(handle, txnhandle, ref key, ref record, flags);
+      }
+    }
+
+    static public unsafe int InsertMany(IntPtr handle, IntPtr txnhandle,
+        byte[][] keyData, byte[][] recordData, int flags) {
+      int count = recordData.Length;
+      if (count == 0)
+        return 0;
+
+      // copy keys and records to a single pooled buffer which is pinned
+      // only once; the keys of a Record Number Database can be null
+      int total = 0;
+      for (int i = 0; i < count; i++) {
+        if (keyData != null && keyData[i] != null)
+          total += keyData[i].Length;
+        total += recordData[i].Length;
+      }
+      byte[] buffer = ArrayPool<byte>.Shared.Rent(Math.Max(total, 1));
+      try {
+        OperationLow[] operations = new OperationLow[count];
+        fixed (byte *b = buffer)
+        fixed (OperationLow *ops = operations) {
+          int offset = 0;
+          for (int i = 0; i < count; i++) {
+            ops[i].type = UpsConst.UPS_OP_INSERT;
+            ops[i].flags = flags;
+            if (keyData != null && keyData[i] != null) {
+              byte[] k = keyData[i];
+              Buffer.BlockCopy(k, 0, buffer, offset, k.Length);
+              ops[i].key.data = b + offset;
+              ops[i].key.size = (short)k.Length;
+              offset += k.Length;
+            }
+            byte[] r = recordData[i];
+            Buffer.BlockCopy(r, 0, buffer, offset, r.Length);
+            ops[i].record.data = b + offset;
+            ops[i].record.size = r.Length;
+            offset += r.Length;
+          }
+          int st = BulkOperationsLow(handle, txnhandle, ops,
+                          new SizeT((uint)count), 0);
+          for (int i = 0; st == 0 && i < count; i++)
+            st = ops[i].result;
+          return st;
+        }
+      }
+      finally {
+        ArrayPool<byte>.Shared.Return(buffer);
+      }
+    }
+
     static public unsafe int InsertRecNo(IntPtr handle, IntPtr txnhandle,
         ref byte[] keydata, byte[] recordData, int flags)
     {
@@ -371,6 +515,16 @@ namespace Upscaledb
       }
     }
 
+    static public unsafe int Erase(IntPtr handle, IntPtr txnhandle,
+                ReadOnlySpan<byte> data, int flags) {
+      KeyStruct key = new KeyStruct();
+      fixed (byte* b = data) {
+        key.data = b;
+        key.size = (short)data.Length;
+        return EraseLow(handle, txnhandle, ref key, flags);
+      }
+    }
+
     [DllImport(UpscaleNativeDll, EntryPoint = "ups_db_count",
        CallingConvention = CallingConvention.Cdecl)]
     static public extern int GetCount(IntPtr handle, IntPtr txnhandle,
@@ -409,6 +563,11 @@ namespace Upscaledb
     static private extern int CursorMoveLow(IntPtr handle,
         ref KeyStruct key, ref RecordStruct record, int flags);
 
+    [DllImport(UpscaleNativeDll, EntryPoint = "ups_cursor_move",
+       CallingConvention = CallingConvention.Cdecl)]
+    static private unsafe extern int CursorMoveLow(IntPtr handle,
+        KeyStruct* key, RecordStruct* record, int flags);
+
     static public int CursorMove(IntPtr handle, int flags) {
       return CursorMoveLow(handle, IntPtr.Zero, IntPtr.Zero, flags);
     }
@@ -457,6 +616,29 @@ namespace Upscaledb
         return st;
     }
 
+    static unsafe public int CursorGet(IntPtr handle, int flags,
+        Span<byte> keyData, Span<byte> recordData, out int keySize,
+        out int recordSize)
+    {
+        KeyStruct key = new KeyStruct();
+        RecordStruct record = new RecordStruct();
+        keySize = 0;
+        recordSize = 0;
+        // empty spans are not retrieved
+        int st = CursorMoveLow(handle, keyData.IsEmpty ? null : &key,
+                        recordData.IsEmpty ? null : &record, flags);
+        if (st != 0)
+            return st;
+        keySize = (ushort)key.size;
+        recordSize = record.size;
+        // the Cursor was moved even if the spans are too small
+        if (keySize > keyData.Length || recordSize > recordData.Length)
+            return UpsConst.UPS_LIMITS_REACHED;
+        new ReadOnlySpan<byte>(key.data, keySize).CopyTo(keyData);
+        new ReadOnlySpan<byte>(record.data, recordSize).CopyTo(recordData);
+        return 0;
+    }
+
     [DllImport(UpscaleNativeDll, EntryPoint = "ups_cursor_overwrite",
        CallingConvention = CallingConvention.Cdecl)]
     static private extern int CursorOverwriteLow(IntPtr handle,
@@ -103,6 +103,8 @@ namespace Upscaledb
     // Transaction constants
     /// <summary>Flag for Transaction.Begin</summary>
     public const int UPS_TXN_READ_ONLY          =  1;
+    /// <summary>Flag for Transaction.Begin</summary>
+    public const int UPS_TXN_SNAPSHOT           =  4;
     /// <summary>Flag for Transaction.Commit</summary>
     public const int UPS_TXN_FORCE_WRITE        =  1;
 
@@ -126,6 +128,10 @@ namespace Upscaledb
     /// <summary>Flag for Database.Create</summary>
     public const int UPS_ENABLE_DUPLICATE_KEYS  =  0x04000;
     /// <summary>Flag for Database.Create</summary>
+    public const int UPS_HASH_INDEX             =  0x08000;
+    /// <summary>Flag for Database.Create</summary>
+    public const int UPS_TIME_SERIES            =  0x01000000;
+    /// <summary>Flag for Database.Create</summary>
     public const int UPS_ENABLE_RECOVERY        =  UPS_ENABLE_TRANSACTIONS;
     /// <summary>Flag for Database.Open</summary>
     public const int UPS_AUTO_RECOVERY          =  0x10000;
@@ -189,6 +195,100 @@ namespace Upscaledb
     public const int UPS_PARAM_RECORD_COMPRESSION   = 0x1001;
     /// <summary>Value for Database.Create, /// Database.Open</summary>
     public const int UPS_PARAM_KEY_COMPRESSION      = 0x1002;
+    /// <summary>Value for Database.Create, /// Database.Open</summary>
+    public const int UPS_PARAM_DUPLICATE_COMPRESSION = 0x1003;
+    /// <summary>Value for Database.Create</summary>
+    public const int UPS_PARAM_RECORD_COMPRESSION_DICTIONARY = 0x1004;
+    /// <summary>Value for Database.Create</summary>
+    public const int UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE = 0x1005;
+    /// <summary>Value for Database.Create</summary>
+    public const int UPS_PARAM_KEY_LAYOUT           = 0x011c;
+    /// <summary>Value for UPS_PARAM_KEY_LAYOUT: sorted keys</summary>
+    public const int UPS_KEY_LAYOUT_SORTED          = 0;
+    /// <summary>Value for UPS_PARAM_KEY_LAYOUT: Eytzinger order</summary>
+    public const int UPS_KEY_LAYOUT_EYTZINGER       = 1;
+    /// <summary>Value for UPS_PARAM_KEY_LAYOUT: cache-line blocked order</summary>
+    public const int UPS_KEY_LAYOUT_BLOCKED         = 2;
+    /// <summary>Value for Database.Create</summary>
+    public const int UPS_PARAM_LEAF_SUMMARIES       = 0x011d;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_NETWORK_PIPELINE_DEPTH = 0x011e;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_NETWORK_POOL_SIZE    = 0x011f;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE = 0x0120;
+    /// <summary>Parameter name for Environment.Create</summary>
+    public const int UPS_PARAM_PARTITIONS           = 0x0121;
+    /// <summary>Parameter name for Environment.Create</summary>
+    public const int UPS_PARAM_PARTITION_SCHEME     = 0x0122;
+    /// <summary>Value for UPS_PARAM_PARTITION_SCHEME: hash partitioning</summary>
+    public const int UPS_PARTITION_HASH             = 0;
+    /// <summary>Value for UPS_PARAM_PARTITION_SCHEME: range partitioning</summary>
+    public const int UPS_PARTITION_RANGE            = 1;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_NETWORK_COMPRESSION  = 0x0124;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_CACHE_HUGE_PAGES     = 0x0126;
+    /// <summary>Value for UPS_PARAM_CACHE_HUGE_PAGES: regular pages</summary>
+    public const int UPS_HUGE_PAGES_NONE            = 0;
+    /// <summary>Value for UPS_PARAM_CACHE_HUGE_PAGES: 2 MB huge pages</summary>
+    public const int UPS_HUGE_PAGES_2MB             = 1;
+    /// <summary>Value for UPS_PARAM_CACHE_HUGE_PAGES: 1 GB huge pages</summary>
+    public const int UPS_HUGE_PAGES_1GB             = 2;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_CACHE_NUMA_POLICY    = 0x0127;
+    /// <summary>Value for UPS_PARAM_CACHE_NUMA_POLICY: default placement</summary>
+    public const int UPS_NUMA_NONE                  = 0;
+    /// <summary>Value for UPS_PARAM_CACHE_NUMA_POLICY: interleaves the cache shards</summary>
+    public const int UPS_NUMA_INTERLEAVE            = 1;
+    /// <summary>Value for UPS_PARAM_CACHE_NUMA_POLICY: places memory near its users</summary>
+    public const int UPS_NUMA_LOCAL                 = 2;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_CACHE_WARMUP         = 0x0128;
+    /// <summary>Parameter name for Environment.Open</summary>
+    public const int UPS_PARAM_RECOVERY_THREADS     = 0x0129;
+    /// <summary>Parameter name for Environment.Open</summary>
+    public const int UPS_PARAM_RECOVERY_TXN_POLICY  = 0x012a;
+    /// <summary>Value for UPS_PARAM_RECOVERY_TXN_POLICY: aborts active Transactions</summary>
+    public const int UPS_RECOVERY_ABORT_TXNS        = 0;
+    /// <summary>Value for UPS_PARAM_RECOVERY_TXN_POLICY: restores active Transactions</summary>
+    public const int UPS_RECOVERY_RESTORE_TXNS      = 1;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_COMPACTION_FILL_FACTOR = 0x012b;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_COMPACTION_RATE      = 0x012c;
+    /// <summary>Flag for Environment.Compact</summary>
+    public const int UPS_COMPACT_ASYNC              = 1;
+    /// <summary>Flag for Environment.Compact</summary>
+    public const int UPS_COMPACT_STOP               = 2;
+    /// <summary>Flag for Environment.EraseDatabase</summary>
+    public const int UPS_ERASE_DB_ASYNC             = 1;
+    /// <summary>Parameter name for Environment.CreateDatabase</summary>
+    public const int UPS_PARAM_BLOOM_FILTER_BITS    = 0x012d;
+    /// <summary>Parameter name for Environment.CreateDatabase</summary>
+    public const int UPS_PARAM_MEMORY_INDEX         = 0x012e;
+    /// <summary>Value for UPS_PARAM_MEMORY_INDEX</summary>
+    public const int UPS_MEMORY_INDEX_BTREE         = 0;
+    /// <summary>Value for UPS_PARAM_MEMORY_INDEX</summary>
+    public const int UPS_MEMORY_INDEX_ART           = 1;
+    /// <summary>Parameter name for Environment.CreateDatabase</summary>
+    public const int UPS_PARAM_SUBTREE_COUNTS       = 0x012f;
+    /// <summary>Parameter name for Environment.Create</summary>
+    public const int UPS_PARAM_ENCRYPTION_MODE      = 0x0130;
+    /// <summary>Value for UPS_PARAM_ENCRYPTION_MODE</summary>
+    public const int UPS_ENCRYPTION_CBC             = 1;
+    /// <summary>Value for UPS_PARAM_ENCRYPTION_MODE</summary>
+    public const int UPS_ENCRYPTION_XTS             = 2;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_CACHE_COMPRESSED_SIZE = 0x0131;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_CACHE_COMPRESSOR     = 0x0132;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_JOURNAL_PREALLOCATE_SIZE = 0x0134;
+    /// <summary>Parameter name for Environment.Create, Environment.Open</summary>
+    public const int UPS_PARAM_JOURNAL_DIRECT_IO    = 0x0135;
+    /// <summary>Parameter name for Environment.CreateDatabase</summary>
+    public const int UPS_PARAM_DB_PAGE_SIZE         = 0x0136;
     /// <summary>"null" compression</summary>
     public const int UPS_COMPRESSION_NONE                 =      0;
     /// <summary>zlib compression</summary>
@@ -199,6 +299,12 @@ namespace Upscaledb
     public const int UPS_COMPRESSION_LZF                  =      3;
     /// <summary>lzop compression</summary>
     public const int UPS_COMPRESSION_LZOP                 =      4;
+    /// <summary>lz4 compression</summary>
+    public const int UPS_COMPRESSION_LZ4                  =     12;
+    /// <summary>zstd compression</summary>
+    public const int UPS_COMPRESSION_ZSTD                 =     13;
+    /// <summary>prefix compression for binary keys</summary>
+    public const int UPS_COMPRESSION_PREFIX               =     14;
 
     // Database operations
     /// <summary>Flag for Database.Insert, Cursor.Insert</summary>
@@ -255,6 +361,8 @@ namespace Upscaledb
     /// <summary>Flag for Cursor.Find</summary>
     public const int UPS_FIND_GEQ_MATCH  = (UPS_FIND_GT_MATCH
                         | UPS_FIND_EQ_MATCH);
+    /// <summary>Flag for Cursor.Find</summary>
+    public const int UPS_FIND_FROM_CURRENT      =    0x8000;
 
     /// <summary>A binary blob without type; sorted by memcmp</summary>
     public const int UPS_TYPE_BINARY            =         0;
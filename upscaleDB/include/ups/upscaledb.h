@@ -111,6 +111,7 @@
 #ifndef UPS_UPSCALEDB_H
 #define UPS_UPSCALEDB_H
 
+#include <stddef.h> /* for size_t */
 #include <ups/types.h>
 
 #ifdef __cplusplus
@@ -176,6 +177,36 @@ typedef struct ups_env_t ups_env_t;
 struct ups_cursor_t;
 typedef struct ups_cursor_t ups_cursor_t;
 
+/**
+ * A pinned view of a record
+ *
+ * A view keeps the page of a record pinned in the cache, so that the
+ * record's data can be accessed without copying it.
+ *
+ * This structure is allocated with @ref ups_db_find_view and deleted with
+ * @ref ups_view_release.
+ */
+struct ups_view_t;
+typedef struct ups_view_t ups_view_t;
+
+/**
+ * A cache which is shared by several Environments
+ *
+ * This structure is allocated with @ref ups_cache_pool_create and deleted
+ * with @ref ups_cache_pool_close.
+ */
+struct ups_cache_pool_t;
+typedef struct ups_cache_pool_t ups_cache_pool_t;
+
+/**
+ * A batch of write operations
+ *
+ * This structure is allocated with @ref ups_batch_create and deleted with
+ * @ref ups_batch_close. It is applied with @ref ups_db_write_batch.
+ */
+struct ups_batch_t;
+typedef struct ups_batch_t ups_batch_t;
+
 /**
  * A generic record.
  *
@@ -198,6 +229,12 @@ typedef struct ups_cursor_t ups_cursor_t;
  * The record->data pointer is not threadsafe. For threadsafe access it is
  * recommended to use @a UPS_RECORD_USER_ALLOC or have each thread manage its
  * own Txn.
+ *
+ * Temporary record buffers are taken from an arena of the Txn (or, if
+ * Transactions are disabled, of the Database) which grows on demand and
+ * is only released when the Txn is committed or aborted (or the Database
+ * is closed). Fetching records therefore does not call malloc once the
+ * arena is large enough.
  */
 typedef struct {
   /** The size of the record data, in bytes */
@@ -224,6 +261,23 @@ typedef struct {
  */
 #define ups_make_record(PTR, SIZE) { SIZE, PTR, 0 }
 
+/**
+ * A segment of a record.
+ *
+ * An array of segments describes a record which is scattered over several
+ * buffers, i.e. a header, a payload and a trailer. The segments are
+ * concatenated in the order of the array. See @ref ups_db_insert_iov and
+ * @ref ups_cursor_insert_iov.
+ */
+typedef struct {
+  /** The size of the segment data, in bytes */
+  uint32_t size;
+
+  /** Pointer to the segment data */
+  void *data;
+
+} ups_record_iov_t;
+
 /**
  * A generic key.
  *
@@ -304,6 +358,34 @@ typedef struct {
 
 } ups_parameter_t;
 
+/**
+ * A memory allocator.
+ *
+ * Can be specified with @ref UPS_PARAM_ALLOCATOR to replace malloc(3),
+ * realloc(3) and free(3) for the memory of an Environment (i.e. to use
+ * jemalloc or mimalloc arenas). The structure is not copied and must stay
+ * valid till the Environment is closed; all functions must be thread-safe.
+ *
+ * Pages of the cache, the pools and arenas for short-lived objects and
+ * the buffers which are returned in @ref ups_key_t and @ref ups_record_t
+ * are allocated with these functions. Memory of upscaledb's global state
+ * (i.e. the compare and plugin registries) is always allocated with malloc.
+ */
+typedef struct {
+  /** Allocates @a size bytes; returns NULL if out of memory */
+  void *(*alloc)(void *context, size_t size);
+
+  /** Resizes the allocation @a ptr (which can be NULL) to @a size bytes */
+  void *(*realloc)(void *context, void *ptr, size_t size);
+
+  /** Releases the allocation @a ptr (which can be NULL) */
+  void (*free)(void *context, void *ptr);
+
+  /** A user-supplied pointer which is passed to the functions above */
+  void *context;
+
+} ups_allocator_t;
+
 
 /**
  * @defgroup ups_key_types upscaledb Key Types
@@ -533,22 +615,57 @@ ups_get_version(uint32_t *major, uint32_t *minor,
  * to provide recovery if the system crashes. These journal files can be
  * compressed by supplying the parameter
  * @ref UPS_PARAM_ENABLE_JOURNAL_COMPRESSION. Values are one of
- * @ref UPS_COMPRESSOR_ZLIB, @ref UPS_COMPRESSOR_SNAPPY etc. See the
+ * @ref UPS_COMPRESSOR_ZLIB, @ref UPS_COMPRESSOR_SNAPPY,
+ * @ref UPS_COMPRESSOR_LZ4, @ref UPS_COMPRESSOR_ZSTD etc. See the
  * upscaledb documentation for more details. This parameter is not
  * persisted.
  *
  * Upscaledb can transparently encrypt the generated file using
- * 128bit AES in CBC mode. The transactional journal is not encrypted.
+ * 128bit AES. The transactional journal is not encrypted.
  * Encryption can be enabled by specifying @ref UPS_PARAM_ENCRYPTION_KEY
  * (see below). The identical key has to be provided in @ref ups_env_open
  * as well. Ignored for remote Environments.
  *
+ * New Environments encrypt each page with AES-XTS, using the page address
+ * as the tweak (see @ref UPS_PARAM_ENCRYPTION_MODE). AES-128-XTS needs two
+ * different keys: the 16 byte @ref UPS_PARAM_ENCRYPTION_KEY encrypts the
+ * data, and the tweak key is derived from it by encrypting the block
+ * @ref UPS_ENCRYPTION_XTS_KDF_BLOCK with AES-128-ECB under that key. If
+ * libcrypto lacks AES-XTS then new Environments use AES-CBC, and files
+ * which use AES-XTS cannot be opened (@ref UPS_NOT_IMPLEMENTED).
+ *
+ * Unlike CBC, the blocks of a page are independent and are processed in
+ * parallel by the AES-NI and VAES instructions (or the ARMv8 crypto
+ * extensions), which are selected by libcrypto at runtime. Pages which
+ * are written by the background flusher are encrypted on the flusher
+ * thread, and pages which are read ahead (see @ref UPS_CURSOR_PREFETCH)
+ * are decrypted on the prefetch thread; only cache misses and synchronous
+ * flushes are encrypted on the calling thread.
+ *
  * CRC32 checksums are stored when a page is flushed, and verified
  * when it is fetched from disk if the flag @ref UPS_ENABLE_CRC32 is set.
  * API functions will return @ref UPS_INTEGRITY_VIOLATED in case of failed
  * verifications. Not allowed in In-Memory Environments. This flag is not
  * persisted.
  *
+ * An Environment can be partitioned into several physical Environments
+ * (see @ref UPS_PARAM_PARTITIONS). Each partition is stored in a separate
+ * file (@a filename with the suffix ".p0", ".p1" etc) and has its own
+ * lock, cache (@ref UPS_PARAM_CACHE_SIZE is divided among the partitions)
+ * and journal; @a filename stores the partition layout. Each key of a
+ * Database is stored in exactly one partition, which is selected by a
+ * hash of the key or by key ranges (see @ref UPS_PARAM_PARTITION_SCHEME).
+ * The partitioning is transparent: Databases are created in all
+ * partitions, @ref ups_db_insert, @ref ups_db_find and @ref ups_db_erase
+ * are routed to the partition of the key, Cursors merge the partitions in
+ * key order, and UQI queries are executed in all partitions in parallel
+ * and merged afterwards (aggregation plugins require a @a merge
+ * function). Operations on different partitions run in parallel.
+ * Transactions can span several partitions, but a commit is only atomic
+ * within each partition; after a crash, a Txn can be recovered in one
+ * partition and be lost in another. Record number Databases are not
+ * supported for partitioned Environments.
+ *
  * @param env A pointer to an Environment handle
  * @param filename The filename of the Environment file. If the file already
  *      exists, it is overwritten. Can be NULL for an In-Memory
@@ -580,6 +697,17 @@ ups_get_version(uint32_t *major, uint32_t *minor,
  *      Environment.
  *     <li>@ref UPS_ENABLE_CRC32</li> Stores (and verifies) CRC32
  *      checksums. Not allowed in combination with @ref UPS_IN_MEMORY.
+ *     <li>@ref UPS_ENABLE_CONCURRENT_READS</li> Allows lookups
+ *      (@ref ups_db_find, @ref ups_cursor_find, @ref ups_cursor_move) from
+ *      several threads to run in parallel. Btree pages are protected by
+ *      shared latches; only operations which modify the Database (insert,
+ *      erase, page splits and merges) acquire exclusive latches. Not
+ *      allowed in combination with @ref UPS_ENABLE_TRANSACTIONS.
+ *     <li>@ref UPS_ENABLE_BACKGROUND_MERGE</li> Committed Transactions are
+ *      merged into the Btree by a background thread. @ref ups_txn_commit
+ *      only appends the operations to the Txn index and the journal.
+ *      Requires @ref UPS_ENABLE_TRANSACTIONS. Not allowed in combination
+ *      with @ref UPS_FLUSH_TRANSACTIONS_IMMEDIATELY.
  *    </ul>
  *
  * @param mode File access rights for the new file. This is the @a mode
@@ -607,11 +735,187 @@ ups_get_version(uint32_t *major, uint32_t *minor,
  *      file. Ignored for remote Environments.
  *    <li>@ref UPS_PARAM_NETWORK_TIMEOUT_SEC</li> Timeout (in seconds) when
  *      waiting for data from a remote server. By default, no timeout is set.
+ *    <li>@ref UPS_PARAM_NETWORK_PIPELINE_DEPTH</li> The maximum number of
+ *      requests which are sent to a remote server without waiting for
+ *      the reply (see @ref ups_db_submit). The default is 64. Ignored for
+ *      local Environments.
+ *    <li>@ref UPS_PARAM_NETWORK_POOL_SIZE</li> The maximum number of
+ *      connections to a remote server. All remote Environments of a
+ *      process which connect to the same server (identified by host and
+ *      port) share a pool of persistent connections, and their
+ *      Environment, Database and Cursor handles are multiplexed over these
+ *      connections; each request carries an id which is used to match the
+ *      reply. The pool is created by the first Environment and uses its
+ *      setting. The default is 4. If set to 0 then the Environment opens
+ *      its own connection and does not share it. Ignored for local
+ *      Environments.
+ *    <li>@ref UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE</li> The number of
+ *      items which a remote Cursor fetches with a single request when
+ *      moving through the Database (see @ref ups_cursor_move). The
+ *      default is 64. If set to 0 or 1 then every move is sent to the
+ *      server. Ignored for local Environments.
+ *    <li>@ref UPS_PARAM_NETWORK_COMPRESSION</li> Compresses the keys and
+ *      records which are sent to and received from a remote server.
+ *      Allowed values are @ref UPS_COMPRESSOR_NONE (the default),
+ *      @ref UPS_COMPRESSOR_LZF, @ref UPS_COMPRESSOR_LZ4,
+ *      @ref UPS_COMPRESSOR_SNAPPY, @ref UPS_COMPRESSOR_ZLIB and
+ *      @ref UPS_COMPRESSOR_ZSTD. The algorithm is negotiated per
+ *      connection; if the server does not support it then the data is
+ *      sent uncompressed (@ref ups_env_get_parameters returns the
+ *      negotiated algorithm). Payloads smaller than 64 bytes, or which do
+ *      not become smaller, are sent uncompressed. If a Database of the
+ *      server uses the same algorithm for @ref UPS_PARAM_RECORD_COMPRESSION
+ *      then its records are sent as stored, without decompressing and
+ *      compressing them again. Ignored for local Environments.
  *    <li>@ref UPS_PARAM_ENABLE_JOURNAL_COMPRESSION</li> Compresses
  *      the journal files to reduce I/O. See notes above.
  *    <li>@ref UPS_PARAM_ENCRYPTION_KEY</li> The 16 byte long AES
  *      encryption key; enables AES encryption for the Environment file. Not
  *      allowed for In-Memory Environments. Ignored for remote Environments.
+ *    <li>@ref UPS_PARAM_ENCRYPTION_MODE</li> The cipher mode for
+ *      @ref UPS_PARAM_ENCRYPTION_KEY; either @ref UPS_ENCRYPTION_XTS (the
+ *      default if libcrypto supports it) or @ref UPS_ENCRYPTION_CBC, the
+ *      mode of Environments which were created with older versions.
+ *      Returns @ref UPS_NOT_IMPLEMENTED if @ref UPS_ENCRYPTION_XTS is
+ *      requested but not supported. This parameter is persisted.
+ *    <li>@ref UPS_PARAM_ENV_LOCK</li> Selects the lock which protects the
+ *      Environment. Allowed values are @ref UPS_ENV_LOCK_MUTEX (which is
+ *      the default) or @ref UPS_ENV_LOCK_HFAIRLOCK. Ignored for remote
+ *      Environments. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_SHARDS</li> The number of partitions of the
+ *      cache. Pages are distributed to the shards by their address, and
+ *      each shard has its own lock; cache hits do not acquire the
+ *      Environment lock. Must be a power of two and not larger than
+ *      @ref UPS_MAX_CACHE_SHARDS. The default is 1. This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_CACHE_POLICY</li> The replacement policy of the
+ *      cache. Allowed values are @ref UPS_CACHE_POLICY_LRU (which is the
+ *      default) or @ref UPS_CACHE_POLICY_2Q. This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_JOURNAL_GROUP_COMMIT_USEC</li> If @ref
+ *      UPS_ENABLE_FSYNC is set, Transactions which are committed
+ *      concurrently within this time window (in microseconds) are written
+ *      to the journal and flushed with a single fsync(). @ref ups_txn_commit
+ *      still returns after the Transaction is durable. The default is 0
+ *      (each commit is flushed separately). This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_JOURNAL_PREALLOCATE_SIZE</li> Preallocates each
+ *      journal file with fallocate() to this size (in bytes) and recycles
+ *      the two journal files at a switch instead of truncating them. Since
+ *      the file size no longer changes, a flush only needs fdatasync()
+ *      instead of fsync(). Stale entries of a recycled file are ignored
+ *      during recovery because their lsn is older than the file header.
+ *      The default is 0 (the journal files grow with each append). This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_JOURNAL_DIRECT_IO</li> If set to 1, the journal
+ *      files are opened with O_DIRECT (FILE_FLAG_NO_BUFFERING on Windows)
+ *      and all journal writes are padded to aligned blocks of 4 kb. This
+ *      keeps the journal out of the page cache, which is useful if
+ *      @ref UPS_PARAM_LOG_DIRECTORY is on a dedicated device. Requires
+ *      @ref UPS_PARAM_JOURNAL_PREALLOCATE_SIZE. If the file system does not
+ *      support direct I/O then buffered I/O is used, and
+ *      @ref ups_env_get_parameters returns 0. The default is 0. This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CURSOR_PREFETCH_PAGES</li> The number of leaf
+ *      pages which are read ahead by Cursors (see @ref UPS_CURSOR_PREFETCH).
+ *      The default is 4. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_IO_BACKEND</li> Selects the device backend for
+ *      page reads, page flushes and journal writes. Allowed values are
+ *      @ref UPS_IO_BACKEND_DEFAULT (which is the default) or
+ *      @ref UPS_IO_BACKEND_IO_URING. Returns @ref UPS_NOT_IMPLEMENTED
+ *      if io_uring is not available. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_IO_QUEUE_DEPTH</li> The number of entries of the
+ *      io_uring submission queue. The default is 64. This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_FLUSHER_DIRTY_RATIO</li> Enables a background
+ *      thread which flushes dirty pages whenever more than this percentage
+ *      of the cache is dirty, and writes a checkpoint whenever the journal
+ *      is switched (see @ref UPS_PARAM_JOURNAL_SWITCH_THRESHOLD). Cache
+ *      evictions in the calling thread then rarely have to write pages.
+ *      The default is 0 (disabled). Ignored for In-Memory Environments.
+ *      This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_ALLOCATOR</li> A pointer to a
+ *      @ref ups_allocator_t structure which replaces malloc, realloc and
+ *      free for the memory of this Environment. Short-lived objects
+ *      (temporary Cursors, the operations of Transactions and the
+ *      temporary key and record buffers) are allocated from per-thread
+ *      pools and per-Transaction arenas, which request their memory in
+ *      large blocks from this allocator. The default is NULL (the C
+ *      library allocator). Ignored for remote Environments. This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_COMPACTION_FILL_FACTOR</li> Enables a background
+ *      thread which compacts the Environment (see @ref ups_env_compact)
+ *      when many leaf nodes are filled less than this percentage. Two
+ *      neighbouring leaves are merged if the result is filled less than
+ *      (100 + this value) / 2 percent. Allowed values are 0 (disabled,
+ *      which is the default) till 50. Ignored for remote Environments.
+ *      This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_COMPACTION_RATE</li> The maximum number of
+ *      pages which are read or written by the compaction per second. The
+ *      default is 1000. 0 means no limit. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_HUGE_PAGES</li> Backs the cache with an
+ *      arena of huge pages which is reserved when the Environment is
+ *      opened, instead of allocating each page separately. Allowed values
+ *      are @ref UPS_HUGE_PAGES_NONE (the default), @ref UPS_HUGE_PAGES_2MB
+ *      and @ref UPS_HUGE_PAGES_1GB. The arena is rounded up to the size
+ *      of a huge page. If not enough huge pages are available (see
+ *      /proc/sys/vm/nr_hugepages) then transparent huge pages are
+ *      requested with madvise(MADV_HUGEPAGE), and if this fails as well
+ *      the cache falls back to regular pages. If the file is mapped
+ *      (see @ref UPS_DISABLE_MMAP) then the mapping is also advised with
+ *      MADV_HUGEPAGE. Ignored for remote Environments. This parameter is
+ *      not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_NUMA_POLICY</li> Places the memory of the
+ *      cache on the NUMA nodes. Allowed values are @ref UPS_NUMA_NONE (the
+ *      default), @ref UPS_NUMA_INTERLEAVE and @ref UPS_NUMA_LOCAL.
+ *      Requires libnuma; otherwise the parameter is ignored. Ignored for
+ *      remote Environments. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_WARMUP</li> Persists the addresses of
+ *      the hottest pages of the cache (at most this number of pages) to a
+ *      sidecar file "<filename>.warm" in the directory of the journal
+ *      (see @ref UPS_PARAM_LOG_DIRECTORY). The file is written by
+ *      @ref ups_env_close and by each checkpoint of the background flusher
+ *      (see @ref UPS_PARAM_FLUSHER_DIRTY_RATIO). When the Environment is
+ *      opened, these pages are read by background threads in address
+ *      order (and in batches, if @ref UPS_IO_BACKEND_IO_URING is used)
+ *      while the application accesses the Environment; pages are read at
+ *      most up to the cache size. A missing, stale or corrupt file is
+ *      ignored. The default is 0 (disabled). Ignored for In-Memory and
+ *      remote Environments. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_COMPRESSED_SIZE</li> The size (in bytes)
+ *      of a second cache tier, which keeps clean pages that were evicted
+ *      from the cache compressed in memory. A page which is not found in
+ *      the cache is first looked up in this tier and decompressed, before
+ *      it is read from disk. Pages which do not compress to 75 percent of
+ *      the page size or less are not stored. The tier has its own LRU
+ *      list and is not included in @ref UPS_PARAM_CACHE_SIZE. The default
+ *      is 0 (disabled). Ignored for In-Memory and remote Environments.
+ *      This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_COMPRESSOR</li> The algorithm of the
+ *      compressed cache tier; either @ref UPS_COMPRESSOR_LZ4 (the default)
+ *      or @ref UPS_COMPRESSOR_LZF. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_POOL</li> Attaches the Environment to
+ *      a shared cache which was created with @ref ups_cache_pool_create
+ *      (the @a value of this parameter is a ups_cache_pool_t * pointer
+ *      casted to a uint64_t variable). The pages of the Environment are
+ *      then managed by the pool, and @ref UPS_PARAM_CACHE_SIZE,
+ *      @ref UPS_PARAM_CACHE_SHARDS and @ref UPS_PARAM_CACHE_POLICY are
+ *      ignored. Ignored for In-Memory and remote Environments. This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_PARTITIONS</li> The number of partitions
+ *      (between 1 and 256). The default is 1 (not partitioned). Not
+ *      allowed for In-Memory or remote Environments. This parameter is
+ *      persisted.
+ *    <li>@ref UPS_PARAM_PARTITION_SCHEME</li> Selects the partition of a
+ *      key. Allowed values are @ref UPS_PARTITION_HASH (which is the
+ *      default) or @ref UPS_PARTITION_RANGE. This parameter is persisted.
+ *    <li>@ref UPS_PARAM_PARTITION_BOUNDARIES</li> A pointer to an array
+ *      of (partitions - 1) sorted @ref ups_key_t structures, which is
+ *      required for @ref UPS_PARTITION_RANGE. Partition 0 stores the keys
+ *      which are less than the first boundary, partition n the keys which
+ *      are greater than or equal to boundary n - 1 and less than boundary n.
+ *      The keys are compared with the compare function of each Database.
+ *      This parameter is persisted.
  *    </ul>
  *
  * @return @ref UPS_SUCCESS upon success
@@ -696,9 +1000,20 @@ ups_env_create(ups_env_t **env, const char *filename,
  *     <li>@ref UPS_DISABLE_RECOVERY</li> Disables logging/recovery for this
  *      Environment.
  *     <li>@ref UPS_AUTO_RECOVERY </li> Automatically recover the Environment,
- *      if necessary.
+ *      if necessary. The journal files are parsed in parallel, the
+ *      changesets are grouped by page and pages are restored concurrently
+ *      (see @ref UPS_PARAM_RECOVERY_THREADS). Transactions which were
+ *      still active when the Environment crashed are aborted, unless
+ *      @ref UPS_PARAM_RECOVERY_TXN_POLICY is set to
+ *      @ref UPS_RECOVERY_RESTORE_TXNS.
  *     <li>@ref UPS_ENABLE_CRC32</li> Stores (and verifies) CRC32
  *      checksums.
+ *     <li>@ref UPS_ENABLE_CONCURRENT_READS</li> Allows lookups from
+ *      several threads to run in parallel. See @ref ups_env_create
+ *      for details.
+ *     <li>@ref UPS_ENABLE_BACKGROUND_MERGE</li> Committed Transactions are
+ *      merged into the Btree by a background thread. See
+ *      @ref ups_env_create for details.
  *    </ul>
  * @param param An array of ups_parameter_t structures. The following
  *      parameters are available:
@@ -718,11 +1033,180 @@ ups_env_create(ups_env_t **env, const char *filename,
  *      file. Ignored for remote Environments.
  *    <li>@ref UPS_PARAM_NETWORK_TIMEOUT_SEC</li> Timeout (in seconds) when
  *      waiting for data from a remote server. By default, no timeout is set.
+ *    <li>@ref UPS_PARAM_NETWORK_PIPELINE_DEPTH</li> The maximum number of
+ *      requests which are sent to a remote server without waiting for
+ *      the reply (see @ref ups_db_submit). The default is 64. Ignored for
+ *      local Environments.
+ *    <li>@ref UPS_PARAM_NETWORK_POOL_SIZE</li> The maximum number of
+ *      connections to a remote server. All remote Environments of a
+ *      process which connect to the same server (identified by host and
+ *      port) share a pool of persistent connections, and their
+ *      Environment, Database and Cursor handles are multiplexed over these
+ *      connections; each request carries an id which is used to match the
+ *      reply. The pool is created by the first Environment and uses its
+ *      setting. The default is 4. If set to 0 then the Environment opens
+ *      its own connection and does not share it. Ignored for local
+ *      Environments.
+ *    <li>@ref UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE</li> The number of
+ *      items which a remote Cursor fetches with a single request when
+ *      moving through the Database (see @ref ups_cursor_move). The
+ *      default is 64. If set to 0 or 1 then every move is sent to the
+ *      server. Ignored for local Environments.
+ *    <li>@ref UPS_PARAM_NETWORK_COMPRESSION</li> Compresses the keys and
+ *      records which are sent to and received from a remote server.
+ *      Allowed values are @ref UPS_COMPRESSOR_NONE (the default),
+ *      @ref UPS_COMPRESSOR_LZF, @ref UPS_COMPRESSOR_LZ4,
+ *      @ref UPS_COMPRESSOR_SNAPPY, @ref UPS_COMPRESSOR_ZLIB and
+ *      @ref UPS_COMPRESSOR_ZSTD. The algorithm is negotiated per
+ *      connection; if the server does not support it then the data is
+ *      sent uncompressed (@ref ups_env_get_parameters returns the
+ *      negotiated algorithm). Payloads smaller than 64 bytes, or which do
+ *      not become smaller, are sent uncompressed. If a Database of the
+ *      server uses the same algorithm for @ref UPS_PARAM_RECORD_COMPRESSION
+ *      then its records are sent as stored, without decompressing and
+ *      compressing them again. Ignored for local Environments.
  *    <li>@ref UPS_PARAM_JOURNAL_COMPRESSION</li> Compresses
  *      the journal files to reduce I/O. See notes above.
  *    <li>@ref UPS_PARAM_ENCRYPTION_KEY</li> The 16 byte long AES
  *      encryption key; enables AES encryption for the Environment file. Not
  *      allowed for In-Memory Environments. Ignored for remote Environments.
+ *      The cipher mode (see @ref UPS_PARAM_ENCRYPTION_MODE) is read from
+ *      the file.
+ *    <li>@ref UPS_PARAM_ENV_LOCK</li> Selects the lock which protects the
+ *      Environment. Allowed values are @ref UPS_ENV_LOCK_MUTEX (which is
+ *      the default) or @ref UPS_ENV_LOCK_HFAIRLOCK. Ignored for remote
+ *      Environments. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_SHARDS</li> The number of partitions of the
+ *      cache. Pages are distributed to the shards by their address, and
+ *      each shard has its own lock; cache hits do not acquire the
+ *      Environment lock. Must be a power of two and not larger than
+ *      @ref UPS_MAX_CACHE_SHARDS. The default is 1. This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_CACHE_POLICY</li> The replacement policy of the
+ *      cache. Allowed values are @ref UPS_CACHE_POLICY_LRU (which is the
+ *      default) or @ref UPS_CACHE_POLICY_2Q. This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_JOURNAL_GROUP_COMMIT_USEC</li> If @ref
+ *      UPS_ENABLE_FSYNC is set, Transactions which are committed
+ *      concurrently within this time window (in microseconds) are written
+ *      to the journal and flushed with a single fsync(). @ref ups_txn_commit
+ *      still returns after the Transaction is durable. The default is 0
+ *      (each commit is flushed separately). This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_JOURNAL_PREALLOCATE_SIZE</li> Preallocates each
+ *      journal file with fallocate() to this size (in bytes) and recycles
+ *      the two journal files at a switch instead of truncating them. Since
+ *      the file size no longer changes, a flush only needs fdatasync()
+ *      instead of fsync(). Stale entries of a recycled file are ignored
+ *      during recovery because their lsn is older than the file header.
+ *      The default is 0 (the journal files grow with each append). This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_JOURNAL_DIRECT_IO</li> If set to 1, the journal
+ *      files are opened with O_DIRECT (FILE_FLAG_NO_BUFFERING on Windows)
+ *      and all journal writes are padded to aligned blocks of 4 kb. This
+ *      keeps the journal out of the page cache, which is useful if
+ *      @ref UPS_PARAM_LOG_DIRECTORY is on a dedicated device. Requires
+ *      @ref UPS_PARAM_JOURNAL_PREALLOCATE_SIZE. If the file system does not
+ *      support direct I/O then buffered I/O is used, and
+ *      @ref ups_env_get_parameters returns 0. The default is 0. This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CURSOR_PREFETCH_PAGES</li> The number of leaf
+ *      pages which are read ahead by Cursors (see @ref UPS_CURSOR_PREFETCH).
+ *      The default is 4. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_IO_BACKEND</li> Selects the device backend for
+ *      page reads, page flushes and journal writes. Allowed values are
+ *      @ref UPS_IO_BACKEND_DEFAULT (which is the default) or
+ *      @ref UPS_IO_BACKEND_IO_URING. Returns @ref UPS_NOT_IMPLEMENTED
+ *      if io_uring is not available. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_IO_QUEUE_DEPTH</li> The number of entries of the
+ *      io_uring submission queue. The default is 64. This parameter is not
+ *      persisted.
+ *    <li>@ref UPS_PARAM_FLUSHER_DIRTY_RATIO</li> Enables a background
+ *      thread which flushes dirty pages whenever more than this percentage
+ *      of the cache is dirty, and writes a checkpoint whenever the journal
+ *      is switched (see @ref UPS_PARAM_JOURNAL_SWITCH_THRESHOLD). Cache
+ *      evictions in the calling thread then rarely have to write pages.
+ *      The default is 0 (disabled). Ignored for In-Memory Environments.
+ *      This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_ALLOCATOR</li> A pointer to a
+ *      @ref ups_allocator_t structure which replaces malloc, realloc and
+ *      free for the memory of this Environment. Short-lived objects
+ *      (temporary Cursors, the operations of Transactions and the
+ *      temporary key and record buffers) are allocated from per-thread
+ *      pools and per-Transaction arenas, which request their memory in
+ *      large blocks from this allocator. The default is NULL (the C
+ *      library allocator). Ignored for remote Environments. This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_HUGE_PAGES</li> Backs the cache with an
+ *      arena of huge pages which is reserved when the Environment is
+ *      opened, instead of allocating each page separately. Allowed values
+ *      are @ref UPS_HUGE_PAGES_NONE (the default), @ref UPS_HUGE_PAGES_2MB
+ *      and @ref UPS_HUGE_PAGES_1GB. The arena is rounded up to the size
+ *      of a huge page. If not enough huge pages are available (see
+ *      /proc/sys/vm/nr_hugepages) then transparent huge pages are
+ *      requested with madvise(MADV_HUGEPAGE), and if this fails as well
+ *      the cache falls back to regular pages. If the file is mapped
+ *      (see @ref UPS_DISABLE_MMAP) then the mapping is also advised with
+ *      MADV_HUGEPAGE. Ignored for remote Environments. This parameter is
+ *      not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_NUMA_POLICY</li> Places the memory of the
+ *      cache on the NUMA nodes. Allowed values are @ref UPS_NUMA_NONE (the
+ *      default), @ref UPS_NUMA_INTERLEAVE and @ref UPS_NUMA_LOCAL.
+ *      Requires libnuma; otherwise the parameter is ignored. Ignored for
+ *      remote Environments. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_WARMUP</li> Persists the addresses of
+ *      the hottest pages of the cache (at most this number of pages) to a
+ *      sidecar file "<filename>.warm" in the directory of the journal
+ *      (see @ref UPS_PARAM_LOG_DIRECTORY). The file is written by
+ *      @ref ups_env_close and by each checkpoint of the background flusher
+ *      (see @ref UPS_PARAM_FLUSHER_DIRTY_RATIO). When the Environment is
+ *      opened, these pages are read by background threads in address
+ *      order (and in batches, if @ref UPS_IO_BACKEND_IO_URING is used)
+ *      while the application accesses the Environment; pages are read at
+ *      most up to the cache size. A missing, stale or corrupt file is
+ *      ignored. The default is 0 (disabled). Ignored for In-Memory and
+ *      remote Environments. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_COMPRESSED_SIZE</li> The size (in bytes)
+ *      of a second cache tier, which keeps clean pages that were evicted
+ *      from the cache compressed in memory. A page which is not found in
+ *      the cache is first looked up in this tier and decompressed, before
+ *      it is read from disk. Pages which do not compress to 75 percent of
+ *      the page size or less are not stored. The tier has its own LRU
+ *      list and is not included in @ref UPS_PARAM_CACHE_SIZE. The default
+ *      is 0 (disabled). Ignored for In-Memory and remote Environments.
+ *      This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_COMPRESSOR</li> The algorithm of the
+ *      compressed cache tier; either @ref UPS_COMPRESSOR_LZ4 (the default)
+ *      or @ref UPS_COMPRESSOR_LZF. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_CACHE_POOL</li> Attaches the Environment to
+ *      a shared cache which was created with @ref ups_cache_pool_create
+ *      (the @a value of this parameter is a ups_cache_pool_t * pointer
+ *      casted to a uint64_t variable). The pages of the Environment are
+ *      then managed by the pool, and @ref UPS_PARAM_CACHE_SIZE,
+ *      @ref UPS_PARAM_CACHE_SHARDS and @ref UPS_PARAM_CACHE_POLICY are
+ *      ignored. Ignored for In-Memory and remote Environments. This
+ *      parameter is not persisted.
+ *    <li>@ref UPS_PARAM_RECOVERY_THREADS</li> The number of threads
+ *      which restore the pages when the Environment is recovered (see
+ *      @ref UPS_AUTO_RECOVERY). Changesets of different pages are
+ *      independent and applied concurrently; the changesets of each page
+ *      are applied in journal order. The default is 0 (one thread per
+ *      CPU core, but at most 8). This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_RECOVERY_TXN_POLICY</li> Selects what happens
+ *      with Transactions which were active (neither committed nor
+ *      aborted) when the Environment crashed. Allowed values are
+ *      @ref UPS_RECOVERY_ABORT_TXNS (which is the default) or
+ *      @ref UPS_RECOVERY_RESTORE_TXNS. This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_COMPACTION_FILL_FACTOR</li> Enables a background
+ *      thread which compacts the Environment (see @ref ups_env_compact)
+ *      when many leaf nodes are filled less than this percentage. Two
+ *      neighbouring leaves are merged if the result is filled less than
+ *      (100 + this value) / 2 percent. Allowed values are 0 (disabled,
+ *      which is the default) till 50. Ignored for remote Environments.
+ *      This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_COMPACTION_RATE</li> The maximum number of
+ *      pages which are read or written by the compaction per second. The
+ *      default is 1000. 0 means no limit. This parameter is not persisted.
  *    </ul>
  *
  * @return @ref UPS_SUCCESS upon success.
@@ -751,6 +1235,14 @@ ups_env_open(ups_env_t **env, const char *filename,
  * The following parameters are supported:
  *    <ul>
  *    <li>UPS_PARAM_CACHE_SIZE</li> returns the cache size
+ *    <li>UPS_PARAM_CACHE_SHARDS</li> returns the number of cache shards
+ *    <li>UPS_PARAM_CACHE_POLICY</li> returns the cache replacement policy
+ *    <li>UPS_PARAM_CACHE_COMPRESSED_SIZE</li> returns the size of the
+ *        compressed cache tier, or 0 if it is disabled
+ *    <li>UPS_PARAM_IO_BACKEND</li> returns the device backend
+ *    <li>UPS_PARAM_CACHE_HUGE_PAGES</li> returns the huge pages which
+ *        back the cache, or @ref UPS_HUGE_PAGES_NONE if the Environment
+ *        fell back to regular pages
  *    <li>UPS_PARAM_PAGE_SIZE</li> returns the page size
  *    <li>UPS_PARAM_MAX_DATABASES</li> returns the max. number of
  *        Databases of this Database's Environment
@@ -766,6 +1258,16 @@ ups_env_open(ups_env_t **env, const char *filename,
  *    <li>@ref UPS_PARAM_JOURNAL_COMPRESSION</li> Returns the
  *        selected algorithm for journal compression, or 0 if compression
  *        is disabled
+ *    <li>@ref UPS_PARAM_JOURNAL_PREALLOCATE_SIZE</li> Returns the
+ *        preallocated size of the journal files, or 0
+ *    <li>@ref UPS_PARAM_JOURNAL_DIRECT_IO</li> Returns 1 if the journal
+ *        is written with direct I/O, otherwise 0
+ *    <li>@ref UPS_PARAM_NETWORK_COMPRESSION</li> Returns the compression
+ *        algorithm which was negotiated with the remote server
+ *    <li>@ref UPS_PARAM_PARTITIONS</li> Returns the number of partitions
+ *    <li>@ref UPS_PARAM_PARTITION_SCHEME</li> Returns the partition scheme
+ *    <li>@ref UPS_PARAM_ENCRYPTION_MODE</li> Returns the cipher mode, or
+ *        0 if encryption is disabled
  *    </ul>
  *
  * @param env A valid Environment handle
@@ -809,6 +1311,17 @@ ups_env_get_parameters(ups_env_t *env, ups_parameter_t *param);
  * For fixed-length keys (without duplicates) the "pax" layout is chosen.
  * The "pax" layout is more compact and usually faster.
  *
+ * For read-mostly Databases with @ref UPS_TYPE_UINT32 or
+ * @ref UPS_TYPE_UINT64 keys (without duplicates and without key
+ * compression), the keys of a "pax" leaf can additionally be arranged
+ * in a cache-friendly order with @ref UPS_PARAM_KEY_LAYOUT. The
+ * @ref UPS_KEY_LAYOUT_EYTZINGER layout stores the keys in breadth-first
+ * order of an implicit binary search tree; the @ref UPS_KEY_LAYOUT_BLOCKED
+ * layout stores them as a static B+-tree of cache-line sized blocks (8 or
+ * 16 keys per block), and a lookup touches about log16(n) cache lines
+ * instead of log2(n). Both layouts make inserts and deletes in a node
+ * more expensive, because the node has to be re-arranged.
+ *
  * A word of warning regarding the use of fixed length binary keys
  * (@ref UPS_TYPE_CUSTOM or @ref UPS_TYPE_BINARY in combination with
  * @ref UPS_PARAM_KEY_SIZE): if your key size is too large, only few keys
@@ -868,10 +1381,44 @@ ups_env_get_parameters(ups_env_t *env, ups_parameter_t *param);
  * @ref UPS_COMPRESSOR_ZLIB, @ref UPS_COMPRESSOR_SNAPPY etc. See the
  * upscaledb documentation for more details.
  *
+ * @ref UPS_COMPRESSOR_LZ4 is the fastest of these algorithms,
+ * @ref UPS_COMPRESSOR_ZSTD achieves the best compression ratio. Small
+ * records usually do not compress well on their own. Therefore zstd can
+ * use a dictionary which is trained from the first records of the
+ * Database: set @ref UPS_PARAM_RECORD_COMPRESSION_DICTIONARY to the number
+ * of sample records. These records are compressed without the dictionary.
+ * When the last sample record is inserted, the dictionary (at most
+ * @ref UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE bytes) is trained and
+ * stored in the Environment header; all following records are compressed
+ * with the dictionary. Both parameters are persisted. The effect of the
+ * compression is reported in the metrics
+ * (ups_env_metrics_t::record_bytes_before_compression and
+ * ups_env_metrics_t::record_bytes_after_compression).
+ *
+ * Records which are not stored in the Btree leaf nodes are stored in
+ * blob pages. Each Database allocates its own blob pages (blob pages are
+ * not shared between Databases), and new blobs are appended to the blob
+ * page which was last used by this Database. Therefore scans over the
+ * records of a Database (i.e. with @ref uqi_select) only read pages
+ * of this Database, even if many Databases are stored in the same
+ * Environment.
+ *
  * Keys can also be compressed by setting the parameter
  * @ref UPS_PARAM_KEY_COMPRESSION. See the upscaledb documentation
  * for more details.
  *
+ * Variable length @ref UPS_TYPE_BINARY keys with long common prefixes
+ * (i.e. URLs or paths) should use @ref UPS_COMPRESSOR_PREFIX. Each key in
+ * a leaf node then only stores the length of the prefix which it shares
+ * with the previous key, and the remaining suffix; every 16th key is
+ * stored in full, and the binary search runs over these restart points.
+ * Since only the suffix has to fit into the node, far fewer keys are
+ * moved to the overflow area (see ups_env_metrics_t::extended_keys).
+ * The internal nodes store the shortest separator which distinguishes
+ * two neighbouring leaves instead of a full key, which increases the
+ * fan-out and reduces the height of the Btree. The space which is saved
+ * is reported in btree_metrics_t::keylist_prefix_savings.
+ *
  * In addition, several integer compression algorithms are available
  * for Databases created with the type @ref UPS_TYPE_UINT32. Note that
  * integer compression only works with the default page size of 16kb.
@@ -890,8 +1437,25 @@ ups_env_get_parameters(ups_env_t *env, ups_parameter_t *param);
  *      especially for keys that are not dense (i.e. with "gaps"). If possible,
  *      uses AVX-instructions based on MaskedVbyte. Otherwise falls back to
  *      a plain C implementation.</li>
+ *   <li>@ref UPS_COMPRESSOR_UINT32_STREAMVBYTE: Similar compression as
+ *      @ref UPS_COMPRESSOR_UINT32_VARBYTE, but decodes four integers at
+ *      once with SSSE3 instructions. Very fast for unsorted lookups and
+ *      scans.</li>
+ *   <li>@ref UPS_COMPRESSOR_UINT32_GROUPVARINT: Like
+ *      @ref UPS_COMPRESSOR_UINT32_STREAMVBYTE, but stores the length
+ *      descriptors next to the data; slightly faster appends.</li>
  * </ul>
  *
+ * Duplicate records of type @ref UPS_TYPE_UINT32 or @ref UPS_TYPE_UINT64
+ * (see @ref UPS_PARAM_RECORD_TYPE) can be compressed with the parameter
+ * @ref UPS_PARAM_DUPLICATE_COMPRESSION. Supported are
+ * @ref UPS_COMPRESSOR_UINT32_VARBYTE (for uint32 and uint64),
+ * @ref UPS_COMPRESSOR_UINT32_FOR and @ref UPS_COMPRESSOR_UINT32_SIMDCOMP
+ * (uint32 only). The duplicates of a key are then delta-encoded and
+ * stored in ascending order of their record values; the position flags
+ * of @ref ups_db_insert and @ref ups_cursor_insert
+ * (@ref UPS_DUPLICATE_INSERT_FIRST etc) are ignored.
+ *
  * @param env A valid Environment handle.
  * @param db A valid Database handle, which will point to the created
  *      Database. To close the handle, use @ref ups_db_close.
@@ -916,6 +1480,42 @@ ups_env_get_parameters(ups_env_t *env, ups_parameter_t *param);
  *      (and key->flags is @ref UPS_KEY_USER_ALLOC), the value of the current
  *      key is returned in @a key. If key-data is NULL and key->size is 0,
  *      key->data is temporarily allocated by upscaledb.
+ *     <li>@ref UPS_HASH_INDEX </li> Stores the keys in an extendible hash
+ *      table instead of a Btree. Keys are hashed with MurmurHash3; each
+ *      bucket is a page, and a full bucket is split by doubling its share
+ *      of the directory. A lookup reads (at most) one bucket page, and the
+ *      directory is kept in memory. Transactions, the journal and record
+ *      compression work as usual. Cursors visit the keys in hash order,
+ *      which changes when buckets are split. @ref ups_db_find and
+ *      @ref ups_cursor_find only support exact matches (approximate
+ *      matching flags return @ref UPS_INV_PARAMETER), and
+ *      @ref ups_db_erase_range and @ref uqi_select_range are not
+ *      supported. Not allowed in combination with
+ *      @ref UPS_ENABLE_DUPLICATE_KEYS, Record Number Databases,
+ *      @ref UPS_PARAM_KEY_COMPRESSION, @ref UPS_PARAM_KEY_LAYOUT or
+ *      @ref UPS_PARAM_LEAF_SUMMARIES.
+ *     <li>@ref UPS_TIME_SERIES </li> Creates a Database for time series
+ *      with @ref UPS_TYPE_UINT64 keys (i.e. timestamps) and
+ *      @ref UPS_TYPE_REAL64 records; these are also the defaults for
+ *      @ref UPS_PARAM_KEY_TYPE and @ref UPS_PARAM_RECORD_TYPE. The leaf
+ *      nodes store blocks of keys and records: the keys are delta-of-delta
+ *      encoded and bit-packed with the Frame Of Reference codec of
+ *      @ref UPS_COMPRESSOR_UINT32_FOR (or @ref UPS_COMPRESSOR_UINT32_SIMDFOR
+ *      if SSE is available), and the records are XOR encoded against
+ *      their predecessor ("Gorilla" encoding). Each block stores the
+ *      number of keys and the sum, the minimum and the maximum of its
+ *      records, and @ref uqi_select_range answers SUM, AVERAGE, MIN, MAX
+ *      and COUNT of the blocks which are completely inside the range
+ *      without decoding them. New keys are appended to an uncompressed
+ *      tail block of the rightmost leaf, without a Btree descent; the
+ *      block is encoded when it is full. Keys which are not larger than
+ *      the largest key of the Database are allowed, but the block
+ *      which they belong to is decoded and encoded again. Not
+ *      allowed in combination with @ref UPS_ENABLE_DUPLICATE_KEYS,
+ *      Record Number Databases, @ref UPS_HASH_INDEX,
+ *      @ref UPS_PARAM_KEY_COMPRESSION, @ref UPS_PARAM_RECORD_COMPRESSION,
+ *      @ref UPS_PARAM_KEY_LAYOUT or @ref UPS_PARAM_MEMORY_INDEX, or with
+ *      other key and record types.
  *    </ul>
  *
  * @param params An array of ups_parameter_t structures. The following
@@ -935,16 +1535,100 @@ ups_env_get_parameters(ups_env_t *env, ups_parameter_t *param);
  *      specified (this is the default).
  *    <li>@ref UPS_PARAM_RECORD_COMPRESSION</li> Compresses
  *      the records.
+ *    <li>@ref UPS_PARAM_RECORD_COMPRESSION_DICTIONARY</li> The number of
+ *      records which are sampled for training a compression dictionary.
+ *      Requires @ref UPS_COMPRESSOR_ZSTD. The default is 0 (no dictionary).
+ *    <li>@ref UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE</li> The
+ *      maximum size of the compression dictionary, in bytes. The default
+ *      is 16kb.
  *    <li>@ref UPS_PARAM_KEY_COMPRESSION</li> Compresses
  *      the keys.
+ *    <li>@ref UPS_PARAM_DUPLICATE_COMPRESSION</li> Compresses
+ *      the duplicate records. Requires @ref UPS_ENABLE_DUPLICATE_KEYS.
+ *    <li>@ref UPS_PARAM_SEARCH_WINDOW</li> The number of keys at which
+ *      the binary search in a leaf node switches to a SIMD linear scan
+ *      (see @ref ups_env_open_db). This parameter is not persisted.
+ *    <li>@ref UPS_PARAM_KEY_LAYOUT</li> The order of the keys in the
+ *      leaf nodes; one of @ref UPS_KEY_LAYOUT_SORTED (the default),
+ *      @ref UPS_KEY_LAYOUT_EYTZINGER or @ref UPS_KEY_LAYOUT_BLOCKED.
+ *      Only valid for @ref UPS_TYPE_UINT32 and @ref UPS_TYPE_UINT64 keys
+ *      without @ref UPS_ENABLE_DUPLICATE_KEYS and without
+ *      @ref UPS_PARAM_KEY_COMPRESSION; otherwise @ref UPS_INV_PARAMETER
+ *      is returned. This parameter is persisted.
+ *    <li>@ref UPS_PARAM_LEAF_SUMMARIES</li> If set to 1, each leaf node
+ *      stores the minimum and maximum key and (for numeric record types)
+ *      the minimum and maximum record. The summaries are updated when
+ *      keys are inserted or erased, and are used by the UQI queries to
+ *      skip leaf nodes or to answer MIN, MAX and COUNT without decoding
+ *      the leaf (see @ref uqi_select_range). Requires a numeric
+ *      @ref UPS_PARAM_KEY_TYPE. The default is 0. This parameter is
+ *      persisted.
+ *    <li>@ref UPS_PARAM_BLOOM_FILTER_BITS</li> Enables an in-memory
+ *      Bloom filter over the keys of the Database, with this number of
+ *      bits per key (10 bits result in about 1% false positives).
+ *      @ref ups_db_find (without approximate matching flags) and
+ *      @ref ups_cursor_find then return @ref UPS_KEY_NOT_FOUND for most
+ *      missing keys without descending the Btree. Keys are added to the
+ *      filter when they are inserted, also in Transactions which are not
+ *      yet committed; erased keys remain in the filter until it is
+ *      rebuilt. Therefore the filter never hides an existing key. The
+ *      filter is written to the file with each checkpoint and when the
+ *      Environment is closed. If it is missing or stale when the
+ *      Database is opened (i.e. after a crash), lookups descend the Btree
+ *      while the filter is rebuilt in the background; the filter is also
+ *      rebuilt when it is full (see ups_env_metrics_t::bloom_filter_rebuilds).
+ *      Not allowed for Record Number Databases or with
+ *      @ref UPS_TYPE_CUSTOM. The default is 0 (disabled). This parameter
+ *      is persisted.
+ *    <li>@ref UPS_PARAM_MEMORY_INDEX</li> Selects the index structure of
+ *      a Database in an In-Memory Environment (@ref UPS_IN_MEMORY):
+ *      @ref UPS_MEMORY_INDEX_BTREE (the default) uses the page-based
+ *      Btree; @ref UPS_MEMORY_INDEX_ART uses an adaptive radix tree,
+ *      which has no pages, page headers or page manager, and grows and
+ *      shrinks with the number of keys. Keys are sorted byte-wise;
+ *      numeric key types (@ref UPS_PARAM_KEY_TYPE) are converted so
+ *      that their order does not change, but @ref UPS_TYPE_CUSTOM,
+ *      @ref UPS_PARAM_KEY_COMPRESSION, @ref UPS_PARAM_KEY_LAYOUT and
+ *      @ref UPS_PARAM_LEAF_SUMMARIES are not supported. Cursors are
+ *      ordered as usual. If Transactions are disabled then
+ *      @ref ups_db_find, @ref ups_cursor_find and @ref ups_cursor_move
+ *      do not acquire the Environment lock, and any number of threads
+ *      can read the Database while another thread modifies it. Returns
+ *      @ref UPS_INV_PARAMETER if the Environment is not an In-Memory
+ *      Environment.
+ *    <li>@ref UPS_PARAM_SUBTREE_COUNTS</li> If set to 1, the internal
+ *      Btree nodes store the number of keys and the number of records
+ *      (including duplicates) of each child's subtree. They are updated
+ *      when keys are inserted or erased and when nodes are split or
+ *      merged; every insert and erase therefore modifies all nodes
+ *      on the path from the root to the leaf. In exchange,
+ *      @ref ups_db_count (with or without @ref UPS_SKIP_DUPLICATES),
+ *      @ref ups_cursor_move_to_rank and @ref ups_cursor_get_rank are
+ *      logarithmic in the number of keys. Not allowed with
+ *      @ref UPS_PARAM_MEMORY_INDEX set to @ref UPS_MEMORY_INDEX_ART.
+ *      The default is 0 (disabled). This parameter is persisted.
+ *    <li>@ref UPS_PARAM_DB_PAGE_SIZE</li> The size of the Btree nodes
+ *      of this Database, in bytes. Must be a multiple of the page size
+ *      of the Environment (see @ref UPS_PARAM_PAGE_SIZE), and at most
+ *      16 times as large. Each node is allocated as a contiguous extent
+ *      of Environment pages and is read and written with a single I/O.
+ *      Small nodes suit point lookups of small keys, large nodes suit
+ *      scans over wide records. Blob pages still use the page size of
+ *      the Environment. See @ref ups_db_advise_page_size. The default
+ *      is the page size of the Environment. This parameter is persisted.
  *    <li>@ref UPS_PARAM_CUSTOM_COMPARE_NAME</li> Specifies the name of the
  *      custom compare function (only if @a UPS_PARAM_KEY_TYPE is @a
- *      UPS_TYPE_CUSTOM).
+ *      UPS_TYPE_CUSTOM). This is either a function which was registered
+ *      with @ref ups_register_compare, or one of the built-in functions
+ *      @ref UPS_COMPARE_MEMCMP_REVERSE, @ref UPS_COMPARE_CASE_INSENSITIVE
+ *      or @ref UPS_COMPARE_BIG_ENDIAN_COMPOSITE.
  *    </ul>
  *
  * @return @ref UPS_SUCCESS upon success
  * @return @ref UPS_INV_PARAMETER if the @a env pointer is NULL or an
  *        invalid combination of flags was specified
+ * @return @ref UPS_INV_PARAMETER if @ref UPS_PARAM_DB_PAGE_SIZE is not
+ *        a multiple of the Environment's page size
  * @return @ref UPS_DATABASE_ALREADY_EXISTS if a Database with this @a name
  *        already exists in this Environment
  * @return @ref UPS_OUT_OF_MEMORY if memory could not be allocated
@@ -991,7 +1675,18 @@ ups_env_create_db(ups_env_t *env, ups_db_t **db,
  *      Operations that need write access (i.e. @ref ups_db_insert) will
  *      return @ref UPS_WRITE_PROTECTED.
  *   </ul>
- * @param params Reserved; set to NULL
+ * @param params An array of ups_parameter_t structures. The following
+ *    parameters are available:
+ *    <ul>
+ *    <li>@ref UPS_PARAM_SEARCH_WINDOW</li> For uncompressed keys of type
+ *      @ref UPS_TYPE_UINT32, @ref UPS_TYPE_UINT64 and
+ *      @ref UPS_TYPE_REAL64: the binary search in a node stops when the
+ *      remaining range has fewer keys than this window, and scans the
+ *      remaining keys with SIMD compare instructions (AVX2 or SSE2,
+ *      selected at run-time). The value is rounded up to a multiple of
+ *      the SIMD register width. The default is 32; 0 disables the linear
+ *      scan. This parameter is not persisted.
+ *    </ul>
  *
  * @return @ref UPS_SUCCESS upon success
  * @return @ref UPS_INV_PARAMETER if the @a env pointer is NULL or an
@@ -1039,12 +1734,26 @@ ups_env_rename_db(ups_env_t *env, uint16_t oldname,
 /**
  * Deletes a Database from an Environment
  *
+ * By default, this function frees all pages of the Database before it
+ * returns, and blocks the Environment meanwhile. With
+ * @ref UPS_ERASE_DB_ASYNC, the Database is only unlinked from the
+ * Environment (its name can be reused immediately), and its pages are
+ * released by a background thread in batches. The pending pages are
+ * persisted; if the Environment is closed or crashes before all pages are
+ * released then the work is continued when it is opened again. See the
+ * metric |erase_db_pending_pages|.
+ *
  * @param env A valid Environment handle
  * @param name The name of the Database to delete. If a Database
  *      with this name does not exist, the function will fail with
  *      @ref UPS_DATABASE_NOT_FOUND. If the Database was already opened,
  *      the function will fail with @ref UPS_DATABASE_ALREADY_OPEN.
- * @param flags Optional flags for deleting the Database; unused, set to 0.
+ * @param flags Optional flags for deleting the Database, combined with
+ *      bitwise OR. Possible flags are:
+ *    <ul>
+ *     <li>@ref UPS_ERASE_DB_ASYNC</li> Releases the pages of the Database
+ *      in the background. Ignored for In-Memory Environments.
+ *    </ul>
  *
  * @return @ref UPS_SUCCESS upon success
  * @return @ref UPS_INV_PARAMETER if the @a env pointer is NULL or if
@@ -1057,6 +1766,9 @@ ups_env_rename_db(ups_env_t *env, uint16_t oldname,
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_env_erase_db(ups_env_t *env, uint16_t name, uint32_t flags);
 
+/** Flag for @ref ups_env_erase_db */
+#define UPS_ERASE_DB_ASYNC                  1
+
 /* internal flag - only flush committed transactions, not the btree pages */
 #define UPS_FLUSH_COMMITTED_TRANSACTIONS    1
 
@@ -1078,9 +1790,231 @@ ups_env_erase_db(ups_env_t *env, uint16_t name, uint32_t flags);
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_env_flush(ups_env_t *env, uint32_t flags);
 
+/**
+ * Compacts the Environment
+ *
+ * This function merges underfull leaf nodes of all Databases (see
+ * @ref UPS_PARAM_COMPACTION_FILL_FACTOR), moves blobs from sparse blob
+ * pages into dense pages and finally truncates the free pages at the end
+ * of the file. The work is split into small steps, and each step acquires
+ * the Environment lock only briefly; other threads can continue to use
+ * the Environment. Each step is written like any modifying operation, and
+ * therefore is recovered after a crash.
+ *
+ * The compaction is rate-limited with @ref UPS_PARAM_COMPACTION_RATE. If
+ * @ref UPS_PARAM_COMPACTION_FILL_FACTOR was set when the Environment was
+ * created or opened then a background thread runs the compaction
+ * whenever erased keys left enough underfull leaves; this function then
+ * only triggers an immediate run.
+ *
+ * A running compaction can be interrupted by calling this function with
+ * @ref UPS_COMPACT_STOP. The work which was done so far is kept, and
+ * the next run continues where it stopped.
+ *
+ * Since In-Memory Environments do not have a file on disk, the file is
+ * not truncated, but their leaves are merged.
+ *
+ * @param env A valid Environment handle
+ * @param flags Optional flags for compacting the Environment, combined
+ *      with bitwise OR. Possible flags are:
+ *    <ul>
+ *     <li>@ref UPS_COMPACT_ASYNC</li> Starts the compaction in a
+ *      background thread and returns immediately. Does nothing if a
+ *      compaction is already running.
+ *     <li>@ref UPS_COMPACT_STOP</li> Stops a running compaction and waits
+ *      till its current step is finished.
+ *    </ul>
+ *
+ * @return @ref UPS_SUCCESS upon success, even if the compaction was
+ *      stopped
+ * @return @ref UPS_INV_PARAMETER if @a env is NULL or both flags are
+ *      specified
+ * @return @ref UPS_WRITE_PROTECTED if the Environment is read-only
+ * @return @ref UPS_NOT_IMPLEMENTED if @a env is a remote Environment
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_env_compact(ups_env_t *env, uint32_t flags);
+
+/** Flag for @ref ups_env_compact */
+#define UPS_COMPACT_ASYNC                   1
+
+/** Flag for @ref ups_env_compact */
+#define UPS_COMPACT_STOP                    2
+
+/**
+ * Creates a consistent backup of the Environment
+ *
+ * Writes a copy of the Environment file to @a dest_path. The copy
+ * reflects the state of the Environment when the function was called;
+ * if Transactions are enabled then it contains all Transactions which
+ * were committed at this point, but none which were still active.
+ *
+ * The backup does not block other threads. It starts with a checkpoint,
+ * which is taken while the Environment lock is held briefly. Afterwards,
+ * other threads continue to read and write while the pages of the
+ * checkpoint are copied in the background. If a page is modified
+ * before it was copied then its checkpointed version is preserved
+ * (copy-on-write) before it is flushed, and the preserved copy is written
+ * to the backup instead. If journalling is enabled then the journal entries
+ * which were written up to the checkpoint are appended to the backup
+ * as @a dest_path with the extensions ".jrn0" and ".jrn1"; opening the
+ * backup then recovers them like after a crash.
+ *
+ * The backup can be opened with @ref ups_env_open like any other
+ * Environment file. Encryption keys, CRC32 checksums and the page size
+ * are the same as those of the Environment.
+ *
+ * Only one backup can run at a time.
+ *
+ * @param env A valid Environment handle
+ * @param dest_path The path of the backup file; an existing file is
+ *      overwritten
+ * @param flags Optional flags; unused, set to 0
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a env or @a dest_path is NULL, or if
+ *      @a env is an In-Memory Environment
+ * @return @ref UPS_IO_ERROR if @a dest_path could not be created or
+ *      written
+ * @return @ref UPS_LIMITS_REACHED if another backup is already running
+ * @return @ref UPS_NOT_IMPLEMENTED if @a env is a remote Environment
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_env_backup(ups_env_t *env, const char *dest_path, uint32_t flags);
+
+/**
+ * Creates a cache which is shared by several Environments
+ *
+ * By default, each Environment has its own cache, and the memory of a
+ * process is statically partitioned between its Environments. A cache pool
+ * has a single memory limit and a single replacement policy for the pages
+ * of all Environments which are attached to it (with
+ * @ref UPS_PARAM_CACHE_POOL in @ref ups_env_create or @ref ups_env_open).
+ * An Environment which is busy can therefore use the memory of idle
+ * Environments: when the pool is full, the least recently used page of any
+ * attached Environment is evicted. Dirty pages are flushed to their own
+ * Environment before they are evicted.
+ *
+ * The pool is thread-safe; the Environments which are attached to it can
+ * be used from different threads. Pages are distributed to the shards of
+ * the pool by their Environment and their address.
+ *
+ * @param pool A pointer to a pointer which is allocated for the new pool
+ * @param size The size of the pool, in bytes
+ * @param param An array of ups_parameter_t structures, or NULL. The
+ *      following parameters are available:
+ *    <ul>
+ *    <li>@ref UPS_PARAM_CACHE_SHARDS</li> The number of partitions of
+ *      the pool. Must be a power of two and not larger than
+ *      @ref UPS_MAX_CACHE_SHARDS. The default is 1.
+ *    <li>@ref UPS_PARAM_CACHE_POLICY</li> The replacement policy of the
+ *      pool; one of @ref UPS_CACHE_POLICY_LRU (the default) or
+ *      @ref UPS_CACHE_POLICY_2Q.
+ *    </ul>
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a pool is NULL or @a size is 0, or if
+ *      an invalid parameter was specified
+ * @return @ref UPS_OUT_OF_MEMORY if memory could not be allocated
+ *
+ * @sa ups_cache_pool_close
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cache_pool_create(ups_cache_pool_t **pool, uint64_t size,
+            const ups_parameter_t *param);
+
+/**
+ * Returns the usage of a cache pool
+ *
+ * @param pool A valid pool handle
+ * @param size Receives the size of the pool, in bytes; can be NULL
+ * @param used Receives the number of bytes which are currently used by
+ *      the pages of all attached Environments; can be NULL
+ * @param environments Receives the number of attached Environments;
+ *      can be NULL
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a pool is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cache_pool_get_usage(ups_cache_pool_t *pool, uint64_t *size,
+            uint64_t *used, uint32_t *environments);
+
+/**
+ * Releases a cache pool
+ *
+ * The pool must not be used for new Environments afterwards. If
+ * Environments are still attached then the memory is released when the
+ * last of them is closed.
+ *
+ * @param pool A valid pool handle
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a pool is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cache_pool_close(ups_cache_pool_t *pool);
+
 /* internal use only - don't lock mutex */
 #define UPS_DONT_LOCK        0xf0000000
 
+/**
+ * Assigns the calling thread to a scheduling class of the Environment lock
+ *
+ * If the Environment was created or opened with @ref UPS_PARAM_ENV_LOCK
+ * set to @ref UPS_ENV_LOCK_HFAIRLOCK then the Environment's critical
+ * section is granted to the threads according to their weight, and
+ * weights are balanced on each level of the lock hierarchy. Node 0 is the
+ * root of the hierarchy and always exists; further nodes are created
+ * with @ref ups_env_add_lock_node.
+ *
+ * This function has to be called by each thread before it accesses the
+ * Environment for the first time. Threads which did not call this function
+ * are attached to the root node with the default weight (1024).
+ *
+ * If the Environment uses the default lock (@ref UPS_ENV_LOCK_MUTEX)
+ * then this function has no effect and returns @ref UPS_SUCCESS.
+ *
+ * @param env A valid Environment handle
+ * @param weight The weight of the calling thread; must not be 0. A thread
+ *      with twice the weight of another thread will get twice the
+ *      share of the lock hold time
+ * @param parent The id of the parent node in the lock hierarchy
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a env is NULL, @a weight is 0 or
+ *      @a parent is not a valid node of the hierarchy
+ * @return @ref UPS_NOT_IMPLEMENTED if @a env is a remote Environment
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_env_set_thread_class(ups_env_t *env, uint32_t weight, int32_t parent);
+
+/**
+ * Adds a node to the hierarchy of the Environment lock
+ *
+ * The new node is a child of @a parent; it competes with its siblings
+ * (threads and other nodes) with the given @a weight, and its share of
+ * the lock hold time is balanced among its children. Threads are attached
+ * to a node with @ref ups_env_set_thread_class. Nodes cannot be removed.
+ *
+ * If the Environment uses the default lock (@ref UPS_ENV_LOCK_MUTEX)
+ * then the node is only recorded, and the function returns
+ * @ref UPS_SUCCESS as well.
+ *
+ * @param env A valid Environment handle
+ * @param weight The weight of the new node; must not be 0
+ * @param parent The id of the parent node (0 is the root)
+ * @param node Returns the id of the new node
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a env or @a node is NULL, @a weight
+ *      is 0 or @a parent is not a valid node of the hierarchy
+ * @return @ref UPS_NOT_IMPLEMENTED if @a env is a remote Environment
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_env_add_lock_node(ups_env_t *env, uint32_t weight, int32_t parent,
+                int32_t *node);
+
 /**
  * Returns the names of all Databases in an Environment
  *
@@ -1189,6 +2123,13 @@ typedef struct ups_txn_t ups_txn_t;
  *    <ul>
  *     <li>@ref UPS_TXN_READ_ONLY </li> This Txn is read-only and
  *      will not modify the Database.
+ *     <li>@ref UPS_TXN_SNAPSHOT </li> This Txn reads a consistent snapshot
+ *      of the Database, as it was when the Txn was started. It only sees
+ *      Transactions which were committed before, never acquires write
+ *      locks and never fails with @ref UPS_TXN_CONFLICT. Writers are not
+ *      blocked by snapshot Transactions, but older versions of modified
+ *      keys are retained until all snapshots which can see them are
+ *      closed. Requires @ref UPS_TXN_READ_ONLY.
  *    </ul>
  *
  * @return @ref UPS_SUCCESS upon success
@@ -1204,6 +2145,9 @@ ups_txn_begin(ups_txn_t **txn, ups_env_t *env, const char *name,
 /* Internal flag for @ref ups_txn_begin */
 #define UPS_TXN_TEMPORARY                     2
 
+/** Flag for @ref ups_txn_begin */
+#define UPS_TXN_SNAPSHOT                      4
+
 /**
  * Retrieves the Txn name
  *
@@ -1212,6 +2156,70 @@ ups_txn_begin(ups_txn_t **txn, ups_env_t *env, const char *name,
 UPS_EXPORT const char *
 ups_txn_get_name(ups_txn_t *txn);
 
+/**
+ * Retrieves the Txn id
+ *
+ * Txn ids are assigned in ascending order by @ref ups_txn_begin and are
+ * unique within an Environment.
+ *
+ * @returns 0 if @a txn is invalid
+ */
+UPS_EXPORT uint64_t
+ups_txn_get_id(ups_txn_t *txn);
+
+/**
+ * Retrieves information about the last conflict of a Txn
+ *
+ * If an operation of @a txn failed with @ref UPS_TXN_CONFLICT then this
+ * function returns the id of the Txn which caused the conflict (see
+ * @ref ups_txn_get_id) and the conflicting key. Conflicts are detected
+ * per key; operations on different keys of the same Database do not
+ * conflict.
+ *
+ * The key data is owned by @a txn and remains valid till the next
+ * operation of @a txn, or till @a txn is committed or aborted.
+ *
+ * @param txn Pointer to a Txn structure
+ * @param txn_id Receives the id of the conflicting Txn; can be NULL
+ * @param key Receives the conflicting key; can be NULL
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a txn is NULL
+ * @return @ref UPS_KEY_NOT_FOUND if the last operation of @a txn did not
+ *      fail with @ref UPS_TXN_CONFLICT
+ */
+UPS_EXPORT ups_status_t
+ups_txn_get_conflict_info(ups_txn_t *txn, uint64_t *txn_id, ups_key_t *key);
+
+/**
+ * Returns the Transactions which were restored by the recovery
+ *
+ * If the Environment was recovered with @ref UPS_PARAM_RECOVERY_TXN_POLICY
+ * set to @ref UPS_RECOVERY_RESTORE_TXNS then all Transactions which were
+ * active when the Environment crashed are re-created, with their original
+ * names and operations. The application has to commit or abort each of
+ * them with @ref ups_txn_commit or @ref ups_txn_abort; till then they
+ * hold their locks, and other Transactions can conflict with them.
+ *
+ * The memory for @a txns must be allocated by the user. @a length
+ * must be the length of @a txns when calling the function, and will be
+ * the number of restored Transactions when the function returns.
+ * Transactions which were already committed or aborted are not returned.
+ *
+ * @param env A valid Environment handle
+ * @param txns Pointer to an array for the Txn handles
+ * @param length Pointer to the length of the array; will be used to store
+ *      the number of restored Transactions when the function returns.
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a env, @a txns or @a length is NULL
+ * @return @ref UPS_LIMITS_REACHED if @a txns is not large enough to hold
+ *      all Transactions
+ */
+UPS_EXPORT ups_status_t
+ups_env_get_recovered_txns(ups_env_t *env, ups_txn_t **txns,
+            uint32_t *length);
+
 /**
  * Commits a Txn
  *
@@ -1233,6 +2241,54 @@ ups_txn_get_name(ups_txn_t *txn);
 UPS_EXPORT ups_status_t
 ups_txn_commit(ups_txn_t *txn, uint32_t flags);
 
+/**
+ * Typedef for a commit completion callback
+ *
+ * @remark This function is called by @ref ups_txn_commit_async as soon
+ * as the Txn is durable, or if flushing the journal failed. It is
+ * invoked from a background thread of the Environment and must not call
+ * any upscaledb function of the same Environment.
+ *
+ * @param status @ref UPS_SUCCESS if the Txn was flushed, otherwise the
+ *    error code of the failed journal flush
+ * @param user_data The pointer which was passed to
+ *    @ref ups_txn_commit_async
+ */
+typedef void UPS_CALLCONV (*ups_txn_commit_callback_t)(ups_status_t status,
+            void *user_data);
+
+/**
+ * Commits a Txn asynchronously
+ *
+ * This function is similar to @ref ups_txn_commit, but does not wait till
+ * the Txn is flushed to disk. It returns as soon as the Txn is committed
+ * and its position in the journal is assigned; the changes are then
+ * visible to other Transactions. The @a callback is invoked by
+ * a background thread after the journal was flushed (see
+ * @ref UPS_ENABLE_FSYNC and @ref UPS_PARAM_JOURNAL_GROUP_COMMIT_USEC).
+ *
+ * The Txn handle is invalid after this function returned successfully.
+ * If the function fails then the @a callback is not invoked.
+ *
+ * If recovery is disabled (@ref UPS_DISABLE_RECOVERY), or if the
+ * Environment is In-Memory, then @a callback is called immediately
+ * by the calling thread.
+ *
+ * @param txn Pointer to a Txn structure
+ * @param callback The function which is called when the Txn is durable
+ * @param user_data An arbitrary pointer which is passed to @a callback
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a txn or @a callback is NULL
+ * @return @ref UPS_IO_ERROR if writing to the file failed
+ * @return @ref UPS_CURSOR_STILL_OPEN if there are Cursors attached to this
+ *      Txn
+ * @return @ref UPS_NOT_IMPLEMENTED if the Environment is remote
+ */
+UPS_EXPORT ups_status_t
+ups_txn_commit_async(ups_txn_t *txn, ups_txn_commit_callback_t callback,
+            void *user_data);
+
 /**
  * Aborts a Txn
  *
@@ -1275,9 +2331,13 @@ ups_txn_abort(ups_txn_t *txn, uint32_t flags);
  * This flag is non persistent. */
 #define UPS_READ_ONLY                               0x00000004
 
-/* unused                                           0x00000008 */
+/** Flag for @ref ups_env_open, @ref ups_env_create.
+ * This flag is non persistent. */
+#define UPS_ENABLE_CONCURRENT_READS                 0x00000008
 
-/* unused                                           0x00000010 */
+/** Flag for @ref ups_env_open, @ref ups_env_create.
+ * This flag is non persistent. */
+#define UPS_ENABLE_BACKGROUND_MERGE                 0x00000010
 
 /* reserved                                         0x00000020 */
 
@@ -1307,6 +2367,14 @@ ups_txn_abort(ups_txn_t *txn, uint32_t flags);
 /** Flag for @ref ups_env_create_db.
  * This flag is persisted in the Database. */
 #define UPS_ENABLE_DUPLICATE_KEYS                   0x00004000
+
+/** Flag for @ref ups_env_create_db.
+ * This flag is persisted in the Database. */
+#define UPS_HASH_INDEX                              0x00008000
+
+/** Flag for @ref ups_env_create_db.
+ * This flag is persisted in the Database. */
+#define UPS_TIME_SERIES                             0x01000000
 /* deprecated */
 #define UPS_ENABLE_DUPLICATES                       UPS_ENABLE_DUPLICATE_KEYS
 
@@ -1373,6 +2441,12 @@ typedef int UPS_CALLCONV (*ups_compare_func_t)(ups_db_t *db,
  * (@sa UPS_PARAM_CUSTOM_COMPARE_NAME). It is valid to register a compare
  * function multiple times under the same name.
  *
+ * Names starting with "ups." are reserved for the built-in compare
+ * functions (i.e. @ref UPS_COMPARE_MEMCMP_REVERSE). They do not have to
+ * be registered, and they are called directly instead of through a
+ * function pointer. The language bindings can use them without calling
+ * back into the interpreter or virtual machine for each comparison.
+ *
  * !!!
  * The compare functions should be registered PRIOR to opening or
  * creating Environments!
@@ -1381,6 +2455,8 @@ typedef int UPS_CALLCONV (*ups_compare_func_t)(ups_db_t *db,
  * @param func A pointer to the compare function
  *
  * @return @ref UPS_SUCCESS
+ * @return @ref UPS_INV_PARAMETER if the name of a built-in compare function
+ *        is used
  */
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_register_compare(const char *name, ups_compare_func_t func);
@@ -1389,6 +2465,190 @@ ups_register_compare(const char *name, ups_compare_func_t func);
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_db_set_compare_func(ups_db_t *db, ups_compare_func_t foo);
 
+/** Name of a built-in compare function (see
+ * @ref UPS_PARAM_CUSTOM_COMPARE_NAME); sorts in descending memcmp() order */
+#define UPS_COMPARE_MEMCMP_REVERSE          "ups.memcmp_reverse"
+
+/** Name of a built-in compare function; compares ASCII strings without
+ * case */
+#define UPS_COMPARE_CASE_INSENSITIVE        "ups.case_insensitive"
+
+/** Name of a built-in compare function; the keys are sequences of signed
+ * 64bit big-endian integers (i.e. Java's ByteBuffer.putLong()), which are
+ * compared field by field */
+#define UPS_COMPARE_BIG_ENDIAN_COMPOSITE    "ups.big_endian_composite"
+
+/**
+ * Typedef for a key search function
+ *
+ * @remark This function searches @a key in the sorted array @a keys
+ * with @a count keys; the size of each key is in @a key_lengths. It
+ * returns the index of the largest key which is less than or equal to
+ * @a key, or -1 if @a key is smaller than all keys. @a cmp is set to 0
+ * if the returned key is equal to @a key, otherwise to -1 (if -1 is
+ * returned) or 1.
+ */
+typedef int UPS_CALLCONV (*ups_search_func_t)(ups_db_t *db,
+                  const uint8_t *key, uint32_t key_length,
+                  const uint8_t **keys, const uint32_t *key_lengths,
+                  int count, int *cmp);
+
+/**
+ * Globally registers a function to search custom keys
+ *
+ * The search function is optional. If it is registered under the name of
+ * a compare function (see @ref ups_register_compare) then the Btree
+ * calls it once per node instead of calling the compare function for
+ * each step of the binary search. The search function must use the same
+ * order as the compare function.
+ *
+ * The C++ API generates both functions from a comparator class, with
+ * the comparisons inlined (@sa upscaledb::register_compare).
+ *
+ * @param name A (case-insensitive) name of the compare function
+ * @param func A pointer to the search function
+ *
+ * @return @ref UPS_SUCCESS
+ * @return @ref UPS_INV_PARAMETER if the name of a built-in compare function
+ *        is used
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_register_search(const char *name, ups_search_func_t func);
+
+/**
+ * Typedef for an index key extractor function
+ *
+ * @remark This function derives the key of a secondary index (see
+ * @ref ups_env_create_index) from a key/record pair of the primary
+ * Database. It returns 1 and fills @a index_key if the pair is indexed,
+ * or 0 if the pair has no index key. The memory of @a index_key->data
+ * is owned by the function, and has to remain valid till the function
+ * is called again by the same thread. The function is called while
+ * the Environment lock is held; it must not call upscaledb functions.
+ */
+typedef int UPS_CALLCONV (*ups_index_extractor_func_t)(ups_db_t *primary,
+                  const ups_key_t *key, const ups_record_t *record,
+                  ups_key_t *index_key);
+
+/**
+ * Globally registers an index key extractor function
+ *
+ * Secondary indexes store the name of their extractor. When the primary
+ * Database is opened, its indexes are opened as well, and their
+ * extractors are looked up by name; like compare functions (see
+ * @ref ups_register_compare), extractors have to be registered PRIOR to
+ * opening or creating Environments. It is valid to register an extractor
+ * multiple times under the same name.
+ *
+ * @param name A (case-insensitive) name of the extractor function
+ * @param func A pointer to the extractor function
+ *
+ * @return @ref UPS_SUCCESS
+ * @return @ref UPS_INV_PARAMETER if @a name or @a func is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_register_index_extractor(const char *name,
+            ups_index_extractor_func_t func);
+
+/**
+ * Creates a secondary index of a Database
+ *
+ * The index is a new Database with the name @a index_name, which is
+ * maintained by upscaledb. Its keys are derived from the key/record pairs
+ * of @a primary with the extractor function which was registered as
+ * @a extractor_name (see @ref ups_register_index_extractor), and its
+ * records are the keys of @a primary.
+ *
+ * Each modification of @a primary (with @ref ups_db_insert,
+ * @ref ups_cursor_insert, @ref ups_cursor_overwrite, @ref ups_db_erase,
+ * @ref ups_cursor_erase and the bulk functions) updates its indexes in
+ * the same operation: the index keys of the old record are removed and
+ * those of the new record are inserted under the same lock, in the same
+ * Txn and in the same journal entry. A failing index update (i.e. a
+ * duplicate key of a @ref UPS_INDEX_UNIQUE index) fails the whole
+ * operation, and the primary Database is not modified.
+ *
+ * The existing keys of @a primary are indexed before this function
+ * returns.
+ *
+ * The index Database can be read like any other Database, i.e. with
+ * Cursors and @ref uqi_select, and looked up with
+ * @ref ups_db_find_by_index. Modifying it directly returns
+ * @ref UPS_WRITE_PROTECTED. It is opened automatically whenever
+ * @a primary is opened; @ref ups_env_open_db returns a handle of an
+ * index which is already open. An index is deleted with
+ * @ref ups_env_erase_db.
+ *
+ * @param env A valid Environment handle
+ * @param primary A valid Database handle of the indexed Database; Record
+ *        Number Databases are supported
+ * @param index_name The name of the index Database; see
+ *        @ref ups_env_create_db
+ * @param extractor_name The name of a registered extractor function
+ * @param flags Optional flags for creating the index, combined with
+ *        bitwise OR. Possible flags are:
+ *    <ul>
+ *     <li>@ref UPS_INDEX_UNIQUE</li> An index key can only be stored once.
+ *      By default, several primary keys can have the same index key.
+ *    </ul>
+ * @param params An array of ups_parameter_t structures for the index
+ *        Database, or NULL. Supported are @ref UPS_PARAM_KEY_TYPE,
+ *        @ref UPS_PARAM_KEY_SIZE, @ref UPS_PARAM_CUSTOM_COMPARE_NAME and
+ *        @ref UPS_PARAM_KEY_COMPRESSION
+ * @param index A pointer to a pointer which receives the Database handle
+ *        of the index. Can be NULL
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a env, @a primary or
+ *        @a extractor_name is NULL, or if @a primary does not belong to
+ *        @a env
+ * @return @ref UPS_NOT_READY if no extractor was registered under
+ *        @a extractor_name
+ * @return @ref UPS_DATABASE_ALREADY_EXISTS if a Database with the name
+ *        @a index_name already exists
+ * @return @ref UPS_DUPLICATE_KEY if @ref UPS_INDEX_UNIQUE was specified
+ *        and two existing keys of @a primary have the same index key
+ * @return @ref UPS_WRITE_PROTECTED if the Environment is read-only
+ * @return @ref UPS_NOT_IMPLEMENTED if @a env is a remote Environment
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_env_create_index(ups_env_t *env, ups_db_t *primary, uint16_t index_name,
+            const char *extractor_name, uint32_t flags,
+            const ups_parameter_t *params, ups_db_t **index);
+
+/** Flag for @ref ups_env_create_index */
+#define UPS_INDEX_UNIQUE                    1
+
+/**
+ * Looks up a key of a secondary index and returns the primary record
+ *
+ * Searches @a index_key in the secondary index @a index (see
+ * @ref ups_env_create_index), and then looks up the first primary key
+ * of this index key in the primary Database. Both lookups run under
+ * the same lock and see the same snapshot. To visit all primary keys of
+ * a non-unique index key, move a Cursor over the duplicates of the
+ * index Database; their records are the primary keys.
+ *
+ * The memory of @a primary_key and @a record is managed like in
+ * @ref ups_db_find.
+ *
+ * @param index A valid Database handle of a secondary index
+ * @param txn A Txn handle, or NULL
+ * @param index_key The key which is searched in the index
+ * @param primary_key Receives the key of the primary record; can be NULL
+ * @param record Receives the primary record
+ * @param flags Optional flags for searching the index, like in
+ *        @ref ups_db_find (i.e. @ref UPS_FIND_GEQ_MATCH)
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a index, @a index_key or @a record
+ *        is NULL, or if @a index is not a secondary index
+ * @return @ref UPS_KEY_NOT_FOUND if @a index_key was not found
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_find_by_index(ups_db_t *index, ups_txn_t *txn, ups_key_t *index_key,
+            ups_key_t *primary_key, ups_record_t *record, uint32_t flags);
+
 /**
  * Searches an item in the Database
  *
@@ -1486,35 +2746,131 @@ ups_db_find(ups_db_t *db, ups_txn_t *txn, ups_key_t *key,
             ups_record_t *record, uint32_t flags);
 
 /**
- * Inserts a Database item
+ * Searches several items in the Database
  *
- * This function inserts a key/record pair as a new Database item.
+ * This function is similar to @ref ups_db_find, but looks up @a count keys
+ * at once. The keys are sorted internally; all keys which are stored in
+ * the same leaf page are served with a single visit of this page, and the
+ * Environment lock is acquired only once for the whole batch.
  *
- * If the key already exists in the Database, error @ref UPS_DUPLICATE_KEY
- * is returned.
+ * The keys do not have to be sorted by the caller. The result of each
+ * lookup is stored in @a statuses; i.e. @a statuses[i] is
+ * @ref UPS_SUCCESS if @a keys[i] was found (and @a records[i] is
+ * filled), or @ref UPS_KEY_NOT_FOUND if it does not exist.
  *
- * If you wish to overwrite an existing entry specify the
- * flag @ref UPS_OVERWRITE.
+ * The memory of the records is managed as described in @ref ups_db_find;
+ * the records remain valid till the next API call with the same Txn
+ * (or Database, if Transactions are disabled). @ref UPS_RECORD_USER_ALLOC
+ * can be set for each record individually.
  *
- * If you wish to insert a duplicate key specify the flag @ref UPS_DUPLICATE.
- * (Note that the Database has to be created with @ref UPS_ENABLE_DUPLICATE_KEYS
- * in order to use duplicate keys.)
- * The duplicate key is inserted after all other duplicate keys (see
- * @ref UPS_DUPLICATE_INSERT_LAST).
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param keys An array of @a count keys
+ * @param records An array of @a count records
+ * @param statuses An array of @a count status codes
+ * @param count The number of elements in @a keys, @a records and
+ *    @a statuses
+ * @param flags Optional flags for searching; see @ref ups_db_find. The
+ *    flags are applied to all keys
+ *
+ * @return @ref UPS_SUCCESS upon success, even if some (or all) keys were
+ *        not found
+ * @return @ref UPS_INV_PARAMETER if @a db, @a keys, @a records or
+ *        @a statuses is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_find_many(ups_db_t *db, ups_txn_t *txn, ups_key_t *keys,
+            ups_record_t *records, ups_status_t *statuses, uint32_t count,
+            uint32_t flags);
+
+/**
+ * Searches an item in the Database and returns a pinned view of the record
  *
- * Record Number Databases (created with @ref UPS_RECORD_NUMBER32 or
- * @ref UPS_RECORD_NUMBER64) expect either an empty @a key (with a size of
- * 0 and data pointing to NULL), or a user-supplied key (with key.flag
- * @ref UPS_KEY_USER_ALLOC and a valid data pointer).
- * If key.size is 0 and key.data is NULL, upscaledb will temporarily
- * allocate memory for key->data, which will then point to an 4-byte (or 8-byte)
- * unsigned integer.
+ * This function is similar to @ref ups_db_find, but does not copy the
+ * record. Instead, @a record->data points directly into the (memory
+ * mapped) page which stores the record. The page is pinned in the cache
+ * and will neither be flushed nor evicted until @a view is released
+ * with @ref ups_view_release. The record data must not be modified.
+ *
+ * Records which are stored in a blob are resolved directly in the file
+ * mapping if the whole blob is mapped; this also works for blobs which
+ * span several (consecutive) pages. Such a lookup does not copy any data
+ * and does not access the cache.
+ *
+ * If the record cannot be accessed directly (i.e. because it is
+ * compressed, not completely mapped or memory mapped I/O is disabled) then
+ * the record is copied into a buffer which is owned by @a view.
+ * If the record is modified or erased while @a view is active then
+ * the view continues to point to the old record.
+ *
+ * Views are not supported for remote Environments or if Transactions
+ * are enabled.
  *
  * @param db A valid Database handle
  * @param txn A Txn handle, or NULL
- * @param key The key of the new item
- * @param record The record of the new item
- * @param flags Optional flags for inserting. Possible flags are:
+ * @param key The key of the item
+ * @param record Receives the pointer to the record data and its size
+ * @param view Receives the handle of the view
+ * @param flags Optional flags for searching; see @ref ups_db_find
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db, @a key, @a record or @a view
+ *        is NULL
+ * @return @ref UPS_KEY_NOT_FOUND if the @a key does not exist
+ * @return @ref UPS_NOT_IMPLEMENTED if the Environment is remote or
+ *        Transactions are enabled
+ *
+ * @sa ups_view_release
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_find_view(ups_db_t *db, ups_txn_t *txn, ups_key_t *key,
+            ups_record_t *record, ups_view_t **view, uint32_t flags);
+
+/**
+ * Releases a view
+ *
+ * Unpins the page of a view which was returned by @ref ups_db_find_view.
+ * The record data of the view must no longer be accessed. All views have to
+ * be released before the Database is closed.
+ *
+ * @param view A valid view handle
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a view is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_view_release(ups_view_t *view);
+
+/**
+ * Inserts a Database item
+ *
+ * This function inserts a key/record pair as a new Database item.
+ *
+ * If the key already exists in the Database, error @ref UPS_DUPLICATE_KEY
+ * is returned.
+ *
+ * If you wish to overwrite an existing entry specify the
+ * flag @ref UPS_OVERWRITE.
+ *
+ * If you wish to insert a duplicate key specify the flag @ref UPS_DUPLICATE.
+ * (Note that the Database has to be created with @ref UPS_ENABLE_DUPLICATE_KEYS
+ * in order to use duplicate keys.)
+ * The duplicate key is inserted after all other duplicate keys (see
+ * @ref UPS_DUPLICATE_INSERT_LAST).
+ *
+ * Record Number Databases (created with @ref UPS_RECORD_NUMBER32 or
+ * @ref UPS_RECORD_NUMBER64) expect either an empty @a key (with a size of
+ * 0 and data pointing to NULL), or a user-supplied key (with key.flag
+ * @ref UPS_KEY_USER_ALLOC and a valid data pointer).
+ * If key.size is 0 and key.data is NULL, upscaledb will temporarily
+ * allocate memory for key->data, which will then point to an 4-byte (or 8-byte)
+ * unsigned integer.
+ *
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param key The key of the new item
+ * @param record The record of the new item
+ * @param flags Optional flags for inserting. Possible flags are:
  *    <ul>
  *    <li>@ref UPS_OVERWRITE. If the @a key already exists, the record is
  *        overwritten. Otherwise, the key is inserted. Flag is not
@@ -1549,6 +2905,135 @@ UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_db_insert(ups_db_t *db, ups_txn_t *txn, ups_key_t *key,
             ups_record_t *record, uint32_t flags);
 
+/**
+ * Inserts a Database item from several buffers
+ *
+ * This function is similar to @ref ups_db_insert, but the record is
+ * specified as an array of @a iov_count segments. The segments are written
+ * directly into the record's storage (without assembling them in a
+ * temporary buffer). If @ref UPS_PARAM_RECORD_COMPRESSION is enabled then
+ * the compressor reads the segments one after the other.
+ *
+ * The size of the record is the sum of all segment sizes.
+ *
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param key The key of the new item
+ * @param iov An array of record segments
+ * @param iov_count The number of segments in @a iov
+ * @param flags Optional flags for inserting; see @ref ups_db_insert
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db, @a key or @a iov is NULL, or
+ *        if the database is a Record Number database
+ * @return @ref UPS_INV_RECORD_SIZE if the Database stores records with
+ *        a fixed size, and the sum of the segment sizes is different
+ *
+ * @sa ups_db_insert
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_insert_iov(ups_db_t *db, ups_txn_t *txn, ups_key_t *key,
+            const ups_record_iov_t *iov, uint32_t iov_count, uint32_t flags);
+
+/**
+ * A range of record numbers which was reserved with
+ * @ref ups_db_reserve_record_numbers
+ *
+ * The range is owned by the caller (usually a single producer thread)
+ * and passed to @ref ups_db_append_many.
+ */
+typedef struct ups_recno_range_t {
+  /** The next record number of this range */
+  uint64_t next;
+
+  /** The first record number after this range */
+  uint64_t end;
+
+  /** For internal use; the leaf page which received the last append */
+  uint64_t _leaf;
+
+} ups_recno_range_t;
+
+/**
+ * Reserves a range of record numbers
+ *
+ * Atomically advances the record number counter of a Record Number
+ * Database by @a count and stores the skipped numbers in @a range. No
+ * items are inserted; the numbers are assigned when @a range is passed to
+ * @ref ups_db_append_many.
+ *
+ * This allows several producer threads to append to the same Database
+ * without contending on the counter or on the rightmost leaf page:
+ * each thread appends to its own range, and each range remembers the
+ * leaf page which received its last record.
+ *
+ * Record numbers of a range which are never used remain as gaps; they
+ * are not assigned again, neither after closing and re-opening the
+ * Database.
+ *
+ * @param db A valid Database handle
+ * @param count The number of record numbers to reserve
+ * @param range Receives the reserved range
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db or @a range is NULL, if
+ *        @a count is 0 or if the Database is not a Record Number Database
+ * @return @ref UPS_LIMITS_REACHED if the range exceeds the largest
+ *        record number (i.e. for @ref UPS_RECORD_NUMBER32)
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_reserve_record_numbers(ups_db_t *db, uint32_t count,
+            ups_recno_range_t *range);
+
+/**
+ * Appends several records to a Record Number Database
+ *
+ * This function is similar to calling @ref ups_db_insert with an empty
+ * key for each record, but avoids the per-record overhead:
+ *
+ * - the record numbers are taken from an atomic counter (or from
+ *   @a range), and the records of a batch receive consecutive numbers
+ * - the rightmost leaf page (or the leaf page of @a range) stays pinned
+ *   in the cache, and the records are appended without a btree descent
+ *   as long as they fit into this page. A descent is only required after
+ *   the page was split
+ * - the Environment lock is acquired once for the whole batch; with
+ *   @ref UPS_ENABLE_CONCURRENT_READS, only the latch of the leaf page
+ *   is acquired
+ *
+ * If Transactions are enabled then the records are inserted into the
+ * Txn index; the record numbers are nevertheless assigned immediately,
+ * and the appends use the pinned leaf when the Txn is flushed.
+ *
+ * @param db A valid Database handle of a Record Number Database
+ * @param txn A Txn handle, or NULL
+ * @param records An array of @a count records
+ * @param count The number of elements in @a records
+ * @param range An optional range which was returned by
+ *        @ref ups_db_reserve_record_numbers, or NULL to use the record
+ *        number counter of the Database. @a range->next is advanced by
+ *        @a count
+ * @param first_recno Receives the record number of the first record;
+ *        the i-th record of the batch has number @a *first_recno + i.
+ *        Can be NULL
+ * @param flags Optional flags; unused, set to 0
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db or @a records is NULL, or if
+ *        the Database is not a Record Number Database
+ * @return @ref UPS_LIMITS_REACHED if @a range has less than @a count
+ *        record numbers left
+ * @return @ref UPS_WRITE_PROTECTED if the Database is read-only
+ * @return @ref UPS_INV_RECORD_SIZE if the Database stores records with
+ *        a fixed size, and a record has a different size
+ *
+ * @sa ups_db_reserve_record_numbers
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_append_many(ups_db_t *db, ups_txn_t *txn, ups_record_t *records,
+            uint32_t count, ups_recno_range_t *range, uint64_t *first_recno,
+            uint32_t flags);
+
 /**
  * Flag for @ref ups_db_insert and @ref ups_cursor_insert
  *
@@ -1618,6 +3103,281 @@ ups_db_erase(ups_db_t *db, ups_txn_t *txn, ups_key_t *key, uint32_t flags);
 /* internal flag for ups_db_erase() - do not use */
 #define UPS_ERASE_ALL_DUPLICATES                1
 
+/**
+ * Erases a range of keys
+ *
+ * This function erases all keys (and their duplicates) which are greater
+ * than or equal to @a begin and less than @a end. If @a begin is NULL then
+ * the range starts with the first key, and if @a end is NULL then it
+ * ends with the last key.
+ *
+ * Leaf nodes which are completely covered by the range are not read;
+ * they are unlinked from their parents, and their pages (and the pages
+ * of their blobs and extended keys) are released in bulk. Only the two
+ * leaves at the boundaries of the range are modified key by key, and the
+ * Btree is rebalanced once.
+ *
+ * If @a txn is not NULL (or if Transactions are enabled) then the range
+ * is locked, and conflicts with Transactions which modified keys in the
+ * range are reported like in @ref ups_db_erase. The range is
+ * erased in the Btree when the Txn is flushed (or immediately, if
+ * Transactions are disabled).
+ *
+ * Cursors which are coupled to an erased key are set to nil.
+ *
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param begin The first key of the range, or NULL
+ * @param end The end of the range, or NULL
+ * @param flags Optional flags for erasing, combined with bitwise OR.
+ *    Possible flags are:
+ *    <ul>
+ *     <li>@ref UPS_ERASE_RANGE_INCLUSIVE</li> Also erases @a end.
+ *    </ul>
+ *
+ * @return @ref UPS_SUCCESS upon success, even if the range was empty
+ * @return @ref UPS_INV_PARAMETER if @a db is NULL, or if @a end is less
+ *        than @a begin
+ * @return @ref UPS_WRITE_PROTECTED if you tried to erase keys from a
+ *        read-only Database
+ * @return @ref UPS_TXN_CONFLICT if a key of the range was modified in
+ *        another Txn which was not yet committed or aborted
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_erase_range(ups_db_t *db, ups_txn_t *txn, ups_key_t *begin,
+            ups_key_t *end, uint32_t flags);
+
+/** Flag for @ref ups_db_erase_range */
+#define UPS_ERASE_RANGE_INCLUSIVE               2
+
+/**
+ * Exports a Database to a file descriptor
+ *
+ * Writes all keys and records of the Database in sorted order to @a fd,
+ * which must be opened for writing; it can be a file, a pipe or a socket.
+ * The stream is written sequentially and can be read with
+ * @ref ups_db_import into a Database of another Environment.
+ *
+ * The stream starts with a header which describes the Database (key type
+ * and size, record size, flags and the number of keys), followed by blocks
+ * of up to @ref UPS_EXPORT_BLOCK_SIZE bytes of key/record pairs. Each
+ * block is compressed with LZ4 (unless @ref UPS_EXPORT_UNCOMPRESSED
+ * is specified) and stores the CRC32 checksum of its uncompressed payload.
+ * A trailer with the number of exported pairs ends the stream.
+ *
+ * The Btree is read leaf by leaf, and only a single block is buffered,
+ * regardless of the size of the Database. The export sees a consistent
+ * snapshot: if @a txn is not NULL then the changes of this Txn are included,
+ * otherwise a temporary Txn is used (if Transactions are enabled).
+ *
+ * Custom compare functions are not stored in the stream; the destination
+ * Database must use the same compare function, see
+ * @ref ups_register_compare.
+ *
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param fd A file descriptor which is opened for writing
+ * @param flags Optional flags; either 0 or @ref UPS_EXPORT_UNCOMPRESSED
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db is NULL or @a fd is invalid
+ * @return @ref UPS_IO_ERROR if writing to @a fd failed
+ *
+ * @sa ups_db_import
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_export(ups_db_t *db, ups_txn_t *txn, int fd, uint32_t flags);
+
+/** Flag for @ref ups_db_export: blocks are not compressed */
+#define UPS_EXPORT_UNCOMPRESSED                 1
+
+/** The maximum size of an uncompressed block of @ref ups_db_export */
+#define UPS_EXPORT_BLOCK_SIZE                   (1024 * 1024)
+
+/**
+ * Imports a stream which was written by @ref ups_db_export
+ *
+ * Reads the stream from @a fd and inserts all key/record pairs into
+ * @a db. If the Database is empty, or if all imported keys are greater than
+ * the largest key of the Database, then the Btree is built bottom-up like
+ * with @ref UPS_BULK_SORTED: the leaves are filled to
+ * @ref UPS_BULK_FILL_FACTOR percent, and the internal nodes are created
+ * afterwards. Otherwise each pair is inserted like with @ref ups_db_insert.
+ * Duplicate keys are appended to the duplicate list of their key.
+ *
+ * Only a single block of the stream is buffered. The checksum of each
+ * block is verified before its keys are inserted; if verification fails,
+ * the keys of the previous blocks remain in the Database.
+ *
+ * The key type, key size and record size of the stream must be compatible
+ * with those of @a db. If the stream contains duplicate keys then @a db
+ * must have been created with @ref UPS_ENABLE_DUPLICATE_KEYS.
+ *
+ * Bottom-up loading is not possible if Transactions are enabled; then
+ * the pairs are inserted into @a txn (or into temporary Transactions, if
+ * @a txn is NULL).
+ *
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param fd A file descriptor which is opened for reading
+ * @param flags Optional flags; unused, set to 0
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db is NULL or @a fd is invalid, or
+ *        if the stream is not compatible with the Database
+ * @return @ref UPS_INV_FILE_HEADER if the stream was not written by
+ *        @ref ups_db_export
+ * @return @ref UPS_INV_FILE_VERSION if the stream has an unknown version
+ * @return @ref UPS_INTEGRITY_VIOLATED if a checksum does not match, or
+ *        if the stream is truncated
+ * @return @ref UPS_DUPLICATE_KEY if a key already exists and the Database
+ *        does not support duplicate keys
+ * @return @ref UPS_WRITE_PROTECTED if the Database is read-only
+ * @return @ref UPS_IO_ERROR if reading from @a fd failed
+ *
+ * @sa ups_db_export
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_import(ups_db_t *db, ups_txn_t *txn, int fd, uint32_t flags);
+
+/**
+ * Creates a new, empty batch of write operations
+ *
+ * A batch collects inserts and erases, which are then applied atomically
+ * with @ref ups_db_write_batch. Batches are lighter than Transactions:
+ * they are not visible to other threads before they are applied, they
+ * do not create entries in the Txn index, and they are not tracked for
+ * conflicts.
+ *
+ * A batch is not thread-safe; it must not be modified by several threads
+ * at the same time.
+ *
+ * @param batch A pointer to a pointer which is allocated for the new batch
+ * @param flags Optional flags; unused, set to 0
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a batch is NULL
+ * @return @ref UPS_OUT_OF_MEMORY if memory could not be allocated
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_batch_create(ups_batch_t **batch, uint32_t flags);
+
+/**
+ * Adds an insert operation to a batch
+ *
+ * The key and the record are copied into the batch; their memory can be
+ * reused after the function returns.
+ *
+ * @param batch A valid batch handle
+ * @param key The key
+ * @param record The record
+ * @param flags Optional flags for inserting; either 0,
+ *        @ref UPS_OVERWRITE or @ref UPS_DUPLICATE, like in
+ *        @ref ups_db_insert
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a batch, @a key or @a record is NULL,
+ *        or if both flags are specified
+ * @return @ref UPS_OUT_OF_MEMORY if memory could not be allocated
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_batch_put(ups_batch_t *batch, ups_key_t *key, ups_record_t *record,
+            uint32_t flags);
+
+/**
+ * Adds an erase operation to a batch
+ *
+ * The key is copied into the batch. If the key does not exist when the
+ * batch is applied then the operation is ignored.
+ *
+ * @param batch A valid batch handle
+ * @param key The key
+ * @param flags Optional flags; unused, set to 0
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a batch or @a key is NULL
+ * @return @ref UPS_OUT_OF_MEMORY if memory could not be allocated
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_batch_erase(ups_batch_t *batch, ups_key_t *key, uint32_t flags);
+
+/**
+ * Returns the number of operations in a batch
+ *
+ * @param batch A valid batch handle
+ *
+ * @return The number of operations, or 0 if @a batch is NULL
+ */
+UPS_EXPORT uint32_t UPS_CALLCONV
+ups_batch_get_count(ups_batch_t *batch);
+
+/**
+ * Removes all operations from a batch
+ *
+ * The memory of the batch is kept and reused by the following
+ * operations.
+ *
+ * @param batch A valid batch handle
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a batch is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_batch_clear(ups_batch_t *batch);
+
+/**
+ * Releases a batch and its memory
+ *
+ * @param batch A valid batch handle
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a batch is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_batch_close(ups_batch_t *batch);
+
+/**
+ * Applies a batch of write operations atomically
+ *
+ * All operations of @a batch are applied in the order in which they were
+ * added, while the Environment lock is held once for the whole batch;
+ * other threads see either none or all of them.
+ *
+ * Before anything is modified, the batch is validated: if a put without
+ * @ref UPS_OVERWRITE or @ref UPS_DUPLICATE would fail with
+ * @ref UPS_DUPLICATE_KEY (or any other operation would fail) then none
+ * of the operations are applied, and the error is returned.
+ *
+ * If the Environment has a journal then the whole batch is written as
+ * a single journal entry (which is flushed with fsync if
+ * @ref UPS_ENABLE_FSYNC is set) before the Btree is modified. After a
+ * crash, the batch is recovered either completely or not at all.
+ *
+ * If Transactions are enabled then the batch is applied to the Btree
+ * directly, without Txn index entries, as if it was committed and flushed
+ * immediately. If one of its keys is modified by a Txn which is not yet
+ * committed (or not yet flushed) then @ref UPS_TXN_CONFLICT is returned
+ * and none of the operations are applied.
+ *
+ * The batch is not modified, and can be applied again or cleared with
+ * @ref ups_batch_clear.
+ *
+ * @param db A valid Database handle
+ * @param batch A valid batch handle
+ * @param flags Optional flags; unused, set to 0
+ *
+ * @return @ref UPS_SUCCESS upon success, also if @a batch is empty
+ * @return @ref UPS_INV_PARAMETER if @a db or @a batch is NULL
+ * @return @ref UPS_WRITE_PROTECTED if the Database is read-only
+ * @return @ref UPS_DUPLICATE_KEY if a key of a put already exists and
+ *        the put has neither @ref UPS_OVERWRITE nor @ref UPS_DUPLICATE
+ * @return @ref UPS_TXN_CONFLICT if a key is modified by a pending Txn
+ *
+ * @sa ups_batch_create
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_write_batch(ups_db_t *db, ups_batch_t *batch, uint32_t flags);
+
 /**
  * Returns the number of keys stored in the Database
  *
@@ -1625,6 +3385,11 @@ ups_db_erase(ups_db_t *db, ups_txn_t *txn, ups_key_t *key, uint32_t flags);
  * to include any duplicates in the count. This will also speed up the
  * counting.
  *
+ * By default, all leaf nodes are visited. If the Database was created
+ * with @ref UPS_PARAM_SUBTREE_COUNTS then the counts are summed up from
+ * the root node, which is logarithmic in the number of keys. Changes of
+ * Transactions which are not yet flushed to the Btree are added on top.
+ *
  * @param db A valid Database handle
  * @param txn A Txn handle, or NULL
  * @param flags Optional flags:
@@ -1669,6 +3434,26 @@ ups_db_count(ups_db_t *db, ups_txn_t *txn, uint32_t flags, uint64_t *count);
  *    <li>@ref UPS_PARAM_KEY_COMPRESSION</li> Returns the
  *        selected algorithm for key compression, or 0 if compression
  *        is disabled
+ *    <li>@ref UPS_PARAM_DUPLICATE_COMPRESSION</li> Returns the
+ *        selected algorithm for duplicate record compression, or 0 if
+ *        compression is disabled
+ *    <li>@ref UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE</li> Returns
+ *        the size of the trained compression dictionary, or 0 if no
+ *        dictionary was trained (yet)
+ *    <li>@ref UPS_PARAM_SEARCH_WINDOW</li> Returns the size of the
+ *        SIMD search window, or 0 if the keys are not searched with SIMD
+ *    <li>@ref UPS_PARAM_KEY_LAYOUT</li> Returns the layout of the keys
+ *        in the leaf nodes
+ *    <li>@ref UPS_PARAM_LEAF_SUMMARIES</li> Returns 1 if the leaf nodes
+ *        store min/max summaries, otherwise 0
+ *    <li>@ref UPS_PARAM_BLOOM_FILTER_BITS</li> Returns the bits per key
+ *        of the Bloom filter, or 0 if the filter is disabled
+ *    <li>@ref UPS_PARAM_MEMORY_INDEX</li> Returns the index structure
+ *        of an In-Memory Database
+ *    <li>@ref UPS_PARAM_SUBTREE_COUNTS</li> Returns 1 if the internal
+ *        nodes store subtree counts, otherwise 0
+ *    <li>@ref UPS_PARAM_DB_PAGE_SIZE</li> Returns the size of the Btree
+ *        nodes of this Database
  *    </ul>
  *
  * @param db A valid Database handle
@@ -1744,6 +3529,256 @@ ups_db_get_parameters(ups_db_t *db, ups_parameter_t *param);
 /** Value for @ref UPS_PARAM_POSIX_FADVISE */
 #define UPS_POSIX_FADVICE_RANDOM                 1
 
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; selects the
+ * lock which serializes access to the Environment */
+#define UPS_PARAM_ENV_LOCK              0x00000113
+
+/** Value for @ref UPS_PARAM_ENV_LOCK; a plain mutex (the default) */
+#define UPS_ENV_LOCK_MUTEX                       0
+
+/** Value for @ref UPS_PARAM_ENV_LOCK; a hierarchical fair lock. Threads are
+ * scheduled according to the weight and parent node which were assigned
+ * with @ref ups_env_set_thread_class */
+#define UPS_ENV_LOCK_HFAIRLOCK                   1
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * number of cache shards */
+#define UPS_PARAM_CACHE_SHARDS          0x00000114
+
+/** The maximum value for @ref UPS_PARAM_CACHE_SHARDS */
+#define UPS_MAX_CACHE_SHARDS                    64
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; selects the
+ * replacement policy of the cache */
+#define UPS_PARAM_CACHE_POLICY          0x00000115
+
+/** Value for @ref UPS_PARAM_CACHE_POLICY; evicts the least recently used
+ * pages (the default) */
+#define UPS_CACHE_POLICY_LRU                     0
+
+/** Value for @ref UPS_PARAM_CACHE_POLICY; a scan-resistant 2Q policy.
+ * Pages enter a FIFO queue when they are fetched and are only promoted to
+ * the LRU list of hot pages when they are accessed a second time. Pages
+ * fetched by scans (see @ref UPS_CURSOR_READ_ONCE) are never promoted */
+#define UPS_CACHE_POLICY_2Q                      1
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * time window (in microseconds) for grouping concurrent commits */
+#define UPS_PARAM_JOURNAL_GROUP_COMMIT_USEC 0x00000116
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * number of leaf pages which are read ahead by Cursors created with
+ * @ref UPS_CURSOR_PREFETCH */
+#define UPS_PARAM_CURSOR_PREFETCH_PAGES 0x00000117
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; selects the
+ * device backend for file I/O */
+#define UPS_PARAM_IO_BACKEND            0x00000118
+
+/** Value for @ref UPS_PARAM_IO_BACKEND; uses mmap and synchronous
+ * pread/pwrite (the default) */
+#define UPS_IO_BACKEND_DEFAULT                   0
+
+/** Value for @ref UPS_PARAM_IO_BACKEND; submits page reads, page flushes
+ * and journal writes in batches through io_uring. Only available on Linux
+ * if upscaledb was built with liburing. Implies @ref UPS_DISABLE_MMAP */
+#define UPS_IO_BACKEND_IO_URING                  1
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * queue depth of the io_uring backend */
+#define UPS_PARAM_IO_QUEUE_DEPTH        0x00000119
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; enables the
+ * background flusher and sets its target ratio of dirty pages (in percent) */
+#define UPS_PARAM_FLUSHER_DIRTY_RATIO   0x0000011a
+
+/** Parameter name for @ref ups_env_create_db, @ref ups_env_open_db; sets
+ * the number of keys which are searched linearly with SIMD instructions */
+#define UPS_PARAM_SEARCH_WINDOW         0x0000011b
+
+/** Parameter name for @ref ups_env_create_db; selects the order of the
+ * keys in the leaf nodes */
+#define UPS_PARAM_KEY_LAYOUT            0x0000011c
+
+/** Value for @ref UPS_PARAM_KEY_LAYOUT; keys are sorted (the default) */
+#define UPS_KEY_LAYOUT_SORTED                    0
+
+/** Value for @ref UPS_PARAM_KEY_LAYOUT; keys are stored in Eytzinger
+ * (breadth-first) order */
+#define UPS_KEY_LAYOUT_EYTZINGER                 1
+
+/** Value for @ref UPS_PARAM_KEY_LAYOUT; keys are stored as a static
+ * B+-tree of cache-line sized blocks */
+#define UPS_KEY_LAYOUT_BLOCKED                   2
+
+/** Parameter name for @ref ups_env_create_db; enables min/max summaries
+ * of the keys and records of each leaf node */
+#define UPS_PARAM_LEAF_SUMMARIES        0x0000011d
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * maximum number of in-flight requests per remote connection */
+#define UPS_PARAM_NETWORK_PIPELINE_DEPTH 0x0000011e
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * maximum number of pooled connections per remote server */
+#define UPS_PARAM_NETWORK_POOL_SIZE     0x0000011f
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; sets the
+ * number of items which remote Cursors fetch per request */
+#define UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE 0x00000120
+
+/** Parameter name for @ref ups_env_create; sets the number of
+ * partitions */
+#define UPS_PARAM_PARTITIONS            0x00000121
+
+/** Parameter name for @ref ups_env_create; selects how keys are assigned
+ * to the partitions */
+#define UPS_PARAM_PARTITION_SCHEME      0x00000122
+
+/** Value for @ref UPS_PARAM_PARTITION_SCHEME; partitions by a hash of the
+ * key (the default) */
+#define UPS_PARTITION_HASH                       0
+
+/** Value for @ref UPS_PARAM_PARTITION_SCHEME; partitions by key ranges
+ * (see @ref UPS_PARAM_PARTITION_BOUNDARIES) */
+#define UPS_PARTITION_RANGE                      1
+
+/** Parameter name for @ref ups_env_create; the boundary keys of
+ * @ref UPS_PARTITION_RANGE */
+#define UPS_PARAM_PARTITION_BOUNDARIES  0x00000123
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; selects the
+ * compression of keys and records for remote Environments */
+#define UPS_PARAM_NETWORK_COMPRESSION   0x00000124
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; a pointer
+ * to a @ref ups_allocator_t structure */
+#define UPS_PARAM_ALLOCATOR             0x00000125
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; backs
+ * the cache with huge pages */
+#define UPS_PARAM_CACHE_HUGE_PAGES      0x00000126
+
+/** Value for @ref UPS_PARAM_CACHE_HUGE_PAGES; uses regular pages (the
+ * default) */
+#define UPS_HUGE_PAGES_NONE                      0
+
+/** Value for @ref UPS_PARAM_CACHE_HUGE_PAGES; uses 2 MB huge pages */
+#define UPS_HUGE_PAGES_2MB                       1
+
+/** Value for @ref UPS_PARAM_CACHE_HUGE_PAGES; uses 1 GB huge pages */
+#define UPS_HUGE_PAGES_1GB                       2
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; selects
+ * the NUMA placement of the cache */
+#define UPS_PARAM_CACHE_NUMA_POLICY     0x00000127
+
+/** Value for @ref UPS_PARAM_CACHE_NUMA_POLICY; uses the default policy of
+ * the process (the default) */
+#define UPS_NUMA_NONE                            0
+
+/** Value for @ref UPS_PARAM_CACHE_NUMA_POLICY; distributes the shards of
+ * the cache (see @ref UPS_PARAM_CACHE_SHARDS) round-robin to the NUMA
+ * nodes */
+#define UPS_NUMA_INTERLEAVE                      1
+
+/** Value for @ref UPS_PARAM_CACHE_NUMA_POLICY; places the cache of each
+ * partition (see @ref UPS_PARAM_PARTITIONS), or each shard of the cache,
+ * on the NUMA node of the threads which access it most. The placement is
+ * sampled while pages are fetched, and memory is migrated when it changes.
+ * Threads which are pinned to a node (and, with @ref UPS_ENV_LOCK_HFAIRLOCK,
+ * share a lock node) get the most benefit */
+#define UPS_NUMA_LOCAL                           2
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; the maximum
+ * number of page addresses which are saved for warming up the cache */
+#define UPS_PARAM_CACHE_WARMUP          0x00000128
+
+/** Parameter name for @ref ups_env_open; sets the number of threads
+ * which apply the journal during recovery */
+#define UPS_PARAM_RECOVERY_THREADS      0x00000129
+
+/** Parameter name for @ref ups_env_open; selects what happens with
+ * Transactions which were active when the Environment crashed */
+#define UPS_PARAM_RECOVERY_TXN_POLICY   0x0000012a
+
+/** Value for @ref UPS_PARAM_RECOVERY_TXN_POLICY; active Transactions are
+ * aborted (the default) */
+#define UPS_RECOVERY_ABORT_TXNS                  0
+
+/** Value for @ref UPS_PARAM_RECOVERY_TXN_POLICY; active Transactions are
+ * re-created (see @ref ups_env_get_recovered_txns) */
+#define UPS_RECOVERY_RESTORE_TXNS                1
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; enables
+ * the background compaction of underfull leaves */
+#define UPS_PARAM_COMPACTION_FILL_FACTOR 0x0000012b
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; limits the
+ * pages per second of the compaction */
+#define UPS_PARAM_COMPACTION_RATE       0x0000012c
+
+/** Parameter name for @ref ups_env_create_db; enables a Bloom filter
+ * with this number of bits per key */
+#define UPS_PARAM_BLOOM_FILTER_BITS     0x0000012d
+
+/** Parameter name for @ref ups_env_create_db; selects the index of a
+ * Database in an In-Memory Environment */
+#define UPS_PARAM_MEMORY_INDEX          0x0000012e
+
+/** Value for @ref UPS_PARAM_MEMORY_INDEX; a Btree (the default) */
+#define UPS_MEMORY_INDEX_BTREE                   0
+
+/** Value for @ref UPS_PARAM_MEMORY_INDEX; an adaptive radix tree */
+#define UPS_MEMORY_INDEX_ART                     1
+
+/** Parameter name for @ref ups_env_create_db; stores subtree counts in
+ * the internal Btree nodes */
+#define UPS_PARAM_SUBTREE_COUNTS        0x0000012f
+
+/** Parameter name for @ref ups_env_create; selects the AES cipher mode */
+#define UPS_PARAM_ENCRYPTION_MODE       0x00000130
+
+/** Value for @ref UPS_PARAM_ENCRYPTION_MODE; AES-128 in CBC mode, with
+ * the page address as the IV */
+#define UPS_ENCRYPTION_CBC                       1
+
+/** Value for @ref UPS_PARAM_ENCRYPTION_MODE; AES-128 in XTS mode, with
+ * the page address as the tweak (the default). The tweak key is derived
+ * from @ref UPS_PARAM_ENCRYPTION_KEY (see @ref UPS_ENCRYPTION_XTS_KDF_BLOCK) */
+#define UPS_ENCRYPTION_XTS                       2
+
+/** The 16 byte block which is encrypted with AES-128-ECB under
+ * @ref UPS_PARAM_ENCRYPTION_KEY to derive the tweak key of
+ * @ref UPS_ENCRYPTION_XTS; the two keys are therefore different, as
+ * required by libcrypto. This value is part of the file format and
+ * must not change */
+#define UPS_ENCRYPTION_XTS_KDF_BLOCK    "upscaledb:xts-k2"
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; the size of
+ * the compressed cache tier */
+#define UPS_PARAM_CACHE_COMPRESSED_SIZE 0x00000131
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; the
+ * compression algorithm of the compressed cache tier */
+#define UPS_PARAM_CACHE_COMPRESSOR      0x00000132
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; attaches
+ * the Environment to a @ref ups_cache_pool_t */
+#define UPS_PARAM_CACHE_POOL            0x00000133
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; preallocates
+ * and recycles the journal files */
+#define UPS_PARAM_JOURNAL_PREALLOCATE_SIZE 0x00000134
+
+/** Parameter name for @ref ups_env_create, @ref ups_env_open; writes the
+ * journal with O_DIRECT */
+#define UPS_PARAM_JOURNAL_DIRECT_IO     0x00000135
+
+/** Parameter name for @ref ups_env_create_db; sets the size of the Btree
+ * nodes of a Database */
+#define UPS_PARAM_DB_PAGE_SIZE          0x00000136
+
 /** Value for unlimited record sizes */
 #define UPS_RECORD_SIZE_UNLIMITED       ((uint32_t)-1)
 
@@ -1800,6 +3835,25 @@ ups_db_get_parameters(ups_db_t *db, ups_parameter_t *param);
  */
 #define UPS_PARAM_KEY_COMPRESSION       0x00001002
 
+/**
+ * Parameter name for @ref ups_env_create_db,
+ * @ref ups_env_open_db; enables compression for the duplicate records of
+ * a Database.
+ */
+#define UPS_PARAM_DUPLICATE_COMPRESSION 0x00001003
+
+/**
+ * Parameter name for @ref ups_env_create_db; sets the number of records
+ * which are sampled for training a zstd compression dictionary.
+ */
+#define UPS_PARAM_RECORD_COMPRESSION_DICTIONARY       0x00001004
+
+/**
+ * Parameter name for @ref ups_env_create_db; sets the maximum size of
+ * the zstd compression dictionary.
+ */
+#define UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE  0x00001005
+
 /** helper macro for disabling compression */
 #define UPS_COMPRESSOR_NONE         0
 
@@ -1821,6 +3875,25 @@ ups_db_get_parameters(ups_db_t *db, ups_parameter_t *param);
  */
 #define UPS_COMPRESSOR_LZF          3
 
+/**
+ * selects lz4 compression
+ * http://www.lz4.org/
+ */
+#define UPS_COMPRESSOR_LZ4         12
+
+/**
+ * selects zstd compression
+ * http://www.zstd.net/
+ */
+#define UPS_COMPRESSOR_ZSTD        13
+
+/**
+ * selects prefix compression for binary keys (front coding in the leaf
+ * nodes, suffix truncated separators in the internal nodes); only for
+ * @ref UPS_PARAM_KEY_COMPRESSION and @ref UPS_TYPE_BINARY
+ */
+#define UPS_COMPRESSOR_PREFIX      14
+
 /** uint32 key compression (varbyte) */
 #define UPS_COMPRESSOR_UINT32_VARBYTE       5
 #define UPS_COMPRESSOR_UINT32_MASKEDVBYTE   UPS_COMPRESSOR_UINT32_VARBYTE
@@ -1828,10 +3901,10 @@ ups_db_get_parameters(ups_db_t *db, ups_parameter_t *param);
 /** uint32 key compression (BP128) */
 #define UPS_COMPRESSOR_UINT32_SIMDCOMP      6
 
-/* deprecated */
+/** uint32 key compression (GroupVarint) */
 #define UPS_COMPRESSOR_UINT32_GROUPVARINT   7
 
-/* deprecated */
+/** uint32 key compression (StreamVByte) */
 #define UPS_COMPRESSOR_UINT32_STREAMVBYTE   8
 
 /** uint32 key compression (libfor - Frame Of Reference) */
@@ -1920,7 +3993,22 @@ ups_db_close(ups_db_t *db, uint32_t flags);
  *
  * @param db A valid Database handle
  * @param txn A Txn handle, or NULL
- * @param flags Optional flags for creating the Cursor; unused, set to 0
+ * @param flags Optional flags for creating the Cursor, combined with
+ *      bitwise OR. Possible flags are:
+ *    <ul>
+ *     <li>@ref UPS_CURSOR_READ_ONCE</li> The pages which are fetched by this
+ *      Cursor are not expected to be accessed again. They are not promoted
+ *      to the list of hot pages if @ref UPS_PARAM_CACHE_POLICY is
+ *      @ref UPS_CACHE_POLICY_2Q. Use this flag for long scans.
+ *     <li>@ref UPS_CURSOR_PREFETCH</li> The Cursor is used for sequential
+ *      scans. Whenever it moves to a new leaf page, the following
+ *      @ref UPS_PARAM_CURSOR_PREFETCH_PAGES sibling leaves and their blob
+ *      pages are read ahead in the background (with
+ *      posix_fadvise(POSIX_FADV_WILLNEED) or a dedicated I/O thread).
+ *      This flag also overrides @ref UPS_POSIX_FADVICE_RANDOM for the
+ *      pages which are prefetched. Ignored for In-Memory and remote
+ *      Environments.
+ *    </ul>
  * @param cursor A pointer to a pointer which is allocated for the
  *      new Cursor handle
  *
@@ -1932,6 +4020,12 @@ UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_cursor_create(ups_cursor_t **cursor, ups_db_t *db, ups_txn_t *txn,
             uint32_t flags);
 
+/** Flag for @ref ups_cursor_create */
+#define UPS_CURSOR_READ_ONCE            0x0001
+
+/** Flag for @ref ups_cursor_create */
+#define UPS_CURSOR_PREFETCH             0x0002
+
 /**
  * Clones a Database Cursor
  *
@@ -1984,6 +4078,27 @@ ups_cursor_clone(ups_cursor_t *src, ups_cursor_t **dest);
  * UPS_CURSOR_PREVIOUS) will be identical to @a UPS_CURSOR_FIRST (or
  * @a UPS_CURSOR_LAST).
  *
+ * Cursors of remote Environments move in batches: a move with
+ * @ref UPS_CURSOR_NEXT or @ref UPS_CURSOR_PREVIOUS fetches the following
+ * @ref UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE items, and the server reads
+ * the next batch ahead while the client consumes the current one. Most
+ * moves are therefore served from a buffer of the client. The buffer is
+ * discarded (and the next move is sent to the server) if
+ * <ul>
+ *   <li>the direction or the duplicate flags of the move change,
+ *   <li>the Cursor is repositioned (i.e. with @ref ups_cursor_find or
+ *      @ref UPS_CURSOR_FIRST), or is used to insert, overwrite or erase
+ *      an item,
+ *   <li>any handle of the same Environment modifies the Database, or
+ *      commits or aborts a Txn,
+ *   <li>the Cursor is attached to a Txn (or the Database uses
+ *      Transactions), and the batch would leave the Txn's view of the
+ *      Database; in this case the server returns shorter batches.
+ * </ul>
+ * With these rules, a remote Cursor returns the same items as a local
+ * Cursor, with the exception of modifications by other clients, which
+ * become visible with the next batch.
+ *
  * @param cursor A valid Cursor handle
  * @param key An optional pointer to a @ref ups_key_t structure. If this
  *    pointer is not NULL, the key of the new item is returned.
@@ -2059,6 +4174,49 @@ ups_cursor_move(ups_cursor_t *cursor, ups_key_t *key,
 /** Flag for @ref ups_cursor_move */
 #define UPS_ONLY_DUPLICATES             0x0020
 
+/**
+ * Moves the Cursor over several items and retrieves their keys and records
+ *
+ * This function is similar to calling @ref ups_cursor_move repeatedly, but
+ * returns up to @a max key/record pairs with a single call and a single
+ * acquisition of the Environment lock.
+ *
+ * The first move is performed with @a flags (i.e. @ref UPS_CURSOR_FIRST or
+ * @ref UPS_CURSOR_NEXT), all following moves continue in the same
+ * direction (@ref UPS_CURSOR_NEXT or @ref UPS_CURSOR_PREVIOUS). Afterwards,
+ * the Cursor points to the last item which was returned.
+ *
+ * For remote Environments, all items are fetched with a single request,
+ * independent of @ref UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE.
+ *
+ * The key and record data is stored in memory which is owned by the Cursor
+ * and remains valid till the next call with this Cursor. The keys and
+ * records can also be allocated by the caller (see @ref UPS_KEY_USER_ALLOC
+ * and @ref UPS_RECORD_USER_ALLOC). @a records can be NULL if the records
+ * are not required.
+ *
+ * @param cursor A valid Cursor handle
+ * @param keys An array of (at least) @a max keys
+ * @param records An array of (at least) @a max records, or NULL
+ * @param max The maximum number of items which are returned
+ * @param count Returns the number of items which were retrieved. Less
+ *      than @a max if the end (or beginning) of the Database was reached
+ * @param flags The direction of the first move, and optionally one of
+ *      @ref UPS_SKIP_DUPLICATES or @ref UPS_ONLY_DUPLICATES. See
+ *      @ref ups_cursor_move
+ *
+ * @return @ref UPS_SUCCESS upon success, if at least one item was returned
+ * @return @ref UPS_INV_PARAMETER if @a cursor, @a keys or @a count is NULL,
+ *      or if @a max is 0
+ * @return @ref UPS_KEY_NOT_FOUND if no item was found; @a count is then 0
+ *
+ * @sa ups_cursor_move
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cursor_move_batch(ups_cursor_t *cursor, ups_key_t *keys,
+            ups_record_t *records, uint32_t max, uint32_t *count,
+            uint32_t flags);
+
 /**
  * Overwrites the current record
  *
@@ -2145,6 +4303,9 @@ ups_cursor_overwrite(ups_cursor_t *cursor, ups_record_t *record,
  *        the first record which' key is larger than the specified
  *        key, whichever of these records is located first.
  *        When such records cannot be located, an error is returned.
+ *    <li>@ref UPS_FIND_FROM_CURRENT </li> A hint that @a key is
+ *        close behind the current position of the Cursor, i.e. in a
+ *        merge join or skip-scan. See below.
  *    </ul>
  *
  * <b>Remark</b>
@@ -2162,6 +4323,18 @@ ups_cursor_overwrite(ups_cursor_t *cursor, ups_record_t *record,
  * @ref UPS_FIND_LEQ_MATCH, @ref UPS_FIND_GEQ_MATCH and
  * @ref UPS_FIND_LT_MATCH, @ref UPS_FIND_GT_MATCH
  *
+ * <b>Searching from the current position</b>
+ * By default, each search descends the Btree from the root node. With
+ * @ref UPS_FIND_FROM_CURRENT, and if the Cursor points to a key which is
+ * smaller than @a key, the leaf node of the Cursor is searched first;
+ * if @a key is larger than all keys of this leaf, the right siblings
+ * are checked (up to @ref UPS_FIND_FROM_CURRENT_SIBLINGS of them) before
+ * the search falls back to a descent from the root. A sequence of
+ * increasing searches then costs about as much as a sequential scan.
+ * The result is always identical to a search without the flag; if the
+ * Cursor is nil or is not behind @a key then the flag is ignored. The
+ * hits and fall-backs are counted in ups_env_metrics_t.
+ *
  * @return @ref UPS_SUCCESS upon success
  * @return @ref UPS_INV_PARAMETER if @a db, @a key or @a record is NULL
  * @return @ref UPS_CURSOR_IS_NIL if the Cursor does not point to an item
@@ -2227,6 +4400,17 @@ ups_cursor_find(ups_cursor_t *cursor, ups_key_t *key,
 #define UPS_FIND_NEAR_MATCH     (UPS_FIND_LT_MATCH | UPS_FIND_GT_MATCH  \
                                   | UPS_FIND_EQ_MATCH)
 
+/**
+ * Cursor 'find' flag: starts the search at the current position of the
+ * Cursor instead of the root node of the Btree (see @ref ups_cursor_find).
+ * Can be combined with the other 'find' flags.
+ */
+#define UPS_FIND_FROM_CURRENT           0x8000
+
+/** The number of right siblings which are checked with
+ * @ref UPS_FIND_FROM_CURRENT before the root node is searched */
+#define UPS_FIND_FROM_CURRENT_SIBLINGS  4
+
 /**
  * Inserts a Database item and points the Cursor to the inserted item
  *
@@ -2332,6 +4516,30 @@ UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_cursor_insert(ups_cursor_t *cursor, ups_key_t *key,
             ups_record_t *record, uint32_t flags);
 
+/**
+ * Inserts a Database item from several buffers and points the Cursor to it
+ *
+ * This function is similar to @ref ups_cursor_insert, but the record is
+ * specified as an array of segments. See @ref ups_db_insert_iov for
+ * details.
+ *
+ * @param cursor A valid Cursor handle
+ * @param key The key of the new item
+ * @param iov An array of record segments
+ * @param iov_count The number of segments in @a iov
+ * @param flags Optional flags for inserting; see @ref ups_cursor_insert
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a cursor, @a key or @a iov is NULL
+ * @return @ref UPS_INV_RECORD_SIZE if the Database stores records with
+ *        a fixed size, and the sum of the segment sizes is different
+ *
+ * @sa ups_cursor_insert
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cursor_insert_iov(ups_cursor_t *cursor, ups_key_t *key,
+            const ups_record_iov_t *iov, uint32_t iov_count, uint32_t flags);
+
 /**
  * Erases the current key
  *
@@ -2363,6 +4571,9 @@ ups_cursor_erase(ups_cursor_t *cursor, uint32_t flags);
  * Cursor currently refers.
  * Returns 1 if the key has no duplicates.
  *
+ * The number of duplicates is stored in the header of the duplicate table;
+ * this function does not read the duplicate records.
+ *
  * @param cursor A valid Cursor handle
  * @param count Returns the number of duplicate keys
  * @param flags Optional flags; unused, set to 0.
@@ -2383,6 +4594,11 @@ ups_cursor_get_duplicate_count(ups_cursor_t *cursor,
  * Returns the position in the duplicate list of the current key. The position
  * is 0-based.
  *
+ * Large duplicate tables are split into chunks which are indexed by their
+ * first position; looking up the position of a duplicate (and inserting
+ * at a position, see @ref UPS_DUPLICATE_INSERT_BEFORE etc) is therefore
+ * logarithmic in the number of duplicates.
+ *
  * @param cursor A valid Cursor handle
  * @param position Returns the duplicate position
  *
@@ -2409,6 +4625,77 @@ ups_cursor_get_duplicate_position(ups_cursor_t *cursor,
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_cursor_get_record_size(ups_cursor_t *cursor, uint32_t *size);
 
+/**
+ * Moves the Cursor to the item with the given rank
+ *
+ * The rank is the 0-based position of an item in the sort order of the
+ * Database, i.e. rank 0 is the first item, and rank
+ * @ref ups_db_count - 1 is the last one. By default, each duplicate has
+ * its own rank; with @ref UPS_SKIP_DUPLICATES, only the keys are counted
+ * and the Cursor is moved to the first duplicate of the key.
+ *
+ * If the Database was created with @ref UPS_PARAM_SUBTREE_COUNTS then the
+ * item is located with a single descent from the root, which is
+ * logarithmic in the number of keys. Otherwise, the Cursor steps through
+ * the leaf nodes, skipping whole leaves by their key count.
+ *
+ * If Transactions are enabled then the ranks include the changes of
+ * Transactions which are not yet flushed to the Btree.
+ *
+ * @param cursor A valid Cursor handle
+ * @param rank The rank of the item
+ * @param key An optional pointer to a @ref ups_key_t structure. If this
+ *    pointer is not NULL, the key of the new item is returned.
+ *    Note that key->data will point to temporary data. This pointer
+ *    will be invalidated by subsequent upscaledb API calls. See
+ *    @ref UPS_KEY_USER_ALLOC on how to change this behaviour.
+ * @param record An optional pointer to a @ref ups_record_t structure. If this
+ *    pointer is not NULL, the record of the new item is returned.
+ *    See @ref ups_cursor_move for the memory management of the record.
+ * @param flags Optional flags:
+ *    <ul>
+ *    <li>@ref UPS_SKIP_DUPLICATES. Duplicates are not counted
+ *    </ul>
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a cursor is NULL
+ * @return @ref UPS_KEY_NOT_FOUND if @a rank is not smaller than the number
+ *        of items; the Cursor is not modified
+ *
+ * @sa ups_cursor_get_rank
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cursor_move_to_rank(ups_cursor_t *cursor, uint64_t rank,
+            ups_key_t *key, ups_record_t *record, uint32_t flags);
+
+/**
+ * Returns the rank of the current item
+ *
+ * Returns the 0-based position of the item to which the Cursor refers;
+ * see @ref ups_cursor_move_to_rank. With @ref UPS_SKIP_DUPLICATES, the
+ * rank of the key is returned, regardless of the duplicate to which the
+ * Cursor refers.
+ *
+ * If the Database was created with @ref UPS_PARAM_SUBTREE_COUNTS then
+ * the rank is calculated by walking from the leaf to the root.
+ * Otherwise, all leaves left of the Cursor are visited.
+ *
+ * @param cursor A valid Cursor handle
+ * @param rank Returns the rank
+ * @param flags Optional flags:
+ *    <ul>
+ *    <li>@ref UPS_SKIP_DUPLICATES. Duplicates are not counted
+ *    </ul>
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_CURSOR_IS_NIL if the Cursor does not point to an item
+ * @return @ref UPS_INV_PARAMETER if @a cursor or @a rank is NULL
+ *
+ * @sa ups_cursor_move_to_rank
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_cursor_get_rank(ups_cursor_t *cursor, uint64_t *rank, uint32_t flags);
+
 /**
  * Closes a Database Cursor
  *
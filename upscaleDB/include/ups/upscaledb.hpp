@@ -24,7 +24,9 @@
  * This C++ wrapper class is a very tight wrapper around the C API. It does
  * not attempt to be STL compatible.
  *
- * All functions throw exceptions of class @sa ups::error in case of an error.
+ * All functions throw exceptions of class @sa ups::error in case of an error,
+ * except for the try_* functions (i.e. @sa db::try_find), which return the
+ * status.
  * Please refer to the C API documentation for more information. You can find
  * it here: http://upscaledb.com/?page=doxygen&module=globals.html
  *
@@ -37,8 +39,29 @@
 #include <ups/upscaledb_int.h>
 #include <cstring>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
 #include <vector>
 
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+#  define UPS_HAVE_CXX11 1
+#  include <chrono>
+#  include <thread>
+#elif !defined(UPS_OS_WIN32)
+#  include <time.h>
+#endif
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#  define UPS_HAVE_CXX17 1
+#  include <optional>
+#  include <string_view>
+#endif
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#  define UPS_HAVE_CXX20 1
+#  include <span>
+#endif
+
 #if defined(_MSC_VER) && defined(_DEBUG) && !defined(_CRTDBG_MAP_ALLOC)
 #  define _CRTDBG_MAP_ALLOC
 #  include <crtdbg.h>
@@ -58,6 +81,29 @@ class txn;
 class db;
 class env;
 
+namespace detail {
+
+#if !defined(UPS_HAVE_CXX11) && defined(UPS_OS_WIN32)
+/* same declaration as in winbase.h; avoids including <windows.h> */
+extern "C" __declspec(dllimport) void __stdcall Sleep(unsigned long ms);
+#endif
+
+/** Suspends the calling thread for @a usec microseconds */
+inline void sleep_usec(uint32_t usec) {
+#if defined(UPS_HAVE_CXX11)
+  std::this_thread::sleep_for(std::chrono::microseconds(usec));
+#elif defined(UPS_OS_WIN32)
+  Sleep(usec / 1000 + 1);
+#else
+  struct timespec ts;
+  ts.tv_sec = usec / 1000000;
+  ts.tv_nsec = (long)(usec % 1000000) * 1000;
+  ::nanosleep(&ts, 0);
+#endif
+}
+
+} // namespace detail
+
 /**
  * An error class.
  *
@@ -99,6 +145,28 @@ class key {
       _key.flags = flags;
     }
 
+#ifdef UPS_HAVE_CXX17
+    /** Constructor; the key points to the characters of @a s. */
+    key(std::string_view s, uint32_t flags = 0) {
+      assert(s.size() <= UPS_KEY_SIZE_UNLIMITED);
+      ::memset(&_key, 0, sizeof(_key));
+      _key.data = const_cast<char *>(s.data());
+      _key.size = (uint16_t)s.size();
+      _key.flags = flags;
+    }
+#endif
+
+#ifdef UPS_HAVE_CXX20
+    /** Constructor; the key points to the bytes of @a s. */
+    key(std::span<const uint8_t> s, uint32_t flags = 0) {
+      assert(s.size() <= UPS_KEY_SIZE_UNLIMITED);
+      ::memset(&_key, 0, sizeof(_key));
+      _key.data = const_cast<uint8_t *>(s.data());
+      _key.size = (uint16_t)s.size();
+      _key.flags = flags;
+    }
+#endif
+
     /** Copy constructor. */
     key(const key &other)
       : _key(other._key) {
@@ -249,11 +317,68 @@ class txn {
         throw error(st);
     }
 
+    /** Commit the Txn; @a callback is invoked when the Txn is durable */
+    void commit_async(ups_txn_commit_callback_t callback,
+                    void *user_data = 0) {
+      ups_status_t st = ups_txn_commit_async(_txn, callback, user_data);
+      if (st)
+        throw error(st);
+    }
+
     std::string get_name() {
       const char *p = ups_txn_get_name(_txn);
       return p ? p : "";
     }
 
+    /** Returns the Txn id */
+    uint64_t get_id() {
+      return ups_txn_get_id(_txn);
+    }
+
+    /** Returns the id of the conflicting Txn and the conflicting key */
+    uint64_t get_conflict_info(key *k = 0) {
+      uint64_t id = 0;
+      ups_status_t st = ups_txn_get_conflict_info(_txn, &id,
+                      k ? k->get_handle() : 0);
+      if (st)
+        throw error(st);
+      return id;
+    }
+
+    /**
+     * Runs @a f(txn &) in a new Txn of @a e, then commits the Txn.
+     *
+     * If @a f or the commit fail with UPS_TXN_CONFLICT then the Txn is
+     * aborted and @a f is retried after a delay, which starts with
+     * @a backoff_usec and is doubled for each retry, up to one second.
+     * After @a max_retries retries (or for any other error) the error is
+     * thrown. If @a f throws anything else, the Txn is aborted and the
+     * exception is rethrown.
+     */
+    template <class Env, class Functor>
+    static void retry(Env &e, Functor f, uint32_t max_retries = 10,
+                    uint32_t backoff_usec = 50) {
+      for (uint32_t i = 0; ; i++) {
+        txn t = e.begin();
+        try {
+          f(t);
+          t.commit();
+          return;
+        }
+        catch (error &ex) {
+          (void)ups_txn_abort(t.get_handle(), 0);
+          if (ex.get_errno() != UPS_TXN_CONFLICT || i >= max_retries)
+            throw;
+        }
+        catch (...) {
+          (void)ups_txn_abort(t.get_handle(), 0);
+          throw;
+        }
+        uint64_t usec = (uint64_t)backoff_usec << (i < 16 ? i : 16);
+        detail::sleep_usec(usec > 1000000 ? 1000000 : (uint32_t)usec);
+      }
+    }
+
     /** Returns a pointer to the internal ups_txn_t structure. */
     ups_txn_t *get_handle() {
       return _txn;
@@ -264,6 +389,89 @@ class txn {
 };
 
 
+/**
+ * A batch of write operations
+ *
+ * This class wraps structures of type ups_batch_t. The batch is
+ * applied with db::write_batch().
+ */
+class batch {
+  public:
+    /** Constructor - creates an empty batch */
+    batch()
+      : _batch(0) {
+      ups_status_t st = ups_batch_create(&_batch, 0);
+      if (st)
+        throw error(st);
+    }
+
+    /** Destructor - releases the batch */
+    ~batch() {
+      if (_batch)
+        (void)ups_batch_close(_batch);
+    }
+
+#ifdef UPS_HAVE_CXX11
+    /** Move constructor. */
+    batch(batch &&other) noexcept
+      : _batch(other._batch) {
+      other._batch = 0;
+    }
+
+    /** Move assignment operator. */
+    batch &operator=(batch &&other) noexcept {
+      if (this != &other) {
+        if (_batch)
+          (void)ups_batch_close(_batch);
+        _batch = other._batch;
+        other._batch = 0;
+      }
+      return *this;
+    }
+#endif
+
+    /** Adds an insert operation; the key and the record are copied. */
+    void put(key *k, record *r, uint32_t flags = 0) {
+      ups_status_t st = ups_batch_put(_batch, k ? k->get_handle() : 0,
+                      r ? r->get_handle() : 0, flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Adds an erase operation; the key is copied. */
+    void erase(key *k, uint32_t flags = 0) {
+      ups_status_t st = ups_batch_erase(_batch, k ? k->get_handle() : 0,
+                      flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Returns the number of operations. */
+    uint32_t get_count() {
+      return ups_batch_get_count(_batch);
+    }
+
+    /** Removes all operations. */
+    void clear() {
+      ups_status_t st = ups_batch_clear(_batch);
+      if (st)
+        throw error(st);
+    }
+
+    /** Returns a pointer to the internal ups_batch_t structure. */
+    ups_batch_t *get_handle() {
+      return _batch;
+    }
+
+  private:
+    /* Copy Constructor and assignment are not allowed. */
+    batch(const batch &);
+    batch &operator=(const batch &);
+
+    ups_batch_t *_batch;
+};
+
+
 /**
  * A Database class.
  *
@@ -323,6 +531,26 @@ class db {
       return *this;
     }
 
+#ifdef UPS_HAVE_CXX11
+    /** Move constructor. */
+    db(db &&other) noexcept
+      : _db(other._db) {
+      other._db = 0;
+    }
+
+    /** Move assignment operator. Closes the current Database; like in
+     * the destructor, errors are ignored. */
+    db &operator=(db &&other) noexcept {
+      if (this != &other) {
+        if (_db)
+          (void)ups_db_close(_db, 0);
+        _db = other._db;
+        other._db = 0;
+      }
+      return *this;
+    }
+#endif
+
     /** Sets the comparison function. */
     void set_compare_func(ups_compare_func_t foo) {
       ups_status_t st = ups_db_set_compare_func(_db, foo);
@@ -354,6 +582,73 @@ class db {
       return find(0, k, flags);
     }
 
+    /**
+     * Finds a record by looking up the key. Does not throw; returns the
+     * status, i.e. UPS_KEY_NOT_FOUND if the key does not exist. The
+     * memory of @a r is reused by the following lookups.
+     */
+    ups_status_t try_find(txn *t, key *k, record *r, uint32_t flags = 0) {
+      return ups_db_find(_db, t ? t->get_handle() : 0,
+                      k ? k->get_handle() : 0, r->get_handle(), flags);
+    }
+
+#ifdef UPS_HAVE_CXX17
+    /** Finds a record (without approximate matching). Does not throw;
+     * returns the status. */
+    ups_status_t try_find(txn *t, std::string_view k, record *r,
+                    uint32_t flags = 0) {
+      key tmp(k);
+      return try_find(t, &tmp, r, flags);
+    }
+
+    /**
+     * Finds a record by looking up the key. Returns std::nullopt if the
+     * key does not exist; other errors throw an exception.
+     */
+    std::optional<record> find_optional(txn *t, key *k, uint32_t flags = 0) {
+      record r;
+      ups_status_t st = try_find(t, k, &r, flags);
+      if (st == UPS_KEY_NOT_FOUND)
+        return std::nullopt;
+      if (st)
+        throw error(st);
+      return r;
+    }
+
+    /** Finds a record (without approximate matching). Returns
+     * std::nullopt if the key does not exist. */
+    std::optional<record> find_optional(txn *t, std::string_view k,
+                    uint32_t flags = 0) {
+      key tmp(k);
+      return find_optional(t, &tmp, flags);
+    }
+#endif
+
+    /**
+     * Looks up |count| keys at once. The result of each lookup is stored
+     * in |statuses|; missing keys do not throw an exception.
+     */
+    void find_many(txn *t, key *keys, record *records,
+                    ups_status_t *statuses, uint32_t count,
+                    uint32_t flags = 0) {
+      if (count == 0)
+        return;
+      std::vector<ups_key_t> k(count);
+      std::vector<ups_record_t> r(count);
+      for (uint32_t i = 0; i < count; i++) {
+        k[i] = *keys[i].get_handle();
+        r[i] = *records[i].get_handle();
+      }
+      ups_status_t st = ups_db_find_many(_db, t ? t->get_handle() : 0,
+                      &k[0], &r[0], statuses, count, flags);
+      if (st)
+        throw error(st);
+      for (uint32_t i = 0; i < count; i++) {
+        *keys[i].get_handle() = k[i];
+        *records[i].get_handle() = r[i];
+      }
+    }
+
     /** Inserts a key/record pair. */
     void insert(txn *t, key *k, record *r, uint32_t flags = 0) {
       ups_status_t st = ups_db_insert(_db, t ? t->get_handle() : 0,
@@ -380,6 +675,29 @@ class db {
         throw error(st);
     }
 
+    /**
+     * Looks up @a index_key in this secondary index and returns the
+     * record of the primary Database; @a primary_key receives its key.
+     */
+    record find_by_index(txn *t, key *index_key, key *primary_key = 0,
+                    uint32_t flags = 0) {
+      record r;
+      ups_status_t st = ups_db_find_by_index(_db, t ? t->get_handle() : 0,
+                      index_key ? index_key->get_handle() : 0,
+                      primary_key ? primary_key->get_handle() : 0,
+                      r.get_handle(), flags);
+      if (st)
+        throw error(st);
+      return r;
+    }
+
+    /** Applies all operations of a batch atomically. */
+    void write_batch(batch &b, uint32_t flags = 0) {
+      ups_status_t st = ups_db_write_batch(_db, b.get_handle(), flags);
+      if (st)
+        throw error(st);
+    }
+
     /** Returns number of items in the Database. */
     uint64_t count(ups_txn_t *txn = 0, uint32_t flags = 0) {
       uint64_t count = 0;
@@ -431,7 +749,10 @@ class db {
 /**
  * A Database Cursor.
  *
- * This class wraps the ups_cursor_t Cursor handles.
+ * This class wraps the ups_cursor_t Cursor handles. A Cursor can be
+ * reused for any number of lookups and moves; it does not have to be
+ * re-created. try_find and try_move return the status instead of throwing,
+ * i.e. UPS_KEY_NOT_FOUND at the end of the Database.
  */
 class cursor {
   public:
@@ -478,6 +799,26 @@ class cursor {
       }
     }
 
+#ifdef UPS_HAVE_CXX11
+    /** Move constructor. */
+    cursor(cursor &&other) noexcept
+      : _cursor(other._cursor) {
+      other._cursor = 0;
+    }
+
+    /** Move assignment operator. Closes the current Cursor; like in
+     * the destructor, errors are ignored. */
+    cursor &operator=(cursor &&other) noexcept {
+      if (this != &other) {
+        if (_cursor)
+          (void)ups_cursor_close(_cursor);
+        _cursor = other._cursor;
+        other._cursor = 0;
+      }
+      return *this;
+    }
+#endif
+
     /** Clones the Cursor. */
     cursor clone() {
       ups_cursor_t *dest;
@@ -495,6 +836,12 @@ class cursor {
         throw error(st);
     }
 
+    /** Moves the Cursor. Does not throw; returns the status. */
+    ups_status_t try_move(key *k, record *r, uint32_t flags = 0) {
+      return ups_cursor_move(_cursor, k ? k->get_handle() : 0,
+                        r ? r->get_handle() : 0, flags);
+    }
+
     /** Moves the Cursor to the first Database element. */
     void move_first(key *k = 0, record *r = 0) {
       move(k, r, UPS_CURSOR_FIRST);
@@ -531,6 +878,28 @@ class cursor {
         throw error(st);
     }
 
+    /** Finds a key. Does not throw; returns the status. */
+    ups_status_t try_find(key *k, record *r = 0, uint32_t flags = 0) {
+      return ups_cursor_find(_cursor, k->get_handle(),
+                        (r ? r->get_handle() : 0), flags);
+    }
+
+    /**
+     * Moves the Cursor forward to the first key which is >= @a k (or
+     * which matches @a flags), starting the search at the current
+     * position (@ref UPS_FIND_FROM_CURRENT). Returns false if there is no
+     * such key; other errors throw an exception.
+     */
+    bool seek_forward(key *k, record *r = 0,
+                    uint32_t flags = UPS_FIND_GEQ_MATCH) {
+      ups_status_t st = try_find(k, r, flags | UPS_FIND_FROM_CURRENT);
+      if (st == UPS_KEY_NOT_FOUND)
+        return false;
+      if (st)
+        throw error(st);
+      return true;
+    }
+
     /** Inserts a key/record pair. */
     void insert(key *k, record *r, uint32_t flags = 0) {
       ups_status_t st = ups_cursor_insert(_cursor, k ? k->get_handle() : 0,
@@ -596,6 +965,26 @@ class env {
       : _env(0) {
     }
 
+#ifdef UPS_HAVE_CXX11
+    /** Move constructor. */
+    env(env &&other) noexcept
+      : _env(other._env) {
+      other._env = 0;
+    }
+
+    /** Move assignment operator. Closes the current Environment; like in
+     * the destructor, errors are ignored. */
+    env &operator=(env &&other) noexcept {
+      if (this != &other) {
+        if (_env)
+          (void)ups_env_close(_env, 0);
+        _env = other._env;
+        other._env = 0;
+      }
+      return *this;
+    }
+#endif
+
     /**
      * Destructor - automatically closes the Environment, if necessary.
      *
@@ -639,6 +1028,13 @@ class env {
         throw error(st);
     }
 
+    /** Assigns the calling thread to a class of the Environment lock. */
+    void set_thread_class(uint32_t weight, int32_t parent = 0) {
+      ups_status_t st = ups_env_set_thread_class(_env, weight, parent);
+      if (st)
+        throw error(st);
+    }
+
     /** Creates a new Database in the Environment. */
     db create_db(uint16_t name, uint32_t flags = 0,
                 const ups_parameter_t *param = 0) {
@@ -651,6 +1047,20 @@ class env {
       return upscaledb::db(dbh);
     }
 
+    /** Creates a secondary index of the Database @a primary. */
+    db create_index(db &primary, uint16_t index_name,
+                const char *extractor_name, uint32_t flags = 0,
+                const ups_parameter_t *param = 0) {
+      ups_db_t *dbh;
+
+      ups_status_t st = ups_env_create_index(_env, primary.get_handle(),
+                      index_name, extractor_name, flags, param, &dbh);
+      if (st)
+        throw error(st);
+
+      return upscaledb::db(dbh);
+    }
+
     /** Opens an existing Database in the Environment. */
     db open_db(uint16_t name, uint32_t flags = 0,
                 const ups_parameter_t *param = 0) {
@@ -727,10 +1137,631 @@ class env {
       return v;
     }
 
+    /** Returns a pointer to the internal ups_env_t structure. */
+    ups_env_t *get_handle() {
+      return _env;
+    }
+
   private:
     ups_env_t *_env;
 };
 
+/**
+ * Maps a key type to the Database parameters and the sort order.
+ *
+ * Unsigned integers and floating point types are stored as numeric keys
+ * (@ref UPS_TYPE_UINT32, @ref UPS_TYPE_REAL64 etc). Signed integers are
+ * rejected at compile time, because upscaledb has no signed numeric key
+ * types and their bytes do not sort numerically; use an unsigned type
+ * or a structure with a big-endian encoding. All other types are stored
+ * as fixed-size binary keys and are sorted with memcmp().
+ */
+template<typename T>
+struct key_traits {
+  enum { type = UPS_TYPE_BINARY, fixed_size = 1 };
+
+  static int compare(const T &lhs, const T &rhs) {
+    return ::memcmp(&lhs, &rhs, sizeof(T));
+  }
+};
+
+/** Key traits for numeric keys */
+template<typename T, int Type>
+struct numeric_key_traits {
+  enum { type = Type, fixed_size = 0 };
+
+  static int compare(const T &lhs, const T &rhs) {
+    return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+  }
+};
+
+/** The numeric key type of an unsigned integer with @a Size bytes */
+template<size_t Size> struct uint_key_type;
+template<> struct uint_key_type<1> { enum { type = UPS_TYPE_UINT8 }; };
+template<> struct uint_key_type<2> { enum { type = UPS_TYPE_UINT16 }; };
+template<> struct uint_key_type<4> { enum { type = UPS_TYPE_UINT32 }; };
+template<> struct uint_key_type<8> { enum { type = UPS_TYPE_UINT64 }; };
+
+/* long long is not part of C++98, but supported by all compilers */
+#if defined(UPS_HAVE_CXX11)
+#  define UPS_HAVE_LONG_LONG 1
+typedef long long key_longlong_t;
+typedef unsigned long long key_ulonglong_t;
+#elif defined(__GNUC__)
+#  define UPS_HAVE_LONG_LONG 1
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wlong-long"
+typedef long long key_longlong_t;
+typedef unsigned long long key_ulonglong_t;
+#  pragma GCC diagnostic pop
+#endif
+
+/* all unsigned integer types, not only the uintN_t typedefs (i.e.
+ * unsigned long long is not uint64_t on LP64 platforms) */
+template<> struct key_traits<unsigned char>
+  : numeric_key_traits<unsigned char,
+                uint_key_type<sizeof(unsigned char)>::type> { };
+template<> struct key_traits<unsigned short>
+  : numeric_key_traits<unsigned short,
+                uint_key_type<sizeof(unsigned short)>::type> { };
+template<> struct key_traits<unsigned int>
+  : numeric_key_traits<unsigned int,
+                uint_key_type<sizeof(unsigned int)>::type> { };
+template<> struct key_traits<unsigned long>
+  : numeric_key_traits<unsigned long,
+                uint_key_type<sizeof(unsigned long)>::type> { };
+#ifdef UPS_HAVE_LONG_LONG
+template<> struct key_traits<key_ulonglong_t>
+  : numeric_key_traits<key_ulonglong_t,
+                uint_key_type<sizeof(key_ulonglong_t)>::type> { };
+#endif
+
+/* signed integers are not supported (declared, but not defined) */
+template<> struct key_traits<signed char>;
+template<> struct key_traits<short>;
+template<> struct key_traits<int>;
+template<> struct key_traits<long>;
+#ifdef UPS_HAVE_LONG_LONG
+template<> struct key_traits<key_longlong_t>;
+#endif
+
+template<> struct key_traits<float>
+  : numeric_key_traits<float, UPS_TYPE_REAL32> { };
+template<> struct key_traits<double>
+  : numeric_key_traits<double, UPS_TYPE_REAL64> { };
+
+/**
+ * A Database with keys of type @a K and records of type @a V.
+ *
+ * Both types have to be trivially copyable (i.e. integers, floats or
+ * structures without pointers); they are copied with memcpy(). The key
+ * type and size and the record size are set when the Database is
+ * created (see @ref key_traits). Records are read directly into the
+ * caller's object (@ref UPS_RECORD_USER_ALLOC), without an intermediate
+ * copy.
+ */
+template<typename K, typename V>
+class typed_db {
+  public:
+    /** Constructor */
+    typed_db()
+      : _db(0) {
+    }
+
+    /** Destructor - closes the Database */
+    ~typed_db() {
+      if (_db)
+        (void)ups_db_close(_db, 0);
+    }
+
+#ifdef UPS_HAVE_CXX11
+    /** Move constructor */
+    typed_db(typed_db &&other) noexcept
+      : _db(other._db) {
+      other._db = 0;
+    }
+#endif
+
+    /**
+     * Creates the Database in @a e. Additional parameters can be passed
+     * in @a param (terminated by {0, 0}); they must not set the key type,
+     * the key size or the record size.
+     */
+    void create(env &e, uint16_t name, uint32_t flags = 0,
+                const ups_parameter_t *param = 0) {
+      std::vector<ups_parameter_t> p;
+      ups_parameter_t kt = {UPS_PARAM_KEY_TYPE, (uint64_t)key_traits<K>::type};
+      ups_parameter_t rs = {UPS_PARAM_RECORD_SIZE, sizeof(V)};
+      p.push_back(kt);
+      p.push_back(rs);
+      if (key_traits<K>::fixed_size) {
+        ups_parameter_t ks = {UPS_PARAM_KEY_SIZE, sizeof(K)};
+        p.push_back(ks);
+      }
+      for (; param && param->name; param++)
+        p.push_back(*param);
+      ups_parameter_t last = {0, 0};
+      p.push_back(last);
+
+      close();
+      ups_status_t st = ups_env_create_db(e.get_handle(), &_db, name, flags,
+                      &p[0]);
+      if (st)
+        throw error(st);
+    }
+
+    /** Opens the Database in @a e. */
+    void open(env &e, uint16_t name, uint32_t flags = 0,
+                const ups_parameter_t *param = 0) {
+      close();
+      ups_status_t st = ups_env_open_db(e.get_handle(), &_db, name, flags,
+                      param);
+      if (st)
+        throw error(st);
+    }
+
+    /**
+     * Finds the record of @a k; throws if the key does not exist.
+     * Approximate matching (i.e. @ref UPS_FIND_GEQ_MATCH) overwrites the
+     * key and therefore requires a non-const @a k; with a const @a k,
+     * these flags throw @ref UPS_INV_PARAMETER.
+     */
+    void find(txn *t, const K &k, V &v, uint32_t flags = 0) {
+      if (flags & (UPS_FIND_LT_MATCH | UPS_FIND_GT_MATCH))
+        throw error(UPS_INV_PARAMETER);
+      ups_status_t st = find_impl(t, k, v, flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Finds the record of @a k, or (with approximate matching flags) of
+     * a neighbour of @a k, whose key is then stored in @a k. */
+    void find(txn *t, K &k, V &v, uint32_t flags = 0) {
+      ups_status_t st = find_impl(t, k, v, flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Finds the record of @a k. Returns false if the key does not exist;
+     * other errors throw an exception. Like find(), approximate matching
+     * requires a non-const @a k. */
+    bool try_find(txn *t, const K &k, V &v, uint32_t flags = 0) {
+      if (flags & (UPS_FIND_LT_MATCH | UPS_FIND_GT_MATCH))
+        throw error(UPS_INV_PARAMETER);
+      return check_found(find_impl(t, k, v, flags));
+    }
+
+    /** Like find(), but returns false if the key does not exist. */
+    bool try_find(txn *t, K &k, V &v, uint32_t flags = 0) {
+      return check_found(find_impl(t, k, v, flags));
+    }
+
+    /** Finds the record of @a k; throws if the key does not exist. */
+    V find(const K &k) {
+      V v;
+      find(0, k, v);
+      return v;
+    }
+
+    /**
+     * Looks up @a count keys at once, and reads the records into
+     * @a values. The result of each lookup is stored in @a statuses;
+     * missing keys do not throw an exception.
+     */
+    void find_many(txn *t, const K *keys, V *values, ups_status_t *statuses,
+                    uint32_t count, uint32_t flags = 0) {
+      if (count == 0)
+        return;
+      std::vector<ups_key_t> k(count);
+      std::vector<ups_record_t> r(count);
+      for (uint32_t i = 0; i < count; i++) {
+        k[i] = make_key(keys[i]);
+        r[i] = make_record(values[i]);
+      }
+      ups_status_t st = ups_db_find_many(_db, t ? t->get_handle() : 0,
+                      &k[0], &r[0], statuses, count, flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Inserts a key/record pair. */
+    void insert(txn *t, const K &k, const V &v, uint32_t flags = 0) {
+      ups_key_t key = make_key(k);
+      ups_record_t record = make_record(const_cast<V &>(v));
+      ups_status_t st = ups_db_insert(_db, t ? t->get_handle() : 0, &key,
+                      &record, flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Inserts a key/record pair. */
+    void insert(const K &k, const V &v, uint32_t flags = 0) {
+      insert(0, k, v, flags);
+    }
+
+    /** Erases a key/record pair. */
+    void erase(txn *t, const K &k, uint32_t flags = 0) {
+      ups_key_t key = make_key(k);
+      ups_status_t st = ups_db_erase(_db, t ? t->get_handle() : 0, &key,
+                      flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Erases a key/record pair. */
+    void erase(const K &k, uint32_t flags = 0) {
+      erase(0, k, flags);
+    }
+
+    /** Returns number of items in the Database. */
+    uint64_t count(txn *t = 0, uint32_t flags = 0) {
+      uint64_t count = 0;
+      ups_status_t st = ups_db_count(_db, t ? t->get_handle() : 0, flags,
+                      &count);
+      if (st)
+        throw error(st);
+      return count;
+    }
+
+    /** Closes the Database. */
+    void close(uint32_t flags = 0) {
+      if (!_db)
+        return;
+      ups_status_t st = ups_db_close(_db, flags & ~UPS_AUTO_CLEANUP);
+      _db = 0;
+      if (st)
+        throw error(st);
+    }
+
+    /** Returns a pointer to the internal ups_db_t structure. */
+    ups_db_t *get_handle() {
+      return _db;
+    }
+
+    /** Returns a ups_key_t which points to @a k. */
+    static ups_key_t make_key(const K &k) {
+      ups_key_t key;
+      ::memset(&key, 0, sizeof(key));
+      key.data = const_cast<K *>(&k);
+      key.size = sizeof(K);
+      key.flags = UPS_KEY_USER_ALLOC;
+      return key;
+    }
+
+    /** Returns a ups_record_t which points to @a v. */
+    static ups_record_t make_record(V &v) {
+      ups_record_t record;
+      ::memset(&record, 0, sizeof(record));
+      record.data = &v;
+      record.size = sizeof(V);
+      record.flags = UPS_RECORD_USER_ALLOC;
+      return record;
+    }
+
+  private:
+    /* the key is only overwritten with approximate matching */
+    ups_status_t find_impl(txn *t, const K &k, V &v, uint32_t flags) {
+      ups_key_t key = make_key(k);
+      ups_record_t record = make_record(v);
+      return ups_db_find(_db, t ? t->get_handle() : 0, &key, &record,
+                      flags);
+    }
+
+    static bool check_found(ups_status_t st) {
+      if (st == UPS_KEY_NOT_FOUND)
+        return false;
+      if (st)
+        throw error(st);
+      return true;
+    }
+
+    /* not copyable */
+    typed_db(const typed_db &);
+    typed_db &operator=(const typed_db &);
+
+    ups_db_t *_db;
+};
+
+/**
+ * A Cursor of a @ref typed_db. The move functions return false instead
+ * of throwing if there is no key (@ref UPS_KEY_NOT_FOUND).
+ */
+template<typename K, typename V>
+class typed_cursor {
+  public:
+    /** Constructor */
+    typed_cursor(typed_db<K, V> &db, txn *t = 0, uint32_t flags = 0)
+      : _cursor(0) {
+      ups_status_t st = ups_cursor_create(&_cursor, db.get_handle(),
+                      t ? t->get_handle() : 0, flags);
+      if (st)
+        throw error(st);
+    }
+
+    /** Destructor - closes the Cursor */
+    ~typed_cursor() {
+      if (_cursor)
+        (void)ups_cursor_close(_cursor);
+    }
+
+    /** Moves the Cursor (i.e. @ref UPS_CURSOR_NEXT) and reads the key and
+     * the record of the new position. */
+    bool move(K &k, V &v, uint32_t flags) {
+      ups_key_t key = typed_db<K, V>::make_key(k);
+      ups_record_t record = typed_db<K, V>::make_record(v);
+      return check(ups_cursor_move(_cursor, &key, &record, flags));
+    }
+
+    /** Moves the Cursor to the first key. */
+    bool first(K &k, V &v) {
+      return move(k, v, UPS_CURSOR_FIRST);
+    }
+
+    /** Moves the Cursor to the last key. */
+    bool last(K &k, V &v) {
+      return move(k, v, UPS_CURSOR_LAST);
+    }
+
+    /** Moves the Cursor to the next key. */
+    bool next(K &k, V &v) {
+      return move(k, v, UPS_CURSOR_NEXT);
+    }
+
+    /** Moves the Cursor to the previous key. */
+    bool previous(K &k, V &v) {
+      return move(k, v, UPS_CURSOR_PREVIOUS);
+    }
+
+    /** Moves the Cursor to @a k, or (with approximate matching flags like
+     * @ref UPS_FIND_GEQ_MATCH) to a neighbour of @a k; the key of the
+     * new position is stored in @a k. */
+    bool find(K &k, V &v, uint32_t flags = 0) {
+      ups_key_t key = typed_db<K, V>::make_key(k);
+      ups_record_t record = typed_db<K, V>::make_record(v);
+      return check(ups_cursor_find(_cursor, &key, &record, flags));
+    }
+
+    /** Moves the Cursor to the first key which is >= @a lower. */
+    bool lower_bound(const K &lower, K &k, V &v) {
+      k = lower;
+      return find(k, v, UPS_FIND_GEQ_MATCH);
+    }
+
+    /** Like lower_bound(), but starts the search at the current position
+     * (@ref UPS_FIND_FROM_CURRENT); for increasing keys, i.e. in merge
+     * joins. */
+    bool seek_forward(const K &lower, K &k, V &v) {
+      k = lower;
+      return find(k, v, UPS_FIND_GEQ_MATCH | UPS_FIND_FROM_CURRENT);
+    }
+
+    /** Returns a pointer to the internal ups_cursor_t structure. */
+    ups_cursor_t *get_handle() {
+      return _cursor;
+    }
+
+  private:
+    bool check(ups_status_t st) {
+      if (st == UPS_KEY_NOT_FOUND)
+        return false;
+      if (st)
+        throw error(st);
+      return true;
+    }
+
+    /* not copyable */
+    typed_cursor(const typed_cursor &);
+    typed_cursor &operator=(const typed_cursor &);
+
+    ups_cursor_t *_cursor;
+};
+
+/**
+ * The keys of a @ref typed_db in the range [@a lower, @a upper), in
+ * ascending order. Usage:
+ * <pre>
+ *   typed_range<uint64_t, order_t> r(db, 0, 1000, 2000);
+ *   for (typed_range<uint64_t, order_t>::iterator it = r.begin();
+ *           it != r.end(); ++it)
+ *     process(it->first, it->second);
+ * </pre>
+ * The range has a single Cursor; only one iterator of the range can be
+ * used at a time.
+ */
+template<typename K, typename V>
+class typed_range {
+  public:
+    /** An input iterator; the value is a std::pair<K, V> */
+    class iterator {
+      public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::pair<K, V> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type *pointer;
+        typedef const value_type &reference;
+
+        iterator(typed_range *range = 0)
+          : _range(range) {
+        }
+
+        reference operator*() const {
+          return _range->_value;
+        }
+
+        pointer operator->() const {
+          return &_range->_value;
+        }
+
+        iterator &operator++() {
+          if (!_range->advance())
+            _range = 0;
+          return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+          return _range == other._range;
+        }
+
+        bool operator!=(const iterator &other) const {
+          return _range != other._range;
+        }
+
+      private:
+        typed_range *_range;
+    };
+
+    /** Constructor */
+    typed_range(typed_db<K, V> &db, txn *t, const K &lower, const K &upper)
+      : _cursor(db, t), _lower(lower), _upper(upper) {
+    }
+
+    /** Positions the Cursor on the first key of the range. */
+    iterator begin() {
+      if (!_cursor.lower_bound(_lower, _value.first, _value.second)
+            || !in_range())
+        return end();
+      return iterator(this);
+    }
+
+    /** The end of the range. */
+    iterator end() {
+      return iterator();
+    }
+
+  private:
+    friend class iterator;
+
+    bool in_range() const {
+      return key_traits<K>::compare(_value.first, _upper) < 0;
+    }
+
+    bool advance() {
+      return _cursor.next(_value.first, _value.second) && in_range();
+    }
+
+    typed_cursor<K, V> _cursor;
+    K _lower;
+    K _upper;
+    std::pair<K, V> _value;
+};
+
+/**
+ * A comparator with the order of @ref UPS_COMPARE_MEMCMP_REVERSE.
+ */
+struct memcmp_reverse_compare {
+  int operator()(const uint8_t *lhs, uint32_t lhs_length,
+                  const uint8_t *rhs, uint32_t rhs_length) const {
+    int cmp = ::memcmp(lhs, rhs, lhs_length < rhs_length
+                    ? lhs_length : rhs_length);
+    if (cmp)
+      return -cmp;
+    return lhs_length < rhs_length ? 1 : (lhs_length > rhs_length ? -1 : 0);
+  }
+};
+
+/**
+ * A comparator with the order of @ref UPS_COMPARE_CASE_INSENSITIVE.
+ */
+struct case_insensitive_compare {
+  int operator()(const uint8_t *lhs, uint32_t lhs_length,
+                  const uint8_t *rhs, uint32_t rhs_length) const {
+    uint32_t length = lhs_length < rhs_length ? lhs_length : rhs_length;
+    for (uint32_t i = 0; i < length; i++) {
+      uint8_t l = lhs[i] >= 'A' && lhs[i] <= 'Z' ? lhs[i] + 32 : lhs[i];
+      uint8_t r = rhs[i] >= 'A' && rhs[i] <= 'Z' ? rhs[i] + 32 : rhs[i];
+      if (l != r)
+        return l < r ? -1 : 1;
+    }
+    return lhs_length < rhs_length ? -1 : (lhs_length > rhs_length ? 1 : 0);
+  }
+};
+
+/**
+ * A comparator with the order of @ref UPS_COMPARE_BIG_ENDIAN_COMPOSITE.
+ * Flipping the sign bit of each 8 byte field makes the signed values
+ * comparable byte by byte.
+ */
+struct big_endian_composite_compare {
+  int operator()(const uint8_t *lhs, uint32_t lhs_length,
+                  const uint8_t *rhs, uint32_t rhs_length) const {
+    uint32_t length = lhs_length < rhs_length ? lhs_length : rhs_length;
+    for (uint32_t i = 0; i < length; i++) {
+      uint8_t l = (i & 7) == 0 ? lhs[i] ^ 0x80 : lhs[i];
+      uint8_t r = (i & 7) == 0 ? rhs[i] ^ 0x80 : rhs[i];
+      if (l != r)
+        return l < r ? -1 : 1;
+    }
+    return lhs_length < rhs_length ? -1 : (lhs_length > rhs_length ? 1 : 0);
+  }
+};
+
+/**
+ * The compare and search functions for a comparator; used by
+ * @ref register_compare.
+ */
+template<typename Cmp>
+struct compare_functions {
+  static int UPS_CALLCONV compare(ups_db_t *, const uint8_t *lhs,
+                  uint32_t lhs_length, const uint8_t *rhs,
+                  uint32_t rhs_length) {
+    return Cmp()(lhs, lhs_length, rhs, rhs_length);
+  }
+
+  static int UPS_CALLCONV search(ups_db_t *, const uint8_t *key,
+                  uint32_t key_length, const uint8_t **keys,
+                  const uint32_t *key_lengths, int count, int *cmp) {
+    Cmp comparator;
+    int l = 0;
+    int r = count - 1;
+    int found = -1;
+
+    while (l <= r) {
+      int m = l + (r - l) / 2;
+      int c = comparator(key, key_length, keys[m], key_lengths[m]);
+      if (c == 0) {
+        *cmp = 0;
+        return m;
+      }
+      if (c < 0)
+        r = m - 1;
+      else {
+        found = m;
+        l = m + 1;
+      }
+    }
+    *cmp = found < 0 ? -1 : 1;
+    return found;
+  }
+};
+
+/**
+ * Registers a comparator class as a compare function (see
+ * @ref ups_register_compare) and a search function
+ * (@ref ups_register_search). The comparator is inlined into the search,
+ * therefore the Btree makes only one indirect call per node.
+ *
+ * @a Cmp is default-constructible and has a member function
+ * <pre>
+ *   int operator()(const uint8_t *lhs, uint32_t lhs_length,
+ *                  const uint8_t *rhs, uint32_t rhs_length) const;
+ * </pre>
+ * which returns a negative value, 0 or a positive value (like memcmp).
+ *
+ * Usage:
+ * <pre>
+ *   upscaledb::register_compare<my_compare>("my_compare");
+ * </pre>
+ */
+template<typename Cmp>
+inline void register_compare(const char *name) {
+  ups_status_t st = ups_register_compare(name,
+                  &compare_functions<Cmp>::compare);
+  if (!st)
+    st = ups_register_search(name, &compare_functions<Cmp>::search);
+  if (st)
+    throw error(st);
+}
+
 } // namespace upscaledb
 
 /**
@@ -195,8 +195,69 @@ typedef struct btree_metrics_t {
 
   /* block sizes (if available) */
   min_max_avg_u32_t keylist_block_sizes;
+
+  /* bytes saved by prefix compression of the keys, or by the truncated
+   * separators of the internal nodes (see UPS_COMPRESSOR_PREFIX) */
+  min_max_avg_u32_t keylist_prefix_savings;
 } btree_metrics_t;
 
+/* metrics of a single cache shard */
+typedef struct cache_shard_metrics_t {
+  /* number of successful cache hits */
+  uint64_t cache_hits;
+
+  /* number of cache misses */
+  uint64_t cache_misses;
+
+  /* number of pages which were evicted from this shard */
+  uint64_t cache_evictions;
+} cache_shard_metrics_t;
+
+/* number of buckets of the group commit histogram; bucket i counts the
+ * journal flushes with 2^i to 2^(i+1)-1 Transactions, the last bucket also
+ * counts all larger groups */
+#define UPS_GROUP_COMMIT_HISTOGRAM_BUCKETS  8
+
+/* number of buckets of a latency histogram. Latencies below 8 nanoseconds
+ * have their own bucket; above, each power of two is split into 8
+ * buckets of equal width (i.e. the relative error is at most 12.5%). The
+ * last bucket also counts all latencies above 2^38 nanoseconds. */
+#define UPS_LATENCY_HISTOGRAM_BUCKETS     288
+
+/* a latency histogram; all values are in nanoseconds. The histograms are
+ * recorded per thread and merged by ups_env_get_metrics() */
+typedef struct ups_latency_histogram_t {
+  /* number of recorded operations */
+  uint64_t count;
+
+  /* sum of all latencies */
+  uint64_t total;
+
+  /* largest latency */
+  uint64_t max;
+
+  /* number of operations per bucket */
+  uint64_t buckets[UPS_LATENCY_HISTOGRAM_BUCKETS];
+} ups_latency_histogram_t;
+
+/* metrics of an internal lock. An acquisition is "contended" if the lock
+ * was not available immediately; only contended acquisitions measure the
+ * wait time, and the hold time is sampled for one of 64 acquisitions, so
+ * the overhead for uncontended locks is a counter increment */
+typedef struct ups_lock_metrics_t {
+  /* number of acquisitions */
+  uint64_t acquires;
+
+  /* number of acquisitions which had to wait */
+  uint64_t contended;
+
+  /* wait time of the contended acquisitions */
+  ups_latency_histogram_t wait;
+
+  /* hold time (sampled) */
+  ups_latency_histogram_t hold;
+} ups_lock_metrics_t;
+
 /**
  * Retrieves collected metrics from the upscaledb Environment. Used mainly
  * for testing.
@@ -209,7 +270,7 @@ typedef struct btree_metrics_t {
  * Metrics marked "global" are stored globally and shared between multiple
  * Environments.
  */
-#define UPS_METRICS_VERSION         9
+#define UPS_METRICS_VERSION         42
 
 typedef struct ups_env_metrics_t {
   /* the version indicator - must be UPS_METRICS_VERSION */
@@ -232,12 +293,83 @@ typedef struct ups_env_metrics_t {
   /* the heap size of this process */
   uint64_t mem_heap_size;
 
+  /* number of allocations which were served by the per-thread pools and
+   * per-Transaction arenas instead of the allocator */
+  uint64_t mem_arena_allocations;
+
+  /* current size of the memory blocks held by pools and arenas */
+  uint64_t mem_arena_usage;
+
   /* amount of pages fetched from disk */
   uint64_t page_count_fetched;
 
   /* amount of pages written to disk */
   uint64_t page_count_flushed;
 
+  /* amount of pages written to disk by the background flusher */
+  uint64_t page_count_flushed_background;
+
+  /* amount of dirty pages which were written when they were evicted */
+  uint64_t page_count_flushed_on_eviction;
+
+  /* number of checkpoints written by the background flusher */
+  uint64_t flusher_checkpoints;
+
+  /* number of pages encrypted with UPS_PARAM_ENCRYPTION_KEY */
+  uint64_t encryption_pages_encrypted;
+
+  /* number of pages decrypted with UPS_PARAM_ENCRYPTION_KEY */
+  uint64_t encryption_pages_decrypted;
+
+  /* number of pages which were encrypted or decrypted by the background
+   * flusher or the prefetch threads, and not by the calling thread */
+  uint64_t encryption_pages_background;
+
+  /* time spent encrypting pages, in microseconds */
+  uint64_t encryption_usec;
+
+  /* time spent decrypting pages, in microseconds */
+  uint64_t decryption_usec;
+
+  /* number of searches with UPS_FIND_FROM_CURRENT which were answered
+   * by the leaf of the Cursor, or by one of its right siblings */
+  uint64_t cursor_find_current_leaf;
+  uint64_t cursor_find_current_siblings;
+
+  /* number of searches with UPS_FIND_FROM_CURRENT which fell back to a
+   * descent from the root node */
+  uint64_t cursor_find_current_fallbacks;
+
+  /* number of index keys which were inserted into (or erased from)
+   * secondary indexes (see ups_env_create_index) */
+  uint64_t index_keys_inserted;
+  uint64_t index_keys_erased;
+
+  /* number of lookups with ups_db_find_by_index */
+  uint64_t index_lookups;
+
+  /* number of batches applied with ups_db_write_batch */
+  uint64_t batches_written;
+
+  /* number of operations of all batches */
+  uint64_t batch_operations;
+
+  /* number of batches which were rejected without modifications */
+  uint64_t batches_rejected;
+
+  /* number of backups created with ups_env_backup */
+  uint64_t backup_count;
+
+  /* number of pages copied to backup files */
+  uint64_t backup_pages_copied;
+
+  /* number of checkpointed pages which were preserved (copy-on-write)
+   * because they were modified while a backup was running */
+  uint64_t backup_pages_preserved;
+
+  /* number of journal bytes appended to backup files */
+  uint64_t backup_journal_bytes;
+
   /* number of index pages in this Environment */
   uint64_t page_count_type_index;
 
@@ -253,30 +385,183 @@ typedef struct ups_env_metrics_t {
   /* number of freelist misses */
   uint64_t freelist_misses;
 
+  /* number of free extents (runs of free pages) in the free-space map */
+  uint64_t freelist_extents;
+
+  /* number of page-manager pages which were loaded; the free-space map
+   * is loaded lazily, therefore this can be smaller than
+   * |page_count_type_page_manager| */
+  uint64_t page_manager_pages_loaded;
+
+  /* time (in microseconds) spent in ups_env_open for loading the
+   * page-manager state */
+  uint64_t page_manager_load_usec;
+
+  /* time (in microseconds) spent in ups_env_open for recovering the
+   * Environment; the sum of the following three phases */
+  uint64_t recovery_usec;
+
+  /* time (in microseconds) spent for parsing the journal files */
+  uint64_t recovery_parse_usec;
+
+  /* time (in microseconds) spent for restoring the pages from the
+   * changesets */
+  uint64_t recovery_changeset_usec;
+
+  /* time (in microseconds) spent for re-applying the committed
+   * Transactions */
+  uint64_t recovery_txn_usec;
+
+  /* number of pages which were restored from changesets */
+  uint64_t recovery_pages;
+
+  /* number of Transactions which were re-applied */
+  uint64_t recovery_txns_applied;
+
+  /* number of active Transactions which were aborted or restored (see
+   * UPS_PARAM_RECOVERY_TXN_POLICY) */
+  uint64_t recovery_txns_aborted;
+  uint64_t recovery_txns_restored;
+
   /* number of successful cache hits */
   uint64_t cache_hits;
 
   /* number of cache misses */
   uint64_t cache_misses;
 
+  /* number of cache misses which were served by the compressed cache
+   * tier (see UPS_PARAM_CACHE_COMPRESSED_SIZE) */
+  uint64_t cache_compressed_hits;
+
+  /* number of cache misses which were also missed by the compressed
+   * tier, and therefore read from disk */
+  uint64_t cache_compressed_misses;
+
+  /* number of evicted pages which were stored in the compressed tier */
+  uint64_t cache_compressed_stores;
+
+  /* number of evicted pages which were not stored because they did not
+   * compress well enough */
+  uint64_t cache_compressed_rejects;
+
+  /* number of pages which were evicted from the compressed tier */
+  uint64_t cache_compressed_evictions;
+
+  /* current number of pages and bytes in the compressed tier */
+  uint64_t cache_compressed_pages;
+  uint64_t cache_compressed_bytes;
+
+  /* time spent decompressing pages of the compressed tier, in
+   * microseconds */
+  uint64_t cache_compressed_usec;
+
+  /* number of bytes of the shared cache pool (see UPS_PARAM_CACHE_POOL)
+   * which are used by the pages of this Environment; 0 if the Environment
+   * is not attached to a pool */
+  uint64_t cache_pool_usage;
+
+  /* number of pages of this Environment which were evicted from the pool
+   * to make room for pages of other Environments */
+  uint64_t cache_pool_evictions_foreign;
+
+  /* number of pages which were read for warming up the cache (see
+   * UPS_PARAM_CACHE_WARMUP) */
+  uint64_t cache_warmup_pages;
+
+  /* time (in microseconds) till the cache warm-up was completed; 0 while
+   * it is still running */
+  uint64_t cache_warmup_usec;
+
+  /* number of pages which were saved to the warm-up file */
+  uint64_t cache_warmup_saved;
+
+  /* number of lookups which were answered by a Bloom filter (see
+   * UPS_PARAM_BLOOM_FILTER_BITS) without descending the Btree */
+  uint64_t bloom_filter_negatives;
+
+  /* number of lookups which passed a Bloom filter, although the key did
+   * not exist */
+  uint64_t bloom_filter_false_positives;
+
+  /* number of Bloom filters which were rebuilt */
+  uint64_t bloom_filter_rebuilds;
+
+  /* number of cache shards (see UPS_PARAM_CACHE_SHARDS) */
+  uint32_t cache_shard_count;
+
+  /* per-shard cache metrics; only the first |cache_shard_count| entries
+   * are valid. |cache_hits| and |cache_misses| are the sums over all
+   * shards */
+  cache_shard_metrics_t cache_shards[UPS_MAX_CACHE_SHARDS];
+
   /* number of blobs allocated */
   uint64_t blob_total_allocated;
 
   /* number of blobs read */
   uint64_t blob_total_read;
 
+  /* number of small blobs which were allocated in a slab; these are also
+   * counted in |blob_total_allocated| */
+  uint64_t blob_slab_allocated;
+
+  /* number of blob pages which are used as slabs */
+  uint64_t blob_slab_pages;
+
+  /* number of bytes which are currently used by blob headers */
+  uint64_t blob_header_bytes;
+
+  /* number of blob reads which were resolved directly in the file
+   * mapping, without fetching a page or copying the data; these are also
+   * counted in |blob_total_read| */
+  uint64_t blob_mapped_reads;
+
   /* (global) number of btree page splits */
   uint64_t btree_smo_split;
 
   /* (global) number of btree page merges */
   uint64_t btree_smo_merge;
 
+  /* (global) number of bucket splits of hash indices (see
+   * UPS_HASH_INDEX) */
+  uint64_t hash_bucket_splits;
+
+  /* (global) number of overflow pages of hash buckets; buckets overflow
+   * if all their keys have the same hash prefix */
+  uint64_t hash_overflow_pages;
+
+  /* number of runs of the compaction (see ups_env_compact) */
+  uint64_t compaction_runs;
+
+  /* number of leaf nodes which were merged by the compaction; also
+   * counted in |btree_smo_merge| */
+  uint64_t compaction_leaves_merged;
+
+  /* number of blobs which were moved into dense pages */
+  uint64_t compaction_blobs_moved;
+
+  /* number of pages which were truncated from the end of the file */
+  uint64_t compaction_pages_truncated;
+
+  /* number of leaf nodes which were released in bulk by
+   * ups_db_erase_range */
+  uint64_t erase_range_leaves_freed;
+
+  /* number of pages of erased Databases which are not yet released (see
+   * UPS_ERASE_DB_ASYNC) */
+  uint64_t erase_db_pending_pages;
+
   /* (global) number of extended keys */
   uint64_t extended_keys;
 
   /* (global) number of extended duplicate tables */
   uint64_t extended_duptables;
 
+  /* (global) number of chunks of extended duplicate tables */
+  uint64_t extended_duptable_chunks;
+
+  /* (global) number of chunk splits of extended duplicate tables */
+  uint64_t extended_duptable_splits;
+
   /* number of bytes that the log/journal flushes to disk */
   uint64_t journal_bytes_flushed;
 
@@ -286,6 +571,44 @@ typedef struct ups_env_metrics_t {
   /* log/journal bytes after compression */
   uint64_t journal_bytes_after_compression;
 
+  /* number of journal flushes (fsyncs) which were shared by a group of
+   * committed Transactions (see UPS_PARAM_JOURNAL_GROUP_COMMIT_USEC) */
+  uint64_t journal_group_commits;
+
+  /* histogram of the number of Transactions per group commit */
+  uint64_t journal_group_commit_sizes[UPS_GROUP_COMMIT_HISTOGRAM_BUCKETS];
+
+  /* number of journal files which were recycled instead of truncated
+   * (see UPS_PARAM_JOURNAL_PREALLOCATE_SIZE) */
+  uint64_t journal_files_recycled;
+
+  /* number of journal flushes with fdatasync() instead of fsync() */
+  uint64_t journal_fdatasyncs;
+
+  /* number of aligned journal writes with O_DIRECT
+   * (see UPS_PARAM_JOURNAL_DIRECT_IO) */
+  uint64_t journal_direct_writes;
+
+  /* number of padding bytes which were appended to align direct writes */
+  uint64_t journal_direct_padding_bytes;
+
+  /* number of committed Txn operations which were not yet merged into
+   * the Btree (see UPS_ENABLE_BACKGROUND_MERGE) */
+  uint64_t txn_merge_backlog;
+
+  /* number of Txn operations which were merged into the Btree by the
+   * background thread */
+  uint64_t txn_operations_merged;
+
+  /* number of active snapshot Transactions (see UPS_TXN_SNAPSHOT) */
+  uint32_t txn_active_snapshots;
+
+  /* age of the oldest active snapshot, in microseconds */
+  uint64_t txn_oldest_snapshot_age_usec;
+
+  /* number of old key versions which are retained for active snapshots */
+  uint64_t txn_snapshot_versions_retained;
+
   /* record bytes before compression */
   uint64_t record_bytes_before_compression;
 
@@ -298,6 +621,98 @@ typedef struct ups_env_metrics_t {
   /* key bytes after compression */
   uint64_t key_bytes_after_compression;
 
+  /* number of leaf nodes which were skipped by UQI queries because
+   * their summary did not match the range or the predicate (see
+   * UPS_PARAM_LEAF_SUMMARIES) */
+  uint64_t uqi_leaves_skipped;
+
+  /* number of leaf nodes which were aggregated from their summary,
+   * without decoding the node */
+  uint64_t uqi_leaves_from_summary;
+
+  /* number of blocks of UPS_TIME_SERIES Databases which were encoded
+   * when their tail block was full */
+  uint64_t timeseries_blocks_sealed;
+
+  /* number of encoded blocks which were decoded and encoded again,
+   * because a key was inserted or erased out of order */
+  uint64_t timeseries_blocks_rewritten;
+
+  /* number of blocks which were aggregated from their summary by UQI
+   * queries, without decoding the block */
+  uint64_t timeseries_blocks_from_summary;
+
+  /* number of blocks which were decoded by UQI queries */
+  uint64_t timeseries_blocks_decoded;
+
+  /* primary: number of connected replication followers */
+  uint32_t replication_followers;
+
+  /* follower: the last journal lsn which was applied */
+  uint64_t replication_applied_lsn;
+
+  /* follower: number of committed journal entries of the primary which
+   * were not yet applied */
+  uint64_t replication_lag_lsn;
+
+  /* follower: age (in microseconds) of the oldest commit of the primary
+   * which was not yet applied; 0 if the follower is up to date */
+  uint64_t replication_lag_usec;
+
+  /* remote: key and record bytes before network compression (see
+   * UPS_PARAM_NETWORK_COMPRESSION) */
+  uint64_t network_bytes_before_compression;
+
+  /* remote: key and record bytes after network compression */
+  uint64_t network_bytes_after_compression;
+
+  /* latency of ups_db_find and ups_cursor_find */
+  ups_latency_histogram_t latency_find;
+
+  /* latency of ups_db_insert and ups_cursor_insert */
+  ups_latency_histogram_t latency_insert;
+
+  /* latency of ups_db_erase and ups_cursor_erase */
+  ups_latency_histogram_t latency_erase;
+
+  /* latency of ups_cursor_move */
+  ups_latency_histogram_t latency_cursor_move;
+
+  /* latency of ups_txn_commit */
+  ups_latency_histogram_t latency_txn_commit;
+
+  /* latency of a journal flush (write and fsync) */
+  ups_latency_histogram_t latency_journal_flush;
+
+  /* latency of reading a page from the device (cache misses only) */
+  ups_latency_histogram_t latency_page_fetch;
+
+  /* latency of writing a page to the device */
+  ups_latency_histogram_t latency_page_flush;
+
+  /* the Environment lock (see UPS_PARAM_ENV_LOCK) */
+  ups_lock_metrics_t lock_env;
+
+  /* the latches of the btree pages (see UPS_ENABLE_CONCURRENT_READS) */
+  ups_lock_metrics_t lock_page;
+
+  /* the lock of the Txn manager */
+  ups_lock_metrics_t lock_txn;
+
+  /* the lock of the journal */
+  ups_lock_metrics_t lock_journal;
+
+  /* number of records which ups_db_append_many appended to a pinned
+   * leaf page, without a btree descent */
+  uint64_t recno_appends_pinned;
+
+  /* number of btree descents of ups_db_append_many, i.e. after the pinned
+   * leaf page was split */
+  uint64_t recno_append_descents;
+
+  /* number of ranges reserved with ups_db_reserve_record_numbers */
+  uint64_t recno_ranges_reserved;
+
   /* btree metrics for leaf nodes */
   btree_metrics_t btree_leaf_metrics;
 
@@ -307,6 +722,14 @@ typedef struct ups_env_metrics_t {
   // set to true if AVX is enabled
   ups_bool_t is_avx_enabled;
 
+  // set to true if libcrypto uses the AES instructions of the CPU (AES-NI
+  // or the ARMv8 crypto extensions)
+  ups_bool_t is_aes_hw_enabled;
+
+  // set to true if the UQI kernels were generated with ispc (see
+  // "configure --enable-ispc")
+  ups_bool_t is_ispc_enabled;
+
 } ups_env_metrics_t;
 
 /**
@@ -315,6 +738,119 @@ typedef struct ups_env_metrics_t {
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_env_get_metrics(ups_env_t *env, ups_env_metrics_t *metrics);
 
+/* the maximum number of btree levels of ups_db_metrics_t; deeper levels
+ * are counted in the last level */
+#define UPS_DB_METRICS_LEVELS       8
+
+/* cache and I/O counters of a group of pages */
+typedef struct ups_page_metrics_t {
+  /* number of page fetches which were served by the cache */
+  uint64_t cache_hits;
+
+  /* number of page fetches which were not in the cache */
+  uint64_t cache_misses;
+
+  /* number of pages which were read from the device */
+  uint64_t pages_fetched;
+
+  /* number of pages which were written to the device */
+  uint64_t pages_flushed;
+
+  /* number of pages which were evicted from the cache */
+  uint64_t pages_evicted;
+
+  /* number of pages of this group which are currently cached */
+  uint64_t pages_cached;
+} ups_page_metrics_t;
+
+/**
+ * Metrics of a single Database
+ *
+ * These metrics are NOT persisted to disk. They are collected since the
+ * Database was opened, and are reset if it is closed.
+ */
+#define UPS_DB_METRICS_VERSION      1
+
+typedef struct ups_db_metrics_t {
+  /* the version indicator - must be UPS_DB_METRICS_VERSION */
+  uint16_t version;
+
+  /* the name of the Database */
+  uint16_t name;
+
+  /* the current height of the btree (1 if the root is a leaf) */
+  uint32_t btree_levels;
+
+  /* counters of the btree pages per level; level 0 are the leaf nodes,
+   * level (btree_levels - 1) is the root */
+  ups_page_metrics_t btree_level[UPS_DB_METRICS_LEVELS];
+
+  /* counters of the blob pages which store the records of this Database
+   * (blob pages are not shared between Databases) */
+  ups_page_metrics_t blobs;
+} ups_db_metrics_t;
+
+/**
+ * Retrieves the current metrics of a Database
+ *
+ * Set @a metrics->version to @ref UPS_DB_METRICS_VERSION before calling
+ * this function.
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db or @a metrics is NULL, or if
+ *        @a metrics->version is not @ref UPS_DB_METRICS_VERSION
+ * @return @ref UPS_NOT_IMPLEMENTED for remote Databases
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_get_metrics(ups_db_t *db, ups_db_metrics_t *metrics);
+
+/**
+ * Suggests a node size for a Database (see @ref UPS_PARAM_DB_PAGE_SIZE)
+ *
+ * Collects the @ref btree_metrics_t of the leaf nodes of this Database
+ * and derives a node size from the average number of keys per page
+ * (@a keys_per_page) and the unused space of the KeyLists
+ * (@a keylist_unused). Nodes which are mostly empty suggest a smaller
+ * size, nodes which only store a handful of keys suggest a larger size.
+ * The result is always a multiple of the Environment's page size.
+ *
+ * The node size can not be changed for an existing Database. Copy the
+ * Database into a new one (i.e. with @ref ups_db_export and
+ * @ref ups_db_import) to apply the suggestion. This function reads all
+ * leaf nodes and is therefore expensive.
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a db or @a page_size is NULL
+ * @return @ref UPS_NOT_IMPLEMENTED for remote Databases
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_advise_page_size(ups_db_t *db, uint32_t *page_size);
+
+/**
+ * Returns the latency (in nanoseconds) below which @a percentile percent
+ * of the operations of a histogram were completed, i.e. 99.9 for the p999
+ * latency. Returns the upper bound of the bucket, or 0 if the histogram
+ * is empty.
+ */
+UPS_EXPORT uint64_t UPS_CALLCONV
+ups_latency_histogram_percentile(const ups_latency_histogram_t *histogram,
+                double percentile);
+
+/**
+ * Records a latency of @a ns nanoseconds in a histogram. The histogram
+ * has to be initialized with zeroes. Not thread-safe; use one histogram
+ * per thread and merge them with @ref ups_latency_histogram_merge.
+ */
+UPS_EXPORT void UPS_CALLCONV
+ups_latency_histogram_add(ups_latency_histogram_t *histogram, uint64_t ns);
+
+/**
+ * Adds the operations of @a other to @a histogram
+ */
+UPS_EXPORT void UPS_CALLCONV
+ups_latency_histogram_merge(ups_latency_histogram_t *histogram,
+                const ups_latency_histogram_t *other);
+
 /**
  * Returns @ref UPS_TRUE if this upscaledb library was compiled with debug
  * diagnostics, checks and asserts
@@ -400,12 +936,93 @@ struct ups_operation_t {
  *
  * The @ref txn parameter is passed to @ref ups_db_insert, @ref ups_db_erase
  * and @ref ups_db_find.
+ *
+ * If @a flags is @ref UPS_BULK_SORTED then all operations must be of type
+ * UPS_OP_INSERT, and their keys must be sorted in ascending order and be
+ * greater than all keys already stored in the database. The btree is then
+ * built bottom-up: the leaf pages are filled directly (up to the
+ * fill factor of @ref UPS_BULK_FILL_FACTOR percent), and the internal
+ * levels are created afterwards. This is much faster than inserting
+ * the keys one by one. The result of every operation is stored in
+ * @a result. This flag is not allowed if Transactions are enabled, or
+ * if the database uses a custom compare function or duplicate keys.
+ *
+ * For remote Environments, all operations are sent to the server in a
+ * single request, and the results are returned in a single reply.
+ *
+ * @return @ref UPS_INV_PARAMETER if @ref UPS_BULK_SORTED was specified
+ *        but the operations are not sorted inserts
  */
 UPS_EXPORT ups_status_t UPS_CALLCONV
 ups_db_bulk_operations(ups_db_t *db, ups_txn_t *txn,
                     struct ups_operation_t *operations,
                     size_t operations_length, uint32_t flags);
 
+/** Flag for @ref ups_db_bulk_operations */
+#define UPS_BULK_SORTED     1
+
+/** The fill factor (in percent) of pages which are created with
+ * @ref UPS_BULK_SORTED */
+#define UPS_BULK_FILL_FACTOR  90
+
+/**
+ * A callback function which is invoked when an operation submitted with
+ * @ref ups_db_submit has completed. @a operation->result stores the
+ * result; for UPS_OP_FIND, @a operation->record stores the record.
+ */
+typedef void UPS_CALLCONV (*ups_completion_callback_t)(
+                    struct ups_operation_t *operation, void *context);
+
+/**
+ * Submits an operation without waiting for its completion
+ *
+ * For remote Environments, the request is tagged with an id and sent to
+ * the server immediately; the reply is processed later, and several
+ * requests can be in flight on the same connection (up to
+ * @ref UPS_PARAM_NETWORK_PIPELINE_DEPTH; if this limit is reached then
+ * this function waits for the oldest reply). The server executes the
+ * requests of a connection in order.
+ *
+ * @a callback is invoked in the thread which calls @ref ups_db_submit or
+ * @ref ups_env_wait, after the reply was received. The @a operation
+ * structure, and the key and record buffers it points to, must remain
+ * valid until then. Records of UPS_OP_FIND are copied to the buffer of
+ * @a operation->record if it is flagged with @ref UPS_RECORD_USER_ALLOC,
+ * otherwise they are valid until the callback returns.
+ *
+ * For local Environments, the operation is executed immediately and the
+ * callback is invoked before this function returns.
+ *
+ * @param db A valid Database handle
+ * @param txn A Txn handle, or NULL
+ * @param operation The operation
+ * @param callback The completion callback; can be NULL
+ * @param context A user-supplied pointer which is passed to the callback
+ *
+ * @return @ref UPS_SUCCESS if the operation was submitted; the result of
+ *        the operation itself is stored in @a operation->result
+ * @return @ref UPS_INV_PARAMETER if @a db or @a operation is NULL
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_db_submit(ups_db_t *db, ups_txn_t *txn, struct ups_operation_t *operation,
+                    ups_completion_callback_t callback, void *context);
+
+/**
+ * Waits till all submitted operations of an Environment are completed
+ *
+ * Processes the outstanding replies and invokes the completion callbacks
+ * of the operations which were submitted with @ref ups_db_submit.
+ *
+ * @param env A valid Environment handle
+ *
+ * @return @ref UPS_SUCCESS upon success
+ * @return @ref UPS_INV_PARAMETER if @a env is NULL
+ * @return @ref UPS_NETWORK_ERROR if the connection to the server failed;
+ *        the outstanding operations are completed with this error
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+ups_env_wait(ups_env_t *env);
+
 /**
  * @}
  */
@@ -37,6 +37,27 @@ extern "C" {
  * @{
  */
 
+/**
+ * The scheduling weight of an Environment
+ *
+ * The server schedules the requests with hierarchical weighted fair
+ * queuing: each Environment is a class, and each connection to this
+ * Environment is a sub-class. A busy Environment receives a share of the
+ * worker threads which is proportional to its weight; the connections of
+ * an Environment share its slice equally. A single connection running a
+ * large @ref uqi_select or bulk insert therefore cannot starve the other
+ * connections or Environments.
+ */
+typedef struct {
+  /** The URL of the Environment, as specified in @ref ups_srv_add_env
+   * or @ref ups_srv_add_replica */
+  const char *urlname;
+
+  /** The weight; 0 is treated as 1 */
+  uint32_t weight;
+
+} ups_srv_weight_t;
+
 /**
  * A configuration structure
  *
@@ -59,6 +80,37 @@ typedef struct {
    * - currently NOT USED! */
   const char *error_log_path;
 
+  /** The number of threads which run the event loop (epoll on Linux)
+   * and read and write the network messages; set to 0 for the default
+   * of 1 thread */
+  uint32_t num_io_threads;
+
+  /** The number of threads which execute the requests; set to 0 for the
+   * default (the number of CPU cores). Requests of a single connection
+   * are always executed in order. Requests for different Databases run
+   * in parallel if the Environment allows it (see @ref UPS_PARAM_ENV_LOCK
+   * and @ref UPS_ENABLE_CONCURRENT_READS) */
+  uint32_t num_worker_threads;
+
+  /** The directory from which UQI plugins (i.e. "foo@library.so") are
+   * loaded when remote clients run a query; set to NULL to only allow
+   * plugins which were registered with @ref uqi_register_plugin in this
+   * process */
+  const char *plugin_directory;
+
+  /** An array of weights for the fair scheduling of the Environments
+   * (see @ref ups_srv_weight_t); Environments which are not listed have
+   * a weight of 1. Set to NULL to give all Environments the same weight */
+  const ups_srv_weight_t *env_weights;
+
+  /** The number of elements in @a env_weights */
+  uint32_t num_env_weights;
+
+  /** The maximum number of queued requests per connection; if reached,
+   * the server stops reading from this connection until a request was
+   * executed. Set to 0 for the default of 64 */
+  uint32_t max_connection_queue_depth;
+
 } ups_srv_config_t;
 
 /**
@@ -120,6 +172,124 @@ ups_srv_add_env(ups_srv_t *srv, ups_env_t *env, const char *urlname);
 extern ups_status_t
 ups_srv_remove_env(ups_srv_t *srv, ups_env_t *env);
 
+/**
+ * Allows followers to replicate an Environment
+ *
+ * The Environment has to be added with @ref ups_srv_add_env, and it
+ * has to be created with @ref UPS_ENABLE_TRANSACTIONS (and without
+ * @ref UPS_DISABLE_RECOVERY), because replication ships the entries of
+ * the journal. Whenever a Txn is committed, its journal entries are
+ * streamed asynchronously to all followers; commits do not wait for the
+ * followers.
+ *
+ * The journal files are not switched while a connected follower has not
+ * yet received the entries of the older file.
+ *
+ * @param srv A valid ups_srv_t handle
+ * @param env A valid upscaledb Environment handle
+ *
+ * @return UPS_SUCCESS on success
+ * @return UPS_INV_PARAMETER if @a env was not added to this server
+ * @return UPS_INV_PARAMETER if @a env does not have a journal
+ */
+extern ups_status_t
+ups_srv_enable_replication(ups_srv_t *srv, ups_env_t *env);
+
+/**
+ * Adds an Environment as a read replica
+ *
+ * Like @ref ups_srv_add_env, but the Environment is served read-only,
+ * and it follows the primary at @a primary_url (i.e.
+ * "ups://primary:8080/env1.db"), which has to call
+ * @ref ups_srv_enable_replication. The journal entries of the primary
+ * are applied with the same code path as the recovery of the journal.
+ * A Txn of the primary becomes visible on the replica atomically, when
+ * its commit is applied.
+ *
+ * @a env has to be a copy of the primary Environment (i.e. a copy of
+ * its file, made while the primary was closed), and has to be opened with
+ * @ref UPS_ENABLE_TRANSACTIONS. The follower reconnects automatically if
+ * the connection is lost, and resumes with the first lsn which was not
+ * yet applied. If the primary no longer has the journal entries then
+ * the replication stops with @ref UPS_NEED_RECOVERY.
+ *
+ * Clients of the replica can open the Environment with
+ * @ref ups_env_open and read from it; all modifications fail with
+ * @ref UPS_WRITE_PROTECTED. The replication lag is reported in
+ * @ref ups_env_metrics_t.
+ *
+ * @param srv A valid ups_srv_t handle
+ * @param env A valid upscaledb Environment handle
+ * @param urlname URL of this Environment
+ * @param primary_url URL of the Environment on the primary server
+ *
+ * @return UPS_SUCCESS on success
+ * @return UPS_INV_PARAMETER if @a env does not have a journal
+ * @return UPS_LIMITS_REACHED if more than the max. number of Environments
+ *    were added
+ */
+extern ups_status_t
+ups_srv_add_replica(ups_srv_t *srv, ups_env_t *env, const char *urlname,
+                const char *primary_url);
+
+/**
+ * Scheduling metrics of an Environment
+ *
+ * All latencies are measured from the moment a request is queued until its
+ * execution has finished. See @ref ups_srv_get_class_metrics.
+ */
+typedef struct {
+  /** The weight of this Environment */
+  uint32_t weight;
+
+  /** The number of open connections */
+  uint32_t connections;
+
+  /** The number of currently queued requests of all connections */
+  uint64_t queue_depth;
+
+  /** The highest queue depth ever seen for this Environment */
+  uint64_t max_queue_depth;
+
+  /** The highest number of currently queued requests of a single
+   * connection */
+  uint64_t max_connection_queue_depth;
+
+  /** The number of executed requests */
+  uint64_t requests;
+
+  /** The accumulated time which requests spent waiting in the queue,
+   * in microseconds */
+  uint64_t queue_usec;
+
+  /** The average latency of a request, in microseconds */
+  uint64_t avg_latency_usec;
+
+  /** The highest latency of a request, in microseconds */
+  uint64_t max_latency_usec;
+
+  /** The number of times the server stopped reading from a connection
+   * because its queue was full */
+  uint64_t throttled;
+
+} ups_srv_class_metrics_t;
+
+/**
+ * Retrieves the scheduling metrics of an Environment
+ *
+ * @param srv A valid ups_srv_t handle
+ * @param env A valid upscaledb Environment handle
+ * @param metrics A pointer to a ups_srv_class_metrics_t structure which
+ *    is filled by this function
+ *
+ * @return UPS_SUCCESS on success
+ * @return UPS_INV_PARAMETER if @a env was not added to this server, or
+ *    if @a metrics is NULL
+ */
+extern ups_status_t
+ups_srv_get_class_metrics(ups_srv_t *srv, ups_env_t *env,
+                ups_srv_class_metrics_t *metrics);
+
 /*
  * Release memory and clean up
  *
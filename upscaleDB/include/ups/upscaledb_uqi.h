@@ -40,6 +40,19 @@ extern "C" {
 struct uqi_result_t;
 typedef struct uqi_result_t uqi_result_t;
 
+/**
+ * A structure which delivers the results of a query in batches.
+ * Created with @ref uqi_select_stream.
+ */
+struct uqi_stream_t;
+typedef struct uqi_stream_t uqi_stream_t;
+
+/**
+ * A compiled query. Created with @ref uqi_prepare.
+ */
+struct uqi_plan_t;
+typedef struct uqi_plan_t uqi_plan_t;
+
 /**
  * Returns the number of rows stored in a query result
  */
@@ -175,9 +188,46 @@ typedef int (*uqi_plugin_predicate_function)(void *state,
                     const void *key_data, uint32_t key_size,
                     const void *record_data, uint32_t record_size);
 
+/**
+ * Predicate function for a list of values; sets bit |i| of |bitmap|
+ * (bit |i % 8| of byte |i / 8|) if the |i|th value matches the predicate,
+ * otherwise clears it. |bitmap| has (|list_length| + 7) / 8 bytes.
+ */
+typedef void (*uqi_plugin_predicate_many_function)(void *state,
+                    const void *key_data_list, const void *record_data_list,
+                    size_t list_length, uint8_t *bitmap);
+
 /** Assigns the results to an @a uqi_result_t structure */
 typedef void (*uqi_plugin_result_function)(void *state, uqi_result_t *result);
 
+/** Return value of @ref uqi_plugin_predicate_range_function */
+#define UQI_RANGE_NONE                          0
+
+/** Return value of @ref uqi_plugin_predicate_range_function */
+#define UQI_RANGE_ALL                           1
+
+/** Return value of @ref uqi_plugin_predicate_range_function */
+#define UQI_RANGE_SOME                          2
+
+/**
+ * Predicate function for a range of values; |min_data| and |max_data|
+ * are the smallest and largest value of a leaf node (see
+ * @ref UPS_PARAM_LEAF_SUMMARIES). Returns @ref UQI_RANGE_NONE if no
+ * value in this range can match the predicate (the node is skipped),
+ * @ref UQI_RANGE_ALL if all values match (the predicate is not called)
+ * or @ref UQI_RANGE_SOME otherwise.
+ */
+typedef int (*uqi_plugin_predicate_range_function)(void *state,
+                    const void *min_data, const void *max_data,
+                    uint32_t size);
+
+/**
+ * Merges the partial aggregation state |other| into |state|; used by
+ * parallel queries. The merge has to be associative. |other| is
+ * released (with the cleanup function) afterwards.
+ */
+typedef void (*uqi_plugin_merge_function)(void *state, void *other);
+
 /** Describes a plugin for predicates */
 #define UQI_PLUGIN_PREDICATE                    1
 
@@ -215,6 +265,13 @@ typedef void (*uqi_plugin_result_function)(void *state, uqi_result_t *result);
  * |plugin_descriptor| must be an exported symbol with the "C"
  * calling convention.
  *
+ * Queries of remote Environments are executed by the server, and the
+ * plugins are looked up in the server process: they have to be registered
+ * with @a uqi_register_plugin by the server application, or loaded from a
+ * library on the server. Libraries are only loaded from the directory
+ * which is specified in @a ups_srv_config_t::plugin_directory; the
+ * library name must not contain a path. Plugins which are registered by
+ * the client are not used for remote queries.
  */
 typedef struct {
   /** The name of this plugin */
@@ -234,7 +291,12 @@ typedef struct {
    */
   uint32_t flags;
 
-  /** The version of the plugin's interface; always set to 0 */
+  /**
+   * The version of the plugin's interface; set to 0, to 1 if the
+   * @a merge function is available, to 2 if the @a merge and
+   * @a pred_many functions are available, or to 3 if
+   * @a pred_range is available as well
+   */
   uint32_t plugin_version;
 
   /** The initialization function; can be null */
@@ -264,6 +326,31 @@ typedef struct {
   /** Assigns the result to a @a uqi_result_t structure; must not be null */
   uqi_plugin_result_function results;
 
+  /**
+   * Merges two partial aggregation states; only read if @a plugin_version
+   * is >= 1. Aggregation plugins without this function are always
+   * executed single-threaded, even if the query specifies PARALLEL. Set
+   * to null for predicates.
+   */
+  uqi_plugin_merge_function merge;
+
+  /**
+   * The predicate function for a list of values; only read if
+   * @a plugin_version is >= 2, and only called for fixed-length data
+   * (like @a agg_many). Can be null. If available, the query engine
+   * filters the decoded values of a whole leaf node with this function,
+   * and then passes the selected values to the @a agg_many function of
+   * the aggregation plugin.
+   */
+  uqi_plugin_predicate_many_function pred_many;
+
+  /**
+   * Checks the range of values of a leaf node; only read if
+   * @a plugin_version is >= 3, and only used if the Database was created
+   * with @ref UPS_PARAM_LEAF_SUMMARIES. Can be null.
+   */
+  uqi_plugin_predicate_range_function pred_range;
+
 } uqi_plugin_t;
 
 
@@ -290,6 +377,26 @@ uqi_register_plugin(uqi_plugin_t *descriptor);
  * database. The result is returned in @a result, which is allocated
  * by this function and has to be released with @a uqi_result_close.
  *
+ * The pages which are read by the query are fetched "read once" (see
+ * @ref UPS_CURSOR_READ_ONCE), and will not displace the hot pages from
+ * the cache.
+ *
+ * Queries are executed one leaf node at a time: the keys (or records) of
+ * a node are decoded into a column batch (compressed keys are decoded
+ * with the SIMD decoders of the key compression, i.e. BP128 or
+ * SIMDFOR), and the built-in functions SUM, AVERAGE, MIN, MAX and COUNT
+ * process the batch with SIMD instructions if the stream has a numeric
+ * type (UPS_TYPE_UINT8 ... UPS_TYPE_UINT64, UPS_TYPE_REAL32, UPS_TYPE_REAL64).
+ * The samples/uqi_bench.c benchmark measures the throughput of these
+ * functions.
+ *
+ * If the Environment is remote then the query string is sent to the
+ * server, which executes the query and returns the result; the data of
+ * the Database is not transferred. See @a uqi_plugin_t on how plugins are
+ * resolved by the server. This also applies to @a uqi_select_range (the
+ * cursors then have to be remote cursors of the same Environment),
+ * @a uqi_prepare and @a uqi_execute.
+ *
  * @return UPS_PLUGIN_NOT_FOUND The specified function is not available
  * @return UPS_PARSER_ERROR Failed to parse the @a query string
  *
@@ -312,6 +419,9 @@ uqi_select(ups_env_t *env, const char *query, uqi_result_t **result);
  * If @a begin is not null then it will be moved to the first key behind the
  * processed range.
  *
+ * As with @a uqi_select, the pages which are read by the query are fetched
+ * "read once".
+ *
  * If the specified Database is not yet opened, it will be reopened in
  * background and immediately closed again after the query. Closing the
  * Database can hurt performance. To avoid this, manually open the
@@ -323,6 +433,7 @@ uqi_select(ups_env_t *env, const char *query, uqi_result_t **result);
  *   [DISTINCT] <FUNCTION>(<STREAM>) FROM DATABASE <DB>
  *          [WHERE <PREDICATE>(<STREAM>)]
  *          [LIMIT <LIMIT>]
+ *          [PARALLEL <THREADS>]
  *
  *   DISTINCT: an optional key word which strips the query input from all
  *          duplicate keys. (This is different from SQL where duplicate results
@@ -344,6 +455,31 @@ uqi_select(ups_env_t *env, const char *query, uqi_result_t **result);
  *          functions "TOP" and "BOTTOM"! When used with other functions then
  *          an error is returned.
  *
+ *   THREADS: the number of threads. The database (or the range between
+ *          @a begin and @a end) is split into key ranges at the separator
+ *          keys of the Btree's internal nodes. Each range is aggregated
+ *          by a thread of a pool, and the partial states are combined with
+ *          the plugin's @a merge function. All built-in functions
+ *          support merging. Duplicate keys are never split between two
+ *          ranges. The default is 1. If the function does not support
+ *          merging then the query is executed single-threaded. @a begin
+ *          is moved behind the last processed key, as for
+ *          single-threaded queries.
+ *
+ * If the Database was created with @ref UPS_PARAM_LEAF_SUMMARIES then
+ * leaf nodes outside of the range between @a begin and @a end, and
+ * leaf nodes which are rejected by the predicate's @a pred_range
+ * function, are skipped. MIN, MAX and COUNT (without a predicate, or
+ * if @a pred_range accepts the whole node) are calculated from the
+ * summaries and do not decode the leaf nodes.
+ *
+ * Databases which were created with @ref UPS_TIME_SERIES store such a
+ * summary (including the SUM of the records) for each block of a leaf
+ * node. SUM, AVERAGE, MIN, MAX and COUNT (without a predicate) are
+ * calculated from the summaries of the blocks which are completely
+ * inside of the range; only the blocks at the boundaries of the range
+ * are decoded.
+ *
  * The @a result object is allocated automatically and has to be released
  * with @a uqi_result_close by the caller.
  *
@@ -356,6 +492,143 @@ UPS_EXPORT ups_status_t UPS_CALLCONV
 uqi_select_range(ups_env_t *env, const char *query, ups_cursor_t *begin,
                             const ups_cursor_t *end, uqi_result_t **result);
 
+/**
+ * Performs a "UQI Select" query and returns its results in batches.
+ *
+ * This function parses the query and prepares its execution, but does
+ * not yet return any rows; they are fetched with @a uqi_stream_next_batch.
+ * The query syntax and the parameters @a begin and @a end are identical
+ * to @a uqi_select_range.
+ *
+ * Queries which emit many rows (i.e. TOP or BOTTOM with a large LIMIT, or
+ * plugins which call @a uqi_result_add_row for many rows) never
+ * materialize the full result set; each batch has at most @a batch_size
+ * rows, and the first batch is available as soon as the first
+ * @a batch_size rows were produced. The plugin state of TOP and BOTTOM
+ * is still limited by LIMIT.
+ *
+ * If the Environment is remote then each batch is fetched from the
+ * server with a separate request; the server keeps the stream open
+ * until it is closed or the connection is lost.
+ *
+ * The stream has to be closed with @a uqi_stream_close. The cursors
+ * @a begin and @a end must remain valid until then.
+ *
+ * @param env A valid Environment handle
+ * @param query The query string
+ * @param begin Optional cursor for the begin of the range (or null)
+ * @param end Optional cursor for the end of the range (or null)
+ * @param batch_size The maximum number of rows per batch; 0 selects the
+ *        default of 1024 rows
+ * @param stream Receives the stream handle
+ *
+ * @return UPS_SUCCESS upon success
+ * @return UPS_INV_PARAMETER if @a env, @a query or @a stream is null
+ * @return UPS_PLUGIN_NOT_FOUND The specified function is not available
+ * @return UPS_PARSER_ERROR Failed to parse the @a query string
+ *
+ * @sa uqi_stream_next_batch
+ * @sa uqi_stream_close
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+uqi_select_stream(ups_env_t *env, const char *query, ups_cursor_t *begin,
+                            const ups_cursor_t *end, uint32_t batch_size,
+                            uqi_stream_t **stream);
+
+/**
+ * Returns the next batch of rows of a stream.
+ *
+ * The returned @a result has at least one and at most @a batch_size rows
+ * (see @a uqi_select_stream), and has to be released with
+ * @a uqi_result_close by the caller.
+ *
+ * @param stream A valid stream handle
+ * @param result Receives the next batch
+ *
+ * @return UPS_SUCCESS upon success
+ * @return UPS_INV_PARAMETER if @a stream or @a result is null
+ * @return UPS_KEY_NOT_FOUND if all rows were already returned; then
+ *        @a result is set to null
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+uqi_stream_next_batch(uqi_stream_t *stream, uqi_result_t **result);
+
+/**
+ * Closes a stream and releases its resources.
+ *
+ * The stream can be closed before all rows were fetched; the query
+ * is then cancelled.
+ *
+ * @param stream A valid stream handle
+ *
+ * @return UPS_SUCCESS upon success
+ * @return UPS_INV_PARAMETER if @a stream is null
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+uqi_stream_close(uqi_stream_t *stream);
+
+/**
+ * Compiles a query.
+ *
+ * Parses the @a query string and resolves the functions and the
+ * Database. Plugins from external libraries are loaded once and remain
+ * loaded while the plan exists. The plan can then be executed several
+ * times with @a uqi_execute, without parsing the query again.
+ *
+ * The Environment caches its plans; preparing the same query string
+ * again returns the cached plan. Plans are reference counted and have
+ * to be released with @a uqi_plan_release. All plans are released when
+ * the Environment is closed.
+ *
+ * @param env A valid Environment handle
+ * @param query The query string; see @a uqi_select_range for the syntax
+ * @param plan Receives the compiled query
+ *
+ * @return UPS_SUCCESS upon success
+ * @return UPS_INV_PARAMETER if @a env, @a query or @a plan is null
+ * @return UPS_PLUGIN_NOT_FOUND The specified function is not available
+ * @return UPS_PARSER_ERROR Failed to parse the @a query string
+ *
+ * @sa uqi_execute
+ * @sa uqi_plan_release
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+uqi_prepare(ups_env_t *env, const char *query, uqi_plan_t **plan);
+
+/**
+ * Executes a compiled query.
+ *
+ * Works like @a uqi_select_range; @a begin and @a end are optional.
+ *
+ * @param plan A valid plan handle
+ * @param begin Optional cursor for the begin of the range (or null)
+ * @param end Optional cursor for the end of the range (or null)
+ * @param result Receives the result, which has to be released with
+ *        @a uqi_result_close
+ *
+ * @return UPS_SUCCESS upon success
+ * @return UPS_INV_PARAMETER if @a plan or @a result is null
+ *
+ * @sa uqi_prepare
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+uqi_execute(uqi_plan_t *plan, ups_cursor_t *begin, const ups_cursor_t *end,
+                            uqi_result_t **result);
+
+/**
+ * Releases a compiled query.
+ *
+ * Decrements the reference counter of the plan; the plan remains in the
+ * Environment's cache until it is closed.
+ *
+ * @param plan A valid plan handle
+ *
+ * @return UPS_SUCCESS upon success
+ * @return UPS_INV_PARAMETER if @a plan is null
+ */
+UPS_EXPORT ups_status_t UPS_CALLCONV
+uqi_plan_release(uqi_plan_t *plan);
+
 /**
  * @}
  */
@@ -138,6 +138,9 @@ public class Const {
   /** Flag for Transaction.begin() */
   public final static int UPS_TXN_READ_ONLY           =    1;
 
+  /** Flag for Transaction.begin() */
+  public final static int UPS_TXN_SNAPSHOT            =    4;
+
   /** Flag for Transaction.commit() */
   public final static int UPS_TXN_FORCE_WRITE         =    1;
 
@@ -163,6 +166,12 @@ public class Const {
   /** Flag for Database.create() */
   public final static int UPS_ENABLE_DUPLICATE_KEYS =  0x4000;
 
+  /** Flag for Database.create() */
+  public final static int UPS_HASH_INDEX            =  0x8000;
+
+  /** Flag for Database.create() */
+  public final static int UPS_TIME_SERIES           =  0x01000000;
+
   /** Flag for Database.open() */
   public final static int UPS_AUTO_RECOVERY         =  0x10000;
 
@@ -214,6 +223,19 @@ public class Const {
   /** Parameter name for Environment.open(), Environment.create() */
   public final static int UPS_PARAM_CUSTOM_COMPARE_NAME =  0x111;
 
+  /** Built-in compare function for UPS_PARAM_CUSTOM_COMPARE_NAME */
+  public final static String UPS_COMPARE_MEMCMP_REVERSE =
+                                                "ups.memcmp_reverse";
+
+  /** Built-in compare function for UPS_PARAM_CUSTOM_COMPARE_NAME */
+  public final static String UPS_COMPARE_CASE_INSENSITIVE =
+                                                "ups.case_insensitive";
+
+  /** Built-in compare function for UPS_PARAM_CUSTOM_COMPARE_NAME; use
+   * with keys written by ByteBuffer.putLong() */
+  public final static String UPS_COMPARE_BIG_ENDIAN_COMPOSITE =
+                                                "ups.big_endian_composite";
+
   /** Value for unlimited record sizes */
   public final static int UPS_RECORD_SIZE_UNLIMITED =  0xffffffff;
 
@@ -245,6 +267,148 @@ public class Const {
   /** upscaledb pro: Parameter name for Database.create(), Database.open() */
   public final static int UPS_PARAM_KEY_COMPRESSION       = 0x01002;
 
+  /** upscaledb pro: Parameter name for Database.create(), Database.open() */
+  public final static int UPS_PARAM_DUPLICATE_COMPRESSION = 0x01003;
+
+  /** Parameter name for Database.create() */
+  public final static int UPS_PARAM_RECORD_COMPRESSION_DICTIONARY = 0x01004;
+
+  /** Parameter name for Database.create() */
+  public final static int UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE
+                                                          = 0x01005;
+
+  /** Parameter name for Database.create() */
+  public final static int UPS_PARAM_KEY_LAYOUT            =  0x11c;
+
+  /** Value for UPS_PARAM_KEY_LAYOUT: sorted keys (the default) */
+  public final static int UPS_KEY_LAYOUT_SORTED       =    0;
+
+  /** Value for UPS_PARAM_KEY_LAYOUT: Eytzinger (breadth-first) order */
+  public final static int UPS_KEY_LAYOUT_EYTZINGER    =    1;
+
+  /** Value for UPS_PARAM_KEY_LAYOUT: cache-line blocked B+-tree order */
+  public final static int UPS_KEY_LAYOUT_BLOCKED      =    2;
+
+  /** Parameter name for Database.create() */
+  public final static int UPS_PARAM_LEAF_SUMMARIES        =  0x11d;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_NETWORK_PIPELINE_DEPTH =  0x11e;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_NETWORK_POOL_SIZE     =  0x11f;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE = 0x120;
+
+  /** Parameter name for Environment.create() */
+  public final static int UPS_PARAM_PARTITIONS            =  0x121;
+
+  /** Parameter name for Environment.create() */
+  public final static int UPS_PARAM_PARTITION_SCHEME      =  0x122;
+
+  /** Value for UPS_PARAM_PARTITION_SCHEME: hash partitioning */
+  public final static int UPS_PARTITION_HASH          =    0;
+
+  /** Value for UPS_PARAM_PARTITION_SCHEME: range partitioning */
+  public final static int UPS_PARTITION_RANGE         =    1;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_NETWORK_COMPRESSION   =  0x124;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_CACHE_HUGE_PAGES      =  0x126;
+
+  /** Value for UPS_PARAM_CACHE_HUGE_PAGES: regular pages */
+  public final static int UPS_HUGE_PAGES_NONE         =    0;
+
+  /** Value for UPS_PARAM_CACHE_HUGE_PAGES: 2 MB huge pages */
+  public final static int UPS_HUGE_PAGES_2MB          =    1;
+
+  /** Value for UPS_PARAM_CACHE_HUGE_PAGES: 1 GB huge pages */
+  public final static int UPS_HUGE_PAGES_1GB          =    2;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_CACHE_NUMA_POLICY     =  0x127;
+
+  /** Value for UPS_PARAM_CACHE_NUMA_POLICY: default placement */
+  public final static int UPS_NUMA_NONE               =    0;
+
+  /** Value for UPS_PARAM_CACHE_NUMA_POLICY: interleaves the cache shards */
+  public final static int UPS_NUMA_INTERLEAVE         =    1;
+
+  /** Value for UPS_PARAM_CACHE_NUMA_POLICY: places memory near its users */
+  public final static int UPS_NUMA_LOCAL              =    2;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_CACHE_WARMUP          =  0x128;
+
+  /** Parameter name for Environment.open() */
+  public final static int UPS_PARAM_RECOVERY_THREADS      =  0x129;
+
+  /** Parameter name for Environment.open() */
+  public final static int UPS_PARAM_RECOVERY_TXN_POLICY   =  0x12a;
+
+  /** Value for UPS_PARAM_RECOVERY_TXN_POLICY: aborts active Transactions */
+  public final static int UPS_RECOVERY_ABORT_TXNS     =    0;
+
+  /** Value for UPS_PARAM_RECOVERY_TXN_POLICY: restores active Transactions */
+  public final static int UPS_RECOVERY_RESTORE_TXNS   =    1;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_COMPACTION_FILL_FACTOR =  0x12b;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_COMPACTION_RATE       =  0x12c;
+
+  /** Flag for Environment.compact() */
+  public final static int UPS_COMPACT_ASYNC           =    1;
+
+  /** Flag for Environment.compact() */
+  public final static int UPS_COMPACT_STOP            =    2;
+
+  /** Flag for Environment.eraseDatabase() */
+  public final static int UPS_ERASE_DB_ASYNC          =    1;
+
+  /** Parameter name for Environment.createDatabase() */
+  public final static int UPS_PARAM_BLOOM_FILTER_BITS     =  0x12d;
+
+  /** Parameter name for Environment.createDatabase() */
+  public final static int UPS_PARAM_MEMORY_INDEX          =  0x12e;
+
+  /** Value for UPS_PARAM_MEMORY_INDEX */
+  public final static int UPS_MEMORY_INDEX_BTREE      =    0;
+
+  /** Value for UPS_PARAM_MEMORY_INDEX */
+  public final static int UPS_MEMORY_INDEX_ART        =    1;
+
+  /** Parameter name for Environment.createDatabase() */
+  public final static int UPS_PARAM_SUBTREE_COUNTS        =  0x12f;
+
+  /** Parameter name for Environment.create() */
+  public final static int UPS_PARAM_ENCRYPTION_MODE       =  0x130;
+
+  /** Value for UPS_PARAM_ENCRYPTION_MODE */
+  public final static int UPS_ENCRYPTION_CBC          =    1;
+
+  /** Value for UPS_PARAM_ENCRYPTION_MODE */
+  public final static int UPS_ENCRYPTION_XTS          =    2;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_CACHE_COMPRESSED_SIZE =  0x131;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_CACHE_COMPRESSOR      =  0x132;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_JOURNAL_PREALLOCATE_SIZE = 0x134;
+
+  /** Parameter name for Environment.create(), Environment.open() */
+  public final static int UPS_PARAM_JOURNAL_DIRECT_IO     =  0x135;
+
+  /** Parameter name for Environment.createDatabase() */
+  public final static int UPS_PARAM_DB_PAGE_SIZE          =  0x136;
+
   /** upscaledb pro: "null" compression */
   public final static int UPS_COMPRESSOR_NONE         =    0;
 
@@ -260,6 +424,15 @@ public class Const {
   /** upscaledb pro: lzop compression */
   public final static int UPS_COMPRESSOR_LZOP         =    4;
 
+  /** lz4 compression */
+  public final static int UPS_COMPRESSOR_LZ4          =   12;
+
+  /** zstd compression */
+  public final static int UPS_COMPRESSOR_ZSTD         =   13;
+
+  /** prefix compression for binary keys */
+  public final static int UPS_COMPRESSOR_PREFIX       =   14;
+
   /** Flag for Database.insert(), Cursor.insert() */
   public final static int UPS_OVERWRITE             =    1;
 
@@ -334,6 +507,9 @@ public class Const {
   public final static int UPS_FIND_GEQ_MATCH          =
         UPS_FIND_GT_MATCH | UPS_FIND_EQ_MATCH;
 
+  /** Flag for Cursor.find() */
+  public final static int UPS_FIND_FROM_CURRENT       =   0x8000;
+
   /** A binary blob without type; sorted by memcmp */
   public final static int UPS_TYPE_BINARY           = 0;
   /** A binary blob without type; sorted by callback function */
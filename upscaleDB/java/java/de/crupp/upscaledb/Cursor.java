@@ -18,6 +18,8 @@
 
 package de.crupp.upscaledb;
 
+import java.nio.ByteBuffer;
+
 public class Cursor {
 
   private native long ups_cursor_create(long dbhandle, long txnhandle);
@@ -26,6 +28,17 @@ public class Cursor {
 
   private native int ups_cursor_move_to(long handle, int flags);
 
+  private native int ups_cursor_move_batch(long handle, byte[][] keys,
+                        byte[][] records, int flags);
+
+  private native long ups_cursor_move_direct(long handle, ByteBuffer key,
+                        int keyOffset, int keyCapacity, ByteBuffer record,
+                        int recordOffset, int recordCapacity, int flags);
+
+  private native long ups_cursor_move_batch_direct(long handle,
+                        ByteBuffer buffer, int offset, int capacity,
+                        int flags);
+
   private native byte[] ups_cursor_get_key(long handle, int flags);
 
   private native byte[] ups_cursor_get_record(long handle, int flags);
@@ -45,6 +58,11 @@ public class Cursor {
 
   private native long ups_cursor_get_record_size(long handle);
 
+  private native int ups_cursor_move_to_rank(long handle, long rank,
+                        int flags);
+
+  private native long ups_cursor_get_rank(long handle, int flags);
+
   private native int ups_cursor_close(long handle);
 
   /**
@@ -235,6 +253,115 @@ public class Cursor {
     move(Const.UPS_CURSOR_PREVIOUS | flags);
   }
 
+  /**
+   * Moves the Cursor over several items and retrieves their keys and records
+   * <p>
+   * This method wraps the native ups_cursor_move_batch function.
+   * <p>
+   * Fills <code>keys</code> (and <code>records</code>, if not null) with
+   * up to <code>keys.length</code> consecutive items. The first move is
+   * performed with <code>flags</code>, all following moves continue in the
+   * same direction. Afterwards, the Cursor points to the last item which
+   * was returned.
+   *
+   * @param keys the array which receives the keys
+   * @param records the array which receives the records; can be null. If
+   *      not null, it must not be shorter than <code>keys</code>
+   * @param flags the direction of the first move; see
+   *      {@link Cursor#move(int)}
+   *
+   * @return the number of items which were retrieved, or 0 if the end
+   *      of the Database was reached
+   */
+  public int moveBatch(byte[][] keys, byte[][] records, int flags)
+      throws DatabaseException {
+    if (keys == null)
+      throw new NullPointerException();
+    if (records != null && records.length < keys.length)
+      throw new IllegalArgumentException();
+    if (keys.length == 0)
+      return 0;
+    // native function will throw exception
+    return ups_cursor_move_batch(m_handle, keys, records, flags);
+  }
+
+  /**
+   * Moves the Cursor and copies the key and the record of the new
+   * position to direct ByteBuffers
+   * <p>
+   * This method wraps the native ups_cursor_move function.
+   * <p>
+   * The key (and the record) are copied to the position of their
+   * buffers, and the positions are advanced. No Java arrays are
+   * allocated. If the key or the record does not fit then
+   * <code>Const.UPS_LIMITS_REACHED</code> is thrown; the Cursor was
+   * moved nevertheless.
+   *
+   * @param key a direct ByteBuffer which receives the key; can be null
+   * @param record a direct ByteBuffer which receives the record; can be null
+   * @param flags the direction of the move; see {@link Cursor#move(int)}
+   */
+  public void move(ByteBuffer key, ByteBuffer record, int flags)
+      throws DatabaseException {
+    if ((key != null && !key.isDirect())
+        || (record != null && !record.isDirect()))
+      throw new IllegalArgumentException("ByteBuffer is not direct");
+    // returns the key size and the record size, or a negative status
+    long sizes = ups_cursor_move_direct(m_handle,
+                    key, key != null ? key.position() : 0,
+                    key != null ? key.remaining() : 0,
+                    record, record != null ? record.position() : 0,
+                    record != null ? record.remaining() : 0, flags);
+    if (sizes < 0)
+      throw new DatabaseException((int)sizes);
+    if (key != null)
+      key.position(key.position() + (int)(sizes >>> 32));
+    if (record != null)
+      record.position(record.position() + (int)sizes);
+  }
+
+  /**
+   * Moves the Cursor over several items and copies their keys and records
+   * to a direct ByteBuffer
+   * <p>
+   * Starting at its position, <code>buffer</code> is filled with as many
+   * consecutive items as fit. Each item is stored as the 32bit key size,
+   * the key, the 32bit record size and the record, in native byte order
+   * (see <code>ByteOrder.nativeOrder()</code>). The position of the buffer
+   * is advanced.
+   * <p>
+   * The first move is performed with <code>flags</code>, all following
+   * moves continue in the same direction. Afterwards, the Cursor points to
+   * the last item which was returned. If not even the first item fits then
+   * <code>Const.UPS_LIMITS_REACHED</code> is thrown, and the Cursor points
+   * to this item.
+   * <p>
+   * All items are retrieved with a single call into the native library,
+   * and no Java arrays are allocated.
+   *
+   * @param buffer a direct ByteBuffer which receives the items
+   * @param flags the direction of the first move; see
+   *      {@link Cursor#move(int)}
+   *
+   * @return the number of items which were retrieved, or 0 if the end
+   *      of the Database was reached
+   */
+  public int moveBatch(ByteBuffer buffer, int flags)
+      throws DatabaseException {
+    if (buffer == null)
+      throw new NullPointerException();
+    if (!buffer.isDirect())
+      throw new IllegalArgumentException("ByteBuffer is not direct");
+    // returns the number of items and the number of bytes, or a
+    // negative status
+    long result = ups_cursor_move_batch_direct(m_handle, buffer,
+                    buffer.position(), buffer.remaining(), flags);
+    if (result < 0)
+      throw new DatabaseException((int)result);
+    buffer.position(buffer.position() + (int)result);
+    return (int)(result >>> 32);
+  }
+
   /**
    * Retrieves the Key of the current item
    * <p>
@@ -443,6 +570,60 @@ public class Cursor {
     return ups_cursor_get_record_size(m_handle);
   }
 
+  /**
+   * Moves the Cursor to the item with the given rank
+   * <p>
+   * This method wraps the native ups_cursor_move_to_rank function.
+   * <p>
+   * The rank is the 0-based position of an item in the sort order of
+   * the Database. With <code>Const.UPS_SKIP_DUPLICATES</code>, only the
+   * keys are counted. This is logarithmic in the number of keys if the
+   * Database was created with <code>Const.UPS_PARAM_SUBTREE_COUNTS</code>.
+   *
+   * @param rank the rank of the item
+   * @param flags 0 or <code>Const.UPS_SKIP_DUPLICATES</code>
+   */
+  public void moveToRank(long rank, int flags)
+      throws DatabaseException {
+    int status = ups_cursor_move_to_rank(m_handle, rank, flags);
+    if (status != 0)
+      throw new DatabaseException(status);
+  }
+
+  /**
+   * Moves the Cursor to the item with the given rank
+   *
+   * @see Cursor#moveToRank(long, int)
+   */
+  public void moveToRank(long rank)
+      throws DatabaseException {
+    moveToRank(rank, 0);
+  }
+
+  /**
+   * Returns the rank of the current item
+   * <p>
+   * This method wraps the native ups_cursor_get_rank function.
+   *
+   * @param flags 0 or <code>Const.UPS_SKIP_DUPLICATES</code>
+   * @return the 0-based rank of the current item
+   * @see Cursor#moveToRank(long, int)
+   */
+  public long getRank(int flags)
+      throws DatabaseException {
+    return ups_cursor_get_rank(m_handle, flags);
+  }
+
+  /**
+   * Returns the rank of the current item
+   *
+   * @see Cursor#getRank(int)
+   */
+  public long getRank()
+      throws DatabaseException {
+    return getRank(0);
+  }
+
   /**
    * Closes the Cursor
    * <p>
@@ -18,6 +18,7 @@
 
 package de.crupp.upscaledb;
 
+import java.nio.ByteBuffer;
 import java.util.HashSet;
 import java.util.Iterator;
 import java.util.ArrayList;
@@ -37,6 +38,9 @@ public class Database {
   private native byte[] ups_db_find(long handle, long txnhandle,
       byte[] key, int flags);
 
+  private native byte[][] ups_db_find_many(long handle, long txnhandle,
+      byte[][] keys, int flags);
+
   private native int ups_db_get_parameters(long handle, Parameter[] params);
 
   private native int ups_db_insert(long handle, long txnhandle,
@@ -45,6 +49,20 @@ public class Database {
   private native int ups_db_erase(long handle, long txnhandle,
       byte[] key, int flags);
 
+  private native long ups_db_append_many(long handle, long txnhandle,
+      byte[][] records, RecnoRange range, int flags);
+
+  private native int ups_db_reserve_record_numbers(long handle, int count,
+      RecnoRange range);
+
+  private native int ups_db_find_direct(long handle, long txnhandle,
+      ByteBuffer key, int keyOffset, int keySize, ByteBuffer record,
+      int recordOffset, int recordCapacity, int flags);
+
+  private native int ups_db_insert_direct(long handle, long txnhandle,
+      ByteBuffer key, int keyOffset, int keySize, ByteBuffer record,
+      int recordOffset, int recordSize, int flags);
+
   private native int ups_db_bulk_operations(long handle, long txnhandle,
       Operation[] operations, int flags);
 
@@ -168,6 +186,170 @@ public class Database {
     return find(null, key);
   }
 
+  /**
+   * Searches an item in the Database, copies the record to a direct
+   * ByteBuffer
+   * <p>
+   * This method wraps the native ups_db_find function.
+   * <p>
+   * Unlike <code>Database.find(Transaction, byte[])</code>, this method
+   * does not allocate Java arrays: the key is passed to the native library
+   * without copying, and the record is copied directly into
+   * <code>record</code>.
+   * <p>
+   * @param txn the (optional) Transaction
+   * @param key a direct ByteBuffer with the key; the key consists of the
+   *      bytes between its position and its limit. The position of
+   *      <code>key</code> is not modified
+   * @param record a direct ByteBuffer which receives the record at its
+   *      position; the position is advanced by the size of the record.
+   *      If the record does not fit then <code>Const.UPS_LIMITS_REACHED</code>
+   *      is thrown
+   * <p>
+   * @return the size of the record
+   */
+  public int find(Transaction txn, ByteBuffer key, ByteBuffer record)
+      throws DatabaseException {
+    if (key == null || record == null)
+      throw new NullPointerException();
+    if (!key.isDirect() || !record.isDirect())
+      throw new IllegalArgumentException("ByteBuffer is not direct");
+    int size = ups_db_find_direct(m_handle,
+                    txn != null ? txn.getHandle() : 0,
+                    key, key.position(), key.remaining(),
+                    record, record.position(), record.remaining(), 0);
+    if (size < 0)
+      throw new DatabaseException(size);
+    record.position(record.position() + size);
+    return size;
+  }
+
+  /**
+   * Searches an item in the Database, copies the record to a direct
+   * ByteBuffer
+   *
+   * @see Database#find(Transaction, ByteBuffer, ByteBuffer)
+   */
+  public int find(ByteBuffer key, ByteBuffer record)
+      throws DatabaseException {
+    return find(null, key, record);
+  }
+
+  /**
+   * Searches several items in the Database, returns their records
+   * <p>
+   * This method wraps the native ups_db_find_many function.
+   * <p>
+   * All keys are looked up with a single call into the native library.
+   * The records are returned in the same order as the keys; if a key
+   * does not exist then the corresponding element of the returned
+   * array is null.
+   * <p>
+   * @param txn the (optional) Transaction
+   * @param keys the keys of the items
+   * <p>
+   * @return the records of the items
+   */
+  public byte[][] findMany(Transaction txn, byte[][] keys)
+      throws DatabaseException {
+    if (keys == null)
+      throw new NullPointerException();
+    for (int i = 0; i < keys.length; i++) {
+      if (keys[i] == null)
+        throw new NullPointerException();
+    }
+    // native function will throw exception
+    return ups_db_find_many(m_handle, txn != null ? txn.getHandle() : 0,
+                    keys, 0);
+  }
+
+  /**
+   * Searches several items in the Database, returns their records
+   *
+   * @see Database#findMany(Transaction, byte[][])
+   */
+  public byte[][] findMany(byte[][] keys)
+      throws DatabaseException {
+    return findMany(null, keys);
+  }
+
+  /**
+   * Appends several records to a Record Number Database
+   * <p>
+   * This method wraps the native ups_db_append_many function.
+   * <p>
+   * All records are appended with a single call into the native library.
+   * They receive consecutive record numbers, which are taken from
+   * <code>range</code> or (if <code>range</code> is null) from the
+   * record number counter of the Database.
+   * <p>
+   * @param txn the (optional) Transaction
+   * @param records the records of the new items
+   * @param range an (optional) range which was returned by
+   *    {@link Database#reserveRecordNumbers}; its <code>next</code>
+   *    field is advanced
+   * <p>
+   * @return the record number of the first record, or 0 if
+   *    <code>records</code> is empty
+   */
+  public long appendMany(Transaction txn, byte[][] records,
+      RecnoRange range) throws DatabaseException {
+    if (records == null)
+      throw new NullPointerException();
+    for (int i = 0; i < records.length; i++) {
+      if (records[i] == null)
+        throw new NullPointerException();
+    }
+    // native function will throw exception
+    return ups_db_append_many(m_handle, txn != null ? txn.getHandle() : 0,
+                    records, range, 0);
+  }
+
+  /**
+   * Appends several records to a Record Number Database
+   *
+   * @see Database#appendMany(Transaction, byte[][], RecnoRange)
+   */
+  public long appendMany(Transaction txn, byte[][] records)
+      throws DatabaseException {
+    return appendMany(txn, records, null);
+  }
+
+  /**
+   * Appends several records to a Record Number Database
+   *
+   * @see Database#appendMany(Transaction, byte[][])
+   */
+  public long appendMany(byte[][] records)
+      throws DatabaseException {
+    return appendMany(null, records, null);
+  }
+
+  /**
+   * Reserves a range of record numbers
+   * <p>
+   * This method wraps the native ups_db_reserve_record_numbers function.
+   * <p>
+   * The record numbers of a Record Number Database are advanced by
+   * <code>count</code>, but no items are inserted. The numbers are
+   * assigned when the range is passed to
+   * {@link Database#appendMany(Transaction, byte[][], RecnoRange)}; this
+   * allows several threads to append to the same Database, each to its
+   * own range. Unused numbers remain as gaps.
+   * <p>
+   * @param count the number of record numbers to reserve
+   * <p>
+   * @return the reserved range
+   */
+  public RecnoRange reserveRecordNumbers(int count)
+      throws DatabaseException {
+    RecnoRange range = new RecnoRange();
+    int status = ups_db_reserve_record_numbers(m_handle, count, range);
+    if (status != 0)
+      throw new DatabaseException(status);
+    return range;
+  }
+
   /**
    * Inserts a Database item
    *
@@ -245,6 +427,51 @@ public class Database {
       throw new DatabaseException(status);
   }
 
+  /**
+   * Inserts a Database item from direct ByteBuffers
+   * <p>
+   * This method wraps the native ups_db_insert function.
+   * <p>
+   * Key and record are passed to the native library without copying. Both
+   * consist of the bytes between the position and the limit of their
+   * buffers; the positions are not modified.
+   * <p>
+   * In a Record Number Database, <code>key</code> can be null. Otherwise it
+   * receives the new record number (it must then have room for 4 or 8
+   * bytes).
+   * <p>
+   * @param txn the (optional) Transaction
+   * @param key a direct ByteBuffer with the key of the new item
+   * @param record a direct ByteBuffer with the record of the new item
+   * @param flags optional flags for inserting; see
+   *      {@link Database#insert(Transaction, byte[], byte[], int)}
+   */
+  public void insert(Transaction txn, ByteBuffer key, ByteBuffer record,
+      int flags)
+      throws DatabaseException {
+    if (record == null)
+      throw new NullPointerException();
+    if ((key != null && !key.isDirect()) || !record.isDirect())
+      throw new IllegalArgumentException("ByteBuffer is not direct");
+    int status = ups_db_insert_direct(m_handle,
+                    txn != null ? txn.getHandle() : 0,
+                    key, key != null ? key.position() : 0,
+                    key != null ? key.remaining() : 0,
+                    record, record.position(), record.remaining(), flags);
+    if (status != 0)
+      throw new DatabaseException(status);
+  }
+
+  /**
+   * Inserts a Database item from direct ByteBuffers
+   *
+   * @see Database#insert(Transaction, ByteBuffer, ByteBuffer, int)
+   */
+  public void insert(ByteBuffer key, ByteBuffer record)
+      throws DatabaseException {
+    insert(null, key, record, 0);
+  }
+
   /**
    * Erases a Database item
    *
@@ -47,6 +47,10 @@ public class Environment {
 
   private native int ups_env_flush(long handle);
 
+  private native int ups_env_compact(long handle, int flags);
+
+  private native int ups_env_backup(long handle, String destPath);
+
   private native long ups_txn_begin(long handle, int flags);
 
   private native long ups_env_select_range(long handle, String query,
@@ -382,7 +386,19 @@ public class Environment {
    */
   public void eraseDatabase(short name)
     throws DatabaseException {
-      int status = ups_env_erase_db(m_handle, name, 0);
+      eraseDatabase(name, 0);
+  }
+
+  /**
+   * Deletes a Database from this Environment
+   *
+   * @param name the name of the Database, which is deleted
+   * @param flags optional flags; <code>Const.UPS_ERASE_DB_ASYNC</code>
+   *        releases the pages of the Database in the background
+   */
+  public void eraseDatabase(short name, int flags)
+    throws DatabaseException {
+      int status = ups_env_erase_db(m_handle, name, flags);
       if (status != 0)
         throw new DatabaseException(status);
   }
@@ -436,6 +452,58 @@ public class Environment {
       throw new DatabaseException(status);
   }
 
+  /**
+   * Compacts the Environment
+   * <p>
+   * This method wraps the native ups_env_compact function.
+   * <p>
+   * Merges underfull leaf nodes, moves blobs into dense pages and
+   * truncates the free pages at the end of the file. Other threads can
+   * continue to use the Environment.
+   *
+   * @param flags Optional flags for compacting the Environment; possible
+   *    flags are:
+   *    <ul>
+   *      <li><code>Const.UPS_COMPACT_ASYNC</code></li>
+   *        starts the compaction in the background and returns immediately
+   *      <li><code>Const.UPS_COMPACT_STOP</code></li>
+   *        stops a running compaction
+   *    </ul>
+   */
+  public void compact(int flags)
+      throws DatabaseException {
+    int status = ups_env_compact(m_handle, flags);
+    if (status != 0)
+      throw new DatabaseException(status);
+  }
+
+  /**
+   * Compacts the Environment and waits till the compaction is finished
+   */
+  public void compact()
+      throws DatabaseException {
+    compact(0);
+  }
+
+  /**
+   * Creates a consistent backup of the Environment
+   * <p>
+   * This method wraps the native ups_env_backup function.
+   * <p>
+   * Copies the Environment file (and the journal entries of the
+   * checkpoint) to <code>destPath</code>. Other threads can continue to
+   * read and write while the backup is created; the backup reflects the
+   * state of the Environment when this method was called.
+   *
+   * @param destPath The path of the backup file
+   */
+  public void backup(String destPath)
+      throws DatabaseException {
+    int status = ups_env_backup(m_handle, destPath);
+    if (status != 0)
+      throw new DatabaseException(status);
+  }
+
   /**
    * Begins a new Transaction
    * <p>
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2005-2017 Christoph Rupp (chris@crupp.de).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * See the file COPYING for License information.
+ */
+
+package de.crupp.upscaledb;
+
+/**
+ * A range of reserved record numbers (for Database::reserveRecordNumbers
+ * and Database::appendMany)
+ * <p>
+ * A range is owned by a single thread; it must not be used by several
+ * threads at the same time.
+ */
+public class RecnoRange {
+  /** The next record number of this range */
+  public long next;
+
+  /** The first record number after this range */
+  public long end;
+
+  /** For internal use; the leaf page which received the last append */
+  private long leaf;
+}
@@ -87,6 +87,8 @@ extern "C" {
 #define de_crupp_upscaledb_Const_UPS_DEBUG_LEVEL_FATAL 3L
 #undef de_crupp_upscaledb_Const_UPS_TXN_READ_ONLY
 #define de_crupp_upscaledb_Const_UPS_TXN_READ_ONLY 1L
+#undef de_crupp_upscaledb_Const_UPS_TXN_SNAPSHOT
+#define de_crupp_upscaledb_Const_UPS_TXN_SNAPSHOT 4L
 #undef de_crupp_upscaledb_Const_UPS_TXN_FORCE_WRITE
 #define de_crupp_upscaledb_Const_UPS_TXN_FORCE_WRITE 1L
 #undef de_crupp_upscaledb_Const_UPS_ENABLE_FSYNC
@@ -105,6 +107,10 @@ extern "C" {
 #define de_crupp_upscaledb_Const_UPS_RECORD_NUMBER 8192L
 #undef de_crupp_upscaledb_Const_UPS_ENABLE_DUPLICATE_KEYS
 #define de_crupp_upscaledb_Const_UPS_ENABLE_DUPLICATE_KEYS 16384L
+#undef de_crupp_upscaledb_Const_UPS_HASH_INDEX
+#define de_crupp_upscaledb_Const_UPS_HASH_INDEX 32768L
+#undef de_crupp_upscaledb_Const_UPS_TIME_SERIES
+#define de_crupp_upscaledb_Const_UPS_TIME_SERIES 16777216L
 #undef de_crupp_upscaledb_Const_UPS_AUTO_RECOVERY
 #define de_crupp_upscaledb_Const_UPS_AUTO_RECOVERY 65536L
 #undef de_crupp_upscaledb_Const_UPS_ENABLE_TRANSACTIONS
@@ -163,6 +169,100 @@ extern "C" {
 #define de_crupp_upscaledb_Const_UPS_PARAM_RECORD_COMPRESSION 4097L
 #undef de_crupp_upscaledb_Const_UPS_PARAM_KEY_COMPRESSION
 #define de_crupp_upscaledb_Const_UPS_PARAM_KEY_COMPRESSION 4098L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_DUPLICATE_COMPRESSION
+#define de_crupp_upscaledb_Const_UPS_PARAM_DUPLICATE_COMPRESSION 4099L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_RECORD_COMPRESSION_DICTIONARY
+#define de_crupp_upscaledb_Const_UPS_PARAM_RECORD_COMPRESSION_DICTIONARY 4100L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE
+#define de_crupp_upscaledb_Const_UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE 4101L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_KEY_LAYOUT
+#define de_crupp_upscaledb_Const_UPS_PARAM_KEY_LAYOUT 284L
+#undef de_crupp_upscaledb_Const_UPS_KEY_LAYOUT_SORTED
+#define de_crupp_upscaledb_Const_UPS_KEY_LAYOUT_SORTED 0L
+#undef de_crupp_upscaledb_Const_UPS_KEY_LAYOUT_EYTZINGER
+#define de_crupp_upscaledb_Const_UPS_KEY_LAYOUT_EYTZINGER 1L
+#undef de_crupp_upscaledb_Const_UPS_KEY_LAYOUT_BLOCKED
+#define de_crupp_upscaledb_Const_UPS_KEY_LAYOUT_BLOCKED 2L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_LEAF_SUMMARIES
+#define de_crupp_upscaledb_Const_UPS_PARAM_LEAF_SUMMARIES 285L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_PIPELINE_DEPTH
+#define de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_PIPELINE_DEPTH 286L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_POOL_SIZE
+#define de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_POOL_SIZE 287L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE
+#define de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE 288L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_PARTITIONS
+#define de_crupp_upscaledb_Const_UPS_PARAM_PARTITIONS 289L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_PARTITION_SCHEME
+#define de_crupp_upscaledb_Const_UPS_PARAM_PARTITION_SCHEME 290L
+#undef de_crupp_upscaledb_Const_UPS_PARTITION_HASH
+#define de_crupp_upscaledb_Const_UPS_PARTITION_HASH 0L
+#undef de_crupp_upscaledb_Const_UPS_PARTITION_RANGE
+#define de_crupp_upscaledb_Const_UPS_PARTITION_RANGE 1L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_COMPRESSION
+#define de_crupp_upscaledb_Const_UPS_PARAM_NETWORK_COMPRESSION 292L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_CACHE_HUGE_PAGES
+#define de_crupp_upscaledb_Const_UPS_PARAM_CACHE_HUGE_PAGES 294L
+#undef de_crupp_upscaledb_Const_UPS_HUGE_PAGES_NONE
+#define de_crupp_upscaledb_Const_UPS_HUGE_PAGES_NONE 0L
+#undef de_crupp_upscaledb_Const_UPS_HUGE_PAGES_2MB
+#define de_crupp_upscaledb_Const_UPS_HUGE_PAGES_2MB 1L
+#undef de_crupp_upscaledb_Const_UPS_HUGE_PAGES_1GB
+#define de_crupp_upscaledb_Const_UPS_HUGE_PAGES_1GB 2L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_CACHE_NUMA_POLICY
+#define de_crupp_upscaledb_Const_UPS_PARAM_CACHE_NUMA_POLICY 295L
+#undef de_crupp_upscaledb_Const_UPS_NUMA_NONE
+#define de_crupp_upscaledb_Const_UPS_NUMA_NONE 0L
+#undef de_crupp_upscaledb_Const_UPS_NUMA_INTERLEAVE
+#define de_crupp_upscaledb_Const_UPS_NUMA_INTERLEAVE 1L
+#undef de_crupp_upscaledb_Const_UPS_NUMA_LOCAL
+#define de_crupp_upscaledb_Const_UPS_NUMA_LOCAL 2L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_CACHE_WARMUP
+#define de_crupp_upscaledb_Const_UPS_PARAM_CACHE_WARMUP 296L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_RECOVERY_THREADS
+#define de_crupp_upscaledb_Const_UPS_PARAM_RECOVERY_THREADS 297L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_RECOVERY_TXN_POLICY
+#define de_crupp_upscaledb_Const_UPS_PARAM_RECOVERY_TXN_POLICY 298L
+#undef de_crupp_upscaledb_Const_UPS_RECOVERY_ABORT_TXNS
+#define de_crupp_upscaledb_Const_UPS_RECOVERY_ABORT_TXNS 0L
+#undef de_crupp_upscaledb_Const_UPS_RECOVERY_RESTORE_TXNS
+#define de_crupp_upscaledb_Const_UPS_RECOVERY_RESTORE_TXNS 1L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_COMPACTION_FILL_FACTOR
+#define de_crupp_upscaledb_Const_UPS_PARAM_COMPACTION_FILL_FACTOR 299L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_COMPACTION_RATE
+#define de_crupp_upscaledb_Const_UPS_PARAM_COMPACTION_RATE 300L
+#undef de_crupp_upscaledb_Const_UPS_COMPACT_ASYNC
+#define de_crupp_upscaledb_Const_UPS_COMPACT_ASYNC 1L
+#undef de_crupp_upscaledb_Const_UPS_COMPACT_STOP
+#define de_crupp_upscaledb_Const_UPS_COMPACT_STOP 2L
+#undef de_crupp_upscaledb_Const_UPS_ERASE_DB_ASYNC
+#define de_crupp_upscaledb_Const_UPS_ERASE_DB_ASYNC 1L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_BLOOM_FILTER_BITS
+#define de_crupp_upscaledb_Const_UPS_PARAM_BLOOM_FILTER_BITS 301L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_MEMORY_INDEX
+#define de_crupp_upscaledb_Const_UPS_PARAM_MEMORY_INDEX 302L
+#undef de_crupp_upscaledb_Const_UPS_MEMORY_INDEX_BTREE
+#define de_crupp_upscaledb_Const_UPS_MEMORY_INDEX_BTREE 0L
+#undef de_crupp_upscaledb_Const_UPS_MEMORY_INDEX_ART
+#define de_crupp_upscaledb_Const_UPS_MEMORY_INDEX_ART 1L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_SUBTREE_COUNTS
+#define de_crupp_upscaledb_Const_UPS_PARAM_SUBTREE_COUNTS 303L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_ENCRYPTION_MODE
+#define de_crupp_upscaledb_Const_UPS_PARAM_ENCRYPTION_MODE 304L
+#undef de_crupp_upscaledb_Const_UPS_ENCRYPTION_CBC
+#define de_crupp_upscaledb_Const_UPS_ENCRYPTION_CBC 1L
+#undef de_crupp_upscaledb_Const_UPS_ENCRYPTION_XTS
+#define de_crupp_upscaledb_Const_UPS_ENCRYPTION_XTS 2L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_CACHE_COMPRESSED_SIZE
+#define de_crupp_upscaledb_Const_UPS_PARAM_CACHE_COMPRESSED_SIZE 305L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_CACHE_COMPRESSOR
+#define de_crupp_upscaledb_Const_UPS_PARAM_CACHE_COMPRESSOR 306L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_JOURNAL_PREALLOCATE_SIZE
+#define de_crupp_upscaledb_Const_UPS_PARAM_JOURNAL_PREALLOCATE_SIZE 308L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_JOURNAL_DIRECT_IO
+#define de_crupp_upscaledb_Const_UPS_PARAM_JOURNAL_DIRECT_IO 309L
+#undef de_crupp_upscaledb_Const_UPS_PARAM_DB_PAGE_SIZE
+#define de_crupp_upscaledb_Const_UPS_PARAM_DB_PAGE_SIZE 310L
 #undef de_crupp_upscaledb_Const_UPS_COMPRESSOR_NONE
 #define de_crupp_upscaledb_Const_UPS_COMPRESSOR_NONE 0L
 #undef de_crupp_upscaledb_Const_UPS_COMPRESSOR_ZLIB
@@ -173,6 +273,12 @@ extern "C" {
 #define de_crupp_upscaledb_Const_UPS_COMPRESSOR_LZF 3L
 #undef de_crupp_upscaledb_Const_UPS_COMPRESSOR_LZOP
 #define de_crupp_upscaledb_Const_UPS_COMPRESSOR_LZOP 4L
+#undef de_crupp_upscaledb_Const_UPS_COMPRESSOR_LZ4
+#define de_crupp_upscaledb_Const_UPS_COMPRESSOR_LZ4 12L
+#undef de_crupp_upscaledb_Const_UPS_COMPRESSOR_ZSTD
+#define de_crupp_upscaledb_Const_UPS_COMPRESSOR_ZSTD 13L
+#undef de_crupp_upscaledb_Const_UPS_COMPRESSOR_PREFIX
+#define de_crupp_upscaledb_Const_UPS_COMPRESSOR_PREFIX 14L
 #undef de_crupp_upscaledb_Const_UPS_OVERWRITE
 #define de_crupp_upscaledb_Const_UPS_OVERWRITE 1L
 #undef de_crupp_upscaledb_Const_UPS_DUPLICATE
@@ -221,6 +327,8 @@ extern "C" {
 #define de_crupp_upscaledb_Const_UPS_FIND_LEQ_MATCH 20480L
 #undef de_crupp_upscaledb_Const_UPS_FIND_GEQ_MATCH
 #define de_crupp_upscaledb_Const_UPS_FIND_GEQ_MATCH 24576L
+#undef de_crupp_upscaledb_Const_UPS_FIND_FROM_CURRENT
+#define de_crupp_upscaledb_Const_UPS_FIND_FROM_CURRENT 32768L
 #undef de_crupp_upscaledb_Const_UPS_TYPE_BINARY
 #define de_crupp_upscaledb_Const_UPS_TYPE_BINARY 0L
 #undef de_crupp_upscaledb_Const_UPS_TYPE_CUSTOM
@@ -31,6 +31,30 @@ JNIEXPORT jlong JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1clone
 JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1to
   (JNIEnv *, jobject, jlong, jint);
 
+/*
+ * Class:     de_crupp_upscaledb_Cursor
+ * Method:    ups_cursor_move_batch
+ * Signature: (J[[B[[BI)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1batch
+  (JNIEnv *, jobject, jlong, jobjectArray, jobjectArray, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Cursor
+ * Method:    ups_cursor_move_direct
+ * Signature: (JLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;III)J
+ */
+JNIEXPORT jlong JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1direct
+  (JNIEnv *, jobject, jlong, jobject, jint, jint, jobject, jint, jint, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Cursor
+ * Method:    ups_cursor_move_batch_direct
+ * Signature: (JLjava/nio/ByteBuffer;III)J
+ */
+JNIEXPORT jlong JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1batch_1direct
+  (JNIEnv *, jobject, jlong, jobject, jint, jint, jint);
+
 /*
  * Class:     de_crupp_upscaledb_Cursor
  * Method:    ups_cursor_get_key
@@ -95,6 +119,22 @@ JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1get_1duplicat
 JNIEXPORT jlong JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1get_1record_1size
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     de_crupp_upscaledb_Cursor
+ * Method:    ups_cursor_move_to_rank
+ * Signature: (JJI)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1to_1rank
+  (JNIEnv *, jobject, jlong, jlong, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Cursor
+ * Method:    ups_cursor_get_rank
+ * Signature: (JI)J
+ */
+JNIEXPORT jlong JNICALL Java_de_crupp_upscaledb_Cursor_ups_1cursor_1get_1rank
+  (JNIEnv *, jobject, jlong, jint);
+
 /*
  * Class:     de_crupp_upscaledb_Cursor
  * Method:    ups_cursor_close
@@ -47,6 +47,30 @@ JNIEXPORT void JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1set_1compare_1f
 JNIEXPORT jbyteArray JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1find
   (JNIEnv *, jobject, jlong, jlong, jbyteArray, jint);
 
+/*
+ * Class:     de_crupp_upscaledb_Database
+ * Method:    ups_db_find_many
+ * Signature: (JJ[[BI)[[B
+ */
+JNIEXPORT jobjectArray JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1find_1many
+  (JNIEnv *, jobject, jlong, jlong, jobjectArray, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Database
+ * Method:    ups_db_append_many
+ * Signature: (JJ[[BLde/crupp/upscaledb/RecnoRange;I)J
+ */
+JNIEXPORT jlong JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1append_1many
+  (JNIEnv *, jobject, jlong, jlong, jobjectArray, jobject, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Database
+ * Method:    ups_db_reserve_record_numbers
+ * Signature: (JILde/crupp/upscaledb/RecnoRange;)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1reserve_1record_1numbers
+  (JNIEnv *, jobject, jlong, jint, jobject);
+
 /*
  * Class:     de_crupp_upscaledb_Database
  * Method:    ups_db_get_parameters
@@ -71,6 +95,22 @@ JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1insert
 JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1erase
   (JNIEnv *, jobject, jlong, jlong, jbyteArray, jint);
 
+/*
+ * Class:     de_crupp_upscaledb_Database
+ * Method:    ups_db_find_direct
+ * Signature: (JJLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;III)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1find_1direct
+  (JNIEnv *, jobject, jlong, jlong, jobject, jint, jint, jobject, jint, jint, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Database
+ * Method:    ups_db_insert_direct
+ * Signature: (JJLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;III)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Database_ups_1db_1insert_1direct
+  (JNIEnv *, jobject, jlong, jlong, jobject, jint, jint, jobject, jint, jint, jint);
+
 /*
  * Class:     de_crupp_upscaledb_Database
  * Method:    ups_db_bulk_operations
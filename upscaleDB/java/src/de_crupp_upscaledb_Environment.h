@@ -79,6 +79,22 @@ JNIEXPORT jshortArray JNICALL Java_de_crupp_upscaledb_Environment_ups_1env_1get_
 JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Environment_ups_1env_1flush
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     de_crupp_upscaledb_Environment
+ * Method:    ups_env_compact
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Environment_ups_1env_1compact
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     de_crupp_upscaledb_Environment
+ * Method:    ups_env_backup
+ * Signature: (JLjava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_de_crupp_upscaledb_Environment_ups_1env_1backup
+  (JNIEnv *, jobject, jlong, jstring);
+
 /*
  * Class:     de_crupp_upscaledb_Environment
  * Method:    ups_txn_begin
@@ -0,0 +1,13 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class de_crupp_upscaledb_RecnoRange */
+
+#ifndef _Included_de_crupp_upscaledb_RecnoRange
+#define _Included_de_crupp_upscaledb_RecnoRange
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -42,6 +42,7 @@ typedef struct jnipriv {
   JNIEnv *jenv;
   jobject jobj;
   jobject jcmp;
+  jmethodID jcmpmid;
 } jnipriv;
 
 #define SET_DB_CONTEXT(db, jenv, jobj)                          \
@@ -49,6 +50,7 @@ typedef struct jnipriv {
       p.jenv = jenv;                                            \
       p.jobj = jobj;                                            \
       p.jcmp = 0;                                               \
+      p.jcmpmid = 0;                                            \
       ups_set_context_data(db, &p);
 
 static jint
@@ -86,6 +88,65 @@ jni_set_cursor_env(jnipriv *p, JNIEnv *jenv, jobject jobj, jlong jhandle)
   return (0);
 }
 
+/*
+ * A copy of the elements of a Java byte array; small arrays are copied to
+ * an inline buffer on the stack. The array is not pinned (with
+ * GetPrimitiveArrayCritical() or GetByteArrayElements()), because
+ * upscaledb can block (i.e. on a lock or on I/O) and call back into Java
+ * while it uses the elements, and a pinned array can stall the garbage
+ * collector - or deadlock.
+ */
+class JniByteArray {
+  public:
+    JniByteArray()
+      : m_size(0) {
+    }
+
+    void acquire(JNIEnv *jenv, jbyteArray array) {
+      m_size = (uint32_t)jenv->GetArrayLength(array);
+      if (m_size > sizeof(m_inline))
+        m_heap.resize(m_size);
+      if (m_size)
+        jenv->GetByteArrayRegion(array, 0, m_size, (jbyte *)data());
+    }
+
+    uint8_t *data() {
+      return (m_heap.empty() ? m_inline : &m_heap[0]);
+    }
+
+    uint32_t size() const {
+      return (m_size);
+    }
+
+  private:
+    uint8_t m_inline[256];
+    std::vector<uint8_t> m_heap;
+    uint32_t m_size;
+};
+
+/* Appends a copy of the elements of |array| to |buffer|, and returns the
+ * offset of the copy; for the batch functions */
+static size_t
+jni_copy_array(JNIEnv *jenv, jbyteArray array, std::vector<uint8_t> &buffer)
+{
+  size_t offset = buffer.size();
+  jsize len = jenv->GetArrayLength(array);
+  buffer.resize(offset + len);
+  if (len)
+    jenv->GetByteArrayRegion(array, 0, len, (jbyte *)&buffer[offset]);
+  return (offset);
+}
+
+/* Returns the address of a direct ByteBuffer plus |offset|, or null */
+static uint8_t *
+jni_buffer_address(JNIEnv *jenv, jobject jbuffer, jint offset)
+{
+  if (!jbuffer)
+    return (0);
+  uint8_t *p = (uint8_t *)jenv->GetDirectBufferAddress(jbuffer);
+  return (p ? p + offset : 0);
+}
+
 static void
 jni_throw_error(JNIEnv *jenv, ups_status_t st)
 {
@@ -252,18 +313,25 @@ jni_compare_func2(ups_db_t *db,
     p->jcmp = jcmpobj = g_callbacks[hash]; // TODO lock
   }
 
-  jclass jcmpcls = p->jenv->GetObjectClass(jcmpobj);
-  if (!jcmpcls) {
-    jni_log(("GetObjectClass failed\n"));
-    jni_throw_error(p->jenv, UPS_INTERNAL_ERROR);
-    return (-1);
-  }
-
-  jmethodID jmid = p->jenv->GetMethodID(jcmpcls, "compare", "([B[B)I");
+  /* the method is looked up once per native call, not per comparison;
+   * the built-in compare functions (i.e. Const.UPS_COMPARE_MEMCMP_REVERSE)
+   * avoid the callback altogether */
+  jmethodID jmid = p->jcmpmid;
   if (!jmid) {
-    jni_log(("GetMethodID failed\n"));
-    jni_throw_error(p->jenv, UPS_INTERNAL_ERROR);
-    return (-1);
+    jclass jcmpcls = p->jenv->GetObjectClass(jcmpobj);
+    if (!jcmpcls) {
+      jni_log(("GetObjectClass failed\n"));
+      jni_throw_error(p->jenv, UPS_INTERNAL_ERROR);
+      return (-1);
+    }
+
+    p->jcmpmid = jmid = p->jenv->GetMethodID(jcmpcls, "compare", "([B[B)I");
+    p->jenv->DeleteLocalRef(jcmpcls);
+    if (!jmid) {
+      jni_log(("GetMethodID failed\n"));
+      jni_throw_error(p->jenv, UPS_INTERNAL_ERROR);
+      return (-1);
+    }
   }
 
   /* prepare the parameters */
@@ -279,6 +347,7 @@ jni_compare_func2(ups_db_t *db,
 
   jbyteArray jrhs = p->jenv->NewByteArray(rhs_length);
   if (!jrhs) {
+    p->jenv->DeleteLocalRef(jlhs);
     jni_log(("NewByteArray failed\n"));
     jni_throw_error(p->jenv, UPS_INTERNAL_ERROR);
     return (-1);
@@ -287,7 +356,13 @@ jni_compare_func2(ups_db_t *db,
   if (rhs_length)
     p->jenv->SetByteArrayRegion(jrhs, 0, rhs_length, (jbyte *)rhs);
 
-  return (p->jenv->CallIntMethod(jcmpobj, jmid, jlhs, jrhs));
+  int cmp = p->jenv->CallIntMethod(jcmpobj, jmid, jlhs, jrhs);
+
+  /* a btree search makes many comparisons in a single native call; release
+   * the arrays immediately instead of filling the local reference table */
+  p->jenv->DeleteLocalRef(jlhs);
+  p->jenv->DeleteLocalRef(jrhs);
+  return (cmp);
 }
 
 static ups_status_t
@@ -494,19 +569,20 @@ Java_de_crupp_upscaledb_Database_ups_1db_1find(JNIEnv *jenv, jobject jobj,
   ups_key_t hkey;
   ups_record_t hrec;
   jbyteArray jrec;
+  JniByteArray key;
 
   SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
 
   memset(&hkey, 0, sizeof(hkey));
   memset(&hrec, 0, sizeof(hrec));
 
-  hkey.data = (uint8_t *)jenv->GetByteArrayElements(jkey, 0);
-  hkey.size = (uint32_t)jenv->GetArrayLength(jkey);
+  key.acquire(jenv, jkey);
+  hkey.data = key.data();
+  hkey.size = (uint16_t)key.size();
 
   st = ups_db_find((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
             &hkey, &hrec, (uint32_t)jflags);
 
-  jenv->ReleaseByteArrayElements(jkey, (jbyte *)hkey.data, 0);
   if (st)
     return (0);
 
@@ -517,6 +593,90 @@ Java_de_crupp_upscaledb_Database_ups_1db_1find(JNIEnv *jenv, jobject jobj,
   return (jrec);
 }
 
+JNIEXPORT jobjectArray JNICALL
+Java_de_crupp_upscaledb_Database_ups_1db_1find_1many(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jlong jtxnhandle, jobjectArray jkeys,
+    jint jflags)
+{
+  ups_status_t st;
+  jbyteArray jrec;
+  jobjectArray jrecords;
+
+  SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
+
+  unsigned size = jenv->GetArrayLength(jkeys);
+  std::vector<ups_key_t> keys(size);
+  std::vector<ups_record_t> records(size);
+  std::vector<ups_status_t> statuses(size);
+  std::vector<size_t> offsets(size);
+  std::vector<uint8_t> keydata;
+
+  /* copy all keys into one buffer, and release each local reference
+   * immediately; otherwise a large batch overflows the table of local
+   * references */
+  for (unsigned i = 0; i < size; i++) {
+    jbyteArray jkey = (jbyteArray)jenv->GetObjectArrayElement(jkeys, i);
+    jsize len = jenv->GetArrayLength(jkey);
+    if (len > 0xffff) {
+      jenv->DeleteLocalRef(jkey);
+      jni_throw_error(jenv, UPS_INV_KEY_SIZE);
+      return (0);
+    }
+    memset(&keys[i], 0, sizeof(ups_key_t));
+    memset(&records[i], 0, sizeof(ups_record_t));
+    keys[i].size = (uint16_t)len;
+    offsets[i] = keydata.size();
+    keydata.resize(keydata.size() + len);
+    if (len)
+      jenv->GetByteArrayRegion(jkey, 0, len, (jbyte *)&keydata[offsets[i]]);
+    jenv->DeleteLocalRef(jkey);
+  }
+  /* the buffer is no longer resized; now the pointers are stable */
+  for (unsigned i = 0; i < size; i++)
+    keys[i].data = keydata.empty() ? 0 : &keydata[offsets[i]];
+
+  st = ups_db_find_many((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
+            size ? &keys[0] : 0, size ? &records[0] : 0,
+            size ? &statuses[0] : 0, size, (uint32_t)jflags);
+
+  if (st) {
+    jni_throw_error(jenv, st);
+    return (0);
+  }
+
+  jclass jcls = jenv->FindClass("[B");
+  if (!jcls) {
+    jni_log(("FindClass failed\n"));
+    jni_throw_error(jenv, UPS_INTERNAL_ERROR);
+    return (0);
+  }
+
+  jrecords = jenv->NewObjectArray(size, jcls, 0);
+  jenv->DeleteLocalRef(jcls);
+  if (!jrecords) {
+    jni_log(("NewObjectArray failed\n"));
+    jni_throw_error(jenv, UPS_OUT_OF_MEMORY);
+    return (0);
+  }
+
+  for (unsigned i = 0; i < size; i++) {
+    if (statuses[i] == UPS_KEY_NOT_FOUND)
+      continue;
+    if (statuses[i]) {
+      jni_throw_error(jenv, statuses[i]);
+      return (0);
+    }
+    jrec = jenv->NewByteArray(records[i].size);
+    if (records[i].size)
+      jenv->SetByteArrayRegion(jrec, 0, records[i].size,
+                      (jbyte *)records[i].data);
+    jenv->SetObjectArrayElement(jrecords, i, jrec);
+    jenv->DeleteLocalRef(jrec);
+  }
+
+  return (jrecords);
+}
+
 JNIEXPORT jint JNICALL
 Java_de_crupp_upscaledb_Database_ups_1db_1insert(JNIEnv *jenv, jobject jobj,
     jlong jhandle, jlong jtxnhandle, jbyteArray jkey,
@@ -525,23 +685,23 @@ Java_de_crupp_upscaledb_Database_ups_1db_1insert(JNIEnv *jenv, jobject jobj,
   ups_status_t st;
   ups_key_t hkey;
   ups_record_t hrec;
+  JniByteArray key, record;
 
   SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
 
   memset(&hkey, 0, sizeof(hkey));
   memset(&hrec, 0, sizeof(hrec));
 
-  hkey.data = (uint8_t *)jenv->GetByteArrayElements(jkey, 0);
-  hkey.size = (uint32_t)jenv->GetArrayLength(jkey);
-  hrec.data = (uint8_t *)jenv->GetByteArrayElements(jrecord, 0);
-  hrec.size = (uint32_t)jenv->GetArrayLength(jrecord);
+  key.acquire(jenv, jkey);
+  record.acquire(jenv, jrecord);
+  hkey.data = key.data();
+  hkey.size = (uint16_t)key.size();
+  hrec.data = record.data();
+  hrec.size = record.size();
 
   st = ups_db_insert((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
             &hkey, &hrec, (uint32_t)jflags);
 
-  jenv->ReleaseByteArrayElements(jkey, (jbyte *)hkey.data, 0);
-  jenv->ReleaseByteArrayElements(jrecord, (jbyte *)hrec.data, 0);
-
   return (st);
 }
 
@@ -551,99 +711,263 @@ Java_de_crupp_upscaledb_Database_ups_1db_1erase(JNIEnv *jenv, jobject jobj,
 {
   ups_status_t st;
   ups_key_t hkey;
+  JniByteArray key;
 
   SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
 
   memset(&hkey, 0, sizeof(hkey));
 
-  hkey.data = (uint8_t *)jenv->GetByteArrayElements(jkey, 0);
-  hkey.size = (uint32_t)jenv->GetArrayLength(jkey);
+  key.acquire(jenv, jkey);
+  hkey.data = key.data();
+  hkey.size = (uint16_t)key.size();
 
   st = ups_db_erase((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
             &hkey, (uint32_t)jflags);
 
-  jenv->ReleaseByteArrayElements(jkey, (jbyte *)hkey.data, 0);
-
   return (st);
 }
 
+/*
+ * Copies a de.crupp.upscaledb.RecnoRange object to |range| (if |store| is
+ * false) or |range| to the object (if |store| is true)
+ */
+static bool
+jni_copy_recno_range(JNIEnv *jenv, jobject jrange, ups_recno_range_t *range,
+                bool store)
+{
+  jclass jcls = jenv->GetObjectClass(jrange);
+  if (!jcls) {
+    jni_log(("GetObjectClass failed\n"));
+    return (false);
+  }
+  jfieldID fidnext = jenv->GetFieldID(jcls, "next", "J");
+  jfieldID fidend = jenv->GetFieldID(jcls, "end", "J");
+  jfieldID fidleaf = jenv->GetFieldID(jcls, "leaf", "J");
+  jenv->DeleteLocalRef(jcls);
+  if (!fidnext || !fidend || !fidleaf) {
+    jni_log(("GetFieldID failed\n"));
+    return (false);
+  }
+
+  if (store) {
+    jenv->SetLongField(jrange, fidnext, (jlong)range->next);
+    jenv->SetLongField(jrange, fidend, (jlong)range->end);
+    jenv->SetLongField(jrange, fidleaf, (jlong)range->_leaf);
+  }
+  else {
+    range->next = (uint64_t)jenv->GetLongField(jrange, fidnext);
+    range->end = (uint64_t)jenv->GetLongField(jrange, fidend);
+    range->_leaf = (uint64_t)jenv->GetLongField(jrange, fidleaf);
+  }
+  return (true);
+}
+
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Database_ups_1db_1reserve_1record_1numbers(
+    JNIEnv *jenv, jobject jobj, jlong jhandle, jint jcount, jobject jrange)
+{
+  ups_recno_range_t range;
+
+  SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
+
+  memset(&range, 0, sizeof(range));
+  ups_status_t st = ups_db_reserve_record_numbers((ups_db_t *)jhandle,
+            (uint32_t)jcount, &range);
+  if (st)
+    return (st);
+  if (!jni_copy_recno_range(jenv, jrange, &range, true))
+    return (UPS_INTERNAL_ERROR);
+  return (0);
+}
+
+JNIEXPORT jlong JNICALL
+Java_de_crupp_upscaledb_Database_ups_1db_1append_1many(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jlong jtxnhandle, jobjectArray jrecords,
+    jobject jrange, jint jflags)
+{
+  ups_status_t st;
+  uint64_t first = 0;
+  ups_recno_range_t range;
+
+  SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
+
+  unsigned size = jenv->GetArrayLength(jrecords);
+  if (size == 0)
+    return (0);
+  std::vector<ups_record_t> records(size);
+  std::vector<size_t> offsets(size);
+  std::vector<uint8_t> recdata;
+
+  /* copy all records into one buffer, and release each local reference
+   * immediately */
+  for (unsigned i = 0; i < size; i++) {
+    jbyteArray jrec = (jbyteArray)jenv->GetObjectArrayElement(jrecords, i);
+    memset(&records[i], 0, sizeof(ups_record_t));
+    records[i].size = (uint32_t)jenv->GetArrayLength(jrec);
+    offsets[i] = jni_copy_array(jenv, jrec, recdata);
+    jenv->DeleteLocalRef(jrec);
+  }
+  /* the buffer is no longer resized; now the pointers are stable */
+  for (unsigned i = 0; i < size; i++)
+    records[i].data = recdata.empty() ? 0 : &recdata[offsets[i]];
+
+  if (jrange && !jni_copy_recno_range(jenv, jrange, &range, false)) {
+    jni_throw_error(jenv, UPS_INTERNAL_ERROR);
+    return (0);
+  }
+
+  st = ups_db_append_many((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
+            &records[0], size, jrange ? &range : 0, &first, (uint32_t)jflags);
+
+  /* the range was advanced */
+  if (st == 0 && jrange && !jni_copy_recno_range(jenv, jrange, &range, true))
+    st = UPS_INTERNAL_ERROR;
+
+  if (st) {
+    jni_throw_error(jenv, st);
+    return (0);
+  }
+  return ((jlong)first);
+}
+
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Database_ups_1db_1find_1direct(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jlong jtxnhandle, jobject jkey,
+    jint jkeyoffset, jint jkeysize, jobject jrecord, jint jrecordoffset,
+    jint jrecordcapacity, jint jflags)
+{
+  ups_status_t st;
+  ups_key_t hkey;
+  ups_record_t hrec;
+
+  SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
+
+  memset(&hkey, 0, sizeof(hkey));
+  memset(&hrec, 0, sizeof(hrec));
+
+  hkey.data = jni_buffer_address(jenv, jkey, jkeyoffset);
+  hkey.size = (uint16_t)jkeysize;
+  uint8_t *rp = jni_buffer_address(jenv, jrecord, jrecordoffset);
+  if (!hkey.data || !rp)
+    return (UPS_INV_PARAMETER);
+
+  st = ups_db_find((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
+            &hkey, &hrec, (uint32_t)jflags);
+  if (st)
+    return (st);
+
+  /* the record belongs to upscaledb; copy it to the buffer */
+  if (hrec.size > (uint32_t)jrecordcapacity)
+    return (UPS_LIMITS_REACHED);
+  if (hrec.size)
+    memcpy(rp, hrec.data, hrec.size);
+  return ((jint)hrec.size);
+}
+
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Database_ups_1db_1insert_1direct(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jlong jtxnhandle, jobject jkey,
+    jint jkeyoffset, jint jkeysize, jobject jrecord, jint jrecordoffset,
+    jint jrecordsize, jint jflags)
+{
+  ups_key_t hkey;
+  ups_record_t hrec;
+
+  SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
+
+  memset(&hkey, 0, sizeof(hkey));
+  memset(&hrec, 0, sizeof(hrec));
+
+  hkey.data = jni_buffer_address(jenv, jkey, jkeyoffset);
+  hkey.size = (uint16_t)jkeysize;
+  hrec.data = jni_buffer_address(jenv, jrecord, jrecordoffset);
+  hrec.size = (uint32_t)jrecordsize;
+  if ((jkey && !hkey.data) || !hrec.data)
+    return (UPS_INV_PARAMETER);
+
+  /* record number databases store the new record number in the key */
+  if (hkey.size && (ups_db_get_flags((ups_db_t *)jhandle)
+                      & (UPS_RECORD_NUMBER32 | UPS_RECORD_NUMBER64)))
+    hkey.flags = UPS_KEY_USER_ALLOC;
+
+  return (ups_db_insert((ups_db_t *)jhandle, (ups_txn_t *)jtxnhandle,
+            &hkey, &hrec, (uint32_t)jflags));
+}
+
 JNIEXPORT jint JNICALL
 Java_de_crupp_upscaledb_Database_ups_1db_1bulk_1operations(JNIEnv *jenv,
                 jobject jobj, jlong jhandle, jlong jtxnhandle,
                 jobjectArray joperations, jint jflags)
 {
-  std::vector<ups_operation_t> ops;
-  jbyteArray jbyteData;
-  jobject jop;
-  jfieldID fidname;
+  SET_DB_CONTEXT((ups_db_t *)jhandle, jenv, jobj);
 
   unsigned size = jenv->GetArrayLength(joperations);
-  for (unsigned i = 0; i < size; i++) {
-    ups_operation_t operation = {0};
-    jop = jenv->GetObjectArrayElement(joperations, i);
+  if (size == 0)
+    return (0);
 
-    jclass jcls = jenv->GetObjectClass(jop);
-    if (!jcls) {
-      jni_log(("GetObjectClass failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
+  /* all elements are Operation objects; look up the fields only once */
+  jclass jcls = jenv->FindClass("de/crupp/upscaledb/Operation");
+  if (!jcls) {
+    jni_log(("FindClass failed\n"));
+    return (UPS_INTERNAL_ERROR);
+  }
+  jfieldID fidtype = jenv->GetFieldID(jcls, "type", "I");
+  jfieldID fidflags = jenv->GetFieldID(jcls, "flags", "I");
+  jfieldID fidkey = jenv->GetFieldID(jcls, "key", "[B");
+  jfieldID fidrecord = jenv->GetFieldID(jcls, "record", "[B");
+  jfieldID fidresult = jenv->GetFieldID(jcls, "result", "I");
+  if (!fidtype || !fidflags || !fidkey || !fidrecord || !fidresult) {
+    jni_log(("GetFieldID failed\n"));
+    return (UPS_INTERNAL_ERROR);
+  }
 
-    // ups_operation_t::type
-    fidname = jenv->GetFieldID(jcls, "type", "I");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-    operation.type = jenv->GetIntField(jop, fidname);
+  /* the Operation objects are updated with the results */
+  if (jenv->EnsureLocalCapacity(size + 2) != 0)
+    return (UPS_OUT_OF_MEMORY);
 
-    // ups_operation_t::flags
-    fidname = jenv->GetFieldID(jcls, "flags", "I");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-    operation.flags = jenv->GetIntField(jop, fidname);
+  std::vector<ups_operation_t> ops(size);
+  std::vector<jobject> jops(size);
+  /* the offsets of the copies; (size_t)-1 if there is no array */
+  std::vector<size_t> keyoffsets(size, (size_t)-1);
+  std::vector<size_t> recoffsets(size, (size_t)-1);
+  std::vector<uint8_t> data;
 
-    // ups_operation_t::key
-    fidname = jenv->GetFieldID(jcls, "key", "[B");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-    jbyteData = (jbyteArray)jenv->GetObjectField(jop, fidname);
-    if (jbyteData) {
-      operation.key.size = (uint16_t)jenv->GetArrayLength(jbyteData);
-      operation.key.data = (uint8_t *)jenv->GetByteArrayElements(jbyteData, 0);
-    }
-
-    // ups_operation_t::record
-    fidname = jenv->GetFieldID(jcls, "record", "[B");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
+  /* copy all keys and records into one buffer */
+  for (unsigned i = 0; i < size; i++) {
+    memset(&ops[i], 0, sizeof(ops[i]));
+    jops[i] = jenv->GetObjectArrayElement(joperations, i);
+    ops[i].type = jenv->GetIntField(jops[i], fidtype);
+    ops[i].flags = jenv->GetIntField(jops[i], fidflags);
+    jbyteArray jkey = (jbyteArray)jenv->GetObjectField(jops[i], fidkey);
+    if (jkey) {
+      ops[i].key.size = (uint16_t)jenv->GetArrayLength(jkey);
+      keyoffsets[i] = jni_copy_array(jenv, jkey, data);
+      jenv->DeleteLocalRef(jkey);
     }
-    jbyteData = (jbyteArray)jenv->GetObjectField(jop, fidname);
-    if (jbyteData) {
-      operation.record.size = (uint16_t)jenv->GetArrayLength(jbyteData);
-      operation.record.data = (uint8_t *)jenv->GetByteArrayElements(jbyteData, 0);
+    jbyteArray jrec = (jbyteArray)jenv->GetObjectField(jops[i], fidrecord);
+    if (jrec) {
+      ops[i].record.size = (uint32_t)jenv->GetArrayLength(jrec);
+      recoffsets[i] = jni_copy_array(jenv, jrec, data);
+      jenv->DeleteLocalRef(jrec);
     }
-
-    ops.push_back(operation);
+  }
+  /* the buffer is no longer resized; now the pointers are stable */
+  for (unsigned i = 0; !data.empty() && i < size; i++) {
+    if (keyoffsets[i] != (size_t)-1)
+      ops[i].key.data = &data[keyoffsets[i]];
+    if (recoffsets[i] != (size_t)-1)
+      ops[i].record.data = &data[recoffsets[i]];
   }
 
   ups_status_t st = ups_db_bulk_operations((ups_db_t *)jhandle,
                   (ups_txn_t *)jtxnhandle, ops.data(), ops.size(), 0);
-  if (st)
-    return (st);
 
   bool is_record_number_db = (ups_db_get_flags((ups_db_t *)jhandle)
                                 & (UPS_RECORD_NUMBER32 | UPS_RECORD_NUMBER64))
                              != 0;
 
   ups_operation_t *pop = &ops[0];
-  for (unsigned i = 0; i < size; i++, pop++) {
-    jop = jenv->GetObjectArrayElement(joperations, i);
-
+  for (unsigned i = 0; st == 0 && i < size; i++, pop++) {
     bool copy_key = false;
     bool copy_record = false;
 
@@ -660,52 +984,35 @@ Java_de_crupp_upscaledb_Database_ups_1db_1bulk_1operations(JNIEnv *jenv,
       copy_record = true;
     }
 
-    jclass jcls = jenv->GetObjectClass(jop);
-    if (!jcls) {
-      jni_log(("GetObjectClass failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-
     // ups_operation_t::key
-    fidname = jenv->GetFieldID(jcls, "key", "[B");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-    jbyteData = (jbyteArray)jenv->GetObjectField(jop, fidname);
     if (copy_key) {
-      jbyteData = jenv->NewByteArray(pop->key.size);
+      jbyteArray jbyteData = jenv->NewByteArray(pop->key.size);
       if (pop->key.size)
         jenv->SetByteArrayRegion(jbyteData, 0, pop->key.size,
                         (jbyte *)pop->key.data);
-      jenv->SetObjectField(jop, fidname, jbyteData);
+      jenv->SetObjectField(jops[i], fidkey, jbyteData);
+      jenv->DeleteLocalRef(jbyteData);
     }
 
     // ups_operation_t::record
-    fidname = jenv->GetFieldID(jcls, "record", "[B");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-    jbyteData = (jbyteArray)jenv->GetObjectField(jop, fidname);
     if (copy_record) {
-      jbyteData = jenv->NewByteArray(pop->record.size);
+      jbyteArray jbyteData = jenv->NewByteArray(pop->record.size);
       if (pop->record.size)
         jenv->SetByteArrayRegion(jbyteData, 0, pop->record.size,
                         (jbyte *)pop->record.data);
-      jenv->SetObjectField(jop, fidname, jbyteData);
+      jenv->SetObjectField(jops[i], fidrecord, jbyteData);
+      jenv->DeleteLocalRef(jbyteData);
     }
 
     // ups_operation_t::result
-    fidname = jenv->GetFieldID(jcls, "result", "I");
-    if (!fidname) {
-      jni_log(("GetFieldID failed\n"));
-      return (UPS_INTERNAL_ERROR);
-    }
-    jenv->SetIntField(jop, fidname, pop->result);
+    jenv->SetIntField(jops[i], fidresult, pop->result);
   }
 
-  return 0;
+  for (unsigned i = 0; i < size; i++)
+    jenv->DeleteLocalRef(jops[i]);
+  jenv->DeleteLocalRef(jcls);
+
+  return (st);
 }
 
 JNIEXPORT jint JNICALL
@@ -759,6 +1066,173 @@ Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1to(JNIEnv *jenv,
         (uint32_t)jflags));
 }
 
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1batch(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jobjectArray jkeys, jobjectArray jrecords,
+    jint jflags)
+{
+  ups_status_t st;
+  uint32_t count = 0;
+  jbyteArray jdata;
+  jnipriv p;
+
+  st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
+  if (st) {
+    jni_throw_error(jenv, st);
+    return (0);
+  }
+
+  unsigned max = jenv->GetArrayLength(jkeys);
+  std::vector<ups_key_t> keys(max);
+  std::vector<ups_record_t> records(jrecords ? max : 0);
+  for (unsigned i = 0; i < max; i++) {
+    memset(&keys[i], 0, sizeof(ups_key_t));
+    if (jrecords)
+      memset(&records[i], 0, sizeof(ups_record_t));
+  }
+
+  st = ups_cursor_move_batch((ups_cursor_t *)jhandle, &keys[0],
+            jrecords ? &records[0] : 0, max, &count, (uint32_t)jflags);
+  if (st == UPS_KEY_NOT_FOUND)
+    return (0);
+  if (st) {
+    jni_throw_error(jenv, st);
+    return (0);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    jdata = jenv->NewByteArray(keys[i].size);
+    if (keys[i].size)
+      jenv->SetByteArrayRegion(jdata, 0, keys[i].size, (jbyte *)keys[i].data);
+    jenv->SetObjectArrayElement(jkeys, i, jdata);
+    jenv->DeleteLocalRef(jdata);
+
+    if (!jrecords)
+      continue;
+    jdata = jenv->NewByteArray(records[i].size);
+    if (records[i].size)
+      jenv->SetByteArrayRegion(jdata, 0, records[i].size,
+                      (jbyte *)records[i].data);
+    jenv->SetObjectArrayElement(jrecords, i, jdata);
+    jenv->DeleteLocalRef(jdata);
+  }
+
+  return ((jint)count);
+}
+
+JNIEXPORT jlong JNICALL
+Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1direct(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jobject jkey, jint jkeyoffset,
+    jint jkeycapacity, jobject jrecord, jint jrecordoffset,
+    jint jrecordcapacity, jint jflags)
+{
+  ups_status_t st;
+  ups_key_t key;
+  ups_record_t rec;
+  jnipriv p;
+
+  st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
+  if (st)
+    return (st);
+
+  uint8_t *kp = jni_buffer_address(jenv, jkey, jkeyoffset);
+  uint8_t *rp = jni_buffer_address(jenv, jrecord, jrecordoffset);
+  if ((jkey && !kp) || (jrecord && !rp))
+    return (UPS_INV_PARAMETER);
+
+  memset(&key, 0, sizeof(key));
+  memset(&rec, 0, sizeof(rec));
+  st = ups_cursor_move((ups_cursor_t *)jhandle, kp ? &key : 0,
+                  rp ? &rec : 0, (uint32_t)jflags);
+  if (st)
+    return (st);
+
+  /* the Cursor was moved even if the buffers are too small */
+  if ((kp && key.size > (uint32_t)jkeycapacity)
+      || (rp && rec.size > (uint32_t)jrecordcapacity))
+    return (UPS_LIMITS_REACHED);
+  if (key.size)
+    memcpy(kp, key.data, key.size);
+  if (rec.size)
+    memcpy(rp, rec.data, rec.size);
+
+  /* the key size in the upper, the record size in the lower 32 bits */
+  return (((jlong)key.size << 32) | (jlong)rec.size);
+}
+
+JNIEXPORT jlong JNICALL
+Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1batch_1direct(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jobject jbuffer, jint joffset,
+    jint jcapacity, jint jflags)
+{
+  ups_status_t st;
+  ups_key_t key;
+  ups_record_t rec;
+  jnipriv p;
+
+  st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
+  if (st)
+    return (st);
+
+  uint8_t *base = jni_buffer_address(jenv, jbuffer, joffset);
+  if (!base)
+    return (UPS_INV_PARAMETER);
+
+  /* all moves after the first one continue in the same direction; if an
+   * item does not fit then the Cursor steps back to the previous item */
+  const uint32_t directions = UPS_CURSOR_FIRST | UPS_CURSOR_LAST
+                | UPS_CURSOR_NEXT | UPS_CURSOR_PREVIOUS;
+  uint32_t others = (uint32_t)jflags & ~directions;
+  bool backwards = ((uint32_t)jflags
+                    & (UPS_CURSOR_LAST | UPS_CURSOR_PREVIOUS)) != 0;
+  uint32_t next = (backwards ? UPS_CURSOR_PREVIOUS : UPS_CURSOR_NEXT) | others;
+  uint32_t back = (backwards ? UPS_CURSOR_NEXT : UPS_CURSOR_PREVIOUS) | others;
+
+  uint32_t flags = (uint32_t)jflags;
+  uint32_t used = 0;
+  jint count = 0;
+  while (true) {
+    memset(&key, 0, sizeof(key));
+    memset(&rec, 0, sizeof(rec));
+    st = ups_cursor_move((ups_cursor_t *)jhandle, &key, &rec, flags);
+    if (st)
+      break;
+
+    uint32_t required = 2 * sizeof(uint32_t) + key.size + rec.size;
+    if (used + required > (uint32_t)jcapacity) {
+      if (count == 0)
+        st = UPS_LIMITS_REACHED;
+      else
+        st = ups_cursor_move((ups_cursor_t *)jhandle, 0, 0, back);
+      break;
+    }
+
+    uint32_t size = key.size;
+    memcpy(base + used, &size, sizeof(size));
+    if (key.size)
+      memcpy(base + used + sizeof(size), key.data, key.size);
+    used += sizeof(size) + key.size;
+    size = rec.size;
+    memcpy(base + used, &size, sizeof(size));
+    if (rec.size)
+      memcpy(base + used + sizeof(size), rec.data, rec.size);
+    used += sizeof(size) + rec.size;
+    count++;
+
+    flags = next;
+  }
+
+  /* the end of the Database terminates the batch */
+  if (st == UPS_KEY_NOT_FOUND)
+    st = 0;
+  if (st)
+    return (st);
+
+  /* the number of items in the upper, the number of bytes in the lower
+   * 32 bits */
+  return (((jlong)count << 32) | (jlong)used);
+}
+
 JNIEXPORT jbyteArray JNICALL
 Java_de_crupp_upscaledb_Cursor_ups_1cursor_1get_1key(JNIEnv *jenv,
     jobject jobj, jlong jhandle, jint jflags)
@@ -814,19 +1288,19 @@ Java_de_crupp_upscaledb_Cursor_ups_1cursor_1overwrite(JNIEnv *jenv,
   ups_status_t st;
   ups_record_t hrec;
   jnipriv p;
+  JniByteArray record;
   memset(&hrec, 0, sizeof(hrec));
 
   st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
   if (st)
     return (st);
 
-  hrec.data = (uint8_t *)jenv->GetByteArrayElements(jrec, 0);
-  hrec.size = (uint32_t)jenv->GetArrayLength(jrec);
+  record.acquire(jenv, jrec);
+  hrec.data = record.data();
+  hrec.size = record.size();
 
   st = ups_cursor_overwrite((ups_cursor_t *)jhandle, &hrec, (uint32_t)jflags);
 
-  jenv->ReleaseByteArrayElements(jrec, (jbyte *)hrec.data, 0);
-
   return (st);
 }
 
@@ -837,19 +1311,19 @@ Java_de_crupp_upscaledb_Cursor_ups_1cursor_1find(JNIEnv *jenv, jobject jobj,
   ups_status_t st;
   ups_key_t hkey;
   jnipriv p;
+  JniByteArray key;
   memset(&hkey, 0, sizeof(hkey));
 
   st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
   if (st)
     return (st);
 
-  hkey.data = (uint8_t *)jenv->GetByteArrayElements(jkey, 0);
-  hkey.size = (uint32_t)jenv->GetArrayLength(jkey);
+  key.acquire(jenv, jkey);
+  hkey.data = key.data();
+  hkey.size = (uint16_t)key.size();
 
   st = ups_cursor_find((ups_cursor_t *)jhandle, &hkey, 0, (uint32_t)jflags);
 
-  jenv->ReleaseByteArrayElements(jkey, (jbyte *)hkey.data, 0);
-
   return (st);
 }
 
@@ -861,6 +1335,7 @@ Java_de_crupp_upscaledb_Cursor_ups_1cursor_1insert(JNIEnv *jenv, jobject jobj,
   ups_key_t hkey;
   ups_record_t hrec;
   jnipriv p;
+  JniByteArray key, record;
   memset(&hkey, 0, sizeof(hkey));
   memset(&hrec, 0, sizeof(hrec));
 
@@ -868,17 +1343,16 @@ Java_de_crupp_upscaledb_Cursor_ups_1cursor_1insert(JNIEnv *jenv, jobject jobj,
   if (st)
     return (st);
 
-  hkey.data = (uint8_t *)jenv->GetByteArrayElements(jkey, 0);
-  hkey.size = (uint32_t)jenv->GetArrayLength(jkey);
-  hrec.data = (uint8_t *)jenv->GetByteArrayElements(jrecord, 0);
-  hrec.size = (uint32_t)jenv->GetArrayLength(jrecord);
+  key.acquire(jenv, jkey);
+  record.acquire(jenv, jrecord);
+  hkey.data = key.data();
+  hkey.size = (uint16_t)key.size();
+  hrec.data = record.data();
+  hrec.size = record.size();
 
   st = ups_cursor_insert((ups_cursor_t *)jhandle, &hkey, &hrec,
                 (uint32_t)jflags);
 
-  jenv->ReleaseByteArrayElements(jkey, (jbyte *)hkey.data, 0);
-  jenv->ReleaseByteArrayElements(jrecord, (jbyte *)hrec.data, 0);
-
   return (st);
 }
 
@@ -934,6 +1408,39 @@ Java_de_crupp_upscaledb_Cursor_ups_1cursor_1get_1record_1size
   return ((jlong)size);
 }
 
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Cursor_ups_1cursor_1move_1to_1rank
+    (JNIEnv *jenv, jobject jobj, jlong jhandle, jlong jrank, jint jflags)
+{
+  jnipriv p;
+
+  ups_status_t st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
+  if (st)
+    return (st);
+
+  return (ups_cursor_move_to_rank((ups_cursor_t *)jhandle, (uint64_t)jrank,
+                          0, 0, (uint32_t)jflags));
+}
+
+JNIEXPORT jlong JNICALL
+Java_de_crupp_upscaledb_Cursor_ups_1cursor_1get_1rank
+    (JNIEnv *jenv, jobject jobj, jlong jhandle, jint jflags)
+{
+  uint64_t rank;
+  jnipriv p;
+
+  ups_status_t st = jni_set_cursor_env(&p, jenv, jobj, jhandle);
+  if (st)
+    return (st);
+
+  st = ups_cursor_get_rank((ups_cursor_t *)jhandle, &rank, (uint32_t)jflags);
+  if (st) {
+    jni_throw_error(jenv, st);
+    return (0);
+  }
+  return ((jlong)rank);
+}
+
 JNIEXPORT jint JNICALL
 Java_de_crupp_upscaledb_Cursor_ups_1cursor_1close(JNIEnv *jenv, jobject jobj,
     jlong jhandle)
@@ -1227,6 +1734,26 @@ Java_de_crupp_upscaledb_Environment_ups_1env_1flush(JNIEnv *jenv,
   return (ups_env_flush((ups_env_t *)jhandle, (uint32_t)0));
 }
 
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Environment_ups_1env_1compact(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jint jflags)
+{
+  return (ups_env_compact((ups_env_t *)jhandle, (uint32_t)jflags));
+}
+
+JNIEXPORT jint JNICALL
+Java_de_crupp_upscaledb_Environment_ups_1env_1backup(JNIEnv *jenv,
+    jobject jobj, jlong jhandle, jstring jdest_path)
+{
+  if (!jdest_path)
+    return (UPS_INV_PARAMETER);
+
+  const char *dest_path = jenv->GetStringUTFChars(jdest_path, 0);
+  ups_status_t st = ups_env_backup((ups_env_t *)jhandle, dest_path, 0);
+  jenv->ReleaseStringUTFChars(jdest_path, dest_path);
+  return (st);
+}
+
 JNIEXPORT jlong JNICALL
 Java_de_crupp_upscaledb_Environment_ups_1env_1select_1range(JNIEnv *jenv,
     jobject jobj, jlong jhandle, jstring jquery, jlong jbegin, jlong jend)
@@ -17,6 +17,8 @@
  */
 
 import de.crupp.upscaledb.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import junit.framework.TestCase;
 
 public class CursorTest extends TestCase {
@@ -188,6 +190,100 @@ public class CursorTest extends TestCase {
     }
   }
 
+  public void testMoveBatch() {
+    byte[][] keys = new byte[2][];
+    byte[][] records = new byte[2][];
+    try {
+      Cursor c = new Cursor(m_db);
+      m_db.insert(new byte[] {1}, new byte[] {0x11});
+      m_db.insert(new byte[] {2}, new byte[] {0x22});
+      m_db.insert(new byte[] {3}, new byte[] {0x33});
+      assertEquals(2, c.moveBatch(keys, records, Const.UPS_CURSOR_FIRST));
+      assertByteArrayEquals(new byte[] {1}, keys[0]);
+      assertByteArrayEquals(new byte[] {0x11}, records[0]);
+      assertByteArrayEquals(new byte[] {2}, keys[1]);
+      assertByteArrayEquals(new byte[] {0x22}, records[1]);
+      assertEquals(1, c.moveBatch(keys, null, Const.UPS_CURSOR_NEXT));
+      assertByteArrayEquals(new byte[] {3}, keys[0]);
+      assertEquals(0, c.moveBatch(keys, records, Const.UPS_CURSOR_NEXT));
+      c.close();
+    }
+    catch (DatabaseException err) {
+      fail("DatabaseException "+err.getMessage());
+    }
+  }
+
+  public void testMoveDirect() {
+    ByteBuffer key = ByteBuffer.allocateDirect(8);
+    ByteBuffer record = ByteBuffer.allocateDirect(8);
+    try {
+      Cursor c = new Cursor(m_db);
+      m_db.insert(new byte[] {1}, new byte[] {0x11, 0x12});
+      m_db.insert(new byte[] {2}, new byte[] {0x22});
+      c.move(key, record, Const.UPS_CURSOR_FIRST);
+      assertEquals(1, key.position());
+      assertEquals(2, record.position());
+      assertEquals(1, key.get(0));
+      assertEquals(0x12, record.get(1));
+      key.clear();
+      c.move(key, null, Const.UPS_CURSOR_NEXT);
+      assertEquals(2, key.get(0));
+      try {
+        c.move(key, record, Const.UPS_CURSOR_NEXT);
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_KEY_NOT_FOUND, err.getErrno());
+      }
+      c.close();
+    }
+    catch (DatabaseException err) {
+      fail("DatabaseException "+err.getMessage());
+    }
+  }
+
+  public void testMoveBatchDirect() {
+    ByteBuffer buffer = ByteBuffer.allocateDirect(22);
+    buffer.order(ByteOrder.nativeOrder());
+    try {
+      Cursor c = new Cursor(m_db);
+      m_db.insert(new byte[] {1}, new byte[] {0x11, 0x11});
+      m_db.insert(new byte[] {2}, new byte[] {0x22});
+      m_db.insert(new byte[] {3}, new byte[] {0x33});
+      // each item occupies 8 bytes plus key and record
+      assertEquals(2, c.moveBatch(buffer, Const.UPS_CURSOR_FIRST));
+      assertEquals(21, buffer.position());
+      buffer.flip();
+      assertEquals(1, buffer.getInt());
+      assertEquals(1, buffer.get());
+      assertEquals(2, buffer.getInt());
+      assertEquals(0x11, buffer.get());
+      assertEquals(0x11, buffer.get());
+      assertEquals(1, buffer.getInt());
+      assertEquals(2, buffer.get());
+      assertEquals(1, buffer.getInt());
+      assertEquals(0x22, buffer.get());
+
+      buffer.clear();
+      assertEquals(1, c.moveBatch(buffer, Const.UPS_CURSOR_NEXT));
+      assertEquals(10, buffer.position());
+      assertEquals(3, buffer.get(4));
+      assertEquals(0, c.moveBatch(buffer, Const.UPS_CURSOR_NEXT));
+
+      try {
+        c.moveBatch(ByteBuffer.allocateDirect(4), Const.UPS_CURSOR_FIRST);
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_LIMITS_REACHED, err.getErrno());
+      }
+      c.close();
+    }
+    catch (DatabaseException err) {
+      fail("DatabaseException "+err.getMessage());
+    }
+  }
+
   public void testGetKey() {
     byte[] key = new byte[10];
     key[0] = 0x13;
@@ -334,6 +430,40 @@ public class CursorTest extends TestCase {
     }
   }
 
+  public void testRank() throws Exception {
+    Parameter[] params = new Parameter[1];
+    params[0] = new Parameter(Const.UPS_PARAM_SUBTREE_COUNTS, 1);
+
+    try {
+      tearDown();
+      m_env = new Environment();
+      m_env.create("jtest.db");
+      m_db = m_env.createDatabase((short)1, Const.UPS_ENABLE_DUPLICATE_KEYS,
+                      params);
+      Cursor c = new Cursor(m_db);
+      for (byte i = 0; i < 10; i++)
+        m_db.insert(new byte[] {i}, new byte[] {i});
+      m_db.insert(new byte[] {3}, new byte[] {0x33}, Const.UPS_DUPLICATE);
+      c.moveToRank(5);
+      assertByteArrayEquals(new byte[] {4}, c.getKey());
+      assertEquals(5, c.getRank());
+      assertEquals(4, c.getRank(Const.UPS_SKIP_DUPLICATES));
+      c.moveToRank(4, Const.UPS_SKIP_DUPLICATES);
+      assertByteArrayEquals(new byte[] {4}, c.getKey());
+      try {
+        c.moveToRank(11);
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_KEY_NOT_FOUND, err.getErrno());
+      }
+      c.close();
+    }
+    catch (DatabaseException err) {
+      fail("DatabaseException " + err.getMessage());
+    }
+  }
+
   public void testSetComparator() throws Exception {
     byte[] k = new byte[5];
     byte[] r = new byte[5];
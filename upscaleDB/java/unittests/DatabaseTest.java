@@ -17,6 +17,7 @@
  */
 
 import de.crupp.upscaledb.*;
+import java.nio.ByteBuffer;
 import junit.framework.TestCase;
 
 public class DatabaseTest extends TestCase {
@@ -141,6 +142,39 @@ public class DatabaseTest extends TestCase {
     env.close();
   }
 
+  public void testBuiltinComparator() {
+    byte[] k = new byte[5];
+    byte[] r = new byte[5];
+    Environment env = new Environment();
+    Database db;
+    try {
+      env.create("jtest.db");
+      Parameter[] params = new Parameter[2];
+      params[0] = new Parameter(Const.UPS_PARAM_KEY_TYPE,
+                                Const.UPS_TYPE_CUSTOM);
+      params[1] = new Parameter(Const.UPS_PARAM_CUSTOM_COMPARE_NAME,
+                                Const.UPS_COMPARE_MEMCMP_REVERSE);
+      db = env.createDatabase((short)1, 0, params);
+      db.insert(k, r);
+      k[0] = 1;
+      db.insert(k, r);
+      k[0] = 2;
+      db.insert(k, r);
+      Cursor c = new Cursor(db);
+      c.moveFirst();
+      assertEquals(2, c.getKey()[0]);
+      c.moveLast();
+      assertEquals(0, c.getKey()[0]);
+      c.close();
+      db.close();
+    }
+    catch (DatabaseException err) {
+      env.close();
+      fail("Exception " + err);
+    }
+    env.close();
+  }
+
   public void testGetParameters() {
     byte[] k = new byte[5];
     byte[] r = new byte[5];
@@ -195,6 +229,92 @@ public class DatabaseTest extends TestCase {
     env.close();
   }
 
+  public void testFindMany() {
+    byte[][] keys = new byte[][] {
+      new byte[] {0x33}, new byte[] {0x44}, new byte[] {0x11}
+    };
+    Database db;
+    Environment env = new Environment();
+    try {
+      env.create("jtest.db");
+      db = env.createDatabase((short)1);
+      db.insert(new byte[] {0x11}, new byte[] {0x01, 0x11});
+      db.insert(new byte[] {0x22}, new byte[] {0x02, 0x22});
+      db.insert(new byte[] {0x33}, new byte[] {0x03, 0x33});
+      byte[][] records = db.findMany(keys);
+      assertEquals(3, records.length);
+      assertByteArrayEquals(new byte[] {0x03, 0x33}, records[0]);
+      assertNull(records[1]);
+      assertByteArrayEquals(new byte[] {0x01, 0x11}, records[2]);
+      assertEquals(0, db.findMany(new byte[0][]).length);
+      db.close();
+    }
+    catch (DatabaseException err) {
+      fail("Exception "+err);
+    }
+    env.close();
+  }
+
+  public void testAppendMany() {
+    Database db;
+    Environment env = new Environment();
+    try {
+      env.create("jtest.db");
+      db = env.createDatabase((short)1, Const.UPS_RECORD_NUMBER64);
+      assertEquals(1, db.appendMany(new byte[][] {
+                      new byte[] {0x01}, new byte[] {0x02, 0x22}}));
+      assertEquals(3, db.appendMany(new byte[][] {new byte[] {0x03}}));
+      assertEquals(0, db.appendMany(new byte[0][]));
+      assertEquals(3, db.getCount());
+      Cursor c = new Cursor(db);
+      c.moveFirst();
+      c.moveNext();
+      assertByteArrayEquals(new byte[] {0x02, 0x22}, c.getRecord());
+      c.close();
+      db.close();
+      db = env.createDatabase((short)2);
+      try {
+        db.appendMany(new byte[][] {new byte[] {0x01}});
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_INV_PARAMETER, err.getErrno());
+      }
+      db.close();
+    }
+    catch (DatabaseException err) {
+      fail("Exception "+err);
+    }
+    env.close();
+  }
+
+  public void testReserveRecordNumbers() {
+    Database db;
+    Environment env = new Environment();
+    try {
+      env.create("jtest.db");
+      db = env.createDatabase((short)1, Const.UPS_RECORD_NUMBER64);
+      RecnoRange r1 = db.reserveRecordNumbers(3);
+      RecnoRange r2 = db.reserveRecordNumbers(2);
+      assertEquals(1, r1.next);
+      assertEquals(4, r1.end);
+      assertEquals(4, r2.next);
+      assertEquals(6, r2.end);
+      assertEquals(4, db.appendMany(null, new byte[][] {
+                      new byte[] {0x04}, new byte[] {0x05}}, r2));
+      assertEquals(6, r2.next);
+      assertEquals(1, db.appendMany(null, new byte[][] {
+                      new byte[] {0x01}}, r1));
+      assertEquals(2, r1.next);
+      assertEquals(3, db.getCount());
+      db.close();
+    }
+    catch (DatabaseException err) {
+      fail("Exception "+err);
+    }
+    env.close();
+  }
+
   public void testBulkOperations() {
     byte[] k1 = new byte[] {0x11};
     byte[] r1 = new byte[] {0x11};
@@ -277,4 +397,59 @@ public class DatabaseTest extends TestCase {
     }
     env.close();
   }
+
+  public void testDirectBuffers() {
+    ByteBuffer key = ByteBuffer.allocateDirect(8);
+    ByteBuffer record = ByteBuffer.allocateDirect(16);
+    Database db;
+    Environment env = new Environment();
+    try {
+      env.create("jtest.db");
+      db = env.createDatabase((short)1);
+      key.put(new byte[] {0x11, 0x22}).flip();
+      record.put(new byte[] {0x01, 0x02, 0x03}).flip();
+      db.insert(key, record);
+      assertEquals(0, key.position());
+      assertByteArrayEquals(new byte[] {0x01, 0x02, 0x03},
+                      db.find(new byte[] {0x11, 0x22}));
+
+      record.clear();
+      assertEquals(3, db.find(key, record));
+      assertEquals(3, record.position());
+      record.flip();
+      byte[] r = new byte[record.remaining()];
+      record.get(r);
+      assertByteArrayEquals(new byte[] {0x01, 0x02, 0x03}, r);
+
+      try {
+        db.find(key, ByteBuffer.allocateDirect(2));
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_LIMITS_REACHED, err.getErrno());
+      }
+
+      key.clear();
+      key.put(new byte[] {0x33}).flip();
+      try {
+        db.find(key, ByteBuffer.allocateDirect(16));
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_KEY_NOT_FOUND, err.getErrno());
+      }
+
+      try {
+        db.find(ByteBuffer.allocate(2), record);
+        fail("Exception expected");
+      }
+      catch (IllegalArgumentException err) {
+      }
+      db.close();
+    }
+    catch (DatabaseException err) {
+      fail("Exception "+err);
+    }
+    env.close();
+  }
 }
@@ -187,6 +187,68 @@ public class EnvironmentTest extends TestCase {
     env.close();
   }
 
+  public void testCompactEnvironment() {
+    Environment env = new Environment();
+    byte[] rec = new byte[10];
+    try {
+      env.create("jtest.db");
+      Database db = env.createDatabase((short)13);
+      for (int i = 0; i < 1000; i++) {
+        byte[] key = new byte[4];
+        key[0] = (byte)(i >> 8);
+        key[1] = (byte)i;
+        db.insert(key, rec);
+        if ((i & 1) == 0)
+          db.erase(key);
+      }
+      env.compact();
+      env.compact(Const.UPS_COMPACT_ASYNC);
+      env.compact(Const.UPS_COMPACT_STOP);
+    }
+    catch (DatabaseException err) {
+      fail("Exception " + err);
+    }
+    env.close();
+  }
+
+  public void testBackup() {
+    Environment env = new Environment();
+    byte[] key = new byte[4];
+    byte[] rec = new byte[10];
+    try {
+      env.create("jtest.db");
+      Database db = env.createDatabase((short)13);
+      for (int i = 0; i < 100; i++) {
+        key[0] = (byte)i;
+        db.insert(key, rec);
+      }
+      env.backup("jtest-backup.db");
+      key[0] = (byte)100;
+      db.insert(key, rec);
+      env.close();
+
+      env = new Environment();
+      env.open("jtest-backup.db");
+      db = env.openDatabase((short)13);
+      for (int i = 0; i < 100; i++) {
+        key[0] = (byte)i;
+        assertEquals(10, db.find(key).length);
+      }
+      key[0] = (byte)100;
+      try {
+        db.find(key);
+        fail("Exception expected");
+      }
+      catch (DatabaseException err) {
+        assertEquals(Const.UPS_KEY_NOT_FOUND, err.getErrno());
+      }
+    }
+    catch (DatabaseException err) {
+      fail("Exception " + err);
+    }
+    env.close();
+  }
+
   public void testCreateDatabaseNegative() {
     Environment env = new Environment();
     try {
@@ -20,6 +20,7 @@
 #include <map>
 #include <Python.h>
 #include "structmember.h"
+#include "pythread.h"
 #include <ups/upscaledb_int.h>
 #include <ups/upscaledb_uqi.h>
 
@@ -52,6 +53,7 @@ typedef struct {
   PyObject *comparecb;
   PyObject *cursorlist;
   PyObject *err_type, *err_value, *err_traceback;
+  PyThread_type_lock lock;
 } UpsDatabase;
 
 /* a Cursor Object */
@@ -73,6 +75,89 @@ typedef struct {
   uqi_result_t *result;
 } UpsResult;
 
+/* a range of reserved record numbers (see reserve_record_numbers) */
+typedef struct {
+  PyObject_HEAD
+  ups_recno_range_t range;
+} UpsRecnoRange;
+
+/*
+ * Releases the GIL while upscaledb is called, and (if |db| is not null)
+ * locks the Database. Keys and records returned by upscaledb point to
+ * memory of the Database (or Cursor, or Txn) which is overwritten by the
+ * next call; therefore the lock is held till the object goes out of scope,
+ * and the results can be converted after calling restore().
+ *
+ * The Database lock is always acquired without holding the GIL, otherwise
+ * two threads could deadlock.
+ */
+class ReleaseGil {
+  public:
+    ReleaseGil(UpsDatabase *db = 0)
+      : m_lock(db ? db->lock : 0) {
+      m_state = PyEval_SaveThread();
+      if (m_lock)
+        PyThread_acquire_lock(m_lock, WAIT_LOCK);
+    }
+
+    ~ReleaseGil() {
+      restore();
+      if (m_lock)
+        PyThread_release_lock(m_lock);
+    }
+
+    /* re-acquires the GIL; the Database remains locked */
+    void restore() {
+      if (m_state) {
+        PyEval_RestoreThread(m_state);
+        m_state = 0;
+      }
+    }
+
+  private:
+    PyThreadState *m_state;
+    PyThread_type_lock m_lock;
+};
+
+/*
+ * A Python buffer (i.e. a string, a memoryview or a numpy array) which is
+ * passed to upscaledb without copying. Must be destroyed while the GIL
+ * is held.
+ */
+struct Buffer {
+  Buffer() {
+    ::memset(&view, 0, sizeof(view));
+  }
+
+  ~Buffer() {
+    if (view.obj)
+      PyBuffer_Release(&view);
+  }
+
+  Py_buffer view;
+};
+
+/* A list of buffers for the bulk functions */
+struct BufferList {
+  ~BufferList() {
+    for (size_t i = 0; i < views.size(); i++)
+      PyBuffer_Release(&views[i]);
+  }
+
+  /* Converts |obj| to a buffer; same rules as the "s*" argument format */
+  bool append(PyObject *obj, void **data, Py_ssize_t *size) {
+    Py_buffer view;
+    if (!PyArg_Parse(obj, "s*", &view))
+      return (false);
+    views.push_back(view);
+    *data = view.buf;
+    *size = view.len;
+    return (true);
+  }
+
+  std::vector<Py_buffer> views;
+};
+
 static void
 db_dealloc(UpsDatabase *self)
 {
@@ -89,6 +174,7 @@ db_dealloc(UpsDatabase *self)
     for (i = 0; i < size; i++) {
       UpsCursor *c = (UpsCursor *)PyList_GET_ITEM(self->cursorlist, i);
       if (c && c->cursor) {
+        ReleaseGil nogil;
         ups_cursor_close(c->cursor);
         c->cursor = 0;
       }
@@ -98,9 +184,16 @@ db_dealloc(UpsDatabase *self)
     self->cursorlist = 0;
   }
 
-  ups_db_close(self->db, 0);
+  {
+    ReleaseGil nogil;
+    ups_db_close(self->db, 0);
+  }
   self->db = 0;
 
+  if (self->lock)
+    PyThread_free_lock(self->lock);
+  self->lock = 0;
+
   PyObject_Del(self);
 }
 
@@ -178,8 +271,11 @@ env_create(UpsEnvironment *self, PyObject *args)
       return (0);
   }
 
-  st = ups_env_create(&self->env, filename, flags, mode, 
+  {
+    ReleaseGil nogil;
+    st = ups_env_create(&self->env, filename, flags, mode,
                   extargs ? &params[0] : 0);
+  }
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -203,7 +299,10 @@ env_open(UpsEnvironment *self, PyObject *args)
       return (0);
   }
 
-  st = ups_env_open(&self->env, filename, flags, extargs ? &params[0] : 0);
+  {
+    ReleaseGil nogil;
+    st = ups_env_open(&self->env, filename, flags, extargs ? &params[0] : 0);
+  }
   if (st)
     THROW(st);
 
@@ -216,7 +315,11 @@ env_close(UpsEnvironment *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":close"))
     return (0);
 
-  ups_status_t st = ups_env_close(self->env, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_env_close(self->env, 0);
+  }
   if (st)
     THROW(st);
   self->env = 0;
@@ -252,8 +355,11 @@ env_create_db(UpsEnvironment *self, PyObject *args)
   if (!db)
     return (0);
 
-  st = ups_env_create_db(self->env, &db->db, (uint16_t)name, flags,
+  {
+    ReleaseGil nogil;
+    st = ups_env_create_db(self->env, &db->db, (uint16_t)name, flags,
                   extargs ? &params[0] : 0);
+  }
   if (st) {
     db_dealloc(db);
     THROW(st);
@@ -299,8 +405,11 @@ env_open_db(UpsEnvironment *self, PyObject *args)
 
   ups_set_context_data(db->db, db);
 
-  st = ups_env_open_db(self->env, &db->db, (uint16_t)name, flags,
+  {
+    ReleaseGil nogil;
+    st = ups_env_open_db(self->env, &db->db, (uint16_t)name, flags,
                   extargs ? &params[0] : 0);
+  }
   if (st) {
     db_dealloc(db);
     THROW(st);
@@ -334,8 +443,11 @@ env_rename_db(UpsEnvironment *self, PyObject *args)
   if (!PyArg_ParseTuple(args, "ii|:rename_db", &oldname, &newname))
     return (0);
 
-  ups_status_t st = ups_env_rename_db(self->env,
-                  (uint16_t)oldname, (uint16_t)newname, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_env_rename_db(self->env, (uint16_t)oldname, (uint16_t)newname, 0);
+  }
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -345,11 +457,16 @@ static PyObject *
 env_erase_db(UpsEnvironment *self, PyObject *args)
 {
   uint32_t name = 0;
+  uint32_t flags = 0;
 
-  if (!PyArg_ParseTuple(args, "i|:erase_db", &name))
+  if (!PyArg_ParseTuple(args, "i|I:erase_db", &name, &flags))
     return (0);
 
-  ups_status_t st = ups_env_erase_db(self->env, (uint16_t)name, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_env_erase_db(self->env, (uint16_t)name, flags);
+  }
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -361,7 +478,47 @@ env_flush(UpsEnvironment *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":flush"))
     return (0);
 
-  ups_status_t st = ups_env_flush(self->env, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_env_flush(self->env, 0);
+  }
+  if (st)
+    THROW(st);
+  return (Py_BuildValue(""));
+}
+
+static PyObject *
+env_compact(UpsEnvironment *self, PyObject *args)
+{
+  uint32_t flags = 0;
+
+  if (!PyArg_ParseTuple(args, "|I:compact", &flags))
+    return (0);
+
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_env_compact(self->env, flags);
+  }
+  if (st)
+    THROW(st);
+  return (Py_BuildValue(""));
+}
+
+static PyObject *
+env_backup(UpsEnvironment *self, PyObject *args)
+{
+  const char *dest_path = 0;
+
+  if (!PyArg_ParseTuple(args, "s:backup", &dest_path))
+    return (0);
+
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_env_backup(self->env, dest_path, 0);
+  }
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -410,6 +567,10 @@ static PyObject *
 result_get_record_type(UpsResult *self, PyObject *args);
 static PyObject *
 result_close(UpsResult *self, PyObject *args);
+static PyObject *
+result_get_key_array(UpsResult *self, PyObject *args);
+static PyObject *
+result_get_record_array(UpsResult *self, PyObject *args);
 
 static PyMethodDef UpsResult_methods[] = {
   {"get_row_count", (PyCFunction)result_get_row_count, METH_VARARGS},
@@ -418,6 +579,8 @@ static PyMethodDef UpsResult_methods[] = {
   {"get_record", (PyCFunction)result_get_record, METH_VARARGS},
   {"get_record_type", (PyCFunction)result_get_record_type, METH_VARARGS},
   {"close", (PyCFunction)result_close, METH_VARARGS},
+  {"get_key_array", (PyCFunction)result_get_key_array, METH_VARARGS},
+  {"get_record_array", (PyCFunction)result_get_record_array, METH_VARARGS},
   {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -429,7 +592,11 @@ env_select(UpsEnvironment *self, PyObject *args)
     return (0);
 
   uqi_result_t *result;
-  ups_status_t st = uqi_select(self->env, query, &result);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = uqi_select(self->env, query, &result);
+  }
   if (st)
     THROW(st);
 
@@ -458,10 +625,14 @@ env_select_range(UpsEnvironment *self, PyObject *args)
     end = 0;
 
   uqi_result_t *result;
-  ups_status_t st = uqi_select_range(self->env, query,
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = uqi_select_range(self->env, query,
                             begin ? begin->cursor : 0,
                             end ? end->cursor : 0,
                             &result);
+  }
   if (st)
     THROW(st);
 
@@ -507,6 +678,7 @@ db_find(UpsDatabase *self, PyObject *args)
   uint32_t recno32;
   uint64_t recno64;
   UpsTransaction *txn = 0;
+  Buffer kbuf;
 
   /* recno: first object is an integer */
   if (self->flags & UPS_RECORD_NUMBER32) {
@@ -525,14 +697,22 @@ db_find(UpsDatabase *self, PyObject *args)
     key.data = &recno64;
     key.size = sizeof(recno64);
   }
-  else if (!PyArg_ParseTuple(args, "Os#:find", &txn, &key.data, &key.size))
-    return (0);
+  else {
+    if (!PyArg_ParseTuple(args, "Os*:find", &txn, &kbuf.view))
+      return (0);
+    if (kbuf.view.len > 0xffff)
+      THROW(UPS_INV_KEY_SIZE);
+    key.data = kbuf.view.buf;
+    key.size = (uint16_t)kbuf.view.len;
+  }
 
   /* check if first object is either a Transaction or None */
   if (txn == (UpsTransaction *)Py_None)
     txn = 0;
 
+  ReleaseGil nogil(self);
   ups_status_t st = ups_db_find(self->db, txn ? txn->txn : 0, &key, &record, 0);
+  nogil.restore();
   if (st) {
     if (self->err_type || self->err_value) {
       PyErr_Restore(self->err_type, self->err_value, self->err_traceback);
@@ -585,24 +765,35 @@ db_insert(UpsDatabase *self, PyObject *args)
   ups_record_t record = {0};
   uint32_t flags = 0;
   UpsTransaction *txn = 0;
+  Buffer kbuf, rbuf;
 
   /* recno: ignore the second object */
   if (self->flags & (UPS_RECORD_NUMBER32 | UPS_RECORD_NUMBER64)) {
     PyObject *temp;
-    if (!PyArg_ParseTuple(args, "OOs#|i:insert", &txn, &temp,
-                            &record.data, &record.size, &flags))
+    if (!PyArg_ParseTuple(args, "OOs*|i:insert", &txn, &temp,
+                            &rbuf.view, &flags))
       return (0);
   }
-  else if (!PyArg_ParseTuple(args, "Os#s#|i:insert", &txn, &key.data, &key.size,
-                          &record.data, &record.size, &flags))
-    return (0);
+  else {
+    if (!PyArg_ParseTuple(args, "Os*s*|i:insert", &txn, &kbuf.view,
+                            &rbuf.view, &flags))
+      return (0);
+    if (kbuf.view.len > 0xffff)
+      THROW(UPS_INV_KEY_SIZE);
+    key.data = kbuf.view.buf;
+    key.size = (uint16_t)kbuf.view.len;
+  }
+  record.data = rbuf.view.buf;
+  record.size = (uint32_t)rbuf.view.len;
 
   /* check if first object is either a Transaction or None */
   if (txn == (UpsTransaction *)Py_None)
     txn = 0;
 
+  ReleaseGil nogil(self);
   ups_status_t st = ups_db_insert(self->db, txn ? txn->txn : 0,
                   &key, &record, flags);
+  nogil.restore();
   if (st) {
     if (self->err_type || self->err_value) {
       PyErr_Restore(self->err_type, self->err_value, self->err_traceback);
@@ -623,6 +814,7 @@ db_erase(UpsDatabase *self, PyObject *args)
   uint32_t recno32;
   uint64_t recno64;
   UpsTransaction *txn;
+  Buffer kbuf;
 
   /* recno: first object is an integer */
   if (self->flags & UPS_RECORD_NUMBER32) {
@@ -641,14 +833,62 @@ db_erase(UpsDatabase *self, PyObject *args)
     key.data = &recno64;
     key.size = sizeof(recno64);
   }
-  else if (!PyArg_ParseTuple(args, "Os#:erase", &txn, &key.data, &key.size))
-    return (0);
+  else {
+    if (!PyArg_ParseTuple(args, "Os*:erase", &txn, &kbuf.view))
+      return (0);
+    if (kbuf.view.len > 0xffff)
+      THROW(UPS_INV_KEY_SIZE);
+    key.data = kbuf.view.buf;
+    key.size = (uint16_t)kbuf.view.len;
+  }
 
   /* check if first object is either a Transaction or None */
   if (txn == (UpsTransaction *)Py_None)
     txn = 0;
 
+  ReleaseGil nogil(self);
   ups_status_t st = ups_db_erase(self->db, txn ? txn->txn : 0, &key, 0);
+  nogil.restore();
+  if (st) {
+    if (self->err_type || self->err_value) {
+      PyErr_Restore(self->err_type, self->err_value, self->err_traceback);
+      self->err_type = 0;
+      self->err_value = 0;
+      self->err_traceback = 0;
+      return (0);
+    }
+    THROW(st);
+  }
+  return (Py_BuildValue(""));
+}
+
+static PyObject *
+db_erase_range(UpsDatabase *self, PyObject *args)
+{
+  ups_key_t begin = {0};
+  ups_key_t end = {0};
+  uint32_t flags = 0;
+  UpsTransaction *txn;
+  Buffer bbuf, ebuf;
+
+  if (!PyArg_ParseTuple(args, "Oz*z*|I:erase_range", &txn, &bbuf.view,
+                &ebuf.view, &flags))
+    return (0);
+  if (bbuf.view.len > 0xffff || ebuf.view.len > 0xffff)
+    THROW(UPS_INV_KEY_SIZE);
+  begin.data = bbuf.view.buf;
+  begin.size = (uint16_t)bbuf.view.len;
+  end.data = ebuf.view.buf;
+  end.size = (uint16_t)ebuf.view.len;
+
+  /* check if first object is either a Transaction or None */
+  if (txn == (UpsTransaction *)Py_None)
+    txn = 0;
+
+  ReleaseGil nogil(self);
+  ups_status_t st = ups_db_erase_range(self->db, txn ? txn->txn : 0,
+                begin.data ? &begin : 0, end.data ? &end : 0, flags);
+  nogil.restore();
   if (st) {
     if (self->err_type || self->err_value) {
       PyErr_Restore(self->err_type, self->err_value, self->err_traceback);
@@ -662,11 +902,345 @@ db_erase(UpsDatabase *self, PyObject *args)
   return (Py_BuildValue(""));
 }
 
+static PyObject *
+db_insert_many(UpsDatabase *self, PyObject *args)
+{
+  UpsTransaction *txn = 0;
+  PyObject *items = 0;
+  uint32_t flags = 0;
+  BufferList buffers;
+
+  if (!PyArg_ParseTuple(args, "OO|i:insert_many", &txn, &items, &flags))
+    return (0);
+
+  /* check if first object is either a Transaction or None */
+  if (txn == (UpsTransaction *)Py_None)
+    txn = 0;
+
+  PyObject *seq = PySequence_Fast(items,
+                  "insert_many expects a sequence of (key, record) tuples");
+  if (!seq)
+    return (0);
+
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+  std::vector<ups_operation_t> ops(count);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    void *data;
+    Py_ssize_t size;
+
+    ::memset(&ops[i], 0, sizeof(ops[i]));
+    ops[i].type = UPS_OP_INSERT;
+    ops[i].flags = flags;
+
+    if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+      Py_DECREF(seq);
+      PyErr_SetString(PyExc_TypeError,
+                  "insert_many expects a sequence of (key, record) tuples");
+      return (0);
+    }
+    PyObject *k = PyTuple_GET_ITEM(item, 0);
+    PyObject *r = PyTuple_GET_ITEM(item, 1);
+
+    /* recno: ignore the key */
+    if (!(self->flags & (UPS_RECORD_NUMBER32 | UPS_RECORD_NUMBER64))) {
+      if (!buffers.append(k, &data, &size)) {
+        Py_DECREF(seq);
+        return (0);
+      }
+      if (size > 0xffff) {
+        Py_DECREF(seq);
+        THROW(UPS_INV_KEY_SIZE);
+      }
+      ops[i].key.data = data;
+      ops[i].key.size = (uint16_t)size;
+    }
+    if (!buffers.append(r, &data, &size)) {
+      Py_DECREF(seq);
+      return (0);
+    }
+    ops[i].record.data = data;
+    ops[i].record.size = (uint32_t)size;
+  }
+
+  ups_status_t st = 0;
+  if (count > 0) {
+    ReleaseGil nogil(self);
+    st = ups_db_bulk_operations(self->db, txn ? txn->txn : 0,
+                  &ops[0], ops.size(), 0);
+    for (Py_ssize_t i = 0; st == 0 && i < count; i++)
+      st = ops[i].result;
+  }
+  Py_DECREF(seq);
+
+  if (st) {
+    if (self->err_type || self->err_value) {
+      PyErr_Restore(self->err_type, self->err_value, self->err_traceback);
+      self->err_type = 0;
+      self->err_value = 0;
+      self->err_traceback = 0;
+      return (0);
+    }
+    THROW(st);
+  }
+  return (Py_BuildValue(""));
+}
+
+static PyObject *
+db_find_many(UpsDatabase *self, PyObject *args)
+{
+  UpsTransaction *txn = 0;
+  PyObject *keys = 0;
+  uint32_t flags = 0;
+  BufferList buffers;
+
+  if (!PyArg_ParseTuple(args, "OO|i:find_many", &txn, &keys, &flags))
+    return (0);
+
+  /* check if first object is either a Transaction or None */
+  if (txn == (UpsTransaction *)Py_None)
+    txn = 0;
+
+  PyObject *seq = PySequence_Fast(keys, "find_many expects a sequence of keys");
+  if (!seq)
+    return (0);
+
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+  std::vector<ups_key_t> k(count);
+  std::vector<ups_record_t> r(count);
+  std::vector<ups_status_t> statuses(count);
+  std::vector<uint64_t> recnos(count);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    ::memset(&k[i], 0, sizeof(k[i]));
+    ::memset(&r[i], 0, sizeof(r[i]));
+
+    /* recno: the keys are integers */
+    if (self->flags & (UPS_RECORD_NUMBER32 | UPS_RECORD_NUMBER64)) {
+      if (!PyInt_Check(item)) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_TypeError, "record numbers must be integers");
+        return (0);
+      }
+      if (self->flags & UPS_RECORD_NUMBER32) {
+        *(uint32_t *)&recnos[i] = (uint32_t)PyInt_AsLong(item);
+        k[i].size = sizeof(uint32_t);
+      }
+      else {
+        recnos[i] = PyInt_AsLong(item);
+        k[i].size = sizeof(uint64_t);
+      }
+      k[i].data = &recnos[i];
+    }
+    else {
+      void *data;
+      Py_ssize_t size;
+      if (!buffers.append(item, &data, &size)) {
+        Py_DECREF(seq);
+        return (0);
+      }
+      if (size > 0xffff) {
+        Py_DECREF(seq);
+        THROW(UPS_INV_KEY_SIZE);
+      }
+      k[i].data = data;
+      k[i].size = (uint16_t)size;
+    }
+  }
+  Py_DECREF(seq);
+
+  PyObject *list = PyList_New(count);
+  if (!list || count == 0)
+    return (list);
+
+  /* the records belong to the Database; keep it locked till they
+   * are copied */
+  ReleaseGil nogil(self);
+  ups_status_t st = ups_db_find_many(self->db, txn ? txn->txn : 0,
+                  &k[0], &r[0], &statuses[0], (uint32_t)count, flags);
+  nogil.restore();
+  for (Py_ssize_t i = 0; st == 0 && i < count; i++) {
+    if (statuses[i] != 0 && statuses[i] != UPS_KEY_NOT_FOUND)
+      st = statuses[i];
+  }
+  if (st) {
+    Py_DECREF(list);
+    if (self->err_type || self->err_value) {
+      PyErr_Restore(self->err_type, self->err_value, self->err_traceback);
+      self->err_type = 0;
+      self->err_value = 0;
+      self->err_traceback = 0;
+      return (0);
+    }
+    THROW(st);
+  }
+
+  /* missing keys are returned as None */
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *item;
+    if (statuses[i] == UPS_KEY_NOT_FOUND) {
+      Py_INCREF(Py_None);
+      item = Py_None;
+    }
+    else {
+      item = PyString_FromStringAndSize((const char *)r[i].data, r[i].size);
+      if (!item) {
+        Py_DECREF(list);
+        return (0);
+      }
+    }
+    PyList_SET_ITEM(list, i, item);
+  }
+  return (list);
+}
+
+static void
+recno_range_dealloc(UpsRecnoRange *self)
+{
+  PyObject_Del(self);
+}
+
+static PyObject *
+recno_range_getattr(UpsRecnoRange *self, char *name)
+{
+  if (!strcmp(name, "next"))
+    return (PyLong_FromUnsignedLongLong(self->range.next));
+  if (!strcmp(name, "end"))
+    return (PyLong_FromUnsignedLongLong(self->range.end));
+  PyErr_SetString(PyExc_AttributeError, name);
+  return (0);
+}
+
+statichere PyTypeObject UpsRecnoRange_Type = {
+    PyObject_HEAD_INIT(NULL)
+    0,          /*ob_size*/
+    "recno_range",   /*tp_name*/
+    sizeof(UpsRecnoRange),   /*tp_basicsize*/
+    0,          /*tp_itemsize*/
+    /* methods */
+    (destructor)recno_range_dealloc, /*tp_dealloc*/
+    0,          /*tp_print*/
+    (getattrfunc)recno_range_getattr, /*tp_getattr*/
+    0,          /*tp_setattr*/
+    0,          /*tp_compare*/
+    0,          /*tp_repr*/
+    0,          /*tp_as_number*/
+    0,          /*tp_as_sequence*/
+    0,          /*tp_as_mapping*/
+    0,          /*tp_hash*/
+    0,          /*tp_call*/
+    0,          /*tp_str*/
+    0,          /*tp_getattro*/
+    0,          /*tp_setattro*/
+    0,          /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,     /* tp_flags */
+    "upscaledb range of reserved record numbers"  /* tp_doc */
+};
+
+static PyObject *
+db_reserve_record_numbers(UpsDatabase *self, PyObject *args)
+{
+  uint32_t count = 0;
+
+  if (!PyArg_ParseTuple(args, "I:reserve_record_numbers", &count))
+    return (0);
+
+  UpsRecnoRange *range = PyObject_New(UpsRecnoRange, &UpsRecnoRange_Type);
+  if (!range)
+    return (0);
+  ::memset(&range->range, 0, sizeof(range->range));
+
+  ups_status_t st;
+  {
+    ReleaseGil nogil(self);
+    st = ups_db_reserve_record_numbers(self->db, count, &range->range);
+  }
+  if (st) {
+    Py_DECREF(range);
+    THROW(st);
+  }
+  return ((PyObject *)range);
+}
+
+static PyObject *
+db_append_many(UpsDatabase *self, PyObject *args)
+{
+  UpsTransaction *txn = 0;
+  PyObject *records = 0;
+  uint32_t flags = 0;
+  UpsRecnoRange *range = 0;
+  BufferList buffers;
+
+  if (!PyArg_ParseTuple(args, "OO|iO:append_many", &txn, &records, &flags,
+                          &range))
+    return (0);
+
+  /* the optional range was returned by reserve_record_numbers */
+  if (range == (UpsRecnoRange *)Py_None)
+    range = 0;
+  if (range && range->ob_type != &UpsRecnoRange_Type) {
+    PyErr_SetString(PyExc_TypeError, "range must be a recno_range");
+    return (0);
+  }
+
+  /* check if first object is either a Transaction or None */
+  if (txn == (UpsTransaction *)Py_None)
+    txn = 0;
+
+  PyObject *seq = PySequence_Fast(records,
+                  "append_many expects a sequence of records");
+  if (!seq)
+    return (0);
+
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+  std::vector<ups_record_t> r(count);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    void *data;
+    Py_ssize_t size;
+
+    ::memset(&r[i], 0, sizeof(r[i]));
+    if (!buffers.append(PySequence_Fast_GET_ITEM(seq, i), &data, &size)) {
+      Py_DECREF(seq);
+      return (0);
+    }
+    r[i].data = data;
+    r[i].size = (uint32_t)size;
+  }
+  Py_DECREF(seq);
+
+  /* like the Java binding: 0 is never a valid record number */
+  if (count == 0)
+    return (PyLong_FromUnsignedLongLong(0));
+
+  ups_status_t st;
+  uint64_t first = 0;
+  {
+    ReleaseGil nogil(self);
+    st = ups_db_append_many(self->db, txn ? txn->txn : 0, &r[0],
+                  (uint32_t)count, range ? &range->range : 0, &first, flags);
+  }
+  if (st)
+    THROW(st);
+
+  /* the record number of the first record */
+  return (PyLong_FromUnsignedLongLong(first));
+}
+
+/*
+ * Calls the Python compare function. upscaledb calls it while the
+ * Database is locked (see ReleaseGil); the Python function therefore must
+ * not use the same Database (or its Cursors), otherwise the thread
+ * deadlocks. Releasing the lock is not an option, because the Database
+ * is in the middle of an operation.
+ */
 static int
 compare_func(ups_db_t *db,
                 const uint8_t *lhs, uint32_t lhs_length,
                 const uint8_t *rhs, uint32_t rhs_length)
 {
+  /* upscaledb is called without the GIL */
+  PyGILState_STATE gil = PyGILState_Ensure();
+
   PyObject *comparecb;
   UpsDatabase *self = (UpsDatabase *)ups_get_context_data(db, UPS_TRUE);
 
@@ -679,8 +1253,11 @@ compare_func(ups_db_t *db,
     // store callback - this will speed up the following calls
     if (self)
       self->comparecb = comparecb;
-    if (!comparecb)
-      THROW(UPS_INTERNAL_ERROR);
+    if (!comparecb) {
+      throw_exception(UPS_INTERNAL_ERROR);
+      PyGILState_Release(gil);
+      return (0);
+    }
   }
 
   PyObject *arglist, *result;
@@ -691,12 +1268,14 @@ compare_func(ups_db_t *db,
   if (!result) {
     /* save exception */
     PyErr_Fetch(&self->err_type, &self->err_value, &self->err_traceback);
+    PyGILState_Release(gil);
     return (0);
   }
 
   int i = PyInt_AsLong(result);
   //PyErr_Fetch(&self->err_type, &self->err_value, &self->err_traceback);
   Py_DECREF(result);
+  PyGILState_Release(gil);
   return (i);
 }
 
@@ -734,7 +1313,11 @@ db_close(UpsDatabase *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":close"))
     return (0);
 
-  ups_status_t st = ups_db_close(self->db, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil(self);
+    st = ups_db_close(self->db, 0);
+  }
   if (st)
     THROW(st);
   self->db = 0;
@@ -760,6 +1343,10 @@ static PyMethodDef UpsEnvironment_methods[] = {
       METH_VARARGS},
   {"flush", (PyCFunction)env_flush,
       METH_VARARGS},
+  {"compact", (PyCFunction)env_compact,
+      METH_VARARGS},
+  {"backup", (PyCFunction)env_backup,
+      METH_VARARGS},
   {"select", (PyCFunction)env_select,
       METH_VARARGS},
   {"select_range", (PyCFunction)env_select_range,
@@ -776,6 +1363,16 @@ static PyMethodDef UpsDatabase_methods[] = {
       METH_VARARGS},
   {"erase", (PyCFunction)db_erase,
       METH_VARARGS},
+  {"erase_range", (PyCFunction)db_erase_range,
+      METH_VARARGS},
+  {"insert_many", (PyCFunction)db_insert_many,
+      METH_VARARGS},
+  {"find_many", (PyCFunction)db_find_many,
+      METH_VARARGS},
+  {"append_many", (PyCFunction)db_append_many,
+      METH_VARARGS},
+  {"reserve_record_numbers", (PyCFunction)db_reserve_record_numbers,
+      METH_VARARGS},
   {"set_compare_func", (PyCFunction)db_set_compare_func,  // deprecated
       METH_VARARGS},
   {NULL}  /* Sentinel */
@@ -801,6 +1398,7 @@ env_dealloc(UpsEnvironment *self)
     for (i = 0; i < size; i++) {
       UpsDatabase *db = (UpsDatabase *)PyList_GET_ITEM(self->dblist, i);
       if (db && db->db) {
+        ReleaseGil nogil;
         ups_db_close(db->db, 0);
         db->db = 0;
       }
@@ -811,6 +1409,7 @@ env_dealloc(UpsEnvironment *self)
   }
 
   if (self->env) {
+    ReleaseGil nogil;
     ups_env_close(self->env, 0);
     self->env = 0;
   }
@@ -824,7 +1423,10 @@ cursor_dealloc(UpsCursor *self)
   if (!self->cursor)
     return;
 
-  ups_cursor_close(self->cursor);
+  {
+    ReleaseGil nogil;
+    ups_cursor_close(self->cursor);
+  }
   self->cursor = 0;
 
   PyObject_Del(self);
@@ -845,6 +1447,8 @@ cursor_erase(UpsCursor *self, PyObject *args);
 static PyObject *
 cursor_move_to(UpsCursor *self, PyObject *args);
 static PyObject *
+cursor_fetchmany(UpsCursor *self, PyObject *args);
+static PyObject *
 cursor_get_key(UpsCursor *self, PyObject *args);
 static PyObject *
 cursor_get_record(UpsCursor *self, PyObject *args);
@@ -856,6 +1460,10 @@ static PyObject *
 cursor_get_duplicate_position(UpsCursor *self, PyObject *args);
 static PyObject *
 cursor_get_record_size(UpsCursor *self, PyObject *args);
+static PyObject *
+cursor_move_to_rank(UpsCursor *self, PyObject *args);
+static PyObject *
+cursor_get_rank(UpsCursor *self, PyObject *args);
 
 static PyMethodDef UpsCursor_methods[] = {
   {"create", (PyCFunction)cursor_create, 
@@ -872,6 +1480,8 @@ static PyMethodDef UpsCursor_methods[] = {
       METH_VARARGS},
   {"move_to", (PyCFunction)cursor_move_to,
       METH_VARARGS},
+  {"fetchmany", (PyCFunction)cursor_fetchmany,
+      METH_VARARGS},
   {"get_key", (PyCFunction)cursor_get_key,
       METH_VARARGS},
   {"get_record", (PyCFunction)cursor_get_record,
@@ -884,6 +1494,10 @@ static PyMethodDef UpsCursor_methods[] = {
       METH_VARARGS},
   {"get_record_size", (PyCFunction)cursor_get_record_size,
       METH_VARARGS},
+  {"move_to_rank", (PyCFunction)cursor_move_to_rank,
+      METH_VARARGS},
+  {"get_rank", (PyCFunction)cursor_get_rank,
+      METH_VARARGS},
   {NULL}  /* Sentinel */
 };
 
@@ -918,6 +1532,16 @@ add_const(PyObject *dict, const char *name, long value)
   Py_XDECREF(v);
 }
 
+static void
+add_string_const(PyObject *dict, const char *name, const char *value)
+{
+  PyObject *v = PyBytes_FromString(value);
+  if (!v || PyDict_SetItemString(dict, name, v))
+    PyErr_Clear();
+
+  Py_XDECREF(v);
+}
+
 static PyObject *
 strerror(PyObject *self, PyObject *args)
 {
@@ -1007,7 +1631,8 @@ static PyMethodDef upscaledb_methods[] = {
   {"txn", (PyCFunction)construct_txn, METH_VARARGS, 
       "creates a new Transaction object"},
   {"register_compare", (PyCFunction)register_compare,
-      METH_VARARGS},
+      METH_VARARGS, "registers a compare function; it is called while the "
+      "Database is locked, and must not use the Database"},
   {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -1089,6 +1714,11 @@ construct_db(PyObject *self, PyObject *args)
   hdb->err_value = 0;
   hdb->err_traceback = 0;
   hdb->cursorlist = 0;
+  hdb->lock = PyThread_allocate_lock();
+  if (!hdb->lock) {
+    PyObject_Del(hdb);
+    return (PyErr_NoMemory());
+  }
 
   return ((PyObject *)hdb);
 }
@@ -1172,7 +1802,10 @@ txn_dealloc(UpsTransaction *self)
   if (!self->txn)
     return;
 
-  ups_txn_abort(self->txn, 0);
+  {
+    ReleaseGil nogil;
+    ups_txn_abort(self->txn, 0);
+  }
   self->txn = 0;
 
   PyObject_Del(self);
@@ -1186,10 +1819,13 @@ txn_begin(UpsTransaction *self, PyObject *args)
   if (!PyArg_ParseTuple(args, "O!:begin", &UpsEnvironment_Type, &env))
     return (0);
 
-  if (self->txn)
-    ups_txn_abort(self->txn, 0);
-
-  ups_status_t st = ups_txn_begin(&self->txn, env->env, 0, 0, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    if (self->txn)
+      ups_txn_abort(self->txn, 0);
+    st = ups_txn_begin(&self->txn, env->env, 0, 0, 0);
+  }
   if (st)
     THROW(st);
 
@@ -1203,7 +1839,11 @@ txn_abort(UpsTransaction *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":txn_abort"))
     return (0);
 
-  ups_status_t st = ups_txn_abort(self->txn, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_txn_abort(self->txn, 0);
+  }
   if (st)
     THROW(st);
 
@@ -1218,7 +1858,11 @@ txn_commit(UpsTransaction *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":txn_commit"))
     return (0);
 
-  ups_status_t st = ups_txn_commit(self->txn, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil;
+    st = ups_txn_commit(self->txn, 0);
+  }
   if (st)
     THROW(st);
 
@@ -1247,15 +1891,17 @@ cursor_create(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, "O!|O:create", &UpsDatabase_Type, &db, &txn))
     return (0);
 
-  if (self->cursor)
-    ups_cursor_close(self->cursor);
-
   /* check if first object is either a Transaction or None */
   if (txn && txn == (UpsTransaction *)Py_None)
     txn = 0;
 
-  ups_status_t st = ups_cursor_create(&self->cursor, db->db,
-                  txn ? txn->txn : 0, 0);
+  ups_status_t st;
+  {
+    ReleaseGil nogil(db);
+    if (self->cursor)
+      ups_cursor_close(self->cursor);
+    st = ups_cursor_create(&self->cursor, db->db, txn ? txn->txn : 0, 0);
+  }
   if (st)
     THROW(st);
 
@@ -1284,7 +1930,11 @@ cursor_clone(UpsCursor *self, PyObject *args)
   if (!c)
     return (0);
 
-  ups_status_t st = ups_cursor_clone(self->cursor, &c->cursor);
+  ups_status_t st;
+  {
+    ReleaseGil nogil(self->db);
+    st = ups_cursor_clone(self->cursor, &c->cursor);
+  }
   if (st)
     THROW(st);
 
@@ -1311,19 +1961,29 @@ cursor_insert(UpsCursor *self, PyObject *args)
   ups_key_t key = {0};
   ups_record_t record = {0};
   uint32_t flags = 0;
+  Buffer kbuf, rbuf;
 
   /* recno: ignore the first object */
   if (self->db->flags & (UPS_RECORD_NUMBER32 | UPS_RECORD_NUMBER64)) {
     PyObject *temp;
-    if (!PyArg_ParseTuple(args, "Os#|i:insert", &temp,
-              &record.data, &record.size, &flags))
+    if (!PyArg_ParseTuple(args, "Os*|i:insert", &temp, &rbuf.view, &flags))
       return (0);
   }
-  else if (!PyArg_ParseTuple(args, "s#s#|i:insert", &key.data, &key.size,
-              &record.data, &record.size, &flags))
-    return (0);
+  else {
+    if (!PyArg_ParseTuple(args, "s*s*|i:insert", &kbuf.view, &rbuf.view,
+              &flags))
+      return (0);
+    if (kbuf.view.len > 0xffff)
+      THROW(UPS_INV_KEY_SIZE);
+    key.data = kbuf.view.buf;
+    key.size = (uint16_t)kbuf.view.len;
+  }
+  record.data = rbuf.view.buf;
+  record.size = (uint32_t)rbuf.view.len;
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_insert(self->cursor, &key, &record, flags);
+  nogil.restore();
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -1336,6 +1996,7 @@ cursor_find(UpsCursor *self, PyObject *args)
   ups_record_t record = {0};
   uint32_t recno32;
   uint64_t recno64;
+  Buffer kbuf;
 
   /* recno: first object is an integer */
   if (self->db->flags & UPS_RECORD_NUMBER32) {
@@ -1354,10 +2015,18 @@ cursor_find(UpsCursor *self, PyObject *args)
     key.data = &recno64;
     key.size = sizeof(recno64);
   }
-  else if (!PyArg_ParseTuple(args, "s#:find", &key.data, &key.size))
-    return (0);
+  else {
+    if (!PyArg_ParseTuple(args, "s*:find", &kbuf.view))
+      return (0);
+    if (kbuf.view.len > 0xffff)
+      THROW(UPS_INV_KEY_SIZE);
+    key.data = kbuf.view.buf;
+    key.size = (uint16_t)kbuf.view.len;
+  }
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_find(self->cursor, &key, &record, 0);
+  nogil.restore();
   if (st)
     THROW(st);
   return (Py_BuildValue("s#", record.data, record.size));
@@ -1369,7 +2038,9 @@ cursor_erase(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":erase"))
     return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_erase(self->cursor, 0);
+  nogil.restore();
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -1383,12 +2054,71 @@ cursor_move_to(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, "i:move_to", &flags))
     return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_move(self->cursor, 0, 0, flags);
+  nogil.restore();
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
 }
 
+static PyObject *
+cursor_fetchmany(UpsCursor *self, PyObject *args)
+{
+  int max;
+  uint32_t count = 0;
+  int flags = UPS_CURSOR_NEXT;
+  UpsDatabase *db = self->db;
+
+  if (!PyArg_ParseTuple(args, "i|i:fetchmany", &max, &flags))
+    return (0);
+  if (max < 0) {
+    PyErr_SetString(PyExc_ValueError, "max must not be negative");
+    return (0);
+  }
+
+  PyObject *list = PyList_New(0);
+  if (!list || max == 0)
+    return (list);
+
+  std::vector<ups_key_t> keys(max);
+  std::vector<ups_record_t> records(max);
+  ::memset(&keys[0], 0, max * sizeof(ups_key_t));
+  ::memset(&records[0], 0, max * sizeof(ups_record_t));
+
+  ReleaseGil nogil(self->db);
+  ups_status_t st = ups_cursor_move_batch(self->cursor, &keys[0],
+                  &records[0], (uint32_t)max, &count, (uint32_t)flags);
+  nogil.restore();
+  if (st == UPS_KEY_NOT_FOUND)
+    return (list);
+  if (st) {
+    Py_DECREF(list);
+    THROW(st);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    PyObject *item;
+    /* recno: return int, otherwise string */
+    if (db->flags & UPS_RECORD_NUMBER32)
+      item = Py_BuildValue("(is#)", (int)*(uint32_t *)keys[i].data,
+                      records[i].data, records[i].size);
+    else if (db->flags & UPS_RECORD_NUMBER64)
+      item = Py_BuildValue("(is#)", (int)*(uint64_t *)keys[i].data,
+                      records[i].data, records[i].size);
+    else
+      item = Py_BuildValue("(s#s#)", keys[i].data, keys[i].size,
+                      records[i].data, records[i].size);
+    if (!item || PyList_Append(list, item)) {
+      Py_XDECREF(item);
+      Py_DECREF(list);
+      return (0);
+    }
+    Py_DECREF(item);
+  }
+  return (list);
+}
+
 static PyObject *
 cursor_get_key(UpsCursor *self, PyObject *args)
 {
@@ -1398,7 +2128,9 @@ cursor_get_key(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":get_key"))
     return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_move(self->cursor, &key, 0, 0);
+  nogil.restore();
   if (st)
     THROW(st);
 
@@ -1422,7 +2154,9 @@ cursor_get_record(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":get_record"))
     return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_move(self->cursor, 0, &record, 0);
+  nogil.restore();
   if (st)
     THROW(st);
   return (Py_BuildValue("s#", record.data, record.size));
@@ -1432,11 +2166,16 @@ static PyObject *
 cursor_overwrite(UpsCursor *self, PyObject *args)
 {
   ups_record_t record = {0};
+  Buffer rbuf;
 
-  if (!PyArg_ParseTuple(args, "s#:overwrite", &record.data, &record.size))
+  if (!PyArg_ParseTuple(args, "s*:overwrite", &rbuf.view))
     return (0);
+  record.data = rbuf.view.buf;
+  record.size = (uint32_t)rbuf.view.len;
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_overwrite(self->cursor, &record, 0);
+  nogil.restore();
   if (st)
     THROW(st);
   return (Py_BuildValue(""));
@@ -1451,7 +2190,9 @@ cursor_get_duplicate_count(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":get_duplicate_count"))
       return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_get_duplicate_count(self->cursor, &count, 0);
+  nogil.restore();
   if (st)
     THROW(st);
 
@@ -1466,7 +2207,9 @@ cursor_get_duplicate_position(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":get_duplicate_position"))
       return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_get_duplicate_position(self->cursor, &position);
+  nogil.restore();
   if (st)
     THROW(st);
 
@@ -1481,20 +2224,62 @@ cursor_get_record_size(UpsCursor *self, PyObject *args)
   if (!PyArg_ParseTuple(args, ":get_record_size"))
       return (0);
 
+  ReleaseGil nogil(self->db);
   ups_status_t st = ups_cursor_get_record_size(self->cursor, &size);
+  nogil.restore();
   if (st)
     THROW(st);
 
   return (Py_BuildValue("i", size));
 }
 
+static PyObject *
+cursor_move_to_rank(UpsCursor *self, PyObject *args)
+{
+  unsigned long long rank;
+  uint32_t flags = 0;
+
+  if (!PyArg_ParseTuple(args, "K|i:move_to_rank", &rank, &flags))
+    return (0);
+
+  ReleaseGil nogil(self->db);
+  ups_status_t st = ups_cursor_move_to_rank(self->cursor, (uint64_t)rank,
+                  0, 0, flags);
+  nogil.restore();
+  if (st)
+    THROW(st);
+  return (Py_BuildValue(""));
+}
+
+static PyObject *
+cursor_get_rank(UpsCursor *self, PyObject *args)
+{
+  uint64_t rank = 0;
+  uint32_t flags = 0;
+
+  if (!PyArg_ParseTuple(args, "|i:get_rank", &flags))
+    return (0);
+
+  ReleaseGil nogil(self->db);
+  ups_status_t st = ups_cursor_get_rank(self->cursor, &rank, flags);
+  nogil.restore();
+  if (st)
+    THROW(st);
+
+  return (PyLong_FromUnsignedLongLong(rank));
+}
+
 static PyObject *
 cursor_close(UpsCursor *self, PyObject *args)
 {
   if (!PyArg_ParseTuple(args, ":close"))
     return (0);
 
-  ups_status_t st = ups_cursor_close(self->cursor);
+  ups_status_t st;
+  {
+    ReleaseGil nogil(self->db);
+    st = ups_cursor_close(self->cursor);
+  }
   if (st)
     THROW(st);
   self->cursor = 0;
@@ -1568,6 +2353,81 @@ result_get_record_type(UpsResult *self, PyObject *args)
   return (Py_BuildValue("i", uqi_result_get_record_type(self->result)));
 }
 
+/*
+ * Returns the serialized keys or records of a result as a numpy array.
+ * numpy is imported on demand and is not required for building the module.
+ */
+static PyObject *
+result_to_array(uint32_t type, void *data, uint32_t size)
+{
+  const char *dtype;
+  switch (type) {
+    case UPS_TYPE_UINT8:
+      dtype = "uint8";
+      break;
+    case UPS_TYPE_UINT16:
+      dtype = "uint16";
+      break;
+    case UPS_TYPE_UINT32:
+      dtype = "uint32";
+      break;
+    case UPS_TYPE_UINT64:
+      dtype = "uint64";
+      break;
+    case UPS_TYPE_REAL32:
+      dtype = "float32";
+      break;
+    case UPS_TYPE_REAL64:
+      dtype = "float64";
+      break;
+    default:
+      PyErr_SetString(PyExc_TypeError,
+                      "arrays are only available for numeric types");
+      return (0);
+  }
+
+  PyObject *numpy = PyImport_ImportModule("numpy");
+  if (!numpy)
+    return (0);
+
+  /* the array is a read-only view of this string, and the result can be
+   * closed */
+  PyObject *bytes = PyString_FromStringAndSize((const char *)data, size);
+  if (!bytes) {
+    Py_DECREF(numpy);
+    return (0);
+  }
+
+  PyObject *array = PyObject_CallMethod(numpy, (char *)"frombuffer",
+                  (char *)"Os", bytes, dtype);
+  Py_DECREF(bytes);
+  Py_DECREF(numpy);
+  return (array);
+}
+
+static PyObject *
+result_get_key_array(UpsResult *self, PyObject *args)
+{
+  if (!PyArg_ParseTuple(args, ":get_key_array"))
+    return (0);
+
+  uint32_t size = 0;
+  void *data = uqi_result_get_key_data(self->result, &size);
+  return (result_to_array(uqi_result_get_key_type(self->result), data, size));
+}
+
+static PyObject *
+result_get_record_array(UpsResult *self, PyObject *args)
+{
+  if (!PyArg_ParseTuple(args, ":get_record_array"))
+    return (0);
+
+  uint32_t size = 0;
+  void *data = uqi_result_get_record_data(self->result, &size);
+  return (result_to_array(uqi_result_get_record_type(self->result),
+                          data, size));
+}
+
 static PyObject *
 result_close(UpsResult *self, PyObject *args)
 {
@@ -1582,6 +2442,10 @@ result_close(UpsResult *self, PyObject *args)
 PyMODINIT_FUNC
 initupscaledb()
 {
+  /* upscaledb is called without the GIL, and compare callbacks can be
+   * invoked from any thread */
+  PyEval_InitThreads();
+
   PyObject *m = Py_InitModule3("upscaledb", upscaledb_methods, "upscaledb");
   if (!m)
     return;
@@ -1591,6 +2455,7 @@ initupscaledb()
   UpsCursor_Type.ob_type = &PyType_Type;
   UpsTransaction_Type.ob_type = &PyType_Type;
   UpsResult_Type.ob_type = &PyType_Type;
+  UpsRecnoRange_Type.ob_type = &PyType_Type;
 
   PyObject *d = PyModule_GetDict(m);
   g_exception = PyErr_NewException((char *)"upscaledb.error", NULL, NULL);
@@ -1643,6 +2508,7 @@ initupscaledb()
   add_const(d, "UPS_DEBUG_LEVEL_FATAL", UPS_DEBUG_LEVEL_FATAL);
   add_const(d, "UPS_TXN_READ_ONLY", UPS_TXN_READ_ONLY);
   add_const(d, "UPS_TXN_TEMPORARY", UPS_TXN_TEMPORARY);
+  add_const(d, "UPS_TXN_SNAPSHOT", UPS_TXN_SNAPSHOT);
   add_const(d, "UPS_ENABLE_FSYNC", UPS_ENABLE_FSYNC);
   add_const(d, "UPS_READ_ONLY", UPS_READ_ONLY);
   add_const(d, "UPS_IN_MEMORY", UPS_IN_MEMORY);
@@ -1651,6 +2517,8 @@ initupscaledb()
   add_const(d, "UPS_RECORD_NUMBER32", UPS_RECORD_NUMBER32);
   add_const(d, "UPS_RECORD_NUMBER64", UPS_RECORD_NUMBER64);
   add_const(d, "UPS_ENABLE_DUPLICATE_KEYS", UPS_ENABLE_DUPLICATE_KEYS);
+  add_const(d, "UPS_HASH_INDEX", UPS_HASH_INDEX);
+  add_const(d, "UPS_TIME_SERIES", UPS_TIME_SERIES);
   add_const(d, "UPS_AUTO_RECOVERY", UPS_AUTO_RECOVERY);
   add_const(d, "UPS_ENABLE_TRANSACTIONS", UPS_ENABLE_TRANSACTIONS);
   add_const(d, "UPS_CACHE_UNLIMITED", UPS_CACHE_UNLIMITED);
@@ -1692,11 +2560,76 @@ initupscaledb()
   add_const(d, "UPS_PARAM_JOURNAL_COMPRESSION", UPS_PARAM_JOURNAL_COMPRESSION);
   add_const(d, "UPS_PARAM_RECORD_COMPRESSION", UPS_PARAM_RECORD_COMPRESSION);
   add_const(d, "UPS_PARAM_KEY_COMPRESSION", UPS_PARAM_KEY_COMPRESSION);
+  add_const(d, "UPS_PARAM_DUPLICATE_COMPRESSION",
+                  UPS_PARAM_DUPLICATE_COMPRESSION);
   add_const(d, "UPS_PARAM_CUSTOM_COMPARE_NAME", UPS_PARAM_CUSTOM_COMPARE_NAME);
+  add_string_const(d, "UPS_COMPARE_MEMCMP_REVERSE",
+                  UPS_COMPARE_MEMCMP_REVERSE);
+  add_string_const(d, "UPS_COMPARE_CASE_INSENSITIVE",
+                  UPS_COMPARE_CASE_INSENSITIVE);
+  add_string_const(d, "UPS_COMPARE_BIG_ENDIAN_COMPOSITE",
+                  UPS_COMPARE_BIG_ENDIAN_COMPOSITE);
+  add_const(d, "UPS_PARAM_KEY_LAYOUT", UPS_PARAM_KEY_LAYOUT);
+  add_const(d, "UPS_KEY_LAYOUT_SORTED", UPS_KEY_LAYOUT_SORTED);
+  add_const(d, "UPS_KEY_LAYOUT_EYTZINGER", UPS_KEY_LAYOUT_EYTZINGER);
+  add_const(d, "UPS_KEY_LAYOUT_BLOCKED", UPS_KEY_LAYOUT_BLOCKED);
+  add_const(d, "UPS_PARAM_LEAF_SUMMARIES", UPS_PARAM_LEAF_SUMMARIES);
+  add_const(d, "UPS_PARAM_NETWORK_PIPELINE_DEPTH",
+          UPS_PARAM_NETWORK_PIPELINE_DEPTH);
+  add_const(d, "UPS_PARAM_NETWORK_POOL_SIZE", UPS_PARAM_NETWORK_POOL_SIZE);
+  add_const(d, "UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE",
+          UPS_PARAM_NETWORK_CURSOR_BATCH_SIZE);
+  add_const(d, "UPS_PARAM_PARTITIONS", UPS_PARAM_PARTITIONS);
+  add_const(d, "UPS_PARAM_PARTITION_SCHEME", UPS_PARAM_PARTITION_SCHEME);
+  add_const(d, "UPS_PARTITION_HASH", UPS_PARTITION_HASH);
+  add_const(d, "UPS_PARTITION_RANGE", UPS_PARTITION_RANGE);
+  add_const(d, "UPS_PARAM_NETWORK_COMPRESSION", UPS_PARAM_NETWORK_COMPRESSION);
+  add_const(d, "UPS_PARAM_CACHE_HUGE_PAGES", UPS_PARAM_CACHE_HUGE_PAGES);
+  add_const(d, "UPS_HUGE_PAGES_NONE", UPS_HUGE_PAGES_NONE);
+  add_const(d, "UPS_HUGE_PAGES_2MB", UPS_HUGE_PAGES_2MB);
+  add_const(d, "UPS_HUGE_PAGES_1GB", UPS_HUGE_PAGES_1GB);
+  add_const(d, "UPS_PARAM_CACHE_NUMA_POLICY", UPS_PARAM_CACHE_NUMA_POLICY);
+  add_const(d, "UPS_NUMA_NONE", UPS_NUMA_NONE);
+  add_const(d, "UPS_NUMA_INTERLEAVE", UPS_NUMA_INTERLEAVE);
+  add_const(d, "UPS_NUMA_LOCAL", UPS_NUMA_LOCAL);
+  add_const(d, "UPS_PARAM_CACHE_WARMUP", UPS_PARAM_CACHE_WARMUP);
+  add_const(d, "UPS_PARAM_RECOVERY_THREADS", UPS_PARAM_RECOVERY_THREADS);
+  add_const(d, "UPS_PARAM_RECOVERY_TXN_POLICY", UPS_PARAM_RECOVERY_TXN_POLICY);
+  add_const(d, "UPS_RECOVERY_ABORT_TXNS", UPS_RECOVERY_ABORT_TXNS);
+  add_const(d, "UPS_RECOVERY_RESTORE_TXNS", UPS_RECOVERY_RESTORE_TXNS);
+  add_const(d, "UPS_PARAM_COMPACTION_FILL_FACTOR",
+          UPS_PARAM_COMPACTION_FILL_FACTOR);
+  add_const(d, "UPS_PARAM_COMPACTION_RATE", UPS_PARAM_COMPACTION_RATE);
+  add_const(d, "UPS_COMPACT_ASYNC", UPS_COMPACT_ASYNC);
+  add_const(d, "UPS_COMPACT_STOP", UPS_COMPACT_STOP);
+  add_const(d, "UPS_ERASE_DB_ASYNC", UPS_ERASE_DB_ASYNC);
+  add_const(d, "UPS_ERASE_RANGE_INCLUSIVE", UPS_ERASE_RANGE_INCLUSIVE);
+  add_const(d, "UPS_PARAM_BLOOM_FILTER_BITS", UPS_PARAM_BLOOM_FILTER_BITS);
+  add_const(d, "UPS_PARAM_MEMORY_INDEX", UPS_PARAM_MEMORY_INDEX);
+  add_const(d, "UPS_MEMORY_INDEX_BTREE", UPS_MEMORY_INDEX_BTREE);
+  add_const(d, "UPS_MEMORY_INDEX_ART", UPS_MEMORY_INDEX_ART);
+  add_const(d, "UPS_PARAM_SUBTREE_COUNTS", UPS_PARAM_SUBTREE_COUNTS);
+  add_const(d, "UPS_PARAM_ENCRYPTION_MODE", UPS_PARAM_ENCRYPTION_MODE);
+  add_const(d, "UPS_ENCRYPTION_CBC", UPS_ENCRYPTION_CBC);
+  add_const(d, "UPS_ENCRYPTION_XTS", UPS_ENCRYPTION_XTS);
+  add_const(d, "UPS_PARAM_CACHE_COMPRESSED_SIZE",
+                  UPS_PARAM_CACHE_COMPRESSED_SIZE);
+  add_const(d, "UPS_PARAM_CACHE_COMPRESSOR", UPS_PARAM_CACHE_COMPRESSOR);
+  add_const(d, "UPS_PARAM_JOURNAL_PREALLOCATE_SIZE",
+                  UPS_PARAM_JOURNAL_PREALLOCATE_SIZE);
+  add_const(d, "UPS_PARAM_JOURNAL_DIRECT_IO", UPS_PARAM_JOURNAL_DIRECT_IO);
+  add_const(d, "UPS_PARAM_DB_PAGE_SIZE", UPS_PARAM_DB_PAGE_SIZE);
   add_const(d, "UPS_COMPRESSOR_NONE", UPS_COMPRESSOR_NONE);
   add_const(d, "UPS_COMPRESSOR_ZLIB", UPS_COMPRESSOR_ZLIB);
   add_const(d, "UPS_COMPRESSOR_SNAPPY", UPS_COMPRESSOR_SNAPPY);
   add_const(d, "UPS_COMPRESSOR_LZF", UPS_COMPRESSOR_LZF);
+  add_const(d, "UPS_COMPRESSOR_LZ4", UPS_COMPRESSOR_LZ4);
+  add_const(d, "UPS_COMPRESSOR_ZSTD", UPS_COMPRESSOR_ZSTD);
+  add_const(d, "UPS_COMPRESSOR_PREFIX", UPS_COMPRESSOR_PREFIX);
+  add_const(d, "UPS_PARAM_RECORD_COMPRESSION_DICTIONARY",
+                  UPS_PARAM_RECORD_COMPRESSION_DICTIONARY);
+  add_const(d, "UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE",
+                  UPS_PARAM_RECORD_COMPRESSION_DICTIONARY_SIZE);
   add_const(d, "UPS_TXN_AUTO_ABORT", UPS_TXN_AUTO_ABORT);
   add_const(d, "UPS_TXN_AUTO_COMMIT", UPS_TXN_AUTO_COMMIT);
   add_const(d, "UPS_CURSOR_FIRST", UPS_CURSOR_FIRST);
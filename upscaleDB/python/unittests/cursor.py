@@ -99,6 +99,27 @@ class CursorTestCase(unittest.TestCase):
     db.close()
     env.close()
 
+  def testFetchMany(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    db.insert(None, "key1", "value1")
+    db.insert(None, "key2", "value2")
+    db.insert(None, "key3", "value3")
+    c = upscaledb.cursor(db)
+    assert [("key1", "value1"), ("key2", "value2")] \
+            == c.fetchmany(2, upscaledb.UPS_CURSOR_FIRST)
+    assert [("key3", "value3")] == c.fetchmany(2)
+    assert [] == c.fetchmany(2)
+    try:
+      c.fetchmany(-1, upscaledb.UPS_CURSOR_FIRST)
+      assert False
+    except ValueError:
+      pass
+    c.close()
+    db.close()
+    env.close()
+
   def testGetKey(self):
     env = upscaledb.env()
     env.create("test.db")
@@ -274,6 +295,11 @@ class CursorTestCase(unittest.TestCase):
       c.find()
     except TypeError:
       pass
+    try:
+      c.find("k" * 0x10000)
+      assert False
+    except upscaledb.error, (errno, string):
+      assert upscaledb.UPS_INV_KEY_SIZE  == errno
     c.close()
     db.close()
     env.close()
@@ -336,6 +362,11 @@ class CursorTestCase(unittest.TestCase):
       c.insert("key1", "value1")
     except upscaledb.error, (errno, string):
       assert upscaledb.UPS_DUPLICATE_KEY  == errno
+    try:
+      c.insert("k" * 0x10000, "value1")
+      assert False
+    except upscaledb.error, (errno, string):
+      assert upscaledb.UPS_INV_KEY_SIZE  == errno
     c.close()
     db.close()
     env.close()
@@ -417,6 +448,30 @@ class CursorTestCase(unittest.TestCase):
     db.close()
     env.close()
 
+  def testRank(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1, 0,
+            ((upscaledb.UPS_PARAM_SUBTREE_COUNTS, 1), (0, 0)))
+    for i in range(100):
+      db.insert(None, "key%03d" % i, "value%03d" % i)
+    c = upscaledb.cursor(db)
+    c.move_to_rank(42)
+    assert "key042" == c.get_key()
+    assert 42 == c.get_rank()
+    c.move_to(upscaledb.UPS_CURSOR_NEXT)
+    assert 43 == c.get_rank(upscaledb.UPS_SKIP_DUPLICATES)
+    c.move_to_rank(0)
+    assert "key000" == c.get_key()
+    try:
+      c.move_to_rank(100)
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_KEY_NOT_FOUND == errno
+    assert "key000" == c.get_key()
+    c.close()
+    db.close()
+    env.close()
+
   def testGetRecordSize(self):
     env = upscaledb.env()
     env.create("test.db")
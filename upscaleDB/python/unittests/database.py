@@ -22,6 +22,7 @@ import unittest
 import os
 import sys
 import distutils.util
+import threading
 p    = distutils.util.get_platform()
 ps   = ".%s-%s" % (p, sys.version[0:3])
 sys.path.insert(0, os.path.join('build', 'lib' + ps))
@@ -175,6 +176,45 @@ class DatabaseTestCase(unittest.TestCase):
       pass
     db.close()
 
+  def testEraseRange(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    for i in range(100):
+      db.insert(None, "key%03d" % i, "value")
+    db.erase_range(None, "key010", "key020")
+    db.erase_range(None, "key090", None)
+    db.erase_range(None, None, "key005", upscaledb.UPS_ERASE_RANGE_INCLUSIVE)
+    for i in range(100):
+      if i <= 5 or (i >= 10 and i < 20) or i >= 90:
+        try:
+          db.find(None, "key%03d" % i)
+          assert False
+        except upscaledb.error, (errno, strerror):
+          assert upscaledb.UPS_KEY_NOT_FOUND == errno
+      else:
+        assert "value" == db.find(None, "key%03d" % i)
+    db.close()
+
+  def testEraseRangeNegative(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    try:
+      db.erase_range(None, "b", "a")
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_INV_PARAMETER == errno
+    try:
+      db.erase_range(None, 5, None)
+    except TypeError:
+      pass
+    try:
+      db.erase_range(None, "a" * 0x10000, None)
+      assert False
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_INV_KEY_SIZE == errno
+    db.close()
+
   def testEraseRecno(self):
     env = upscaledb.env()
     env.create("test.db")
@@ -277,6 +317,35 @@ class DatabaseTestCase(unittest.TestCase):
     db.close()
     env.close()
 
+  def testBuiltinCompare(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1, 0, \
+          ((upscaledb.UPS_PARAM_KEY_TYPE, upscaledb.UPS_TYPE_CUSTOM),
+           (upscaledb.UPS_PARAM_CUSTOM_COMPARE_NAME,
+            upscaledb.UPS_COMPARE_MEMCMP_REVERSE),
+           (0, 0)))
+    db.insert(None, "1", "value1")
+    db.insert(None, "2", "value2")
+    db.insert(None, "3", "value3")
+    c = upscaledb.cursor(db)
+    c.move_to(upscaledb.UPS_CURSOR_FIRST)
+    assert "3" == c.get_key()
+    c.move_to(upscaledb.UPS_CURSOR_NEXT)
+    assert "2" == c.get_key()
+    c.move_to(upscaledb.UPS_CURSOR_LAST)
+    assert "1" == c.get_key()
+    c.close()
+    db.close()
+    env.close()
+
+  def testBuiltinCompareNegative(self):
+    try:
+      upscaledb.register_compare(upscaledb.UPS_COMPARE_MEMCMP_REVERSE,
+              self.callbackCompare3)
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_INV_PARAMETER == errno
+
   def testRecnoReopen(self):
     env = upscaledb.env()
     env.create("test.db")
@@ -293,5 +362,150 @@ class DatabaseTestCase(unittest.TestCase):
     db.close()
     env.close()
 
+  def testBuffers(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    db.insert(None, bytearray("key1"), memoryview("value1"))
+    db.insert(None, buffer("xxkey2", 2), bytearray("value2"))
+    assert "value1" == db.find(None, memoryview("key1"))
+    assert "value2" == db.find(None, bytearray("key2"))
+    db.erase(None, memoryview("key1"))
+    try:
+      db.find(None, "key1")
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_KEY_NOT_FOUND == errno
+    db.close()
+    env.close()
+
+  def testKeyTooLong(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    key = "k" * 0x10000
+    calls = [lambda: db.insert(None, key, "value"),
+             lambda: db.find(None, key),
+             lambda: db.erase(None, key),
+             lambda: db.insert_many(None, [(key, "value")]),
+             lambda: db.find_many(None, [key])]
+    for call in calls:
+      try:
+        call()
+        assert False
+      except upscaledb.error, (errno, strerror):
+        assert upscaledb.UPS_INV_KEY_SIZE == errno
+    db.close()
+    env.close()
+
+  def testInsertManyFindMany(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    db.insert_many(None, [("key1", "value1"), ("key2", "value2"),
+                    (bytearray("key3"), memoryview("value3"))])
+    db.insert_many(None, [])
+    assert ["value2", None, "value1", "value3"] \
+            == db.find_many(None, ["key2", "key4", "key1", "key3"])
+    assert [] == db.find_many(None, [])
+    db.close()
+    env.close()
+
+  def testInsertManyNegative(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    db.insert(None, "key2", "value")
+    try:
+      db.insert_many(None, [("key1", "value1"), ("key2", "value2")])
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_DUPLICATE_KEY == errno
+    db.insert_many(None, [("key2", "value2")], upscaledb.UPS_OVERWRITE)
+    assert "value2" == db.find(None, "key2")
+    try:
+      db.insert_many(None, ["key3"])
+    except TypeError:
+      pass
+    db.close()
+    env.close()
+
+  def testFindManyRecno(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1, upscaledb.UPS_RECORD_NUMBER64)
+    db.insert_many(None, [(None, "value1"), (None, "value2")])
+    assert ["value2", "value1", None] == db.find_many(None, [2, 1, 3])
+    db.close()
+    env.close()
+
+  def testAppendMany(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1, upscaledb.UPS_RECORD_NUMBER64)
+    assert 1 == db.append_many(None, ["value1", "value2"])
+    assert 3 == db.append_many(None, [buffer("value3")])
+    assert 0 == db.append_many(None, [])
+    assert ["value1", "value2", "value3"] == db.find_many(None, [1, 2, 3])
+    db.close()
+    db = env.create_db(2)
+    try:
+      db.append_many(None, ["value1"])
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_INV_PARAMETER == errno
+    db.close()
+    env.close()
+
+  def testReserveRecordNumbers(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1, upscaledb.UPS_RECORD_NUMBER64)
+    r1 = db.reserve_record_numbers(2)
+    r2 = db.reserve_record_numbers(10)
+    assert 1 == r1.next and 3 == r1.end
+    assert 3 == r2.next and 13 == r2.end
+    assert 3 == db.append_many(None, ["value3"], 0, r2)
+    assert 1 == db.append_many(None, ["value1", "value2"], 0, r1)
+    assert 3 == r1.next and 4 == r2.next
+    try:
+      db.append_many(None, ["value"], 0, r1)
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_LIMITS_REACHED == errno
+    try:
+      db.append_many(None, ["value"], 0, 5)
+    except TypeError:
+      pass
+    assert ["value1", "value2", "value3"] == db.find_many(None, [1, 2, 3])
+    db.close()
+    env.close()
+
+  def testThreads(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    # failed assertions in a thread do not fail the test; they are
+    # collected and raised in the main thread
+    errors = []
+    def work(n):
+      try:
+        for i in range(200):
+          key = "%d-%d" % (n, i)
+          db.insert(None, key, key)
+          assert key == db.find(None, key)
+        keys = ["%d-%d" % (n, i) for i in range(200)]
+        assert keys == db.find_many(None, keys)
+      except Exception, e:
+        errors.append(e)
+    threads = [threading.Thread(target=work, args=(n,)) for n in range(4)]
+    for t in threads:
+      t.start()
+    for t in threads:
+      t.join()
+    if errors:
+      raise errors[0]
+    c = upscaledb.cursor(db)
+    assert 800 == len(c.fetchmany(1000, upscaledb.UPS_CURSOR_FIRST))
+    c.close()
+    db.close()
+    env.close()
+
 unittest.main()
 
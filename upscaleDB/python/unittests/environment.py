@@ -247,6 +247,23 @@ class EnvironmentTestCase(unittest.TestCase):
       assert upscaledb.UPS_DATABASE_NOT_FOUND == errno
     env.close()
 
+  def testEraseDbAsync(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    for i in range(1000):
+      db.insert(None, "key%05d" % i, "value")
+    db.close()
+    env.erase_db(1, upscaledb.UPS_ERASE_DB_ASYNC)
+    # the name can be reused immediately
+    db = env.create_db(1)
+    try:
+      db.find(None, "key00001")
+    except upscaledb.error, (errno, message):
+      assert upscaledb.UPS_KEY_NOT_FOUND == errno
+    db.close()
+    env.close()
+
   def testEraseDbNegative(self):
     env = upscaledb.env()
     env.create("test.db")
@@ -297,5 +314,62 @@ class EnvironmentTestCase(unittest.TestCase):
     env.create("test.db")
     env.flush()
 
+  def testCompact(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    for i in range(1000):
+      db.insert(None, "key%05d" % i, "value")
+    for i in range(0, 1000, 2):
+      db.erase(None, "key%05d" % i)
+    env.compact()
+    env.compact(upscaledb.UPS_COMPACT_ASYNC)
+    env.compact(upscaledb.UPS_COMPACT_STOP)
+    for i in range(1, 1000, 2):
+      assert "value" == db.find(None, "key%05d" % i)
+    db.close()
+    env.close()
+
+  def testCompactNegative(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    try:
+      env.compact(upscaledb.UPS_COMPACT_ASYNC | upscaledb.UPS_COMPACT_STOP)
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_INV_PARAMETER == errno
+    env.close()
+
+  def testBackup(self):
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    for i in range(100):
+      db.insert(None, "key%05d" % i, "value")
+    env.backup("test-backup.db")
+    db.insert(None, "key00100", "value")
+    db.close()
+    env.close()
+
+    env = upscaledb.env()
+    env.open("test-backup.db")
+    db = env.open_db(1)
+    for i in range(100):
+      assert "value" == db.find(None, "key%05d" % i)
+    try:
+      db.find(None, "key00100")
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_KEY_NOT_FOUND == errno
+    db.close()
+    env.close()
+
+  def testBackupNegative(self):
+    env = upscaledb.env()
+    env.create(None, upscaledb.UPS_IN_MEMORY)
+    try:
+      env.backup("test-backup.db")
+    except upscaledb.error, (errno, strerror):
+      assert upscaledb.UPS_INV_PARAMETER == errno
+    env.close()
+
 unittest.main()
 
@@ -47,6 +47,25 @@ class UqiTestCase(unittest.TestCase):
     db.close()
     env.close()
 
+  def testRecordArray(self):
+    try:
+      import numpy
+    except ImportError:
+      return
+    env = upscaledb.env()
+    env.create("test.db")
+    db = env.create_db(1)
+    db.insert(None, "1", "value")
+    db.insert(None, "2", "value")
+    db.insert(None, "3", "value")
+    result = env.select("COUNT($key) FROM DATABASE 1")
+    array = result.get_record_array()
+    assert array.dtype == numpy.uint64
+    assert list(array) == [3]
+    result.close()
+    db.close()
+    env.close()
+
 
 unittest.main()
 
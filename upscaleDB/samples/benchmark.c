@@ -0,0 +1,1000 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ * All Rights Reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * See the file COPYING for License information.
+ */
+
+/**
+ * The standard benchmark suite ("make bench").
+ *
+ * Runs a set of workloads on a fresh Environment each, and prints one line
+ * per workload with the configuration and the results as "name=value"
+ * pairs, i.e.
+ *
+ *   workload=ycsb-a key=uint64 page_size=16384 ... ops_per_sec=812345 ...
+ *
+ * The workloads are:
+ *
+ *   insert-seq     inserts the keys in ascending order
+ *   insert-random  inserts the keys in random order
+ *   find-random    looks up random keys (uniform distribution)
+ *   scan           scans the full Database with a Cursor
+ *   ycsb-a         50% reads, 50% updates (zipfian)
+ *   ycsb-b         95% reads, 5% updates (zipfian)
+ *   ycsb-c         100% reads (zipfian)
+ *   ycsb-d         95% reads of the latest keys, 5% inserts
+ *   ycsb-e         95% short range scans, 5% inserts (zipfian)
+ *   ycsb-f         50% reads, 50% read-modify-writes (zipfian)
+ *   uqi-sum        SUM($record) over the full Database (uint64 records)
+ *   duplicates     inserts 100 duplicates per key
+ *   append         appends batches of records to a Record Number Database;
+ *                  with --threads, each thread reserves its own ranges of
+ *                  record numbers
+ *
+ * With --baseline=FILE, the results are compared to an earlier output
+ * with the same configuration; the program returns 1 if the throughput of
+ * any workload dropped by more than --tolerance percent.
+ *
+ * Run "benchmark --help" for all options.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h> /* for exit() */
+#include <getopt.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+#include <ups/upscaledb.h>
+#include <ups/upscaledb_int.h>
+#include <ups/upscaledb_uqi.h>
+
+#define DATABASE_NAME   1
+#define MAX_THREADS     64
+#define MAX_RESULTS     64
+#define MAX_SCAN_LENGTH 100
+#define DUPLICATES      100
+#define APPEND_BATCH    64
+#define APPEND_RANGE    (64 * APPEND_BATCH)
+
+/* the latency histograms of upscaledb (all values in nanoseconds) */
+typedef ups_latency_histogram_t histogram_t;
+
+typedef enum {
+  KEY_UINT32,
+  KEY_UINT64,
+  KEY_BINARY
+} key_type_t;
+
+static const char *key_type_names[] = {"uint32", "uint64", "binary"};
+
+typedef struct {
+  const char *workloads;
+  uint64_t records;
+  uint64_t operations;
+  uint32_t page_size;
+  uint64_t cache_size;
+  uint64_t compressed_cache_size;
+  key_type_t key_type;
+  uint32_t record_size;
+  const char *compressor;
+  int use_transactions;
+  int in_memory;
+  int threads;
+  const char *output;
+  const char *baseline;
+  double tolerance;
+} config_t;
+
+/* the zipfian generator of YCSB (Gray et al., "Quickly generating
+ * billion-record synthetic databases") */
+typedef struct {
+  uint64_t items;
+  double theta;
+  double zetan;
+  double alpha;
+  double eta;
+} zipfian_t;
+
+struct workload_t;
+
+typedef struct {
+  const struct workload_t *workload;
+  const config_t *config;
+  const zipfian_t *zipfian;
+  ups_db_t *db;
+  uint64_t operations;
+  uint64_t rng;
+  volatile uint64_t *next_id;
+  uint64_t conflicts;
+  uint64_t misses;
+  histogram_t histogram;
+} thread_data_t;
+
+typedef struct workload_t {
+  const char *name;
+  /* percentage of reads, updates, inserts, scans and read-modify-writes */
+  int reads, updates, inserts, scans, rmws;
+  /* 1 for a zipfian, 0 for a uniform key distribution */
+  int zipfian;
+  /* 1 if reads prefer the latest keys */
+  int latest;
+  /* runs the whole workload; NULL for the operation mixes */
+  double (*run)(const config_t *, ups_db_t *, histogram_t *, uint64_t *);
+} workload_t;
+
+typedef struct {
+  char config[512];
+  double ops_per_sec;
+} result_t;
+
+static result_t results[MAX_RESULTS];
+static int num_results;
+
+void
+error(const char *foo, ups_status_t st) {
+  printf("%s() returned error %d: %s\n", foo, st, ups_strerror(st));
+  exit(-1);
+}
+
+static uint64_t
+now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* xorshift64* */
+static uint64_t
+next_random(uint64_t *state) {
+  *state ^= *state >> 12;
+  *state ^= *state << 25;
+  *state ^= *state >> 27;
+  return *state * 2685821657736338717ull;
+}
+
+static double
+next_double(uint64_t *state) {
+  return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* FNV-1a; spreads the hot zipfian items over the key space */
+static uint64_t
+scramble(uint64_t value) {
+  uint64_t hash = 14695981039346656037ull;
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    hash ^= value & 0xff;
+    hash *= 1099511628211ull;
+    value >>= 8;
+  }
+  return hash;
+}
+
+static void
+zipfian_init(zipfian_t *z, uint64_t items, double theta) {
+  double zeta2 = 1.0 + pow(0.5, theta);
+  uint64_t i;
+
+  z->items = items;
+  z->theta = theta;
+  z->zetan = 0;
+  for (i = 1; i <= items; i++)
+    z->zetan += 1.0 / pow((double)i, theta);
+  z->alpha = 1.0 / (1.0 - theta);
+  z->eta = (1.0 - pow(2.0 / items, 1.0 - theta)) / (1.0 - zeta2 / z->zetan);
+}
+
+/* returns a rank; 0 is the most popular item */
+static uint64_t
+zipfian_next(const zipfian_t *z, uint64_t *rng) {
+  double u = next_double(rng);
+  double uz = u * z->zetan;
+  uint64_t rank;
+
+  if (uz < 1.0)
+    return 0;
+  if (uz < 1.0 + pow(0.5, z->theta))
+    return 1;
+  rank = (uint64_t)(z->items * pow(z->eta * u - z->eta + 1.0, z->alpha));
+  return rank < z->items ? rank : z->items - 1;
+}
+
+/* converts the id |id| to a key; keys sort in the order of their ids */
+static void
+make_key(const config_t *config, uint64_t id, ups_key_t *key, char *buffer) {
+  memset(key, 0, sizeof(*key));
+  switch (config->key_type) {
+    case KEY_UINT32:
+      *(uint32_t *)buffer = (uint32_t)id;
+      key->size = sizeof(uint32_t);
+      break;
+    case KEY_UINT64:
+      *(uint64_t *)buffer = id;
+      key->size = sizeof(uint64_t);
+      break;
+    case KEY_BINARY:
+      snprintf(buffer, 32, "%020llu", (unsigned long long)id);
+      key->size = 20;
+      break;
+  }
+  key->data = buffer;
+}
+
+/* a record with a compressible (repeating) pattern */
+static void
+make_record(const config_t *config, uint64_t id, ups_record_t *record,
+                char *buffer) {
+  uint32_t i;
+
+  for (i = 0; i < config->record_size; i++)
+    buffer[i] = (char)('a' + (id + i / 16) % 26);
+  memset(record, 0, sizeof(*record));
+  record->data = buffer;
+  record->size = config->record_size;
+}
+
+static uint32_t
+compressor_id(const char *name) {
+  static const struct {
+    const char *name;
+    uint32_t id;
+  } compressors[] = {
+    {"none", UPS_COMPRESSOR_NONE},
+    {"zlib", UPS_COMPRESSOR_ZLIB},
+    {"snappy", UPS_COMPRESSOR_SNAPPY},
+    {"lzf", UPS_COMPRESSOR_LZF},
+    {"lz4", UPS_COMPRESSOR_LZ4},
+    {"zstd", UPS_COMPRESSOR_ZSTD},
+    {0, 0}
+  };
+  int i;
+
+  for (i = 0; compressors[i].name; i++)
+    if (!strcmp(compressors[i].name, name))
+      return compressors[i].id;
+  fprintf(stderr, "unknown compressor %s\n", name);
+  exit(2);
+}
+
+static void
+open_environment(const config_t *config, ups_env_t **env, ups_db_t **db,
+                uint32_t db_flags, uint32_t record_type) {
+  uint32_t flags = 0;
+  ups_status_t st;
+  ups_parameter_t env_params[] = {
+    {UPS_PARAM_PAGE_SIZE, config->page_size},
+    {0, },
+    {0, },
+    {0, }
+  };
+  ups_parameter_t *p = &env_params[1];
+  ups_parameter_t db_params[] = {
+    {UPS_PARAM_KEY_TYPE, UPS_TYPE_BINARY},
+    {0, },
+    {0, },
+    {0, }
+  };
+  uint32_t compressor = compressor_id(config->compressor);
+
+  switch (config->key_type) {
+    case KEY_UINT32:
+      db_params[0].value = UPS_TYPE_UINT32;
+      break;
+    case KEY_UINT64:
+      db_params[0].value = UPS_TYPE_UINT64;
+      break;
+    case KEY_BINARY:
+      db_params[2].name = UPS_PARAM_KEY_SIZE;
+      db_params[2].value = 20;
+      break;
+  }
+  if (record_type) {
+    db_params[1].name = UPS_PARAM_RECORD_TYPE;
+    db_params[1].value = record_type;
+  }
+  else if (compressor != UPS_COMPRESSOR_NONE) {
+    db_params[1].name = UPS_PARAM_RECORD_COMPRESSION;
+    db_params[1].value = compressor;
+  }
+
+  /* Record Number Databases have a fixed key type */
+  if (db_flags & UPS_RECORD_NUMBER64) {
+    db_params[0] = db_params[1];
+    memset(&db_params[1], 0, sizeof(db_params[1]));
+  }
+
+  if (config->use_transactions)
+    flags |= UPS_ENABLE_TRANSACTIONS;
+  if (config->in_memory)
+    flags |= UPS_IN_MEMORY;
+  else {
+    if (config->cache_size) {
+      p->name = UPS_PARAM_CACHE_SIZE;
+      p->value = config->cache_size;
+      p++;
+    }
+    if (config->compressed_cache_size) {
+      p->name = UPS_PARAM_CACHE_COMPRESSED_SIZE;
+      p->value = config->compressed_cache_size;
+      p++;
+    }
+  }
+
+  st = ups_env_create(env, "benchmark.db", flags, 0664, &env_params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create", st);
+  st = ups_env_create_db(*env, db, DATABASE_NAME, db_flags, &db_params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create_db", st);
+}
+
+/* removes the files of open_environment() */
+static void
+remove_environment(void) {
+  remove("benchmark.db");
+  remove("benchmark.db.jrn0");
+  remove("benchmark.db.jrn1");
+}
+
+/* inserts the ids 0 .. records - 1; the order is random if |order| is
+ * not NULL */
+static double
+load(const config_t *config, ups_db_t *db, const uint32_t *order,
+                histogram_t *histogram) {
+  char key_buffer[32];
+  char *record_buffer = malloc(config->record_size + 1);
+  uint64_t start = now_ns();
+  uint64_t i;
+
+  for (i = 0; i < config->records; i++) {
+    uint64_t id = order ? order[i] : i;
+    uint64_t t = histogram ? now_ns() : 0;
+    ups_key_t key;
+    ups_record_t record;
+    ups_status_t st;
+
+    make_key(config, id, &key, key_buffer);
+    make_record(config, id, &record, record_buffer);
+    st = ups_db_insert(db, 0, &key, &record, order ? 0 : UPS_HINT_APPEND);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+    if (histogram)
+      ups_latency_histogram_add(histogram, now_ns() - t);
+  }
+
+  free(record_buffer);
+  return (now_ns() - start) / 1e9;
+}
+
+static double
+run_insert_seq(const config_t *config, ups_db_t *db, histogram_t *histogram,
+                uint64_t *operations) {
+  *operations = config->records;
+  return load(config, db, 0, histogram);
+}
+
+static double
+run_insert_random(const config_t *config, ups_db_t *db,
+                histogram_t *histogram, uint64_t *operations) {
+  uint32_t *order = malloc(config->records * sizeof(uint32_t));
+  uint64_t rng = 42;
+  uint64_t i;
+  double sec;
+
+  for (i = 0; i < config->records; i++)
+    order[i] = (uint32_t)i;
+  for (i = config->records - 1; i > 0; i--) {
+    uint64_t j = next_random(&rng) % (i + 1);
+    uint32_t tmp = order[i];
+    order[i] = order[j];
+    order[j] = tmp;
+  }
+
+  *operations = config->records;
+  sec = load(config, db, order, histogram);
+  free(order);
+  return sec;
+}
+
+static double
+run_scan(const config_t *config, ups_db_t *db, histogram_t *histogram,
+                uint64_t *operations) {
+  ups_cursor_t *cursor;
+  ups_key_t key = {0};
+  ups_record_t record = {0};
+  uint64_t start, t;
+  ups_status_t st;
+
+  load(config, db, 0, 0);
+
+  st = ups_cursor_create(&cursor, db, 0, 0);
+  if (st != UPS_SUCCESS)
+    error("ups_cursor_create", st);
+
+  *operations = 0;
+  start = t = now_ns();
+  while ((st = ups_cursor_move(cursor, &key, &record, UPS_CURSOR_NEXT))
+                  == UPS_SUCCESS) {
+    uint64_t n = now_ns();
+    ups_latency_histogram_add(histogram, n - t);
+    t = n;
+    (*operations)++;
+  }
+  if (st != UPS_KEY_NOT_FOUND)
+    error("ups_cursor_move", st);
+
+  ups_cursor_close(cursor);
+  return (now_ns() - start) / 1e9;
+}
+
+static double
+run_uqi_sum(const config_t *config, ups_db_t *db, histogram_t *histogram,
+                uint64_t *operations) {
+  char query[64];
+  char key_buffer[32];
+  uint64_t start, i;
+  ups_status_t st;
+
+  /* the records are uint64 values */
+  for (i = 0; i < config->records; i++) {
+    ups_key_t key;
+    ups_record_t record = ups_make_record(&i, sizeof(i));
+    make_key(config, i, &key, key_buffer);
+    st = ups_db_insert(db, 0, &key, &record, UPS_HINT_APPEND);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+  }
+
+  snprintf(query, sizeof(query), "SUM($record) FROM DATABASE %d",
+                  DATABASE_NAME);
+  *operations = 10;
+  start = now_ns();
+  for (i = 0; i < *operations; i++) {
+    uint64_t t = now_ns();
+    uqi_result_t *result;
+    st = uqi_select(ups_db_get_env(db), query, &result);
+    if (st != UPS_SUCCESS)
+      error("uqi_select", st);
+    uqi_result_close(result);
+    ups_latency_histogram_add(histogram, now_ns() - t);
+  }
+  return (now_ns() - start) / 1e9;
+}
+
+static double
+run_duplicates(const config_t *config, ups_db_t *db, histogram_t *histogram,
+                uint64_t *operations) {
+  char key_buffer[32];
+  char *record_buffer = malloc(config->record_size + 1);
+  uint64_t start = now_ns();
+  uint64_t i;
+
+  for (i = 0; i < config->records; i++) {
+    uint64_t t = now_ns();
+    ups_key_t key;
+    ups_record_t record;
+    ups_status_t st;
+
+    make_key(config, i / DUPLICATES, &key, key_buffer);
+    make_record(config, i, &record, record_buffer);
+    st = ups_db_insert(db, 0, &key, &record, UPS_DUPLICATE);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+    ups_latency_histogram_add(histogram, now_ns() - t);
+  }
+
+  free(record_buffer);
+  *operations = config->records;
+  return (now_ns() - start) / 1e9;
+}
+
+typedef struct {
+  const config_t *config;
+  ups_db_t *db;
+  uint64_t records;
+  histogram_t histogram;
+} append_data_t;
+
+static void *
+append_worker(void *arg) {
+  append_data_t *data = (append_data_t *)arg;
+  const config_t *config = data->config;
+  char *record_buffer = malloc(config->record_size + 1);
+  ups_record_t records[APPEND_BATCH];
+  ups_recno_range_t range = {0};
+  /* a single thread appends with the counter of the Database */
+  ups_recno_range_t *prange = config->threads > 1 ? &range : 0;
+  uint64_t i;
+  int n;
+
+  make_record(config, 0, &records[0], record_buffer);
+  for (n = 1; n < APPEND_BATCH; n++)
+    records[n] = records[0];
+
+  for (i = 0; i < data->records; ) {
+    uint32_t count = data->records - i < APPEND_BATCH
+                        ? (uint32_t)(data->records - i)
+                        : APPEND_BATCH;
+    uint64_t t;
+    ups_status_t st;
+
+    /* the remaining numbers of an exhausted range are left as gaps */
+    if (prange && range.next + count > range.end) {
+      st = ups_db_reserve_record_numbers(data->db, APPEND_RANGE, &range);
+      if (st != UPS_SUCCESS)
+        error("ups_db_reserve_record_numbers", st);
+    }
+
+    t = now_ns();
+    st = ups_db_append_many(data->db, 0, records, count, prange, 0, 0);
+    if (st != UPS_SUCCESS)
+      error("ups_db_append_many", st);
+    /* the latency per record */
+    ups_latency_histogram_add(&data->histogram, (now_ns() - t) / count);
+    i += count;
+  }
+
+  free(record_buffer);
+  return 0;
+}
+
+static double
+run_append(const config_t *config, ups_db_t *db, histogram_t *histogram,
+                uint64_t *operations) {
+  static append_data_t data[MAX_THREADS];
+  pthread_t tids[MAX_THREADS];
+  uint64_t start = now_ns();
+  int t;
+
+  for (t = 0; t < config->threads; t++) {
+    memset(&data[t], 0, sizeof(data[t]));
+    data[t].config = config;
+    data[t].db = db;
+    data[t].records = config->records / config->threads;
+    pthread_create(&tids[t], 0, append_worker, &data[t]);
+  }
+
+  *operations = 0;
+  for (t = 0; t < config->threads; t++) {
+    pthread_join(tids[t], 0);
+    ups_latency_histogram_merge(histogram, &data[t].histogram);
+    *operations += data[t].records;
+  }
+  return (now_ns() - start) / 1e9;
+}
+
+static const workload_t workloads[] = {
+  /* name            reads upd ins scans rmw zipf latest run */
+  {"insert-seq",        0,  0,  0,  0,  0, 0, 0, run_insert_seq},
+  {"insert-random",     0,  0,  0,  0,  0, 0, 0, run_insert_random},
+  {"find-random",     100,  0,  0,  0,  0, 0, 0, 0},
+  {"scan",              0,  0,  0,  0,  0, 0, 0, run_scan},
+  {"ycsb-a",           50, 50,  0,  0,  0, 1, 0, 0},
+  {"ycsb-b",           95,  5,  0,  0,  0, 1, 0, 0},
+  {"ycsb-c",          100,  0,  0,  0,  0, 1, 0, 0},
+  {"ycsb-d",           95,  0,  5,  0,  0, 1, 1, 0},
+  {"ycsb-e",            0,  0,  5, 95,  0, 1, 0, 0},
+  {"ycsb-f",           50,  0,  0,  0, 50, 1, 0, 0},
+  {"uqi-sum",           0,  0,  0,  0,  0, 0, 0, run_uqi_sum},
+  {"duplicates",        0,  0,  0,  0,  0, 0, 0, run_duplicates},
+  {"append",            0,  0,  0,  0,  0, 0, 0, run_append},
+  {0, }
+};
+
+/* returns the id of an existing key; with --threads, the latest id might
+ * be reserved by another thread which did not yet insert it */
+static uint64_t
+choose_id(thread_data_t *data) {
+  uint64_t max = *data->next_id;
+
+  if (data->workload->latest) {
+    uint64_t rank = zipfian_next(data->zipfian, &data->rng);
+    return rank < max ? max - 1 - rank : 0;
+  }
+  if (data->workload->zipfian)
+    return scramble(zipfian_next(data->zipfian, &data->rng))
+              % data->config->records;
+  return next_random(&data->rng) % data->config->records;
+}
+
+static void
+check(thread_data_t *data, const char *foo, ups_status_t st) {
+  /* concurrent Transactions can conflict */
+  if (st == UPS_TXN_CONFLICT)
+    data->conflicts++;
+  else if (st != UPS_SUCCESS)
+    error(foo, st);
+}
+
+static void *
+worker(void *arg) {
+  thread_data_t *data = (thread_data_t *)arg;
+  const workload_t *w = data->workload;
+  const config_t *config = data->config;
+  char key_buffer[32];
+  char *record_buffer = malloc(config->record_size + 1);
+  char *read_buffer = malloc(config->record_size + 1);
+  ups_cursor_t *cursor = 0;
+  ups_status_t st;
+  uint64_t i;
+
+  if (w->scans) {
+    st = ups_cursor_create(&cursor, data->db, 0, 0);
+    if (st != UPS_SUCCESS)
+      error("ups_cursor_create", st);
+  }
+
+  for (i = 0; i < data->operations; i++) {
+    int dice = (int)(next_random(&data->rng) % 100);
+    uint64_t t = now_ns();
+    ups_key_t key;
+    ups_record_t record;
+    /* each thread provides its own record buffer; otherwise all threads
+     * would share the buffer of the Database handle */
+    ups_record_t result = {0};
+    result.data = read_buffer;
+    result.size = config->record_size;
+    result.flags = UPS_RECORD_USER_ALLOC;
+
+    if (dice < w->reads) {
+      make_key(config, choose_id(data), &key, key_buffer);
+      st = ups_db_find(data->db, 0, &key, &result, 0);
+      if (st == UPS_KEY_NOT_FOUND && w->latest)
+        data->misses++;
+      else
+        check(data, "ups_db_find", st);
+    }
+    else if ((dice -= w->reads) < w->updates) {
+      uint64_t id = choose_id(data);
+      make_key(config, id, &key, key_buffer);
+      make_record(config, id + i, &record, record_buffer);
+      check(data, "ups_db_insert",
+                  ups_db_insert(data->db, 0, &key, &record, UPS_OVERWRITE));
+    }
+    else if ((dice -= w->updates) < w->inserts) {
+      uint64_t id = __sync_fetch_and_add(data->next_id, 1);
+      make_key(config, id, &key, key_buffer);
+      make_record(config, id, &record, record_buffer);
+      check(data, "ups_db_insert",
+                  ups_db_insert(data->db, 0, &key, &record, 0));
+    }
+    else if ((dice -= w->inserts) < w->scans) {
+      uint64_t length = 1 + next_random(&data->rng) % MAX_SCAN_LENGTH;
+      uint64_t n;
+      make_key(config, choose_id(data), &key, key_buffer);
+      st = ups_cursor_find(cursor, &key, 0, UPS_FIND_GEQ_MATCH);
+      for (n = 1; st == UPS_SUCCESS && n < length; n++)
+        st = ups_cursor_move(cursor, 0, &result, UPS_CURSOR_NEXT);
+      if (st != UPS_KEY_NOT_FOUND)
+        check(data, "ups_cursor_move", st);
+    }
+    else {
+      /* read-modify-write */
+      uint64_t id = choose_id(data);
+      make_key(config, id, &key, key_buffer);
+      st = ups_db_find(data->db, 0, &key, &result, 0);
+      if (st == UPS_SUCCESS) {
+        make_record(config, id + i, &record, record_buffer);
+        check(data, "ups_db_insert",
+                  ups_db_insert(data->db, 0, &key, &record, UPS_OVERWRITE));
+      }
+      else
+        check(data, "ups_db_find", st);
+    }
+
+    ups_latency_histogram_add(&data->histogram, now_ns() - t);
+  }
+
+  if (cursor)
+    ups_cursor_close(cursor);
+  free(record_buffer);
+  free(read_buffer);
+  return 0;
+}
+
+static double
+run_mix(const config_t *config, const workload_t *w, ups_db_t *db,
+                histogram_t *histogram, uint64_t *operations,
+                uint64_t *conflicts, uint64_t *misses) {
+  static thread_data_t data[MAX_THREADS];
+  pthread_t tids[MAX_THREADS];
+  volatile uint64_t next_id = config->records;
+  zipfian_t zipfian;
+  uint64_t start;
+  int t;
+
+  load(config, db, 0, 0);
+  zipfian_init(&zipfian, config->records, 0.99);
+
+  start = now_ns();
+  for (t = 0; t < config->threads; t++) {
+    memset(&data[t], 0, sizeof(data[t]));
+    data[t].workload = w;
+    data[t].config = config;
+    data[t].zipfian = &zipfian;
+    data[t].db = db;
+    data[t].operations = config->operations / config->threads;
+    data[t].rng = 0x9e3779b97f4a7c15ull * (t + 1);
+    data[t].next_id = &next_id;
+    pthread_create(&tids[t], 0, worker, &data[t]);
+  }
+
+  *operations = 0;
+  *conflicts = 0;
+  *misses = 0;
+  for (t = 0; t < config->threads; t++) {
+    pthread_join(tids[t], 0);
+    ups_latency_histogram_merge(histogram, &data[t].histogram);
+    *operations += data[t].operations;
+    *conflicts += data[t].conflicts;
+    *misses += data[t].misses;
+  }
+  return (now_ns() - start) / 1e9;
+}
+
+static void
+run_workload(const config_t *config, const workload_t *w, FILE *output) {
+  static histogram_t histogram;
+  ups_env_t *env;
+  ups_db_t *db;
+  uint64_t operations, conflicts = 0, misses = 0;
+  uint32_t db_flags = 0;
+  ups_status_t st;
+  result_t *result;
+  char line[1024];
+  double sec;
+
+  memset(&histogram, 0, sizeof(histogram));
+  if (w->run == run_duplicates)
+    db_flags = UPS_ENABLE_DUPLICATE_KEYS;
+  else if (w->run == run_append)
+    db_flags = UPS_RECORD_NUMBER64;
+  open_environment(config, &env, &db, db_flags,
+                  w->run == run_uqi_sum ? UPS_TYPE_UINT64 : 0);
+
+  if (w->run)
+    sec = w->run(config, db, &histogram, &operations);
+  else
+    sec = run_mix(config, w, db, &histogram, &operations, &conflicts,
+                    &misses);
+
+  st = ups_env_close(env, UPS_AUTO_CLEANUP);
+  if (st != UPS_SUCCESS)
+    error("ups_env_close", st);
+  remove_environment();
+
+  if (num_results == MAX_RESULTS) {
+    fprintf(stderr, "too many results\n");
+    exit(2);
+  }
+  result = &results[num_results++];
+  snprintf(result->config, sizeof(result->config),
+          "workload=%s key=%s page_size=%u record_size=%u compressor=%s "
+          "txn=%d inmemory=%d threads=%d records=%llu",
+          w->name, key_type_names[config->key_type], config->page_size,
+          config->record_size, config->compressor, config->use_transactions,
+          config->in_memory,
+          w->run && w->run != run_append ? 1 : config->threads,
+          (unsigned long long)config->records);
+  result->ops_per_sec = sec > 0 ? operations / sec : 0;
+
+  snprintf(line, sizeof(line),
+          "%s ops=%llu sec=%.3f ops_per_sec=%.0f p50_ns=%llu p99_ns=%llu "
+          "p999_ns=%llu conflicts=%llu misses=%llu\n",
+          result->config, (unsigned long long)operations, sec,
+          result->ops_per_sec,
+          (unsigned long long)ups_latency_histogram_percentile(&histogram,
+                  50),
+          (unsigned long long)ups_latency_histogram_percentile(&histogram,
+                  99),
+          (unsigned long long)ups_latency_histogram_percentile(&histogram,
+                  99.9),
+          (unsigned long long)conflicts, (unsigned long long)misses);
+  fputs(line, stdout);
+  fflush(stdout);
+  if (output)
+    fputs(line, output);
+}
+
+/* splits a result line into the configuration (everything before " ops=")
+ * and the throughput */
+static int
+parse_line(const char *line, char *config, size_t size, double *ops_per_sec) {
+  const char *p = strstr(line, " ops=");
+  const char *q = strstr(line, " ops_per_sec=");
+
+  if (!p || !q || (size_t)(p - line) >= size)
+    return 0;
+  memcpy(config, line, p - line);
+  config[p - line] = 0;
+  *ops_per_sec = atof(q + 13);
+  return 1;
+}
+
+/* returns the number of regressions */
+static int
+compare_baseline(const config_t *config) {
+  FILE *f = fopen(config->baseline, "r");
+  char line[1024], cfg[512];
+  double base;
+  int regressions = 0;
+  int i;
+
+  if (!f) {
+    perror(config->baseline);
+    exit(2);
+  }
+
+  while (fgets(line, sizeof(line), f)) {
+    if (!parse_line(line, cfg, sizeof(cfg), &base))
+      continue;
+    for (i = 0; i < num_results; i++) {
+      double change;
+      if (strcmp(results[i].config, cfg) || base <= 0)
+        continue;
+      change = (results[i].ops_per_sec - base) * 100.0 / base;
+      printf("%s %s: %+.1f%% (%.0f -> %.0f ops/sec)\n",
+              change < -config->tolerance ? "REGRESSION" : "ok        ",
+              cfg + strlen("workload="), change, base,
+              results[i].ops_per_sec);
+      if (change < -config->tolerance)
+        regressions++;
+    }
+  }
+
+  fclose(f);
+  return regressions;
+}
+
+static void
+usage(void) {
+  printf("usage: benchmark [options]\n"
+    "  --workload=LIST     comma-separated workloads, or \"all\" (default)\n"
+    "  --records=N         number of records (default 1000000)\n"
+    "  --operations=N      operations of the mixed workloads (default 1000000)\n"
+    "  --page-size=N       page size (default 16384)\n"
+    "  --cache-size=N      cache size in bytes (default: library default)\n"
+    "  --compressed-cache=N\n"
+    "                      size of the compressed cache tier in bytes\n"
+    "                      (default 0: disabled)\n"
+    "  --key=TYPE          uint32, uint64 (default) or binary\n"
+    "  --record-size=N     record size (default 8)\n"
+    "  --compressor=NAME   record compression: none (default), zlib, snappy,\n"
+    "                      lzf, lz4 or zstd\n"
+    "  --txn               enables Transactions\n"
+    "  --inmemory          uses an In-Memory Environment\n"
+    "  --threads=N         threads of the mixed and append workloads\n"
+    "                      (default 1)\n"
+    "  --output=FILE       appends the results to FILE\n"
+    "  --baseline=FILE     compares the results with FILE\n"
+    "  --tolerance=PCT     allowed throughput drop (default 5 percent)\n");
+}
+
+static int
+is_selected(const char *list, const char *name) {
+  size_t length = strlen(name);
+  const char *p = list;
+
+  if (!strcmp(list, "all"))
+    return 1;
+  while ((p = strstr(p, name)) != 0) {
+    if ((p == list || p[-1] == ',') && (p[length] == 0 || p[length] == ','))
+      return 1;
+    p += length;
+  }
+  return 0;
+}
+
+int
+main(int argc, char **argv) {
+  static const struct option options[] = {
+    {"workload", required_argument, 0, 'w'},
+    {"records", required_argument, 0, 'r'},
+    {"operations", required_argument, 0, 'o'},
+    {"page-size", required_argument, 0, 'p'},
+    {"cache-size", required_argument, 0, 'c'},
+    {"compressed-cache", required_argument, 0, 'C'},
+    {"key", required_argument, 0, 'k'},
+    {"record-size", required_argument, 0, 's'},
+    {"compressor", required_argument, 0, 'z'},
+    {"txn", no_argument, 0, 't'},
+    {"inmemory", no_argument, 0, 'm'},
+    {"threads", required_argument, 0, 'n'},
+    {"output", required_argument, 0, 'O'},
+    {"baseline", required_argument, 0, 'b'},
+    {"tolerance", required_argument, 0, 'T'},
+    {"help", no_argument, 0, 'h'},
+    {0, 0, 0, 0}
+  };
+  config_t config;
+  FILE *output = 0;
+  int i, opt;
+
+  memset(&config, 0, sizeof(config));
+  config.workloads = "all";
+  config.records = 1000000;
+  config.operations = 1000000;
+  config.page_size = 16 * 1024;
+  config.key_type = KEY_UINT64;
+  config.record_size = 8;
+  config.compressor = "none";
+  config.threads = 1;
+  config.tolerance = 5;
+
+  while ((opt = getopt_long(argc, argv, "", options, 0)) != -1) {
+    switch (opt) {
+      case 'w': config.workloads = optarg; break;
+      case 'r': config.records = strtoull(optarg, 0, 0); break;
+      case 'o': config.operations = strtoull(optarg, 0, 0); break;
+      case 'p': config.page_size = (uint32_t)strtoul(optarg, 0, 0); break;
+      case 'c': config.cache_size = strtoull(optarg, 0, 0); break;
+      case 'C':
+        config.compressed_cache_size = strtoull(optarg, 0, 0);
+        break;
+      case 'k':
+        if (!strcmp(optarg, "uint32"))
+          config.key_type = KEY_UINT32;
+        else if (!strcmp(optarg, "uint64"))
+          config.key_type = KEY_UINT64;
+        else if (!strcmp(optarg, "binary"))
+          config.key_type = KEY_BINARY;
+        else {
+          usage();
+          return 2;
+        }
+        break;
+      case 's': config.record_size = (uint32_t)strtoul(optarg, 0, 0); break;
+      case 'z': config.compressor = optarg; break;
+      case 't': config.use_transactions = 1; break;
+      case 'm': config.in_memory = 1; break;
+      case 'n': config.threads = atoi(optarg); break;
+      case 'O': config.output = optarg; break;
+      case 'b': config.baseline = optarg; break;
+      case 'T': config.tolerance = atof(optarg); break;
+      case 'h': usage(); return 0;
+      default: usage(); return 2;
+    }
+  }
+
+  if (config.records == 0 || config.records > 0xffffffffull
+          || config.threads < 1 || config.threads > MAX_THREADS) {
+    usage();
+    return 2;
+  }
+  if (config.key_type == KEY_UINT32 && config.records * 2 > 0xffffffffull) {
+    fprintf(stderr, "too many records for uint32 keys\n");
+    return 2;
+  }
+
+  if (config.output) {
+    output = fopen(config.output, "a");
+    if (!output) {
+      perror(config.output);
+      return 2;
+    }
+  }
+
+  for (i = 0; workloads[i].name; i++)
+    if (is_selected(config.workloads, workloads[i].name))
+      run_workload(&config, &workloads[i], output);
+
+  if (output)
+    fclose(output);
+
+  if (config.baseline)
+    return compare_baseline(&config) ? 1 : 0;
+  return 0;
+}
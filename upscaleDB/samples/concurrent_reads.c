@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ * All Rights Reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * See the file COPYING for License information.
+ */
+
+/**
+ * A multi-threaded benchmark for read scalability. The Database is filled
+ * with uint32 keys, then 1, 2, 4, ... threads perform random lookups
+ * with ups_db_find() for a few seconds. The throughput is printed for each
+ * number of threads.
+ *
+ * Run with "-c" to enable UPS_ENABLE_CONCURRENT_READS; without this flag
+ * all lookups are serialized by the Environment lock.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h> /* for exit() */
+#include <pthread.h>
+#include <time.h>
+#include <ups/upscaledb.h>
+
+#define DATABASE_NAME   1
+#define NUM_KEYS        1000000
+#define MAX_THREADS     32
+#define DURATION_SEC    3
+
+typedef struct {
+  ups_db_t *db;
+  unsigned seed;
+  volatile int *stop;
+  uint64_t lookups;
+} thread_data_t;
+
+void
+error(const char *foo, ups_status_t st) {
+  printf("%s() returned error %d: %s\n", foo, st, ups_strerror(st));
+  exit(-1);
+}
+
+static double
+now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *
+reader(void *arg) {
+  thread_data_t *data = (thread_data_t *)arg;
+  ups_key_t key = {0};
+  ups_record_t record = {0};
+  uint32_t k, r;
+  ups_status_t st;
+  /* the seed and the counter are kept on the stack and published at the
+   * end; the thread_data_t structures of all threads share cache lines,
+   * and updating them in the loop would measure false sharing instead
+   * of the Database */
+  unsigned seed = data->seed;
+  uint64_t lookups = 0;
+
+  key.data = &k;
+  key.size = sizeof(k);
+
+  /* each thread provides its own record buffer; otherwise all threads
+   * would share the buffer of the Database handle */
+  record.data = &r;
+  record.size = sizeof(r);
+  record.flags = UPS_RECORD_USER_ALLOC;
+
+  while (!*data->stop) {
+    k = (uint32_t)(rand_r(&seed) % NUM_KEYS);
+    st = ups_db_find(data->db, 0, &key, &record, 0);
+    if (st != UPS_SUCCESS)
+      error("ups_db_find", st);
+    lookups++;
+  }
+
+  data->lookups = lookups;
+  return 0;
+}
+
+int
+main(int argc, char **argv) {
+  uint32_t i;
+  int t, threads;
+  ups_status_t st;             /* status variable */
+  ups_env_t *env;              /* upscaledb environment object */
+  ups_db_t *db;                /* upscaledb database object */
+  ups_key_t key = {0};         /* the structure for a key */
+  ups_record_t record = {0};   /* the structure for a record */
+  uint32_t flags = 0;
+  pthread_t tids[MAX_THREADS];
+  thread_data_t data[MAX_THREADS];
+  volatile int stop;
+  ups_parameter_t params[] = { /* parameters for ups_env_create_db */
+    {UPS_PARAM_KEY_TYPE, UPS_TYPE_UINT32},
+    {UPS_PARAM_RECORD_SIZE, sizeof(uint32_t)},
+    {0, }
+  };
+
+  if (argc > 1 && !strcmp(argv[1], "-c"))
+    flags |= UPS_ENABLE_CONCURRENT_READS;
+
+  st = ups_env_create(&env, "test.db", flags, 0664, 0);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create", st);
+
+  st = ups_env_create_db(env, &db, DATABASE_NAME, 0, &params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create_db", st);
+
+  /* Fill the Database with sorted keys */
+  key.size = sizeof(i);
+  key.data = &i;
+  record.size = sizeof(i);
+  record.data = &i;
+  for (i = 0; i < NUM_KEYS; i++) {
+    st = ups_db_insert(db, 0, &key, &record, UPS_HINT_APPEND);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+  }
+
+  printf("concurrent reads: %s\n",
+          (flags & UPS_ENABLE_CONCURRENT_READS) ? "enabled" : "disabled");
+
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    uint64_t total = 0;
+    double start, elapsed;
+
+    stop = 0;
+    start = now();
+    for (t = 0; t < threads; t++) {
+      data[t].db = db;
+      data[t].seed = (unsigned)t + 1;
+      data[t].stop = &stop;
+      data[t].lookups = 0;
+      pthread_create(&tids[t], 0, reader, &data[t]);
+    }
+
+    while (now() - start < DURATION_SEC)
+      nanosleep(&(struct timespec){0, 10 * 1000 * 1000}, 0);
+    stop = 1;
+
+    for (t = 0; t < threads; t++) {
+      pthread_join(tids[t], 0);
+      total += data[t].lookups;
+    }
+    elapsed = now() - start;
+
+    printf("%2d threads: %10.0f lookups/sec\n", threads, total / elapsed);
+  }
+
+  /* We're done! Close the handles. UPS_AUTO_CLEANUP will also close the
+   * Database handle */
+  st = ups_env_close(env, UPS_AUTO_CLEANUP);
+  if (st != UPS_SUCCESS)
+    error("ups_env_close", st);
+
+  return 0;
+}
@@ -19,6 +19,11 @@
  * This example opens an Environment and copies one Database into another.
  * With small modifications this sample would also be able to copy
  * In Memory-Environments to On Disk-Environments and vice versa.
+ *
+ * By default the Database is exported to a temporary file with
+ * ups_db_export, and then read with ups_db_import, which builds the
+ * Btree of the destination bottom-up. Specify "-c" as the last argument
+ * to copy the keys with a cursor and ups_db_insert instead.
  */
 
 #include <stdio.h>
@@ -34,10 +39,34 @@ error(const char *foo, ups_status_t st) {
 
 void
 usage() {
-  printf("usage: ./db2 <environment> <source-db> <destination-db>\n");
+  printf("usage: ./db2 <environment> <source-db> <destination-db> [-c]\n");
   exit(-1);
 }
 
+void
+export_import_db(ups_db_t *source, ups_db_t *dest) {
+  ups_status_t st;
+  FILE *tmp;
+
+  /* the stream is written to (and read from) the file descriptor */
+  tmp = tmpfile();
+  if (!tmp)
+    error("tmpfile", UPS_IO_ERROR);
+
+  st = ups_db_export(source, 0, fileno(tmp), 0);
+  if (st)
+    error("ups_db_export", st);
+
+  /* move back to the beginning of the stream */
+  rewind(tmp);
+
+  st = ups_db_import(dest, 0, fileno(tmp), 0);
+  if (st)
+    error("ups_db_import", st);
+
+  fclose(tmp);
+}
+
 void
 copy_db(ups_db_t *source, ups_db_t *dest) {
   ups_cursor_t *cursor;  /* upscaledb cursor object */
@@ -92,9 +121,12 @@ main(int argc, char **argv) {
   uint16_t src_name;
   uint16_t dest_name;
   const char *env_path = 0;
+  int use_cursor = 0;
 
   /* check and parse the command line parameters */
-  if (argc != 4)
+  if (argc == 5 && !strcmp(argv[4], "-c"))
+    use_cursor = 1;
+  else if (argc != 4)
     usage();
   env_path = argv[1];
   src_name = atoi(argv[2]);
@@ -119,7 +151,10 @@ main(int argc, char **argv) {
     error("ups_env_create_db", st);
 
   /* copy the data */
-  copy_db(src_db, dest_db);
+  if (use_cursor)
+    copy_db(src_db, dest_db);
+  else
+    export_import_db(src_db, dest_db);
 
   /* clean up and return */
   st = ups_env_close(env, UPS_AUTO_CLEANUP);
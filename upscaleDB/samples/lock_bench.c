@@ -0,0 +1,739 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ * All Rights Reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * See the file COPYING for License information.
+ */
+
+/**
+ * A lock contention and fairness benchmark.
+ *
+ * Several classes of threads perform database operations on a shared
+ * Environment; the critical section is one ups_db_find or ups_db_insert
+ * call (and optionally --cs-usec of busy work). The benchmark runs with
+ * each of the following locks:
+ *
+ *   mutex      a pthread mutex around each operation
+ *   ticket     a ticket spinlock around each operation
+ *   mcs        an MCS queue lock around each operation
+ *   hfairlock  the Environment's hierarchical fair lock
+ *              (UPS_ENV_LOCK_HFAIRLOCK)
+ *   engine     the Environment's default lock (UPS_ENV_LOCK_MUTEX)
+ *
+ * For each lock and class, one line with "name=value" pairs is printed:
+ * the throughput, the share of all operations, the expected share, the
+ * share of the lock hold time (only measurable for the external locks)
+ * and the p50/p99/p999 latency of the operations (including the wait for
+ * the lock).
+ *
+ * The expected share depends on the lock: the hfairlock divides the
+ * lock according to the weights of the hierarchy; the FIFO locks (ticket,
+ * mcs) ignore the weights and grant the same share to each thread; the
+ * mutexes (mutex, engine) do not guarantee any order, therefore no
+ * share is expected ("-").
+ *
+ * The thread classes and the lock hierarchy are read from a file
+ * (--config=FILE, see samples/lock_bench.conf):
+ *
+ *   # an inner node of the hierarchy
+ *   node <id> <parent> <weight>
+ *   # a class of threads, attached to node <parent> (0 is the root)
+ *   class <name> <threads> <parent> <weight|nice:N> [find|insert] [think_usec]
+ *
+ * "nice:N" sets the nice value N (-20 .. 19) of the threads and derives
+ * the weight from it, as the CFS scheduler does. --cs-usec does not apply
+ * to the Environment locks, which cannot be extended by the application.
+ *
+ * Usage: lock_bench [--config=FILE] [--locks=LIST] [--duration=SEC]
+ *              [--cs-usec=N] [--disk]
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h> /* for exit() */
+#include <getopt.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <ups/upscaledb.h>
+#include <ups/upscaledb_int.h>
+
+#define DATABASE_NAME   1
+#define NUM_KEYS        100000
+#define MAX_NODES       64
+#define MAX_CLASSES     32
+#define MAX_THREADS     256
+
+/* the latency histograms of upscaledb (all values in nanoseconds) */
+typedef ups_latency_histogram_t histogram_t;
+
+typedef enum {
+  LOCK_MUTEX,
+  LOCK_TICKET,
+  LOCK_MCS,
+  LOCK_HFAIRLOCK,
+  LOCK_ENGINE
+} lock_type_t;
+
+static const char *lock_names[] = {"mutex", "ticket", "mcs", "hfairlock",
+        "engine"};
+
+typedef struct {
+  int id;
+  int parent;
+  uint32_t weight;
+} node_t;
+
+typedef struct {
+  char name[32];
+  int threads;
+  int parent;
+  uint32_t weight;
+  int has_nice;
+  int nice;
+  int insert;
+  uint32_t think_usec;
+} class_t;
+
+typedef struct {
+  node_t nodes[MAX_NODES];
+  int num_nodes;
+  class_t classes[MAX_CLASSES];
+  int num_classes;
+  uint32_t cs_usec;
+  int duration;
+  int in_memory;
+} config_t;
+
+typedef struct mcs_node_t {
+  struct mcs_node_t *volatile next;
+  volatile int locked;
+} mcs_node_t;
+
+typedef struct {
+  pthread_mutex_t mutex;
+  volatile uint32_t next_ticket;
+  volatile uint32_t now_serving;
+  mcs_node_t *volatile tail;
+} locks_t;
+
+typedef struct {
+  const config_t *config;
+  const class_t *cls;
+  lock_type_t lock_type;
+  locks_t *locks;
+  ups_env_t *env;
+  ups_db_t *db;
+  int32_t node;
+  unsigned seed;
+  volatile int *stop;
+  pthread_barrier_t *barrier;
+  mcs_node_t qnode;
+  uint64_t operations;
+  uint64_t hold_ns;
+  histogram_t latency;
+} thread_data_t;
+
+/* maps a nice value (-20 .. 19) to a lock weight, as the CFS scheduler
+ * does */
+static const int prio_to_weight[40] = {
+  88761, 71755, 56483, 46273, 36291,
+  29154, 23254, 18705, 14949, 11916,
+   9548,  7620,  6100,  4904,  3906,
+   3121,  2501,  1991,  1586,  1277,
+   1024,   820,   655,   526,   423,
+    335,   272,   215,   172,   137,
+    110,    87,    70,    56,    45,
+     36,    29,    23,    18,    15
+};
+
+void
+error(const char *foo, ups_status_t st) {
+  printf("%s() returned error %d: %s\n", foo, st, ups_strerror(st));
+  exit(-1);
+}
+
+static uint64_t
+now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void
+spin_usec(uint32_t usec) {
+  uint64_t end = now_ns() + usec * 1000ull;
+  while (now_ns() < end)
+    ;
+}
+
+static void
+cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+static void
+ticket_lock(locks_t *l) {
+  uint32_t ticket = __atomic_fetch_add(&l->next_ticket, 1, __ATOMIC_RELAXED);
+  while (__atomic_load_n(&l->now_serving, __ATOMIC_ACQUIRE) != ticket)
+    cpu_relax();
+}
+
+static void
+ticket_unlock(locks_t *l) {
+  __atomic_store_n(&l->now_serving, l->now_serving + 1, __ATOMIC_RELEASE);
+}
+
+static void
+mcs_lock(locks_t *l, mcs_node_t *node) {
+  mcs_node_t *prev;
+
+  node->next = 0;
+  node->locked = 1;
+  prev = __atomic_exchange_n(&l->tail, node, __ATOMIC_ACQ_REL);
+  if (!prev)
+    return;
+  __atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+  while (__atomic_load_n(&node->locked, __ATOMIC_ACQUIRE))
+    cpu_relax();
+}
+
+static void
+mcs_unlock(locks_t *l, mcs_node_t *node) {
+  mcs_node_t *next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+
+  if (!next) {
+    mcs_node_t *expected = node;
+    if (__atomic_compare_exchange_n(&l->tail, &expected, 0, 0,
+                __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+      return;
+    while (!(next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)))
+      cpu_relax();
+  }
+  __atomic_store_n(&next->locked, 0, __ATOMIC_RELEASE);
+}
+
+static void
+acquire(thread_data_t *data) {
+  switch (data->lock_type) {
+    case LOCK_MUTEX:
+      pthread_mutex_lock(&data->locks->mutex);
+      break;
+    case LOCK_TICKET:
+      ticket_lock(data->locks);
+      break;
+    case LOCK_MCS:
+      mcs_lock(data->locks, &data->qnode);
+      break;
+    default:
+      break;
+  }
+}
+
+static void
+release(thread_data_t *data) {
+  switch (data->lock_type) {
+    case LOCK_MUTEX:
+      pthread_mutex_unlock(&data->locks->mutex);
+      break;
+    case LOCK_TICKET:
+      ticket_unlock(data->locks);
+      break;
+    case LOCK_MCS:
+      mcs_unlock(data->locks, &data->qnode);
+      break;
+    default:
+      break;
+  }
+}
+
+static int
+is_external(lock_type_t type) {
+  return type == LOCK_MUTEX || type == LOCK_TICKET || type == LOCK_MCS;
+}
+
+static void *
+worker(void *arg) {
+  thread_data_t *data = (thread_data_t *)arg;
+  const class_t *cls = data->cls;
+  int external = is_external(data->lock_type);
+  ups_key_t key = {0};
+  ups_record_t record = {0};
+  uint32_t k, r = 0;
+  ups_status_t st;
+
+  if (cls->has_nice
+        && setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), cls->nice))
+    perror("setpriority");
+
+  st = ups_env_set_thread_class(data->env, cls->weight, data->node);
+  if (st != UPS_SUCCESS)
+    error("ups_env_set_thread_class", st);
+
+  key.data = &k;
+  key.size = sizeof(k);
+  /* each thread provides its own record buffer; otherwise all threads
+   * would share the buffer of the Database handle */
+  record.data = &r;
+  record.size = sizeof(r);
+  record.flags = UPS_RECORD_USER_ALLOC;
+
+  pthread_barrier_wait(data->barrier);
+
+  while (!*data->stop) {
+    uint64_t start, locked;
+
+    k = (uint32_t)(rand_r(&data->seed) % NUM_KEYS);
+
+    start = now_ns();
+    acquire(data);
+    locked = now_ns();
+    if (cls->insert)
+      st = ups_db_insert(data->db, 0, &key, &record, UPS_OVERWRITE);
+    else
+      st = ups_db_find(data->db, 0, &key, &record, 0);
+    if (st != UPS_SUCCESS)
+      error(cls->insert ? "ups_db_insert" : "ups_db_find", st);
+    if (external && data->config->cs_usec)
+      spin_usec(data->config->cs_usec);
+    if (external)
+      data->hold_ns += now_ns() - locked;
+    release(data);
+
+    ups_latency_histogram_add(&data->latency, now_ns() - start);
+    data->operations++;
+
+    if (cls->think_usec)
+      spin_usec(cls->think_usec);
+  }
+
+  return 0;
+}
+
+static int
+find_node(const config_t *config, int id) {
+  int i;
+
+  for (i = 0; i < config->num_nodes; i++)
+    if (config->nodes[i].id == id)
+      return i;
+  return -1;
+}
+
+/* sum of the weights of the active children of node |id| (threads and
+ * nodes with threads below them) */
+static double
+active_weight(const config_t *config, int id, const int *active) {
+  double sum = 0;
+  int i;
+
+  for (i = 0; i < config->num_nodes; i++)
+    if (config->nodes[i].parent == id && active[i])
+      sum += config->nodes[i].weight;
+  for (i = 0; i < config->num_classes; i++)
+    if (config->classes[i].parent == id)
+      sum += (double)config->classes[i].threads * config->classes[i].weight;
+  return sum;
+}
+
+/* the share of all threads of a class, according to the weights */
+static double
+weighted_share(const config_t *config, const class_t *cls) {
+  int active[MAX_NODES] = {0};
+  double share;
+  int i, n, changed = 1;
+
+  /* a node is active if a class or an active node is attached to it */
+  while (changed) {
+    changed = 0;
+    for (i = 0; i < config->num_nodes; i++) {
+      int j, a = 0;
+      for (j = 0; j < config->num_classes; j++)
+        if (config->classes[j].parent == config->nodes[i].id)
+          a = 1;
+      for (j = 0; j < config->num_nodes; j++)
+        if (config->nodes[j].parent == config->nodes[i].id && active[j])
+          a = 1;
+      if (a != active[i]) {
+        active[i] = a;
+        changed = 1;
+      }
+    }
+  }
+
+  share = (double)cls->threads * cls->weight
+            / active_weight(config, cls->parent, active);
+  for (n = find_node(config, cls->parent); n >= 0;
+                  n = find_node(config, config->nodes[n].parent))
+    share *= config->nodes[n].weight
+            / active_weight(config, config->nodes[n].parent, active);
+  return share;
+}
+
+/* the share of all threads of a class which the lock |type| is supposed
+ * to grant, or -1 if the lock does not promise anything */
+static double
+expected_share(const config_t *config, const class_t *cls,
+                lock_type_t type) {
+  int i, threads = 0;
+
+  switch (type) {
+    case LOCK_HFAIRLOCK:
+      return weighted_share(config, cls);
+    case LOCK_TICKET:
+    case LOCK_MCS:
+      /* FIFO: every waiting thread gets one turn per round */
+      for (i = 0; i < config->num_classes; i++)
+        threads += config->classes[i].threads;
+      return (double)cls->threads / threads;
+    default:
+      return -1;
+  }
+}
+
+static void
+parse_weight(const char *s, class_t *cls) {
+  if (!strncmp(s, "nice:", 5)) {
+    cls->nice = atoi(s + 5);
+    if (cls->nice < -20 || cls->nice > 19) {
+      fprintf(stderr, "invalid nice value %s\n", s);
+      exit(2);
+    }
+    cls->has_nice = 1;
+    cls->weight = (uint32_t)prio_to_weight[cls->nice + 20];
+  }
+  else
+    cls->weight = (uint32_t)strtoul(s, 0, 0);
+}
+
+static void
+load_config(const char *filename, config_t *config) {
+  FILE *f = fopen(filename, "r");
+  char line[256];
+  int lineno = 0;
+
+  if (!f) {
+    perror(filename);
+    exit(2);
+  }
+
+  while (fgets(line, sizeof(line), f)) {
+    char name[32], weight[32], op[16] = "find";
+    int id, parent, threads;
+    unsigned think = 0;
+    uint32_t w;
+
+    lineno++;
+    if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line))
+      continue;
+
+    if (sscanf(line, "node %d %d %u", &id, &parent, &w) == 3) {
+      node_t *node = &config->nodes[config->num_nodes];
+      if (config->num_nodes == MAX_NODES || id <= 0) {
+        fprintf(stderr, "%s:%d: invalid node\n", filename, lineno);
+        exit(2);
+      }
+      node->id = id;
+      node->parent = parent;
+      node->weight = w;
+      config->num_nodes++;
+    }
+    else if (sscanf(line, "class %31s %d %d %31s %15s %u", name, &threads,
+                    &parent, weight, op, &think) >= 4) {
+      class_t *cls = &config->classes[config->num_classes];
+      if (config->num_classes == MAX_CLASSES || threads <= 0) {
+        fprintf(stderr, "%s:%d: invalid class\n", filename, lineno);
+        exit(2);
+      }
+      memset(cls, 0, sizeof(*cls));
+      strcpy(cls->name, name);
+      cls->threads = threads;
+      cls->parent = parent;
+      parse_weight(weight, cls);
+      cls->insert = !strcmp(op, "insert");
+      cls->think_usec = think;
+      config->num_classes++;
+    }
+    else {
+      fprintf(stderr, "%s:%d: syntax error\n", filename, lineno);
+      exit(2);
+    }
+  }
+
+  fclose(f);
+}
+
+static void
+validate_config(const config_t *config) {
+  int i, threads = 0;
+
+  for (i = 0; i < config->num_nodes; i++)
+    if ((config->nodes[i].parent != 0
+            && find_node(config, config->nodes[i].parent) < 0)
+          || config->nodes[i].weight == 0) {
+      fprintf(stderr, "node %d: invalid parent or weight\n",
+                      config->nodes[i].id);
+      exit(2);
+    }
+  for (i = 0; i < config->num_classes; i++) {
+    if ((config->classes[i].parent != 0
+            && find_node(config, config->classes[i].parent) < 0)
+          || config->classes[i].weight == 0) {
+      fprintf(stderr, "class %s: invalid parent or weight\n",
+                      config->classes[i].name);
+      exit(2);
+    }
+    threads += config->classes[i].threads;
+  }
+  if (threads > MAX_THREADS) {
+    fprintf(stderr, "too many threads (max. %d)\n", MAX_THREADS);
+    exit(2);
+  }
+}
+
+/* creates the nodes of the hierarchy, parents first; |ids| receives the
+ * node ids of the Environment */
+static void
+create_nodes(ups_env_t *env, const config_t *config, int32_t *ids) {
+  int created[MAX_NODES] = {0};
+  int i, remaining = config->num_nodes;
+
+  while (remaining) {
+    int progress = 0;
+    for (i = 0; i < config->num_nodes; i++) {
+      const node_t *node = &config->nodes[i];
+      int p = find_node(config, node->parent);
+      ups_status_t st;
+
+      if (created[i] || (p >= 0 && !created[p]))
+        continue;
+      st = ups_env_add_lock_node(env, node->weight, p >= 0 ? ids[p] : 0,
+                      &ids[i]);
+      if (st != UPS_SUCCESS)
+        error("ups_env_add_lock_node", st);
+      created[i] = 1;
+      remaining--;
+      progress = 1;
+    }
+    if (!progress) {
+      fprintf(stderr, "the node hierarchy has a cycle\n");
+      exit(2);
+    }
+  }
+}
+
+static void
+run(const config_t *config, lock_type_t type) {
+  static thread_data_t data[MAX_THREADS];
+  static histogram_t latency;
+  pthread_t tids[MAX_THREADS];
+  pthread_barrier_t barrier;
+  int32_t ids[MAX_NODES];
+  locks_t locks;
+  ups_env_t *env;
+  ups_db_t *db;
+  ups_key_t key = {0};
+  ups_record_t record = {0};
+  volatile int stop = 0;
+  uint64_t total_ops = 0, total_hold = 0;
+  ups_status_t st;
+  double elapsed;
+  uint32_t i;
+  int c, t, n;
+  ups_parameter_t env_params[] = {
+    {UPS_PARAM_ENV_LOCK, type == LOCK_HFAIRLOCK
+                            ? UPS_ENV_LOCK_HFAIRLOCK
+                            : UPS_ENV_LOCK_MUTEX},
+    {0, }
+  };
+  ups_parameter_t db_params[] = {
+    {UPS_PARAM_KEY_TYPE, UPS_TYPE_UINT32},
+    {UPS_PARAM_RECORD_SIZE, sizeof(uint32_t)},
+    {0, }
+  };
+
+  st = ups_env_create(&env, "lock_bench.db",
+                  config->in_memory ? UPS_IN_MEMORY : 0, 0664, &env_params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create", st);
+  st = ups_env_create_db(env, &db, DATABASE_NAME, 0, &db_params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create_db", st);
+
+  key.size = sizeof(i);
+  key.data = &i;
+  record.size = sizeof(i);
+  record.data = &i;
+  for (i = 0; i < NUM_KEYS; i++) {
+    st = ups_db_insert(db, 0, &key, &record, UPS_HINT_APPEND);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+  }
+
+  create_nodes(env, config, ids);
+
+  memset(&locks, 0, sizeof(locks));
+  pthread_mutex_init(&locks.mutex, 0);
+
+  for (c = 0, n = 0; c < config->num_classes; c++)
+    n += config->classes[c].threads;
+  pthread_barrier_init(&barrier, 0, (unsigned)n + 1);
+
+  for (c = 0, n = 0; c < config->num_classes; c++) {
+    const class_t *cls = &config->classes[c];
+    int p = find_node(config, cls->parent);
+    for (t = 0; t < cls->threads; t++, n++) {
+      memset(&data[n], 0, sizeof(data[n]));
+      data[n].config = config;
+      data[n].cls = cls;
+      data[n].lock_type = type;
+      data[n].locks = &locks;
+      data[n].env = env;
+      data[n].db = db;
+      data[n].node = p >= 0 ? ids[p] : 0;
+      data[n].seed = (unsigned)n + 1;
+      data[n].stop = &stop;
+      data[n].barrier = &barrier;
+      pthread_create(&tids[n], 0, worker, &data[n]);
+    }
+  }
+
+  pthread_barrier_wait(&barrier);
+  elapsed = now_ns() / 1e9;
+  sleep((unsigned)config->duration);
+  stop = 1;
+
+  for (t = 0; t < n; t++) {
+    pthread_join(tids[t], 0);
+    total_ops += data[t].operations;
+    total_hold += data[t].hold_ns;
+  }
+  elapsed = now_ns() / 1e9 - elapsed;
+
+  for (c = 0, n = 0; c < config->num_classes; c++) {
+    const class_t *cls = &config->classes[c];
+    uint64_t ops = 0, hold = 0;
+    char hold_share[16] = "-";
+    char expected[16] = "-";
+    double share = expected_share(config, cls, type);
+
+    memset(&latency, 0, sizeof(latency));
+    for (t = 0; t < cls->threads; t++, n++) {
+      ops += data[n].operations;
+      hold += data[n].hold_ns;
+      ups_latency_histogram_merge(&latency, &data[n].latency);
+    }
+    if (is_external(type) && total_hold)
+      snprintf(hold_share, sizeof(hold_share), "%.1f%%",
+                      hold * 100.0 / total_hold);
+    if (share >= 0)
+      snprintf(expected, sizeof(expected), "%.1f%%", share * 100.0);
+
+    printf("lock=%s class=%s threads=%d weight=%u ops_per_sec=%.0f "
+           "share=%.1f%% expected=%s hold_share=%s p50_ns=%llu "
+           "p99_ns=%llu p999_ns=%llu\n",
+           lock_names[type], cls->name, cls->threads, cls->weight,
+           ops / elapsed, total_ops ? ops * 100.0 / total_ops : 0.0,
+           expected, hold_share,
+           (unsigned long long)ups_latency_histogram_percentile(&latency,
+                   50),
+           (unsigned long long)ups_latency_histogram_percentile(&latency,
+                   99),
+           (unsigned long long)ups_latency_histogram_percentile(&latency,
+                   99.9));
+  }
+  printf("lock=%s class=all ops_per_sec=%.0f\n", lock_names[type],
+                  total_ops / elapsed);
+  fflush(stdout);
+
+  pthread_barrier_destroy(&barrier);
+  pthread_mutex_destroy(&locks.mutex);
+
+  /* UPS_AUTO_CLEANUP will also close the Database handle */
+  st = ups_env_close(env, UPS_AUTO_CLEANUP);
+  if (st != UPS_SUCCESS)
+    error("ups_env_close", st);
+}
+
+static int
+is_selected(const char *list, const char *name) {
+  size_t length = strlen(name);
+  const char *p = list;
+
+  if (!strcmp(list, "all"))
+    return 1;
+  while ((p = strstr(p, name)) != 0) {
+    if ((p == list || p[-1] == ',') && (p[length] == 0 || p[length] == ','))
+      return 1;
+    p += length;
+  }
+  return 0;
+}
+
+int
+main(int argc, char **argv) {
+  static const struct option options[] = {
+    {"config", required_argument, 0, 'c'},
+    {"locks", required_argument, 0, 'l'},
+    {"duration", required_argument, 0, 'd'},
+    {"cs-usec", required_argument, 0, 's'},
+    {"disk", no_argument, 0, 'D'},
+    {0, 0, 0, 0}
+  };
+  static config_t config;
+  const char *locks = "all";
+  int opt, t;
+
+  config.duration = 5;
+  config.in_memory = 1;
+
+  while ((opt = getopt_long(argc, argv, "", options, 0)) != -1) {
+    switch (opt) {
+      case 'c': load_config(optarg, &config); break;
+      case 'l': locks = optarg; break;
+      case 'd': config.duration = atoi(optarg); break;
+      case 's': config.cs_usec = (uint32_t)strtoul(optarg, 0, 0); break;
+      case 'D': config.in_memory = 0; break;
+      default:
+        printf("usage: lock_bench [--config=FILE] [--locks=LIST] "
+               "[--duration=SEC] [--cs-usec=N] [--disk]\n");
+        return 2;
+    }
+  }
+
+  /* without a configuration: 4 threads with the same weight */
+  if (config.num_classes == 0) {
+    class_t *cls = &config.classes[config.num_classes++];
+    strcpy(cls->name, "default");
+    cls->threads = 4;
+    cls->weight = 1024;
+  }
+  validate_config(&config);
+  if (config.duration <= 0)
+    config.duration = 5;
+
+  for (t = LOCK_MUTEX; t <= LOCK_ENGINE; t++)
+    if (is_selected(locks, lock_names[t]))
+      run(&config, (lock_type_t)t);
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ * All Rights Reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * See the file COPYING for License information.
+ */
+
+/**
+ * A benchmark for UPS_PARAM_SEARCH_WINDOW. For each page size (1K to 64K)
+ * and several key types, a Database is filled with keys; then random
+ * lookups are performed with ups_db_find() for each search window. The
+ * lookup throughput is printed for each combination.
+ *
+ * A window of 0 disables the SIMD linear scan, i.e. the leaf nodes are
+ * searched with a pure binary search.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h> /* for exit() */
+#include <time.h>
+#include <ups/upscaledb.h>
+
+#define DATABASE_NAME   1
+#define NUM_KEYS        1000000
+#define NUM_LOOKUPS     2000000
+
+void
+error(const char *foo, ups_status_t st) {
+  printf("%s() returned error %d: %s\n", foo, st, ups_strerror(st));
+  exit(-1);
+}
+
+static double
+now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* converts |i| to a key of the given type */
+static void
+make_key(uint32_t type, uint32_t i, ups_key_t *key, void *buffer) {
+  switch (type) {
+    case UPS_TYPE_UINT32:
+      *(uint32_t *)buffer = i;
+      key->size = sizeof(uint32_t);
+      break;
+    case UPS_TYPE_UINT64:
+      *(uint64_t *)buffer = i;
+      key->size = sizeof(uint64_t);
+      break;
+    case UPS_TYPE_REAL64:
+      *(double *)buffer = i;
+      key->size = sizeof(double);
+      break;
+  }
+  key->data = buffer;
+}
+
+static double
+run(uint32_t type, uint32_t page_size, uint32_t window) {
+  uint32_t i;
+  uint64_t buffer;
+  ups_status_t st;             /* status variable */
+  ups_env_t *env;              /* upscaledb environment object */
+  ups_db_t *db;                /* upscaledb database object */
+  ups_key_t key = {0};         /* the structure for a key */
+  ups_record_t record = {0};   /* the structure for a record */
+  unsigned seed = 1;
+  double start;
+  ups_parameter_t env_params[] = { /* parameters for ups_env_create */
+    {UPS_PARAM_PAGE_SIZE, page_size},
+    {0, }
+  };
+  ups_parameter_t db_params[] = { /* parameters for ups_env_create_db */
+    {UPS_PARAM_KEY_TYPE, type},
+    {UPS_PARAM_RECORD_SIZE, 0},
+    {UPS_PARAM_SEARCH_WINDOW, window},
+    {0, }
+  };
+
+  st = ups_env_create(&env, "test.db", UPS_IN_MEMORY, 0664, &env_params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create", st);
+
+  st = ups_env_create_db(env, &db, DATABASE_NAME, 0, &db_params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create_db", st);
+
+  /* Fill the Database with sorted keys */
+  for (i = 0; i < NUM_KEYS; i++) {
+    make_key(type, i, &key, &buffer);
+    st = ups_db_insert(db, 0, &key, &record, UPS_HINT_APPEND);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+  }
+
+  start = now();
+  for (i = 0; i < NUM_LOOKUPS; i++) {
+    make_key(type, (uint32_t)(rand_r(&seed) % NUM_KEYS), &key, &buffer);
+    st = ups_db_find(db, 0, &key, &record, 0);
+    if (st != UPS_SUCCESS)
+      error("ups_db_find", st);
+  }
+
+  start = now() - start;
+
+  st = ups_env_close(env, UPS_AUTO_CLEANUP);
+  if (st != UPS_SUCCESS)
+    error("ups_env_close", st);
+
+  return NUM_LOOKUPS / start;
+}
+
+int
+main(int argc, char **argv) {
+  static const uint32_t types[] = {UPS_TYPE_UINT32, UPS_TYPE_UINT64,
+          UPS_TYPE_REAL64};
+  static const char *type_names[] = {"uint32", "uint64", "real64"};
+  static const uint32_t windows[] = {0, 8, 16, 32, 64, 128};
+  uint32_t page_size;
+  size_t t, w;
+
+  (void)argc;
+  (void)argv;
+
+  printf("%-7s %9s", "type", "pagesize");
+  for (w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+    printf("  window=%-4u", windows[w]);
+  printf("\n");
+
+  for (t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    for (page_size = 1024; page_size <= 64 * 1024; page_size *= 2) {
+      printf("%-7s %9u", type_names[t], page_size);
+      for (w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+        printf("  %11.0f", run(types[t], page_size, windows[w]));
+      printf("\n");
+    }
+  }
+
+  printf("(lookups/sec)\n");
+  return 0;
+}
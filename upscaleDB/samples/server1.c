@@ -39,6 +39,8 @@ main()
   ups_env_t *env;
   ups_srv_t *srv;
   ups_srv_config_t cfg;
+  ups_srv_weight_t weights[1];
+  ups_srv_class_metrics_t metrics;
   ups_status_t st;
   char input[1024];
   int s;
@@ -83,12 +85,23 @@ main()
    * including the port, the Environment etc */
   memset(&cfg, 0, sizeof(cfg));
   cfg.port = 8080;
+  cfg.num_io_threads = 1;
+  cfg.num_worker_threads = 4;
+  /* requests for "/env1.db" get the weight 2. This server has only one
+   * Environment, which therefore gets all of the worker threads; an
+   * Environment which is added later without a weight gets the weight 1,
+   * and only half of the share of "/env1.db" */
+  weights[0].urlname = "/env1.db";
+  weights[0].weight = 2;
+  cfg.env_weights = &weights[0];
+  cfg.num_env_weights = 1;
   ups_srv_init(&cfg, &srv);
   ups_srv_add_env(srv, env, "/env1.db");
 
   printf("server1%s started - please run sample 'client1%s' for a test\n",
       EXT, EXT);
-  printf("type 'exit' to end the server\n");
+  printf("type 'stats' to print the request metrics, 'exit' to end the "
+      "server\n");
 
   /* See client1.c for the corresponding client */
   while (1) {
@@ -98,6 +111,21 @@ main()
       printf("exiting...\n");
       break;
     }
+    if (!strcmp(input, "stats")) {
+      st = ups_srv_get_class_metrics(srv, env, &metrics);
+      if (st) {
+        printf("ups_srv_get_class_metrics: %d\n", st);
+        continue;
+      }
+      printf("connections: %u, queued: %llu, requests: %llu, avg latency: "
+          "%llu usec, max latency: %llu usec\n",
+          (unsigned)metrics.connections,
+          (unsigned long long)metrics.queue_depth,
+          (unsigned long long)metrics.requests,
+          (unsigned long long)metrics.avg_latency_usec,
+          (unsigned long long)metrics.max_latency_usec);
+      continue;
+    }
     printf("unknown command\n");
   }
 
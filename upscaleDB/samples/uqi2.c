@@ -106,6 +106,25 @@ equals10_predicate(void *state, const void *key_data, uint32_t key_size,
   return *(uint32_t *)record_data == 10;
 }
 
+/*
+ * Predicate plugin: checks a list of records. Sets a bit in |bitmap| for
+ * each record which is 10. This function is called for fixed-length data,
+ * but never for variable-length data. The loop is simple enough to be
+ * vectorized by the compiler.
+ */
+static void
+equals10_predicate_many(void *state, const void *key_data_list,
+                const void *record_data_list, size_t list_length,
+                uint8_t *bitmap)
+{
+  const uint32_t *records = (const uint32_t *)record_data_list;
+  size_t i;
+
+  memset(bitmap, 0, (list_length + 7) / 8);
+  for (i = 0; i < list_length; i++)
+    bitmap[i / 8] |= (uint8_t)((records[i] == 10) << (i % 8));
+}
+
 int
 main(int argc, char **argv)
 {
@@ -173,6 +192,8 @@ main(int argc, char **argv)
   pred.type = UQI_PLUGIN_PREDICATE;
   pred.name = "equals10";
   pred.pred = equals10_predicate;
+  pred.pred_many = equals10_predicate_many;
+  pred.plugin_version = 2; /* required for pred_many */
   st = uqi_register_plugin(&pred);
   if (st != UPS_SUCCESS)
     error("uqi_register_plugin", st);
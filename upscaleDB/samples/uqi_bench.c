@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2005-2016 Christoph Rupp (chris@crupp.de).
+ * All Rights Reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * See the file COPYING for License information.
+ */
+
+/**
+ * A benchmark for the built-in UQI aggregation functions. A Database with
+ * uint32 record number keys and uint32 records is filled (by default with
+ * 100 million records), then SUM, AVERAGE, MIN, MAX and COUNT are executed
+ * on the keys and the records, with and without a predicate, and with
+ * several threads. Finally, many queries over small ranges are executed,
+ * with and without a compiled query plan.
+ *
+ * Usage: uqi_bench [-z] [count]
+ *
+ *   -z: compresses the keys with UPS_COMPRESSOR_UINT32_SIMDCOMP
+ *   count: the number of records
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h> /* for exit() */
+#include <time.h>
+
+#include <ups/upscaledb.h>
+#include <ups/upscaledb_uqi.h>
+
+#define DATABASE_NAME  1
+
+void
+error(const char *foo, ups_status_t st)
+{
+  printf("%s() returned error %d: %s\n", foo, st, ups_strerror(st));
+  exit(-1);
+}
+
+static double
+now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* selects every other record */
+static int
+even_predicate(void *state, const void *key_data, uint32_t key_size,
+                const void *record_data, uint32_t record_size)
+{
+  (void)state;
+  (void)key_data;
+  (void)key_size;
+  (void)record_size;
+  return (*(const uint32_t *)record_data & 1) == 0;
+}
+
+static void
+run(ups_env_t *env, const char *query, uint64_t count)
+{
+  uqi_result_t *result;
+  ups_status_t st;
+  double start = now();
+
+  st = uqi_select(env, query, &result);
+  if (st != UPS_SUCCESS)
+    error("uqi_select", st);
+  start = now() - start;
+
+  printf("%-50s %8.3f sec %10.1f M rows/sec\n", query, start,
+                  count / start / 1e6);
+  uqi_result_close(result);
+}
+
+/* positions |cursor| on the record number |recno| */
+static void
+find(ups_cursor_t *cursor, uint32_t recno)
+{
+  ups_key_t key = ups_make_key(&recno, sizeof(recno));
+  ups_status_t st = ups_cursor_find(cursor, &key, 0, 0);
+  if (st != UPS_SUCCESS)
+    error("ups_cursor_find", st);
+}
+
+/*
+ * runs many queries over small ranges of 100 records, once with
+ * uqi_select_range (parsing the query each time) and once with a
+ * compiled plan
+ */
+static void
+run_small_ranges(ups_env_t *env, ups_db_t *db, uint64_t count)
+{
+  const char *query = "SUM($record) FROM DATABASE 1";
+  const int loops = 100000;
+  ups_cursor_t *begin, *end;
+  uqi_result_t *result;
+  uqi_plan_t *plan;
+  unsigned seed = 1;
+  ups_status_t st;
+  double start;
+  int i;
+
+  if (count <= 100)
+    return;
+
+  st = ups_cursor_create(&begin, db, 0, 0);
+  if (st != UPS_SUCCESS)
+    error("ups_cursor_create", st);
+  st = ups_cursor_create(&end, db, 0, 0);
+  if (st != UPS_SUCCESS)
+    error("ups_cursor_create", st);
+
+  start = now();
+  for (i = 0; i < loops; i++) {
+    uint32_t recno = 1 + (uint32_t)(rand_r(&seed) % (count - 100));
+    find(begin, recno);
+    find(end, recno + 100);
+    st = uqi_select_range(env, query, begin, end, &result);
+    if (st != UPS_SUCCESS)
+      error("uqi_select_range", st);
+    uqi_result_close(result);
+  }
+  printf("%-50s %8.3f sec\n", "small ranges, uqi_select_range", now() - start);
+
+  st = uqi_prepare(env, query, &plan);
+  if (st != UPS_SUCCESS)
+    error("uqi_prepare", st);
+
+  seed = 1;
+  start = now();
+  for (i = 0; i < loops; i++) {
+    uint32_t recno = 1 + (uint32_t)(rand_r(&seed) % (count - 100));
+    find(begin, recno);
+    find(end, recno + 100);
+    st = uqi_execute(plan, begin, end, &result);
+    if (st != UPS_SUCCESS)
+      error("uqi_execute", st);
+    uqi_result_close(result);
+  }
+  printf("%-50s %8.3f sec\n", "small ranges, uqi_execute", now() - start);
+
+  uqi_plan_release(plan);
+  ups_cursor_close(begin);
+  ups_cursor_close(end);
+}
+
+int
+main(int argc, char **argv)
+{
+  static const char *queries[] = {
+    "SUM($record) FROM DATABASE 1",
+    "AVERAGE($record) FROM DATABASE 1",
+    "MIN($record) FROM DATABASE 1",
+    "MAX($record) FROM DATABASE 1",
+    "COUNT($record) FROM DATABASE 1",
+    "SUM($key) FROM DATABASE 1",
+    "MAX($key) FROM DATABASE 1",
+    "SUM($record) FROM DATABASE 1 WHERE even($record)",
+    "COUNT($record) FROM DATABASE 1 WHERE even($record)",
+    "SUM($record) FROM DATABASE 1 PARALLEL 2",
+    "SUM($record) FROM DATABASE 1 PARALLEL 4",
+    "SUM($record) FROM DATABASE 1 PARALLEL 8",
+    0
+  };
+  uint64_t count = 100000000;
+  ups_status_t st;             /* status variable */
+  ups_env_t *env;              /* upscaledb environment object */
+  ups_db_t *db;                /* upscaledb database object */
+  uqi_plugin_t pred;
+  double start;
+  int i;
+  ups_parameter_t params[] = { /* parameters for ups_env_create_db */
+    {UPS_PARAM_KEY_TYPE, UPS_TYPE_UINT32},
+    {UPS_PARAM_RECORD_TYPE, UPS_TYPE_UINT32},
+    {0, 0},
+    {0, 0}
+  };
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-z")) {
+      params[2].name = UPS_PARAM_KEY_COMPRESSION;
+      params[2].value = UPS_COMPRESSOR_UINT32_SIMDCOMP;
+    }
+    else
+      count = strtoull(argv[i], 0, 0);
+  }
+
+  st = ups_env_create(&env, "test.db", 0, 0664, 0);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create", st);
+
+  st = ups_env_create_db(env, &db, DATABASE_NAME, UPS_RECORD_NUMBER32,
+                  &params[0]);
+  if (st != UPS_SUCCESS)
+    error("ups_env_create_db", st);
+
+  start = now();
+  for (uint64_t n = 0; n < count; n++) {
+    uint32_t value = (uint32_t)(n % 1000);
+    ups_key_t key = {0};
+    ups_record_t record = ups_make_record(&value, sizeof(value));
+
+    st = ups_db_insert(db, 0, &key, &record, 0);
+    if (st != UPS_SUCCESS)
+      error("ups_db_insert", st);
+  }
+  printf("inserted %llu records in %.3f sec\n", (unsigned long long)count,
+                  now() - start);
+
+  memset(&pred, 0, sizeof(pred));
+  pred.type = UQI_PLUGIN_PREDICATE;
+  pred.name = "even";
+  pred.pred = even_predicate;
+  st = uqi_register_plugin(&pred);
+  if (st != UPS_SUCCESS)
+    error("uqi_register_plugin", st);
+
+  for (i = 0; queries[i]; i++)
+    run(env, queries[i], count);
+
+  run_small_ranges(env, db, count);
+
+  /* we're done! close the handles. UPS_AUTO_CLEANUP will also close the
+   * 'db' handle */
+  st = ups_env_close(env, UPS_AUTO_CLEANUP);
+  if (st != UPS_SUCCESS)
+    error("ups_env_close", st);
+
+  return 0;
+}